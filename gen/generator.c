@@ -239,59 +239,36 @@ int main(int args, char *argv[]) {
   include_abs(pgni_h, "string.h");
   include_rel(pgni_h, "binary_search.h");
   newline(pgni_h);
-  pgni_add_element_function(pgni_h, "solids", "solid_ids", "solid_cons",
-                            "num_solids", "d3plot_read_solid_element_ids",
-                            "d3plot_read_solid_elements", "d3plot_solid_con");
+  pgni_mark_element_function(pgni_h, "solids", "solid_ids", "solid_cons",
+                             "num_solids", "d3plot_read_solid_element_ids",
+                             "d3plot_read_solid_elements", "d3plot_solid_con",
+                             "solid_indices");
   newline(pgni_h);
-  pgni_add_element_function(pgni_h, "beams", "beam_ids", "beam_cons",
-                            "num_beams", "d3plot_read_beam_element_ids",
-                            "d3plot_read_beam_elements", "d3plot_beam_con");
+  pgni_mark_element_function(pgni_h, "beams", "beam_ids", "beam_cons",
+                             "num_beams", "d3plot_read_beam_element_ids",
+                             "d3plot_read_beam_elements", "d3plot_beam_con",
+                             "beam_indices");
   newline(pgni_h);
-  pgni_add_element_function(pgni_h, "shells", "shell_ids", "shell_cons",
-                            "num_shells", "d3plot_read_shell_element_ids",
-                            "d3plot_read_shell_elements", "d3plot_shell_con");
+  pgni_mark_element_function(pgni_h, "shells", "shell_ids", "shell_cons",
+                             "num_shells", "d3plot_read_shell_element_ids",
+                             "d3plot_read_shell_elements", "d3plot_shell_con",
+                             "shell_indices");
   newline(pgni_h);
-  pgni_add_element_function(
+  pgni_mark_element_function(
       pgni_h, "thick_shells", "thick_shell_ids", "thick_shell_cons",
       "num_thick_shells", "d3plot_read_thick_shell_element_ids",
-      "d3plot_read_thick_shell_elements", "d3plot_thick_shell_con");
+      "d3plot_read_thick_shell_elements", "d3plot_thick_shell_con",
+      "thick_shell_indices");
   newline(pgni_h);
-  pgnind_add_element_function(pgni_h, "solids", "solid_ids", "solid_cons",
-                              "num_solids", "d3plot_read_solid_element_ids",
-                              "d3plot_read_solid_elements", "d3plot_solid_con");
-  newline(pgni_h);
-  pgnind_add_element_function(pgni_h, "beams", "beam_ids", "beam_cons",
-                              "num_beams", "d3plot_read_beam_element_ids",
-                              "d3plot_read_beam_elements", "d3plot_beam_con");
-  newline(pgni_h);
-  pgnind_add_element_function(pgni_h, "shells", "shell_ids", "shell_cons",
-                              "num_shells", "d3plot_read_shell_element_ids",
-                              "d3plot_read_shell_elements", "d3plot_shell_con");
-  newline(pgni_h);
-  pgnind_add_element_function(
-      pgni_h, "thick_shells", "thick_shell_ids", "thick_shell_cons",
-      "num_thick_shells", "d3plot_read_thick_shell_element_ids",
-      "d3plot_read_thick_shell_elements", "d3plot_thick_shell_con");
-  newline(pgni_h);
-  pgni_add_element_macro(pgni_h, "SOLIDS", "solids", "solid_ids", "solid_cons",
-                         "num_solids");
-  pgni_add_element_macro(pgni_h, "BEAMS", "beams", "beam_ids", "beam_cons",
-                         "num_beams");
-  pgni_add_element_macro(pgni_h, "SHELLS", "shells", "shell_ids", "shell_cons",
-                         "num_shells");
-  pgni_add_element_macro(pgni_h, "THICK_SHELLS", "thick_shells",
-                         "thick_shell_ids", "thick_shell_cons",
-                         "num_thick_shells");
-  newline(pgni_h);
-  pgnind_add_element_macro(pgni_h, "SOLIDS", "solids", "solid_ids",
-                           "solid_cons", "num_solids");
-  pgnind_add_element_macro(pgni_h, "BEAMS", "beams", "beam_ids", "beam_cons",
-                           "num_beams");
-  pgnind_add_element_macro(pgni_h, "SHELLS", "shells", "shell_ids",
-                           "shell_cons", "num_shells");
-  pgnind_add_element_macro(pgni_h, "THICK_SHELLS", "thick_shells",
-                           "thick_shell_ids", "thick_shell_cons",
-                           "num_thick_shells");
+  pgni_mark_element_macro(pgni_h, "SOLIDS", "solids", "solid_ids",
+                          "solid_cons", "num_solids");
+  pgni_mark_element_macro(pgni_h, "BEAMS", "beams", "beam_ids", "beam_cons",
+                          "num_beams");
+  pgni_mark_element_macro(pgni_h, "SHELLS", "shells", "shell_ids",
+                          "shell_cons", "num_shells");
+  pgni_mark_element_macro(pgni_h, "THICK_SHELLS", "thick_shells",
+                          "thick_shell_ids", "thick_shell_cons",
+                          "num_thick_shells");
   newline(pgni_h);
   header_end(pgni_h);
 
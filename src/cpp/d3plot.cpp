@@ -24,7 +24,9 @@
  ************************************************************************************/
 
 #include "d3plot.hpp"
+#include <cstring>
 #include <ctime>
+#include <regex>
 
 namespace dro {
 
@@ -122,6 +124,25 @@ Array<d3_word> D3plot::read_all_element_ids() {
   return Array<d3_word>(ids, num_ids);
 }
 
+std::tuple<Array<d3_word>, Array<uint8_t>, Array<size_t>>
+D3plot::read_all_element_ids2() {
+  size_t num_ids;
+  uint8_t *types;
+  size_t *indices;
+  d3_word *ids =
+      d3plot_read_all_element_ids2(&m_handle, &num_ids, &types, &indices);
+  if (m_handle.error_string) {
+    free(ids);
+    free(types);
+    free(indices);
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(Array<d3_word>(ids, num_ids),
+                         Array<uint8_t>(types, num_ids),
+                         Array<size_t>(indices, num_ids));
+}
+
 Array<d3_word> D3plot::read_part_ids() {
   size_t num_ids;
   d3_word *ids = d3plot_read_part_ids(&m_handle, &num_ids);
@@ -233,6 +254,138 @@ std::vector<Array<dVec3>> D3plot::read_all_node_acceleration() {
   return time_steps;
 }
 
+Array<dVec3> D3plot::read_node_displacement(size_t state) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(
+      d3plot_read_node_displacement(&m_handle, state, &num_nodes));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(nodes, num_nodes);
+}
+
+std::vector<Array<dVec3>> D3plot::read_all_node_displacement() {
+  size_t num_nodes, num_time_steps;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(d3plot_read_all_node_displacement(
+      &m_handle, &num_nodes, &num_time_steps));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<dVec3>> time_steps(num_time_steps);
+  for (size_t t = 0; t < num_time_steps; t++) {
+    time_steps[t] = Array<dVec3>(&nodes[t * num_nodes], num_nodes, t == 0);
+  }
+  return time_steps;
+}
+
+std::vector<Array<dVec3>>
+D3plot::read_node_displacement(size_t first_state, size_t num_states,
+                               const Array<size_t> &node_indices) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(d3plot_read_node_displacement_range(
+      &m_handle, first_state, num_states, node_indices.data(),
+      node_indices.size(), &num_nodes));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<dVec3>> time_steps(num_states);
+  for (size_t t = 0; t < num_states; t++) {
+    time_steps[t] = Array<dVec3>(&nodes[t * num_nodes], num_nodes, t == 0);
+  }
+  return time_steps;
+}
+
+Array<dVec3> D3plot::read_node_relative_displacement(
+    size_t state, const Array<size_t> &node_indices,
+    const Array<size_t> &reference_indices) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(
+      d3plot_read_node_relative_displacement(
+          &m_handle, state, node_indices.data(), node_indices.size(),
+          reference_indices.data(), reference_indices.size(), &num_nodes));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(nodes, num_nodes);
+}
+
+Array<double> D3plot::read_node_temperature(size_t state) {
+  size_t num_nodes;
+  double *data = d3plot_read_node_temperature(&m_handle, state, &num_nodes);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<double>(data,
+                       num_nodes * m_handle.control_data.num_temperatures);
+}
+
+std::vector<Array<double>> D3plot::read_node_temperature(size_t first_state,
+                                                         size_t num_states) {
+  return read_node_temperature(first_state, num_states, Array<size_t>());
+}
+
+std::vector<Array<double>>
+D3plot::read_node_temperature(size_t first_state, size_t num_states,
+                              const Array<size_t> &node_indices) {
+  size_t num_nodes;
+  double *data = d3plot_read_node_temperature_range(
+      &m_handle, first_state, num_states,
+      node_indices.size() == 0 ? nullptr : node_indices.data(),
+      node_indices.size(), &num_nodes);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  if (num_states == 0) {
+    free(data);
+    return {};
+  }
+
+  const size_t num_values = num_nodes * m_handle.control_data.num_temperatures;
+  std::vector<Array<double>> states(num_states);
+  for (size_t t = 0; t < num_states; t++) {
+    states[t] = Array<double>(&data[t * num_values], num_values, t == 0);
+  }
+  return states;
+}
+
+Array<dVec3> D3plot::read_node_flux(size_t state) {
+  size_t num_nodes;
+  dVec3 *fluxes = reinterpret_cast<dVec3 *>(
+      d3plot_read_node_flux(&m_handle, state, &num_nodes));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(fluxes, num_nodes);
+}
+
+Array<double> D3plot::read_node_mass_scaling(size_t state) {
+  size_t num_nodes;
+  double *data = d3plot_read_node_mass_scaling(&m_handle, state, &num_nodes);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<double>(data, num_nodes);
+}
+
+Array<double> D3plot::read_solids_thermal_state(size_t state) {
+  size_t num_solids;
+  double *data =
+      d3plot_read_solids_thermal_state(&m_handle, state, &num_solids);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<double>(data, num_solids * m_handle.control_data.nt3d);
+}
+
 Array<fVec3> D3plot::read_node_coordinates_32(size_t state) {
   size_t num_nodes;
   fVec3 *nodes = reinterpret_cast<fVec3 *>(
@@ -328,6 +481,76 @@ Array<double> D3plot::read_all_time() {
   return Array<double>(times, num_states);
 }
 
+d3plot_global D3plot::read_global(size_t state) {
+  const d3plot_global global = d3plot_read_global(&m_handle, state);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return global;
+}
+
+Array<d3plot_global> D3plot::read_all_global() {
+  size_t num_states;
+  d3plot_global *globals = d3plot_read_all_global(&m_handle, &num_states);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return Array<d3plot_global>(globals, num_states);
+}
+
+Array<double> D3plot::read_material_data(size_t state,
+                                         MaterialQuantity quantity) {
+  size_t num_materials;
+  double *data = d3plot_read_material_data(
+      &m_handle, state, static_cast<int>(quantity), &num_materials);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return Array<double>(data, num_materials);
+}
+
+std::vector<Array<double>>
+D3plot::read_all_material_data(MaterialQuantity quantity) {
+  size_t num_states, num_materials;
+  double *data = d3plot_read_all_material_data(
+      &m_handle, static_cast<int>(quantity), &num_states, &num_materials);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<double>> states(num_states);
+  for (size_t t = 0; t < num_states; t++) {
+    states[t] = Array<double>(&data[t * num_materials], num_materials, t == 0);
+  }
+  return states;
+}
+
+Array<d3plot_rigid_wall> D3plot::read_rigid_walls(size_t state) {
+  size_t num_rigid_walls;
+  d3plot_rigid_wall *rigid_walls =
+      d3plot_read_rigid_walls(&m_handle, state, &num_rigid_walls);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return Array<d3plot_rigid_wall>(rigid_walls, num_rigid_walls);
+}
+
+std::vector<Array<d3plot_rigid_wall>> D3plot::read_all_rigid_walls() {
+  size_t num_states, num_rigid_walls;
+  d3plot_rigid_wall *rigid_walls =
+      d3plot_read_all_rigid_walls(&m_handle, &num_states, &num_rigid_walls);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<d3plot_rigid_wall>> states(num_states);
+  for (size_t t = 0; t < num_states; t++) {
+    states[t] = Array<d3plot_rigid_wall>(&rigid_walls[t * num_rigid_walls],
+                                         num_rigid_walls, t == 0);
+  }
+  return states;
+}
+
 float D3plot::read_time_32(size_t state) {
   float time{d3plot_read_time_32(&m_handle, state)};
   if (m_handle.error_string) {
@@ -379,6 +602,21 @@ Array<d3plot_beam> D3plot::read_beams_state(size_t state) {
   return Array<d3plot_beam>(elements, num_elements);
 }
 
+D3plotBeams D3plot::read_beams_state_arrays(size_t state,
+                                            bool with_integration_points) {
+  D3plotBeams beams(m_handle.control_data.nel2, m_handle.control_data.beamip,
+                    m_handle.control_data.neipb, with_integration_points);
+  read_beams_state_arrays(state, beams);
+  return beams;
+}
+
+void D3plot::read_beams_state_arrays(size_t state, D3plotBeams &beams) {
+  if (!d3plot_read_beams_state_arrays(&m_handle, state,
+                                      &beams.get_handle())) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+}
+
 Array<D3plotShell> D3plot::read_shells_state(size_t state) {
   size_t num_elements;
   d3plot_shell *elements =
@@ -391,6 +629,182 @@ Array<D3plotShell> D3plot::read_shells_state(size_t state) {
                             num_elements);
 }
 
+Array<d3plot_solid> D3plot::read_part_solids_state(size_t state,
+                                                   const D3plotPart &part) {
+  size_t num_elements;
+  d3plot_solid *elements = d3plot_read_part_solids_state(
+      &m_handle, state, &part.get_handle(), &num_elements);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<d3plot_solid>(elements, num_elements);
+}
+
+Array<D3plotThickShell>
+D3plot::read_part_thick_shells_state(size_t state, const D3plotPart &part) {
+  size_t num_elements;
+  d3plot_thick_shell *elements = d3plot_read_part_thick_shells_state(
+      &m_handle, state, &part.get_handle(), &num_elements);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<D3plotThickShell>(reinterpret_cast<D3plotThickShell *>(elements),
+                                 num_elements);
+}
+
+Array<d3plot_beam> D3plot::read_part_beams_state(size_t state,
+                                                 const D3plotPart &part) {
+  size_t num_elements;
+  d3plot_beam *elements = d3plot_read_part_beams_state(
+      &m_handle, state, &part.get_handle(), &num_elements);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<d3plot_beam>(elements, num_elements);
+}
+
+Array<D3plotShell> D3plot::read_part_shells_state(size_t state,
+                                                  const D3plotPart &part) {
+  size_t num_elements;
+  d3plot_shell *elements = d3plot_read_part_shells_state(
+      &m_handle, state, &part.get_handle(), &num_elements);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<D3plotShell>(reinterpret_cast<D3plotShell *>(elements),
+                            num_elements);
+}
+
+Array<dVec3>
+D3plot::read_part_node_coordinates(size_t state, const D3plotPart &part,
+                                   const Array<d3_word> *part_node_indices) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(d3plot_read_part_node_coordinates2(
+      &m_handle, state, &part.get_handle(), &num_nodes,
+      part_node_indices ? part_node_indices->data() : nullptr,
+      part_node_indices ? part_node_indices->size() : 0));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(nodes, num_nodes);
+}
+
+Array<dVec3>
+D3plot::read_part_node_velocity(size_t state, const D3plotPart &part,
+                                const Array<d3_word> *part_node_indices) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(d3plot_read_part_node_velocity2(
+      &m_handle, state, &part.get_handle(), &num_nodes,
+      part_node_indices ? part_node_indices->data() : nullptr,
+      part_node_indices ? part_node_indices->size() : 0));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(nodes, num_nodes);
+}
+
+Array<dVec3>
+D3plot::read_part_node_acceleration(size_t state, const D3plotPart &part,
+                                    const Array<d3_word> *part_node_indices) {
+  size_t num_nodes;
+  dVec3 *nodes = reinterpret_cast<dVec3 *>(d3plot_read_part_node_acceleration2(
+      &m_handle, state, &part.get_handle(), &num_nodes,
+      part_node_indices ? part_node_indices->data() : nullptr,
+      part_node_indices ? part_node_indices->size() : 0));
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<dVec3>(nodes, num_nodes);
+}
+
+Array<uint8_t> D3plot::read_deleted_nodes(size_t state) {
+  size_t num_nodes;
+  uint8_t *deleted = d3plot_read_deleted_nodes(&m_handle, state, &num_nodes);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<uint8_t>(deleted, (num_nodes + 7) / 8);
+}
+
+Array<uint8_t> D3plot::read_deleted_elements(size_t state, IdType id_type) {
+  size_t num_elements;
+  uint8_t *deleted = d3plot_read_deleted_elements(
+      &m_handle, state, static_cast<int>(id_type), &num_elements);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<uint8_t>(deleted, (num_elements + 7) / 8);
+}
+
+std::tuple<Array<d3plot_solid>, Array<size_t>>
+D3plot::read_alive_solids_state(size_t state) {
+  size_t num_elements;
+  size_t *indices;
+  d3plot_solid *elements =
+      d3plot_read_alive_solids_state(&m_handle, state, &num_elements, &indices);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(Array<d3plot_solid>(elements, num_elements),
+                         Array<size_t>(indices, num_elements));
+}
+
+std::tuple<Array<D3plotThickShell>, Array<size_t>>
+D3plot::read_alive_thick_shells_state(size_t state) {
+  size_t num_elements;
+  size_t *indices;
+  d3plot_thick_shell *elements = d3plot_read_alive_thick_shells_state(
+      &m_handle, state, &num_elements, &indices);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(
+      Array<D3plotThickShell>(reinterpret_cast<D3plotThickShell *>(elements),
+                              num_elements),
+      Array<size_t>(indices, num_elements));
+}
+
+std::tuple<Array<d3plot_beam>, Array<size_t>>
+D3plot::read_alive_beams_state(size_t state) {
+  size_t num_elements;
+  size_t *indices;
+  d3plot_beam *elements =
+      d3plot_read_alive_beams_state(&m_handle, state, &num_elements, &indices);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(Array<d3plot_beam>(elements, num_elements),
+                         Array<size_t>(indices, num_elements));
+}
+
+std::tuple<Array<D3plotShell>, Array<size_t>>
+D3plot::read_alive_shells_state(size_t state) {
+  size_t num_elements;
+  size_t *indices;
+  d3plot_shell *elements =
+      d3plot_read_alive_shells_state(&m_handle, state, &num_elements, &indices);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(
+      Array<D3plotShell>(reinterpret_cast<D3plotShell *>(elements),
+                         num_elements),
+      Array<size_t>(indices, num_elements));
+}
+
 Array<d3plot_solid_con> D3plot::read_solid_elements() {
   size_t num_elements;
   d3plot_solid_con *elements =
@@ -402,6 +816,16 @@ Array<d3plot_solid_con> D3plot::read_solid_elements() {
   return Array<d3plot_solid_con>(elements, num_elements);
 }
 
+Array<d3_word> D3plot::read_solid_extra_nodes() {
+  size_t num_solids;
+  d3_word *extra_nodes = d3plot_read_solid_extra_nodes(&m_handle, &num_solids);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return Array<d3_word>(extra_nodes, num_solids * 2);
+}
+
 Array<d3plot_thick_shell_con> D3plot::read_thick_shell_elements() {
   size_t num_elements;
   d3plot_thick_shell_con *elements =
@@ -476,6 +900,216 @@ D3plotPart D3plot::read_part_by_id(size_t part_id,
   return D3plotPart(part);
 }
 
+template <typename T> static T *clone_part_elements(const T *data, size_t n) {
+  if (n == 0) {
+    return nullptr;
+  }
+
+  T *clone = reinterpret_cast<T *>(malloc(n * sizeof(T)));
+  memcpy(clone, data, n * sizeof(T));
+  return clone;
+}
+
+std::vector<D3plotPart> D3plot::read_all_parts() {
+  d3plot_parts parts = d3plot_read_all_parts(&m_handle);
+  if (m_handle.error_string) {
+    d3plot_free_parts(&parts);
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<D3plotPart> all_parts;
+  all_parts.reserve(parts.num_parts);
+  for (size_t i = 0; i < parts.num_parts; i++) {
+    const d3plot_part view = d3plot_parts_get_part(&parts, i);
+
+    d3plot_part part = view;
+    part.solid_ids = clone_part_elements(view.solid_ids, view.num_solids);
+    part.thick_shell_ids =
+        clone_part_elements(view.thick_shell_ids, view.num_thick_shells);
+    part.beam_ids = clone_part_elements(view.beam_ids, view.num_beams);
+    part.shell_ids = clone_part_elements(view.shell_ids, view.num_shells);
+    part.solid_indices =
+        clone_part_elements(view.solid_indices, view.num_solids);
+    part.thick_shell_indices =
+        clone_part_elements(view.thick_shell_indices, view.num_thick_shells);
+    part.beam_indices = clone_part_elements(view.beam_indices, view.num_beams);
+    part.shell_indices =
+        clone_part_elements(view.shell_indices, view.num_shells);
+
+    all_parts.emplace_back(part);
+  }
+
+  d3plot_free_parts(&parts);
+  return all_parts;
+}
+
+Array<size_t> D3plot::ids_to_indices(IdType id_type,
+                                     const Array<d3_word> &ids) {
+  size_t *indices = reinterpret_cast<size_t *>(
+      malloc(ids.size() * sizeof(size_t)));
+  d3plot_ids_to_indices(&m_handle, static_cast<int>(id_type), ids.data(),
+                        ids.size(), indices);
+  if (m_handle.error_string) {
+    free(indices);
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return Array<size_t>(indices, ids.size());
+}
+
+size_t D3plot::id_to_index(IdType id_type, d3_word id) {
+  const size_t index =
+      d3plot_id_to_index(&m_handle, static_cast<int>(id_type), id);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return index;
+}
+
+size_t D3plot::find_part(const std::string &title) {
+  const size_t index = d3plot_find_part(&m_handle, title.c_str());
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return index;
+}
+
+Array<size_t> D3plot::search_parts(const std::string &pattern,
+                                   PartSearch mode, bool ignore_case) {
+  if (mode != PartSearch::Regex) {
+    int c_mode = static_cast<int>(mode);
+    if (ignore_case) {
+      c_mode |= D3PLOT_PART_SEARCH_IGNORE_CASE;
+    }
+
+    size_t num_parts;
+    size_t *indices =
+        d3plot_search_parts(&m_handle, pattern.c_str(), c_mode, &num_parts);
+    if (m_handle.error_string) {
+      throw Exception(Exception::ErrorString(m_handle.error_string, false));
+    }
+    return Array<size_t>(indices, num_parts);
+  }
+
+  const d3plot_part_titles *titles = d3plot_get_part_titles(&m_handle);
+  if (!titles) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  auto flags = std::regex::ECMAScript;
+  if (ignore_case) {
+    flags |= std::regex::icase;
+  }
+  const std::regex regex(pattern, flags);
+
+  std::vector<size_t> matches;
+  for (size_t i = 0; i < titles->num_parts; i++) {
+    if (std::regex_search(d3plot_part_titles_get(titles, i), regex)) {
+      matches.push_back(i);
+    }
+  }
+
+  size_t *indices = nullptr;
+  if (!matches.empty()) {
+    indices =
+        reinterpret_cast<size_t *>(malloc(matches.size() * sizeof(size_t)));
+    memcpy(indices, matches.data(), matches.size() * sizeof(size_t));
+  }
+  return Array<size_t>(indices, matches.size());
+}
+
+std::tuple<Array<double>, Array<size_t>>
+D3plot::reduce_elements(IdType id_type, ElementQuantity quantity, ReduceOp op,
+                        size_t first_state, size_t num_states,
+                        ShellSurface surface) {
+  if (num_states == SIZE_MAX && first_state < m_handle.num_states) {
+    num_states = m_handle.num_states - first_state;
+  }
+
+  d3plot_reduction reduction = d3plot_reduce_elements(
+      &m_handle, static_cast<int>(id_type), static_cast<int>(quantity),
+      static_cast<int>(surface), static_cast<int>(op), first_state,
+      num_states);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  return std::make_tuple(
+      Array<double>(reduction.values, reduction.num_elements),
+      Array<size_t>(reduction.states, reduction.num_elements));
+}
+
+std::vector<Array<double>>
+D3plot::resample_nodes(NodeQuantity quantity, const Array<double> &times) {
+  if (times.size() == 0) {
+    return {};
+  }
+
+  const size_t num_values = d3plot_resample_num_values(
+      &m_handle, D3PLOT_ID_TYPE_NODE, static_cast<int>(quantity));
+  double *values = reinterpret_cast<double *>(
+      malloc(times.size() * num_values * sizeof(double)));
+  if (!d3plot_resample_nodes(&m_handle, static_cast<int>(quantity),
+                             times.data(), times.size(), values)) {
+    free(values);
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<double>> resampled(times.size());
+  for (size_t t = 0; t < times.size(); t++) {
+    resampled[t] = Array<double>(&values[t * num_values], num_values, t == 0);
+  }
+  return resampled;
+}
+
+std::vector<Array<double>>
+D3plot::resample_elements(IdType id_type, ElementQuantity quantity,
+                          const Array<double> &times, ShellSurface surface) {
+  if (times.size() == 0) {
+    return {};
+  }
+
+  const size_t num_values = d3plot_resample_num_values(
+      &m_handle, static_cast<int>(id_type), static_cast<int>(quantity));
+  double *values = reinterpret_cast<double *>(
+      malloc(times.size() * num_values * sizeof(double)));
+  if (!d3plot_resample_elements(
+          &m_handle, static_cast<int>(id_type), static_cast<int>(quantity),
+          static_cast<int>(surface), times.data(), times.size(), values)) {
+    free(values);
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+
+  std::vector<Array<double>> resampled(times.size());
+  for (size_t t = 0; t < times.size(); t++) {
+    resampled[t] = Array<double>(&values[t * num_values], num_values, t == 0);
+  }
+  return resampled;
+}
+
+D3plotMesh D3plot::get_mesh() {
+  const d3plot_mesh *mesh = d3plot_get_mesh(&m_handle);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return D3plotMesh(mesh);
+}
+
+D3plotSkin D3plot::read_skin() {
+  d3plot_skin skin = d3plot_read_skin(&m_handle);
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return D3plotSkin(skin);
+}
+
+D3plotSkin D3plot::read_part_skin(const D3plotPart &part) {
+  d3plot_skin skin = d3plot_read_part_skin(&m_handle, &part.get_handle());
+  if (m_handle.error_string) {
+    throw Exception(Exception::ErrorString(m_handle.error_string, false));
+  }
+  return D3plotSkin(skin);
+}
+
 } // namespace dro
 
 std::ostream &operator<<(std::ostream &stream, const d3plot_tensor &t) {
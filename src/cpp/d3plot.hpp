@@ -25,6 +25,9 @@
 
 #pragma once
 #include "array.hpp"
+#include "d3plot_derived.hpp"
+#include "d3plot_mesh.hpp"
+#include "d3plot_skin.hpp"
 #include "d3plot_part.hpp"
 #include "d3plot_state.hpp"
 #include "filesystem_bridge.hpp"
@@ -32,10 +35,77 @@
 #include <chrono>
 #include <d3plot.h>
 #include <exception>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace dro {
 
+// The entity types of D3plot::ids_to_indices
+enum class IdType {
+  Node = D3PLOT_ID_TYPE_NODE,
+  Solid = D3PLOT_ID_TYPE_SOLID,
+  Beam = D3PLOT_ID_TYPE_BEAM,
+  Shell = D3PLOT_ID_TYPE_SHELL,
+  ThickShell = D3PLOT_ID_TYPE_THICK_SHELL,
+  Part = D3PLOT_ID_TYPE_PART
+};
+
+// The quantities of D3plot::reduce_elements
+enum class ElementQuantity {
+  VonMises = D3PLOT_DERIVED_VON_MISES,
+  Pressure = D3PLOT_DERIVED_PRESSURE,
+  MaxPrincipal = D3PLOT_DERIVED_MAX_PRINCIPAL,
+  MidPrincipal = D3PLOT_DERIVED_MID_PRINCIPAL,
+  MinPrincipal = D3PLOT_DERIVED_MIN_PRINCIPAL,
+  MaxShear = D3PLOT_DERIVED_MAX_SHEAR,
+  Triaxiality = D3PLOT_DERIVED_TRIAXIALITY,
+  PlasticStrain = D3PLOT_REDUCE_PLASTIC_STRAIN
+};
+
+// The operations of D3plot::reduce_elements
+enum class ReduceOp {
+  Max = D3PLOT_REDUCE_MAX,
+  Min = D3PLOT_REDUCE_MIN,
+  // The value with the largest magnitude including its sign
+  AbsMax = D3PLOT_REDUCE_ABS_MAX,
+  // The value of the last state
+  Last = D3PLOT_REDUCE_LAST
+};
+
+// The node quantities of D3plot::resample_nodes
+enum class NodeQuantity {
+  Coordinates = D3PLOT_RESAMPLE_NODE_COORDINATES,
+  Velocity = D3PLOT_RESAMPLE_NODE_VELOCITY,
+  Acceleration = D3PLOT_RESAMPLE_NODE_ACCELERATION,
+  Displacement = D3PLOT_RESAMPLE_NODE_DISPLACEMENT,
+  Temperature = D3PLOT_RESAMPLE_NODE_TEMPERATURE
+};
+
+// The per material quantities of D3plot::read_material_data
+enum class MaterialQuantity {
+  InternalEnergy = D3PLOT_MATERIAL_INTERNAL_ENERGY,
+  KineticEnergy = D3PLOT_MATERIAL_KINETIC_ENERGY,
+  VelocityX = D3PLOT_MATERIAL_VELOCITY_X,
+  VelocityY = D3PLOT_MATERIAL_VELOCITY_Y,
+  VelocityZ = D3PLOT_MATERIAL_VELOCITY_Z,
+  Mass = D3PLOT_MATERIAL_MASS,
+  HourglassEnergy = D3PLOT_MATERIAL_HOURGLASS_ENERGY
+};
+
+// The modes of D3plot::search_parts
+enum class PartSearch {
+  // The title needs to be equal to the pattern
+  Exact = D3PLOT_PART_SEARCH_EXACT,
+  // The title needs to start with the pattern
+  Prefix = D3PLOT_PART_SEARCH_PREFIX,
+  // '*' matches any number of characters and '?' a single character
+  Wildcard = D3PLOT_PART_SEARCH_WILDCARD,
+  // The pattern is an ECMAScript regular expression, which needs to match any
+  // part of the title
+  Regex
+};
+
 // This holds all data needed to read d3plot files
 class D3plot {
 public:
@@ -86,6 +156,10 @@ public:
   Array<d3_word> read_thick_shell_element_ids();
   // Read all ids of the solid, beam, shell and thick shell elements
   Array<d3_word> read_all_element_ids();
+  // The same as read_all_element_ids, but also returns the type (one of IdType)
+  // of every element and its index inside of the arrays of its type
+  std::tuple<Array<d3_word>, Array<uint8_t>, Array<size_t>>
+  read_all_element_ids2();
   // Read all ids of the parts
   Array<d3_word> read_part_ids();
   // Returns a vector containing all part titles as sized strings
@@ -102,6 +176,38 @@ public:
   // Read the node acceleration of all nodes of a given state (time step)
   Array<dVec3> read_node_acceleration(size_t state);
   std::vector<Array<dVec3>> read_all_node_acceleration();
+  // Reads the displacements of all nodes of a given state. They are the node
+  // coordinates minus the initial node coordinates of the geometry
+  Array<dVec3> read_node_displacement(size_t state);
+  // Reads the displacements of all nodes of all time steps
+  std::vector<Array<dVec3>> read_all_node_displacement();
+  // Reads the displacements of the nodes of node_indices for num_states
+  // states starting at first_state
+  std::vector<Array<dVec3>>
+  read_node_displacement(size_t first_state, size_t num_states,
+                         const Array<size_t> &node_indices);
+  // Reads the displacements of the nodes of node_indices relative to the mean
+  // displacement of the nodes of reference_indices
+  Array<dVec3> read_node_relative_displacement(
+      size_t state, const Array<size_t> &node_indices,
+      const Array<size_t> &reference_indices);
+  // Reads the temperatures (IT != 0) of all nodes of a given state. Every
+  // node has control_data.num_temperatures values
+  Array<double> read_node_temperature(size_t state);
+  // Reads the temperatures of all nodes for num_states states starting at
+  // first_state
+  std::vector<Array<double>> read_node_temperature(size_t first_state,
+                                                   size_t num_states);
+  // The same as above, but only the nodes of node_indices are read
+  std::vector<Array<double>>
+  read_node_temperature(size_t first_state, size_t num_states,
+                        const Array<size_t> &node_indices);
+  // Reads the node fluxes (IT == 2 or IT == 3) of all nodes of a given state
+  Array<dVec3> read_node_flux(size_t state);
+  // Reads the mass scaling of all nodes of a given state
+  Array<double> read_node_mass_scaling(size_t state);
+  // Reads the NT3D thermal variables of all solids of a given state
+  Array<double> read_solids_thermal_state(size_t state);
   // The same as read_node_coordinates but with floats instead of doubles
   Array<fVec3> read_node_coordinates_32(size_t state);
   // Reads all node coordinates of all time steps and returns it as one big
@@ -121,6 +227,22 @@ public:
   float read_time_32(size_t state);
   // Reads all time of every state (time step) in milliseconds
   Array<float> read_all_time_32();
+  // Reads the global kinetic, internal and total energy and the average
+  // velocity of a state
+  d3plot_global read_global(size_t state);
+  // Reads the global data of every state
+  Array<d3plot_global> read_all_global();
+  // Reads a per material quantity of a state. The materials are ordered as in
+  // the file: solid, beam, shell and thick shell materials followed by the
+  // rigid bodies
+  Array<double> read_material_data(size_t state, MaterialQuantity quantity);
+  // The same as read_material_data for every state
+  std::vector<Array<double>> read_all_material_data(MaterialQuantity quantity);
+  // Reads the forces and positions of all rigid walls of a state. The
+  // positions are 0 if the file only contains the forces
+  Array<d3plot_rigid_wall> read_rigid_walls(size_t state);
+  // The same as read_rigid_walls for every state
+  std::vector<Array<d3plot_rigid_wall>> read_all_rigid_walls();
   // Returns stress, strain (if NEIPH >= 6) for a given state
   Array<d3plot_solid> read_solids_state(size_t state);
   // Returns stress, strain (if ISTRN == 1) for a given state
@@ -129,13 +251,70 @@ public:
   // moment, T bending moment and Torsional resultant of all beams for a given
   // state
   Array<d3plot_beam> read_beams_state(size_t state);
+  // Reads all beams of a state into one array per value. If
+  // with_integration_points is false only the resultants and the average,
+  // minimum and maximum of the history variables are kept
+  D3plotBeams read_beams_state_arrays(size_t state,
+                                      bool with_integration_points = true);
+  // The same as above, but the beams of a previous call are reused, so that
+  // no memory is allocated
+  void read_beams_state_arrays(size_t state, D3plotBeams &beams);
   // Returns stress, strain (if ISTRN == 1) and some other variables (see docs
   // pg. 36) of all shells for a given state
   Array<D3plotShell> read_shells_state(size_t state);
+  // The same as read_solids_state but only the solids of part are read
+  Array<d3plot_solid> read_part_solids_state(size_t state,
+                                             const D3plotPart &part);
+  // The same as read_thick_shells_state but only the thick shells of part are
+  // read
+  Array<D3plotThickShell> read_part_thick_shells_state(size_t state,
+                                                       const D3plotPart &part);
+  // The same as read_beams_state but only the beams of part are read
+  Array<d3plot_beam> read_part_beams_state(size_t state,
+                                           const D3plotPart &part);
+  // The same as read_shells_state but only the shells of part are read
+  Array<D3plotShell> read_part_shells_state(size_t state,
+                                            const D3plotPart &part);
+  // Read the node coordinates of all nodes of part. The nodes are in the same
+  // order as part_node_indices. If it is nullptr they are computed using
+  // D3plotPart::get_node_indices
+  Array<dVec3>
+  read_part_node_coordinates(size_t state, const D3plotPart &part,
+                             const Array<d3_word> *part_node_indices = nullptr);
+  // The same as read_part_node_coordinates for the node velocity
+  Array<dVec3>
+  read_part_node_velocity(size_t state, const D3plotPart &part,
+                          const Array<d3_word> *part_node_indices = nullptr);
+  // The same as read_part_node_coordinates for the node acceleration
+  Array<dVec3> read_part_node_acceleration(
+      size_t state, const D3plotPart &part,
+      const Array<d3_word> *part_node_indices = nullptr);
+  // Returns a bitset of all nodes, in which the bits of deleted nodes are set.
+  // Only present if MDLOPT is 1
+  Array<uint8_t> read_deleted_nodes(size_t state);
+  // Returns a bitset of all elements of a type, in which the bits of deleted
+  // elements are set. Only present if MDLOPT is 2
+  Array<uint8_t> read_deleted_elements(size_t state, IdType id_type);
+  // The same as read_solids_state but deleted solids are skipped. Also
+  // returns the indices of the returned solids
+  std::tuple<Array<d3plot_solid>, Array<size_t>>
+  read_alive_solids_state(size_t state);
+  // The same as read_alive_solids_state for thick shells
+  std::tuple<Array<D3plotThickShell>, Array<size_t>>
+  read_alive_thick_shells_state(size_t state);
+  // The same as read_alive_solids_state for beams
+  std::tuple<Array<d3plot_beam>, Array<size_t>>
+  read_alive_beams_state(size_t state);
+  // The same as read_alive_solids_state for shells
+  std::tuple<Array<D3plotShell>, Array<size_t>>
+  read_alive_shells_state(size_t state);
 
   // Returns the node connectivity + material number of all 8 node solid
   // elements
   Array<d3plot_solid_con> read_solid_elements();
+  // Returns the two extra nodes of every ten node tetrahedron (NEL8 < 0). The
+  // nodes of solid i are located at i*2 and i*2+1
+  Array<d3_word> read_solid_extra_nodes();
   // Returns the node connectivity + material number of all 8 node thick shell
   // elements
   Array<d3plot_thick_shell_con> read_thick_shell_elements();
@@ -159,6 +338,53 @@ public:
   // multiple times, it is best to preload the part ids.
   D3plotPart read_part_by_id(size_t part_id,
                              const Array<d3_word> &part_ids = Array<d3_word>());
+  // Returns all parts at once. This is a lot faster than calling read_part for
+  // every part, since all elements are only read once. The index into the
+  // returned vector is the same as the part_index of read_part.
+  std::vector<D3plotPart> read_all_parts();
+  // Translates ids of the given type into indices. Ids that do not exist are
+  // translated to SIZE_MAX. The ids are only read and indexed on the first
+  // call for each type
+  Array<size_t> ids_to_indices(IdType id_type, const Array<d3_word> &ids);
+  // The same as ids_to_indices for a single id
+  size_t id_to_index(IdType id_type, d3_word id);
+  // Returns the index of the first part whose title (without trailing spaces)
+  // equals title or SIZE_MAX if there is none. The part ids and titles are
+  // only read on the first call of find_part or search_parts
+  size_t find_part(const std::string &title);
+  // Returns the indices of all parts whose title matches pattern in ascending
+  // order
+  Array<size_t> search_parts(const std::string &pattern,
+                             PartSearch mode = PartSearch::Exact,
+                             bool ignore_case = false);
+  // Reduces a quantity of all elements of a type (Solid, ThickShell or Shell)
+  // over num_states states starting at first_state, of which only one is held
+  // in memory at a time. Returns the reduced values and the states in which
+  // they occurred. surface is ignored for solids
+  std::tuple<Array<double>, Array<size_t>>
+  reduce_elements(IdType id_type, ElementQuantity quantity, ReduceOp op,
+                  size_t first_state = 0, size_t num_states = SIZE_MAX,
+                  ShellSurface surface = ShellSurface::Mid);
+  // Linearly interpolates a quantity of all nodes at every time of times.
+  // Every state is only read once as long as times is sorted. Returns one
+  // array for every time
+  std::vector<Array<double>> resample_nodes(NodeQuantity quantity,
+                                            const Array<double> &times);
+  // The same as resample_nodes for a quantity of all elements of id_type
+  // (Solid, ThickShell or Shell)
+  std::vector<Array<double>>
+  resample_elements(IdType id_type, ElementQuantity quantity,
+                    const Array<double> &times,
+                    ShellSurface surface = ShellSurface::Mid);
+  // Returns the mesh of all elements. It is built on the first call and is
+  // only valid as long as this D3plot exists
+  D3plotMesh get_mesh();
+  // Returns the skin (all faces which are not shared by two elements) of all
+  // solid and thick shell elements
+  D3plotSkin read_skin();
+  // The same as read_skin but only the solids and thick shells of part are
+  // used
+  D3plotSkin read_part_skin(const D3plotPart &part);
 
   // Returns the number of states (time steps)
   inline size_t num_time_steps() const { return m_handle.num_states; }
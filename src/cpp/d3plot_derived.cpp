@@ -0,0 +1,110 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot_derived.hpp"
+#include <d3plot.h>
+
+namespace dro {
+
+// Computes quantity of num tensors, of which the first one is located at
+// tensors and all others stride bytes after the previous one
+static Array<double> compute_derived_strided(const d3plot_tensor *tensors,
+                                             size_t stride, size_t num,
+                                             DerivedQuantity quantity) {
+  double *values = reinterpret_cast<double *>(malloc(num * sizeof(double)));
+
+  double *outputs[D3PLOT_DERIVED_COUNT] = {nullptr};
+  outputs[static_cast<int>(quantity)] = values;
+  d3plot_compute_derived(tensors, stride, num, outputs);
+
+  return Array<double>(values, num);
+}
+
+template <typename T>
+static const d3plot_surface &get_surface(const T &shell,
+                                         ShellSurface surface) noexcept {
+  switch (surface) {
+  case ShellSurface::Inner:
+    return shell.inner;
+  case ShellSurface::Outer:
+    return shell.outer;
+  default:
+    return shell.mid;
+  }
+}
+
+Array<double> compute_derived(const D3plotSurfaces &surfaces,
+                              DerivedQuantity quantity) {
+  const size_t num = surfaces.size();
+  double *values = reinterpret_cast<double *>(malloc(num * sizeof(double)));
+
+  double *outputs[D3PLOT_DERIVED_COUNT] = {nullptr};
+  outputs[static_cast<int>(quantity)] = values;
+  d3plot_compute_derived_soa(surfaces.get_handle().stress, num, outputs);
+
+  return Array<double>(values, num);
+}
+
+double compute_derived(const d3plot_tensor &tensor,
+                       DerivedQuantity quantity) noexcept {
+  return d3plot_tensor_derived(&tensor, static_cast<int>(quantity));
+}
+
+Array<double> compute_derived(const Array<d3plot_solid> &solids,
+                              DerivedQuantity quantity) {
+  if (solids.empty()) {
+    return Array<double>();
+  }
+  return compute_derived_strided(&solids[0].stress, sizeof(d3plot_solid),
+                                 solids.size(), quantity);
+}
+
+Array<double> compute_derived(const Array<D3plotThickShell> &thick_shells,
+                              DerivedQuantity quantity, ShellSurface surface) {
+  if (thick_shells.empty()) {
+    return Array<double>();
+  }
+  if (surface == ShellSurface::Mean || surface == ShellSurface::AbsMax) {
+    return compute_derived(get_thick_shells_layer(thick_shells, surface),
+                           quantity);
+  }
+  return compute_derived_strided(
+      &get_surface(thick_shells[0], surface).stress, sizeof(D3plotThickShell),
+      thick_shells.size(), quantity);
+}
+
+Array<double> compute_derived(const Array<D3plotShell> &shells,
+                              DerivedQuantity quantity, ShellSurface surface) {
+  if (shells.empty()) {
+    return Array<double>();
+  }
+  if (surface == ShellSurface::Mean || surface == ShellSurface::AbsMax) {
+    return compute_derived(get_shells_layer(shells, surface), quantity);
+  }
+  return compute_derived_strided(&get_surface(shells[0], surface).stress,
+                                 sizeof(D3plotShell), shells.size(), quantity);
+}
+
+} // namespace dro
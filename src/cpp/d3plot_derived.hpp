@@ -0,0 +1,64 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#pragma once
+#include "array.hpp"
+#include "d3plot_state.hpp"
+#include <d3_defines.h>
+
+namespace dro {
+
+// The quantities which can be computed out of a stress (or strain) tensor
+enum class DerivedQuantity {
+  VonMises = D3PLOT_DERIVED_VON_MISES,
+  Pressure = D3PLOT_DERIVED_PRESSURE,
+  MaxPrincipal = D3PLOT_DERIVED_MAX_PRINCIPAL,
+  MidPrincipal = D3PLOT_DERIVED_MID_PRINCIPAL,
+  MinPrincipal = D3PLOT_DERIVED_MIN_PRINCIPAL,
+  MaxShear = D3PLOT_DERIVED_MAX_SHEAR,
+  Triaxiality = D3PLOT_DERIVED_TRIAXIALITY
+};
+
+// Computes a derived quantity of a single tensor
+double compute_derived(const d3plot_tensor &tensor,
+                       DerivedQuantity quantity) noexcept;
+// Computes a derived quantity of the stresses of surfaces
+Array<double> compute_derived(const D3plotSurfaces &surfaces,
+                              DerivedQuantity quantity);
+// Computes a derived quantity of the stresses of solids
+Array<double> compute_derived(const Array<d3plot_solid> &solids,
+                              DerivedQuantity quantity);
+// Computes a derived quantity of the stresses of one surface (or an aggregate
+// of all integration points) of thick shells
+Array<double> compute_derived(const Array<D3plotThickShell> &thick_shells,
+                              DerivedQuantity quantity,
+                              ShellSurface surface = ShellSurface::Mid);
+// Computes a derived quantity of the stresses of one surface (or an aggregate
+// of all integration points) of shells
+Array<double> compute_derived(const Array<D3plotShell> &shells,
+                              DerivedQuantity quantity,
+                              ShellSurface surface = ShellSurface::Mid);
+
+} // namespace dro
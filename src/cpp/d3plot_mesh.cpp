@@ -0,0 +1,63 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot_mesh.hpp"
+#include <d3plot.h>
+
+namespace dro {
+
+D3plotMesh::D3plotMesh(const d3plot_mesh *mesh) noexcept : m_mesh(mesh) {}
+
+Array<uint32_t> D3plotMesh::get_element_nodes(size_t element_index) const {
+  size_t num_nodes;
+  const uint32_t *nodes =
+      d3plot_mesh_get_element_nodes(m_mesh, element_index, &num_nodes);
+  return Array<uint32_t>(const_cast<uint32_t *>(nodes), num_nodes, false);
+}
+
+Array<uint32_t> D3plotMesh::get_node_elements(size_t node_index) const {
+  size_t num_elements;
+  const uint32_t *elements =
+      d3plot_mesh_get_node_elements(m_mesh, node_index, &num_elements);
+  return Array<uint32_t>(const_cast<uint32_t *>(elements), num_elements,
+                         false);
+}
+
+Array<uint32_t> D3plotMesh::get_part_elements(size_t part_index) const {
+  size_t num_elements;
+  const uint32_t *elements =
+      d3plot_mesh_get_part_elements(m_mesh, part_index, &num_elements);
+  return Array<uint32_t>(const_cast<uint32_t *>(elements), num_elements,
+                         false);
+}
+
+Array<uint32_t> D3plotMesh::get_part_nodes(size_t part_index) const {
+  size_t num_nodes;
+  const uint32_t *nodes =
+      d3plot_mesh_get_part_nodes(m_mesh, part_index, &num_nodes);
+  return Array<uint32_t>(const_cast<uint32_t *>(nodes), num_nodes, false);
+}
+
+} // namespace dro
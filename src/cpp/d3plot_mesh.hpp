@@ -0,0 +1,60 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#pragma once
+#include "array.hpp"
+#include <d3_defines.h>
+
+namespace dro {
+
+// A read only view of the mesh of a D3plot. It is owned by the D3plot and is
+// only valid as long as the D3plot exists. The returned arrays point into the
+// mesh and do not need to be deallocated
+class D3plotMesh {
+public:
+  D3plotMesh(const d3plot_mesh *mesh) noexcept;
+
+  inline size_t num_nodes() const noexcept { return m_mesh->num_nodes; }
+  inline size_t num_elements() const noexcept { return m_mesh->num_elements; }
+  inline size_t num_parts() const noexcept { return m_mesh->num_parts; }
+
+  // Returns the node indices of an element in the order of its connectivity.
+  // The elements are numbered in the order solids, beams, shells and thick
+  // shells
+  Array<uint32_t> get_element_nodes(size_t element_index) const;
+  // Returns the indices of all elements which contain a node
+  Array<uint32_t> get_node_elements(size_t node_index) const;
+  // Returns the indices of all elements of a part
+  Array<uint32_t> get_part_elements(size_t part_index) const;
+  // Returns the indices of all nodes of a part
+  Array<uint32_t> get_part_nodes(size_t part_index) const;
+
+  inline const d3plot_mesh &get_handle() const noexcept { return *m_mesh; }
+
+private:
+  const d3plot_mesh *m_mesh;
+};
+
+} // namespace dro
@@ -105,6 +105,8 @@ public:
   // Returns an array containing all element ids
   Array<d3_word> get_all_element_ids() const;
 
+  inline const d3plot_part &get_handle() const noexcept { return m_part; }
+
 private:
   d3plot_part m_part;
 };
@@ -0,0 +1,52 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#pragma once
+#include "array.hpp"
+#include <d3_defines.h>
+
+namespace dro {
+
+// The outer surface (skin) of solid and thick shell elements. See d3plot_skin
+struct D3plotSkin {
+  // Takes ownership over the memory of skin
+  D3plotSkin(d3plot_skin &skin) noexcept
+      : node_indices(skin.node_indices, skin.num_nodes),
+        faces(skin.faces, skin.num_faces * 4),
+        face_elements(skin.face_elements, skin.num_faces),
+        face_element_types(skin.face_element_types, skin.num_faces) {}
+
+  // Indices of all nodes used by the faces, sorted ascending
+  Array<size_t> node_indices;
+  // 4 indices into node_indices for every face with outward normals.
+  // Triangles repeat their last node
+  Array<size_t> faces;
+  // The index of the element of every face inside of the arrays of its type
+  Array<size_t> face_elements;
+  // D3PLOT_ID_TYPE_SOLID or D3PLOT_ID_TYPE_THICK_SHELL for every face
+  Array<uint8_t> face_element_types;
+};
+
+} // namespace dro
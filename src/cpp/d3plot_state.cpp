@@ -127,4 +127,181 @@ template <> Array<D3plotBeam>::~Array<D3plotBeam>() noexcept {
   }
 }
 
+D3plotSurfaces::D3plotSurfaces(size_t num_surfaces,
+                               size_t num_history_variables)
+    : m_handle(d3plot_alloc_surfaces(num_surfaces, num_history_variables)) {}
+
+D3plotSurfaces::D3plotSurfaces(D3plotSurfaces &&rhs) noexcept
+    : m_handle(rhs.m_handle) {
+  memset(&rhs.m_handle, 0, sizeof(d3plot_surfaces));
+}
+
+D3plotSurfaces::~D3plotSurfaces() noexcept { d3plot_free_surfaces(&m_handle); }
+
+Array<double> D3plotSurfaces::get_stress(size_t component) const {
+  if (component >= 6) {
+    std::stringstream stream;
+    stream << component << " is an invalid stress component (" << component
+           << " >= 6)";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+
+  return Array<double>(m_handle.stress[component], m_handle.num_surfaces,
+                       false);
+}
+
+Array<double> D3plotSurfaces::get_effective_plastic_strain() const noexcept {
+  return Array<double>(m_handle.effective_plastic_strain,
+                       m_handle.num_surfaces, false);
+}
+
+Array<double>
+D3plotSurfaces::get_history_variables(size_t history_index) const {
+  if (history_index >= m_handle.num_history_variables) {
+    std::stringstream stream;
+    stream << history_index << " is an invalid index for history variables ("
+           << history_index << " >= " << m_handle.num_history_variables
+           << ")";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+
+  return Array<double>(
+      &m_handle.history_variables[history_index * m_handle.num_surfaces],
+      m_handle.num_surfaces, false);
+}
+
+D3plotBeams::D3plotBeams(size_t num_beams, size_t num_integration_points,
+                         size_t num_history_variables,
+                         bool with_integration_points)
+    : m_handle(d3plot_alloc_beams(num_beams, num_integration_points,
+                                  num_history_variables,
+                                  with_integration_points)) {}
+
+D3plotBeams::D3plotBeams(D3plotBeams &&rhs) noexcept
+    : m_handle(rhs.m_handle) {
+  memset(&rhs.m_handle, 0, sizeof(d3plot_beams));
+}
+
+D3plotBeams::~D3plotBeams() noexcept { d3plot_free_beams(&m_handle); }
+
+Array<double> D3plotBeams::get_resultant(size_t component) const {
+  if (component >= 6) {
+    std::stringstream stream;
+    stream << component << " is an invalid resultant component (" << component
+           << " >= 6)";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+
+  return Array<double>(m_handle.resultants[component], m_handle.num_beams,
+                       false);
+}
+
+Array<double> D3plotBeams::get_ip_value(size_t integration_point,
+                                        size_t value) const {
+  check_integration_point(integration_point);
+  if (value >= 5) {
+    std::stringstream stream;
+    stream << value << " is an invalid integration point value (" << value
+           << " >= 5)";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+
+  return Array<double>(
+      &m_handle.ip_values[value][integration_point * m_handle.num_beams],
+      m_handle.num_beams, false);
+}
+
+Array<double>
+D3plotBeams::get_ip_history_variables(size_t integration_point,
+                                      size_t history_index) const {
+  check_integration_point(integration_point);
+  check_history_index(history_index);
+
+  return Array<double>(
+      &m_handle.ip_history_variables[(integration_point *
+                                          m_handle.num_history_variables +
+                                      history_index) *
+                                     m_handle.num_beams],
+      m_handle.num_beams, false);
+}
+
+Array<double> D3plotBeams::get_history_average(size_t history_index) const {
+  check_history_index(history_index);
+  return Array<double>(
+      &m_handle.history_average[history_index * m_handle.num_beams],
+      m_handle.num_beams, false);
+}
+
+Array<double> D3plotBeams::get_history_min(size_t history_index) const {
+  check_history_index(history_index);
+  return Array<double>(
+      &m_handle.history_min[history_index * m_handle.num_beams],
+      m_handle.num_beams, false);
+}
+
+Array<double> D3plotBeams::get_history_max(size_t history_index) const {
+  check_history_index(history_index);
+  return Array<double>(
+      &m_handle.history_max[history_index * m_handle.num_beams],
+      m_handle.num_beams, false);
+}
+
+void D3plotBeams::check_integration_point(size_t integration_point) const {
+  if (!m_handle.ip_values[0]) {
+    throw D3plot::Exception(D3plot::Exception::ErrorString(
+        strdup("The integration points of the beams have not been kept")));
+  }
+  if (integration_point >= m_handle.num_integration_points) {
+    std::stringstream stream;
+    stream << integration_point << " is an invalid integration point ("
+           << integration_point << " >= " << m_handle.num_integration_points
+           << ")";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+}
+
+void D3plotBeams::check_history_index(size_t history_index) const {
+  if (history_index >= m_handle.num_history_variables) {
+    std::stringstream stream;
+    stream << history_index << " is an invalid index for history variables ("
+           << history_index << " >= " << m_handle.num_history_variables
+           << ")";
+    const auto str(stream.str());
+    throw D3plot::Exception(
+        D3plot::Exception::ErrorString(strdup(str.c_str())));
+  }
+}
+
+D3plotSurfaces get_shells_layer(const Array<D3plotShell> &shells,
+                                ShellSurface layer) {
+  D3plotSurfaces surfaces(shells.size(),
+                          shells.empty() ? 0 : shells[0].num_history_variables);
+  d3plot_get_shells_layer(shells.data(), shells.size(),
+                          static_cast<int>(layer), &surfaces.get_handle());
+  return surfaces;
+}
+
+D3plotSurfaces
+get_thick_shells_layer(const Array<D3plotThickShell> &thick_shells,
+                       ShellSurface layer) {
+  D3plotSurfaces surfaces(thick_shells.size(),
+                          thick_shells.empty()
+                              ? 0
+                              : thick_shells[0].num_history_variables);
+  d3plot_get_thick_shells_layer(thick_shells.data(), thick_shells.size(),
+                                static_cast<int>(layer),
+                                &surfaces.get_handle());
+  return surfaces;
+}
+
 } // namespace dro
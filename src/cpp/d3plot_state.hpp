@@ -30,6 +30,17 @@
 
 namespace dro {
 
+// The integration points through the thickness of shells and thick shells
+enum class ShellSurface {
+  Mid = D3PLOT_SHELL_SURFACE_MID,
+  Inner = D3PLOT_SHELL_SURFACE_INNER,
+  Outer = D3PLOT_SHELL_SURFACE_OUTER,
+  // The mean of all integration points
+  Mean = D3PLOT_SHELL_SURFACE_MEAN,
+  // Every value of the integration point with the largest von Mises stress
+  AbsMax = D3PLOT_SHELL_SURFACE_ABS_MAX
+};
+
 class D3plotSurface : public d3plot_surface {
 public:
   virtual ~D3plotSurface() noexcept;
@@ -102,4 +113,78 @@ public:
 
 template <> Array<D3plotBeam>::~Array<D3plotBeam>() noexcept;
 
+// The stresses, effective plastic strains and history variables of many
+// surfaces stored as one array per value. The returned arrays point into the
+// surfaces and do not need to be deallocated
+class D3plotSurfaces {
+public:
+  D3plotSurfaces(size_t num_surfaces, size_t num_history_variables);
+  D3plotSurfaces(D3plotSurfaces &&rhs) noexcept;
+  D3plotSurfaces(const D3plotSurfaces &rhs) = delete;
+  ~D3plotSurfaces() noexcept;
+
+  inline size_t size() const noexcept { return m_handle.num_surfaces; }
+  // Returns one component of the stresses. 0: x, 1: y, 2: z, 3: xy, 4: yz and
+  // 5: zx
+  Array<double> get_stress(size_t component) const;
+  Array<double> get_effective_plastic_strain() const noexcept;
+  // Returns the history variable with history_index of all surfaces
+  Array<double> get_history_variables(size_t history_index) const;
+
+  inline d3plot_surfaces &get_handle() noexcept { return m_handle; }
+  inline const d3plot_surfaces &get_handle() const noexcept {
+    return m_handle;
+  }
+
+private:
+  d3plot_surfaces m_handle;
+};
+
+// The resultants, integration points and history variables of many beams
+// stored as one array per value
+class D3plotBeams {
+public:
+  D3plotBeams(size_t num_beams, size_t num_integration_points,
+              size_t num_history_variables, bool with_integration_points);
+  D3plotBeams(D3plotBeams &&rhs) noexcept;
+  D3plotBeams(const D3plotBeams &rhs) = delete;
+  ~D3plotBeams() noexcept;
+
+  inline size_t size() const noexcept { return m_handle.num_beams; }
+  // Returns one resultant. 0: axial force, 1: s shear resultant, 2: t shear
+  // resultant, 3: s bending moment, 4: t bending moment and 5: torsional
+  // resultant
+  Array<double> get_resultant(size_t component) const;
+  // Returns one value of an integration point. 0: rs shear stress, 1: tr shear
+  // stress, 2: axial stress, 3: plastic strain and 4: axial strain
+  Array<double> get_ip_value(size_t integration_point, size_t value) const;
+  // Returns the history variable with history_index of an integration point
+  Array<double> get_ip_history_variables(size_t integration_point,
+                                         size_t history_index) const;
+  // Returns the average, minimum or maximum over all integration points of
+  // the history variable with history_index
+  Array<double> get_history_average(size_t history_index) const;
+  Array<double> get_history_min(size_t history_index) const;
+  Array<double> get_history_max(size_t history_index) const;
+
+  inline d3plot_beams &get_handle() noexcept { return m_handle; }
+  inline const d3plot_beams &get_handle() const noexcept { return m_handle; }
+
+private:
+  void check_integration_point(size_t integration_point) const;
+  void check_history_index(size_t history_index) const;
+
+  d3plot_beams m_handle;
+};
+
+// Returns one layer (or an aggregate of all integration points) of all shells
+// at once
+D3plotSurfaces get_shells_layer(const Array<D3plotShell> &shells,
+                                ShellSurface layer);
+// Returns one layer (or an aggregate of all integration points) of all thick
+// shells at once
+D3plotSurfaces
+get_thick_shells_layer(const Array<D3plotThickShell> &thick_shells,
+                       ShellSurface layer);
+
 } // namespace dro
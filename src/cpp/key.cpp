@@ -185,24 +185,29 @@ Keyword KeywordSlice::operator[](size_t index) {
 }
 
 Keywords::Keywords(keyword_t *data, size_t size) noexcept
-    : Array<keyword_t>(data, size, false) {}
+    : Array<keyword_t>(data, size, false), m_index(key_index_new(data, size)) {
+}
 
 Keywords::Keywords(Keywords &&rhs) noexcept {
   m_data = rhs.m_data;
   m_size = rhs.m_size;
   m_delete_data = rhs.m_delete_data;
+  m_index = rhs.m_index;
 
   rhs.m_data = nullptr;
   rhs.m_size = 0;
   rhs.m_delete_data = false;
+  rhs.m_index = key_index_new(nullptr, 0);
 }
 
-Keywords::~Keywords() noexcept { key_file_free(m_data, m_size); }
+Keywords::~Keywords() noexcept {
+  key_index_free(&m_index);
+  key_file_free(m_data, m_size);
+}
 
 KeywordSlice Keywords::operator[](const std::string &name) {
   size_t slice_size;
-  keyword_t *slice =
-      key_file_get_slice(m_data, m_size, name.c_str(), &slice_size);
+  keyword_t *slice = key_index_get_slice(&m_index, name.c_str(), &slice_size);
   if (!slice) {
     THROW_KEY_FILE_EXCEPTION("The keyword \"%s\" could not be found",
                              name.c_str());
@@ -211,6 +216,23 @@ KeywordSlice Keywords::operator[](const std::string &name) {
   return KeywordSlice(slice, slice_size);
 }
 
+KeywordSlice Keywords::prefix(const std::string &prefix) {
+  size_t slice_size;
+  keyword_t *slice =
+      key_index_get_prefix(&m_index, prefix.c_str(), &slice_size);
+  if (!slice) {
+    THROW_KEY_FILE_EXCEPTION("No keyword starting with \"%s\" could be found",
+                             prefix.c_str());
+  }
+
+  return KeywordSlice(slice, slice_size);
+}
+
+bool Keywords::contains(const std::string &name) const noexcept {
+  size_t slice_size;
+  return key_index_get_slice(&m_index, name.c_str(), &slice_size) != nullptr;
+}
+
 KeyFile::Exception::Exception(
     KeyFile::Exception::ErrorString error_str) noexcept
     : m_error_str(std::move(error_str)) {}
@@ -219,23 +241,58 @@ const char *KeyFile::Exception::what() const noexcept {
   return m_error_str.data();
 }
 
+static char **clone_string_array(char **strings, size_t num_strings) {
+  if (num_strings == 0) {
+    return NULL;
+  }
+
+  char **clone =
+      reinterpret_cast<char **>(malloc(num_strings * sizeof(char *)));
+  for (size_t i = 0; i < num_strings; i++) {
+    clone[i] = strdup(strings[i]);
+  }
+  return clone;
+}
+
+template <typename T>
+static char **new_string_array(const std::vector<T> &strings) {
+  if (strings.empty()) {
+    return NULL;
+  }
+
+  char **array =
+      reinterpret_cast<char **>(malloc(strings.size() * sizeof(char *)));
+  for (size_t i = 0; i < strings.size(); i++) {
+    if constexpr (std::is_same_v<T, fs::path>) {
+      const auto str(strings[i].string());
+      array[i] = strdup(str.c_str());
+    } else {
+      array[i] = strdup(strings[i].c_str());
+    }
+  }
+  return array;
+}
+
+static void free_string_array(char **strings, size_t num_strings) {
+  for (size_t i = 0; i < num_strings; i++) {
+    free(strings[i]);
+  }
+  free(strings);
+}
+
 KeyFile::ParseConfig::ParseConfig(
     bool parse_includes, bool ignore_not_found_includes,
-    std::vector<fs::path> extra_include_paths) noexcept {
+    std::vector<fs::path> extra_include_paths,
+    std::vector<std::string> include_keywords,
+    std::vector<std::string> exclude_keywords) noexcept {
   m_handle.parse_includes = parse_includes;
   m_handle.ignore_not_found_includes = ignore_not_found_includes;
-  if (!extra_include_paths.empty()) {
-    m_handle.num_extra_include_paths = extra_include_paths.size();
-    m_handle.extra_include_paths = reinterpret_cast<char **>(
-        malloc(m_handle.num_extra_include_paths * sizeof(char *)));
-    for (size_t i = 0; i < extra_include_paths.size(); i++) {
-      const auto str(extra_include_paths[i].string());
-      m_handle.extra_include_paths[i] = strdup(str.c_str());
-    }
-  } else {
-    m_handle.extra_include_paths = NULL;
-    m_handle.num_extra_include_paths = 0;
-  }
+  m_handle.extra_include_paths = new_string_array(extra_include_paths);
+  m_handle.num_extra_include_paths = extra_include_paths.size();
+  m_handle.include_keywords = new_string_array(include_keywords);
+  m_handle.num_include_keywords = include_keywords.size();
+  m_handle.exclude_keywords = new_string_array(exclude_keywords);
+  m_handle.num_exclude_keywords = exclude_keywords.size();
 }
 
 KeyFile::ParseConfig::ParseConfig(ParseConfig &&rhs) noexcept {
@@ -245,18 +302,19 @@ KeyFile::ParseConfig::ParseConfig(ParseConfig &&rhs) noexcept {
 
 KeyFile::ParseConfig::ParseConfig(const ParseConfig &rhs) noexcept {
   m_handle = rhs.m_handle;
-  if (m_handle.num_extra_include_paths != 0) {
-    m_handle.extra_include_paths = reinterpret_cast<char **>(
-        malloc(m_handle.num_extra_include_paths * sizeof(char *)));
-    for (size_t i = 0; i < m_handle.num_extra_include_paths; i++) {
-      m_handle.extra_include_paths[i] =
-          strdup(rhs.m_handle.extra_include_paths[i]);
-    }
-  }
+  m_handle.extra_include_paths = clone_string_array(
+      rhs.m_handle.extra_include_paths, rhs.m_handle.num_extra_include_paths);
+  m_handle.include_keywords = clone_string_array(
+      rhs.m_handle.include_keywords, rhs.m_handle.num_include_keywords);
+  m_handle.exclude_keywords = clone_string_array(
+      rhs.m_handle.exclude_keywords, rhs.m_handle.num_exclude_keywords);
 }
 
 KeyFile::ParseConfig::~ParseConfig() noexcept {
-  free(m_handle.extra_include_paths);
+  free_string_array(m_handle.extra_include_paths,
+                    m_handle.num_extra_include_paths);
+  free_string_array(m_handle.include_keywords, m_handle.num_include_keywords);
+  free_string_array(m_handle.exclude_keywords, m_handle.num_exclude_keywords);
 }
 
 KeyFile::ParseInfo::ParseInfo(key_parse_info_t *handle) noexcept
@@ -327,4 +385,39 @@ void KeyFile::parse_with_callback(const fs::path &file_name,
   }
 }
 
+IncrementalKeyFile::IncrementalKeyFile() noexcept
+    : m_handle(key_incremental_new()) {}
+
+IncrementalKeyFile::IncrementalKeyFile(IncrementalKeyFile &&rhs) noexcept
+    : m_handle(rhs.m_handle) {
+  rhs.m_handle = key_incremental_new();
+}
+
+IncrementalKeyFile::~IncrementalKeyFile() noexcept {
+  key_incremental_free(&m_handle);
+}
+
+Keywords IncrementalKeyFile::parse(const fs::path &file_name,
+                                   KeyFile::ParseConfig parse_config,
+                                   std::optional<dro::String> *warnings) {
+  size_t num_keywords;
+  char *error_string, *warning_string;
+
+  keyword_t *keywords = key_incremental_parse(
+      &m_handle, file_name.string().c_str(), &num_keywords,
+      parse_config.get_handle(), &error_string, &warning_string);
+  if (warning_string) {
+    if (warnings == nullptr) {
+      free(warning_string);
+    } else {
+      *warnings = dro::String(warning_string);
+    }
+  }
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+
+  return Keywords(keywords, num_keywords);
+}
+
 } // namespace dro
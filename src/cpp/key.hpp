@@ -33,6 +33,8 @@
 #include <exception>
 #include <functional>
 #include <key.h>
+#include <key_incremental.h>
+#include <key_index.h>
 #include <limits>
 #include <optional>
 #include <string>
@@ -150,6 +152,7 @@ class Keyword {
 public:
   friend class IncludeTransform;
   friend class DefineTransformation;
+  friend class KeyNodes;
 
   // An iterator to iterate over all cards of the keyword
   class CardsIterator {
@@ -206,6 +209,9 @@ private:
 // contains only keyword with the same name.
 class KeywordSlice {
 public:
+  friend class KeyNodes;
+  friend class KeyElements;
+
   // An iterator to iterate over all keywords of the slice
   class Iterator {
   public:
@@ -270,6 +276,14 @@ public:
 
   // Return a slice of keywords with the same name
   KeywordSlice operator[](const std::string &name);
+  // Return a slice of all keywords whose name starts with prefix (e.g. "MAT_")
+  KeywordSlice prefix(const std::string &prefix);
+  // Returns wether at least one keyword with name exists
+  bool contains(const std::string &name) const noexcept;
+
+private:
+  // Built once on construction so that lookups by name take constant time
+  key_index_t m_index;
 };
 
 // This static class holds the functions for parsing LS Dyna key files
@@ -309,9 +323,15 @@ public:
     // when not finding an include file.
     // extra_include_paths ... Define some additional include paths which are
     // used to look for files under the INCLUDE keyword and such.
+    // include_keywords ... Glob patterns ('*' and '?') of the keywords which
+    // should be parsed. If empty all keywords are parsed.
+    // exclude_keywords ... Glob patterns of the keywords which should be
+    // skipped.
     ParseConfig(bool parse_includes = true,
                 bool ignore_not_found_includes = false,
-                std::vector<fs::path> extra_include_paths = {}) noexcept;
+                std::vector<fs::path> extra_include_paths = {},
+                std::vector<std::string> include_keywords = {},
+                std::vector<std::string> exclude_keywords = {}) noexcept;
     ParseConfig(ParseConfig &&rhs) noexcept;
     ParseConfig(const ParseConfig &rhs) noexcept;
     ~ParseConfig() noexcept;
@@ -362,6 +382,34 @@ public:
                       std::optional<dro::String> *warnings = nullptr);
 };
 
+// Parses a key file and keeps the cards of all files in memory, so that
+// parsing the same file again only reads the include files which have been
+// modified since the last call
+class IncrementalKeyFile {
+public:
+  IncrementalKeyFile() noexcept;
+  IncrementalKeyFile(IncrementalKeyFile &&rhs) noexcept;
+  ~IncrementalKeyFile() noexcept;
+
+  // Same as KeyFile::parse. The same parse_config should be used for every
+  // call
+  Keywords parse(const fs::path &file_name,
+                 KeyFile::ParseConfig parse_config = KeyFile::ParseConfig(),
+                 std::optional<dro::String> *warnings = nullptr);
+
+  // The number of files which have been read from disk by the last call
+  inline size_t num_parsed_files() const noexcept {
+    return m_handle.num_parsed_files;
+  }
+  // The number of files which have been reused by the last call
+  inline size_t num_reused_files() const noexcept {
+    return m_handle.num_reused_files;
+  }
+
+private:
+  key_incremental_t m_handle;
+};
+
 template <typename T> constexpr bool is_string_v = false;
 template <typename T>
 static constexpr bool is_number_v =
@@ -0,0 +1,106 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "key_mesh.hpp"
+
+namespace dro {
+
+KeyNodes::KeyNodes(KeywordSlice &slice) {
+  char *error_string;
+  m_handle = key_parse_nodes(slice.m_ptr, slice.m_size, &error_string);
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+}
+
+KeyNodes::KeyNodes(Keyword &kw) {
+  char *error_string;
+  m_handle = key_parse_nodes(kw.m_handle, 1, &error_string);
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+}
+
+KeyNodes::KeyNodes(KeyNodes &&rhs) noexcept {
+  m_handle = rhs.m_handle;
+  rhs.m_handle = {0};
+}
+
+KeyNodes::~KeyNodes() noexcept { key_free_nodes(&m_handle); }
+
+KeyNodes &KeyNodes::operator=(KeyNodes &&rhs) noexcept {
+  key_free_nodes(&m_handle);
+  m_handle = rhs.m_handle;
+  rhs.m_handle = {0};
+  return *this;
+}
+
+KeyElements KeyElements::parse_solid(KeywordSlice &slice) {
+  char *error_string;
+  auto handle =
+      key_parse_element_solid(slice.m_ptr, slice.m_size, &error_string);
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+  return KeyElements(handle);
+}
+
+KeyElements KeyElements::parse_shell(KeywordSlice &slice) {
+  char *error_string;
+  auto handle =
+      key_parse_element_shell(slice.m_ptr, slice.m_size, &error_string);
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+  return KeyElements(handle);
+}
+
+KeyElements KeyElements::parse_beam(KeywordSlice &slice) {
+  char *error_string;
+  auto handle =
+      key_parse_element_beam(slice.m_ptr, slice.m_size, &error_string);
+  if (error_string) {
+    throw KeyFile::Exception(KeyFile::Exception::ErrorString(error_string));
+  }
+  return KeyElements(handle);
+}
+
+KeyElements::KeyElements(KeyElements &&rhs) noexcept {
+  m_handle = rhs.m_handle;
+  rhs.m_handle = {0};
+}
+
+KeyElements::~KeyElements() noexcept { key_free_elements(&m_handle); }
+
+KeyElements &KeyElements::operator=(KeyElements &&rhs) noexcept {
+  key_free_elements(&m_handle);
+  m_handle = rhs.m_handle;
+  rhs.m_handle = {0};
+  return *this;
+}
+
+KeyElements::KeyElements(key_elements_t handle) noexcept : m_handle(handle) {}
+
+} // namespace dro
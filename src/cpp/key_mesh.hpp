@@ -0,0 +1,110 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#pragma once
+
+#include "array.hpp"
+#include "key.hpp"
+#include "vec.hpp"
+#include <key_mesh.h>
+
+namespace dro {
+
+// All nodes of one or more NODE keywords stored in contiguous arrays
+class KeyNodes {
+public:
+  // Decodes all cards of the NODE keywords of the slice in one pass. Cards can
+  // be in the standard, long or comma separated free format. Throws a
+  // dro::KeyFile::Exception if an error occurs
+  KeyNodes(KeywordSlice &slice);
+  // Same as above but only decodes one NODE keyword
+  KeyNodes(Keyword &kw);
+  KeyNodes(KeyNodes &&rhs) noexcept;
+  ~KeyNodes() noexcept;
+
+  KeyNodes &operator=(KeyNodes &&rhs) noexcept;
+
+  // The number of nodes
+  inline size_t size() const noexcept { return m_handle.num_nodes; }
+  // The ids of all nodes
+  inline Array<int64_t> get_ids() noexcept {
+    return Array<int64_t>(m_handle.ids, m_handle.num_nodes, false);
+  }
+  // The coordinates of all nodes
+  inline Array<dVec3> get_coords() noexcept {
+    return Array<dVec3>(reinterpret_cast<dVec3 *>(m_handle.xyz),
+                        m_handle.num_nodes, false);
+  }
+
+private:
+  key_nodes_t m_handle;
+};
+
+// All elements of one or more ELEMENT keywords stored in contiguous arrays
+class KeyElements {
+public:
+  // Decodes all cards of the ELEMENT_SOLID keywords of the slice in one pass.
+  // Throws a dro::KeyFile::Exception if an error occurs
+  static KeyElements parse_solid(KeywordSlice &slice);
+  // Decodes all cards of the ELEMENT_SHELL keywords of the slice in one pass.
+  // Throws a dro::KeyFile::Exception if an error occurs
+  static KeyElements parse_shell(KeywordSlice &slice);
+  // Decodes all cards of the ELEMENT_BEAM keywords of the slice in one pass.
+  // Throws a dro::KeyFile::Exception if an error occurs
+  static KeyElements parse_beam(KeywordSlice &slice);
+
+  KeyElements(KeyElements &&rhs) noexcept;
+  ~KeyElements() noexcept;
+
+  KeyElements &operator=(KeyElements &&rhs) noexcept;
+
+  // The number of elements
+  inline size_t size() const noexcept { return m_handle.num_elements; }
+  // The number of node ids per element inside the connectivity array
+  inline size_t nodes_per_element() const noexcept {
+    return m_handle.nodes_per_element;
+  }
+  // The ids of all elements
+  inline Array<int64_t> get_ids() noexcept {
+    return Array<int64_t>(m_handle.ids, m_handle.num_elements, false);
+  }
+  // The part ids of all elements
+  inline Array<int64_t> get_part_ids() noexcept {
+    return Array<int64_t>(m_handle.part_ids, m_handle.num_elements, false);
+  }
+  // The node ids of all elements. Stores nodes_per_element values per element
+  inline Array<int64_t> get_connectivity() noexcept {
+    return Array<int64_t>(m_handle.connectivity,
+                          m_handle.num_elements * m_handle.nodes_per_element,
+                          false);
+  }
+
+private:
+  KeyElements(key_elements_t handle) noexcept;
+
+  key_elements_t m_handle;
+};
+
+} // namespace dro
@@ -90,6 +90,139 @@ typedef struct {
   size_t num_shells;
 } d3plot_part;
 
+/* Translates ids of one entity type (nodes, an element type or parts) into
+ * indices. If the ids are dense (max - min is small compared to the number of
+ * ids) values is a direct table indexed by id - min_id. Otherwise keys and
+ * values form an open addressing hash table with num_buckets (a power of two)
+ * buckets. Empty buckets and missing ids have a value of (size_t)~0*/
+typedef struct {
+  d3_word *keys;
+  size_t *values;
+  size_t num_buckets;
+  size_t num_ids;
+  d3_word min_id;
+  uint8_t direct; /* values is a direct table*/
+  uint8_t built;  /* The index has been built*/
+} d3plot_id_index;
+
+/* The elements of all parts. For every element type the elements of all parts
+ * are stored in one array sorted by part. The elements of the part with index i
+ * are located at [offsets[i], offsets[i+1]). The offsets arrays have
+ * num_parts+1 elements*/
+typedef struct {
+  d3_word *solid_ids;
+  d3_word *thick_shell_ids;
+  d3_word *beam_ids;
+  d3_word *shell_ids;
+
+  size_t *solid_indices;
+  size_t *thick_shell_indices;
+  size_t *beam_indices;
+  size_t *shell_indices;
+
+  size_t *solid_offsets;
+  size_t *thick_shell_offsets;
+  size_t *beam_offsets;
+  size_t *shell_offsets;
+
+  size_t num_parts;
+} d3plot_parts;
+
+/* The topology of the whole model. All elements are numbered consecutively in
+ * the order solids, beams, shells and thick shells (the order of
+ * D3PLOT_ID_TYPE_SOLID to D3PLOT_ID_TYPE_THICK_SHELL). The elements of type t
+ * are located at [type_offsets[t-D3PLOT_ID_TYPE_SOLID],
+ * type_offsets[t-D3PLOT_ID_TYPE_SOLID+1]). All adjacency lists are stored as
+ * CSR (compressed sparse row) arrays: the entries of row i are located at
+ * [offsets[i], offsets[i+1]) and are sorted ascending*/
+typedef struct {
+  size_t num_nodes;
+  size_t num_elements;
+  size_t num_parts;
+  size_t type_offsets[5];
+
+  /* element -> node indices. num_elements+1 offsets*/
+  size_t *element_node_offsets;
+  uint32_t *element_nodes;
+  /* element -> part index. num_elements elements*/
+  uint32_t *element_parts;
+  /* node -> element indices. num_nodes+1 offsets*/
+  size_t *node_element_offsets;
+  uint32_t *node_elements;
+  /* part -> element indices. num_parts+1 offsets*/
+  size_t *part_element_offsets;
+  uint32_t *part_elements;
+  /* part -> node indices. num_parts+1 offsets*/
+  size_t *part_node_offsets;
+  uint32_t *part_nodes;
+} d3plot_mesh;
+
+/* The outer surface of solid and thick shell elements. A face of an element is
+ * part of the skin if no other element has a face with the same nodes*/
+typedef struct {
+  /* Indices of all nodes used by the faces, sorted ascending. They can be used
+   * to index into the arrays of the node read functions (e.g.
+   * d3plot_read_node_coordinates). num_nodes elements*/
+  size_t *node_indices;
+  /* 4 indices into node_indices for every face, ordered so that the normal
+   * points outwards. Triangles repeat their last node. num_faces*4 elements*/
+  size_t *faces;
+  /* The index of the element, which the face belongs to, inside of the arrays
+   * of its type (e.g. d3plot_read_solid_elements). num_faces elements*/
+  size_t *face_elements;
+  /* D3PLOT_ID_TYPE_SOLID or D3PLOT_ID_TYPE_THICK_SHELL for every face*/
+  uint8_t *face_element_types;
+
+  size_t num_nodes;
+  size_t num_faces;
+} d3plot_skin;
+
+/* The ids and titles of all parts. The titles have their trailing spaces
+ * removed and are stored one after another in one pool*/
+typedef struct {
+  size_t num_parts;
+  /* num_parts elements*/
+  d3_word *ids;
+  /* All titles, each terminated by '\0'*/
+  char *title_pool;
+  /* The title of part i starts at title_pool+title_offsets[i]. num_parts
+   * elements*/
+  size_t *title_offsets;
+  /* The part indices ordered by their titles (compared with strcmp). num_parts
+   * elements*/
+  size_t *sorted_indices;
+} d3plot_part_titles;
+
+/* The global data of a state*/
+typedef struct {
+  double kinetic_energy;
+  double internal_energy;
+  double total_energy;
+  /* The average velocity of the model*/
+  double velocity_x;
+  double velocity_y;
+  double velocity_z;
+} d3plot_global;
+
+/* A rigid wall of the GLOBAL section of a state*/
+typedef struct {
+  /* The normal force acting on the rigid wall*/
+  double force;
+  /* The position of the rigid wall (only written by newer versions)*/
+  double position_x;
+  double position_y;
+  double position_z;
+} d3plot_rigid_wall;
+
+/* The result of d3plot_reduce_elements*/
+typedef struct {
+  size_t num_elements;
+  /* The reduced value of every element. num_elements elements*/
+  double *values;
+  /* The state in which the value of values occurred. num_elements elements*/
+  size_t *states;
+} d3plot_reduction;
+
 typedef struct {
   double x;
   double y;
@@ -150,6 +283,49 @@ typedef struct {
   double *history_variables;
 } d3plot_surface;
 
+/* The stresses, effective plastic strains and history variables of many
+ * surfaces stored as one array per value (structure of arrays). All arrays
+ * point into one allocation*/
+typedef struct {
+  size_t num_surfaces;
+  size_t num_history_variables;
+  /* The x, y, z, xy, yz and zx components of the stresses. num_surfaces
+   * elements each*/
+  double *stress[6];
+  /* num_surfaces elements*/
+  double *effective_plastic_strain;
+  /* History variable j of surface i is located at
+   * history_variables[j*num_surfaces+i]*/
+  double *history_variables;
+} d3plot_surfaces;
+
+/* The resultants, integration points and history variables of many beams
+ * stored as one array per value (structure of arrays). All arrays point into
+ * one allocation*/
+typedef struct {
+  size_t num_beams;
+  size_t num_integration_points;
+  size_t num_history_variables;
+  /* The axial force, s and t shear resultants, s and t bending moments and
+   * the torsional resultant. num_beams elements each*/
+  double *resultants[6];
+  /* The rs and tr shear stresses, axial stress, plastic strain and axial
+   * strain. The value of integration point j of beam i is located at
+   * [j*num_beams+i]. NULL if the integration points are not kept*/
+  double *ip_values[5];
+  /* History variable k of integration point j of beam i is located at
+   * [(j*num_history_variables+k)*num_beams+i]. NULL if the integration points
+   * are not kept*/
+  double *ip_history_variables;
+  /* The average, minimum and maximum over all integration points. History
+   * variable k of beam i is located at [k*num_beams+i]*/
+  double *history_average;
+  double *history_min;
+  double *history_max;
+  /* Holds the words of all beams while reading a state*/
+  double *words;
+} d3plot_beams;
+
 typedef struct {
   double rs_shear_stress;
   double tr_shear_stress;
@@ -223,6 +399,77 @@ typedef struct {
   uint8_t num_additional_integration_points;
 } d3plot_shell;
 
+/* The entity types of d3plot_ids_to_indices*/
+#define D3PLOT_ID_TYPE_NODE 0
+#define D3PLOT_ID_TYPE_SOLID 1
+#define D3PLOT_ID_TYPE_BEAM 2
+#define D3PLOT_ID_TYPE_SHELL 3
+#define D3PLOT_ID_TYPE_THICK_SHELL 4
+#define D3PLOT_ID_TYPE_PART 5
+#define D3PLOT_ID_TYPE_COUNT 6
+
+/* The modes of d3plot_search_parts. One of D3PLOT_PART_SEARCH_EXACT,
+ * D3PLOT_PART_SEARCH_PREFIX and D3PLOT_PART_SEARCH_WILDCARD, which can be
+ * combined with D3PLOT_PART_SEARCH_IGNORE_CASE*/
+#define D3PLOT_PART_SEARCH_EXACT 0
+#define D3PLOT_PART_SEARCH_PREFIX 1
+#define D3PLOT_PART_SEARCH_WILDCARD 2
+#define D3PLOT_PART_SEARCH_IGNORE_CASE 4
+
+/* The quantities of d3plot_compute_derived, which can be computed out of a
+ * stress (or strain) tensor. The principal values are ordered so that max >=
+ * mid >= min. The pressure is the negative mean of the normal components and
+ * the triaxiality is the mean normal component divided by the von Mises value
+ * (0 if the von Mises value is 0)*/
+#define D3PLOT_DERIVED_VON_MISES 0
+#define D3PLOT_DERIVED_PRESSURE 1
+#define D3PLOT_DERIVED_MAX_PRINCIPAL 2
+#define D3PLOT_DERIVED_MID_PRINCIPAL 3
+#define D3PLOT_DERIVED_MIN_PRINCIPAL 4
+#define D3PLOT_DERIVED_MAX_SHEAR 5
+#define D3PLOT_DERIVED_TRIAXIALITY 6
+#define D3PLOT_DERIVED_COUNT 7
+
+/* The per material values of the GLOBAL section of every state, which can be
+ * read by d3plot_read_material_data*/
+#define D3PLOT_MATERIAL_INTERNAL_ENERGY 0
+#define D3PLOT_MATERIAL_KINETIC_ENERGY 1
+#define D3PLOT_MATERIAL_VELOCITY_X 2
+#define D3PLOT_MATERIAL_VELOCITY_Y 3
+#define D3PLOT_MATERIAL_VELOCITY_Z 4
+#define D3PLOT_MATERIAL_MASS 5
+#define D3PLOT_MATERIAL_HOURGLASS_ENERGY 6
+#define D3PLOT_MATERIAL_COUNT 7
+
+/* The integration points through the thickness of shells and thick shells.
+ * D3PLOT_SHELL_SURFACE_MEAN is the mean of all integration points and
+ * D3PLOT_SHELL_SURFACE_ABS_MAX takes all values from the integration point
+ * with the largest von Mises stress*/
+#define D3PLOT_SHELL_SURFACE_MID 0
+#define D3PLOT_SHELL_SURFACE_INNER 1
+#define D3PLOT_SHELL_SURFACE_OUTER 2
+#define D3PLOT_SHELL_SURFACE_MEAN 3
+#define D3PLOT_SHELL_SURFACE_ABS_MAX 4
+
+/* The effective plastic strain. d3plot_reduce_elements accepts it next to the
+ * D3PLOT_DERIVED_* quantities*/
+#define D3PLOT_REDUCE_PLASTIC_STRAIN D3PLOT_DERIVED_COUNT
+
+/* The operations of d3plot_reduce_elements. D3PLOT_REDUCE_ABS_MAX keeps the
+ * value with the largest magnitude (including its sign) and
+ * D3PLOT_REDUCE_LAST the value of the last state*/
+#define D3PLOT_REDUCE_MAX 0
+#define D3PLOT_REDUCE_MIN 1
+#define D3PLOT_REDUCE_ABS_MAX 2
+#define D3PLOT_REDUCE_LAST 3
+
+/* The node quantities of d3plot_resample_nodes*/
+#define D3PLOT_RESAMPLE_NODE_COORDINATES 0
+#define D3PLOT_RESAMPLE_NODE_VELOCITY 1
+#define D3PLOT_RESAMPLE_NODE_ACCELERATION 2
+#define D3PLOT_RESAMPLE_NODE_DISPLACEMENT 3
+#define D3PLOT_RESAMPLE_NODE_TEMPERATURE 4
+
 #define D3_FILE_TYPE_D3PLOT 1
 #define D3_FILE_TYPE_D3DRLF 2
 #define D3_FILE_TYPE_D3THDT 3
@@ -256,19 +503,26 @@ typedef struct {
 #define D3PLT_PTR_ELT_IDS (D3PLT_PTR_EL4_IDS + 1)
 #define D3PLT_PTR_PART_IDS (D3PLT_PTR_ELT_IDS + 1)
 #define D3PLT_PTR_EL8_CONNECT (D3PLT_PTR_PART_IDS + 1)
-#define D3PLT_PTR_ELT_CONNECT (D3PLT_PTR_EL8_CONNECT + 1)
+#define D3PLT_PTR_EL8_EXTRA_NODES (D3PLT_PTR_EL8_CONNECT + 1)
+#define D3PLT_PTR_ELT_CONNECT (D3PLT_PTR_EL8_EXTRA_NODES + 1)
 #define D3PLT_PTR_EL2_CONNECT (D3PLT_PTR_ELT_CONNECT + 1)
 #define D3PLT_PTR_EL4_CONNECT (D3PLT_PTR_EL2_CONNECT + 1)
 #define D3PLT_PTR_PART_TITLES (D3PLT_PTR_EL4_CONNECT + 1)
 #define D3PLT_PTR_STATE_TIME (D3PLT_PTR_PART_TITLES + 1)
-#define D3PLT_PTR_STATE_NODE_COORDS (D3PLT_PTR_STATE_TIME + 1)
+#define D3PLT_PTR_STATE_GLOBAL (D3PLT_PTR_STATE_TIME + 1)
+#define D3PLT_PTR_STATE_NODE_TEMP (D3PLT_PTR_STATE_GLOBAL + 1)
+#define D3PLT_PTR_STATE_NODE_FLUX (D3PLT_PTR_STATE_NODE_TEMP + 1)
+#define D3PLT_PTR_STATE_NODE_MASS_SCALING (D3PLT_PTR_STATE_NODE_FLUX + 1)
+#define D3PLT_PTR_STATE_NODE_COORDS (D3PLT_PTR_STATE_NODE_MASS_SCALING + 1)
 #define D3PLT_PTR_STATE_NODE_VEL (D3PLT_PTR_STATE_NODE_COORDS + 1)
 #define D3PLT_PTR_STATE_NODE_ACC (D3PLT_PTR_STATE_NODE_VEL + 1)
-#define D3PLT_PTR_STATE_ELEMENT_SOLID (D3PLT_PTR_STATE_NODE_ACC + 1)
+#define D3PLT_PTR_STATE_ELEMENT_THERMAL (D3PLT_PTR_STATE_NODE_ACC + 1)
+#define D3PLT_PTR_STATE_ELEMENT_SOLID (D3PLT_PTR_STATE_ELEMENT_THERMAL + 1)
 #define D3PLT_PTR_STATE_ELEMENT_THICK_SHELL (D3PLT_PTR_STATE_ELEMENT_SOLID + 1)
 #define D3PLT_PTR_STATE_ELEMENT_BEAM (D3PLT_PTR_STATE_ELEMENT_THICK_SHELL + 1)
 #define D3PLT_PTR_STATE_ELEMENT_SHELL (D3PLT_PTR_STATE_ELEMENT_BEAM + 1)
-#define D3PLT_PTR_STATES (D3PLT_PTR_STATE_ELEMENT_SHELL + 1)
+#define D3PLT_PTR_STATE_DELETION (D3PLT_PTR_STATE_ELEMENT_SHELL + 1)
+#define D3PLT_PTR_STATES (D3PLT_PTR_STATE_DELETION + 1)
 #define D3PLT_PTR_COUNT D3PLT_PTR_STATES
 
 #endif
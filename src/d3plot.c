@@ -62,6 +62,17 @@ d3plot_file d3plot_open(const char *root_file_name) {
   plot_file.num_states = 0;
   plot_file.initial_node_coords = NULL;
   plot_file.initial_node_coords_32 = NULL;
+  memset(plot_file.id_indices, 0, sizeof(plot_file.id_indices));
+  plot_file.mesh = NULL;
+  plot_file.part_titles = NULL;
+  plot_file.state_times = NULL;
+  plot_file.state_globals = NULL;
+#ifndef NO_THREAD_SAFETY
+  plot_file.id_indices_mutex = sync_create();
+  plot_file.mesh_mutex = sync_create();
+  plot_file.part_titles_mutex = sync_create();
+  plot_file.initial_node_coords_mutex = sync_create();
+#endif
 
   plot_file.buffer = d3_buffer_open(root_file_name);
   if (plot_file.buffer.error_string) {
@@ -103,7 +114,14 @@ d3plot_file d3plot_open(const char *root_file_name) {
   d3_buffer_skip_words(&plot_file.buffer, &d3_ptr, 1); /* TODO: Source version*/
   d3_buffer_skip_words(&plot_file.buffer, &d3_ptr,
                        1); /* TODO: Release version*/
-  d3_buffer_skip_words(&plot_file.buffer, &d3_ptr, 1); /* TODO: Version*/
+  /* Version is a real number*/
+  if (plot_file.buffer.word_size == 4) {
+    float version32;
+    d3_buffer_read_words(&plot_file.buffer, &d3_ptr, &version32, 1);
+    CDA.version = version32;
+  } else {
+    d3_buffer_read_words(&plot_file.buffer, &d3_ptr, &CDA.version, 1);
+  }
   READ_CONTROL_DATA_PLOT_FILE_WORD(ndim);
   READ_CONTROL_DATA_PLOT_FILE_WORD(numnp);
   READ_CONTROL_DATA_WORD(icode);
@@ -304,6 +322,13 @@ d3plot_file d3plot_open(const char *root_file_name) {
     ERROR_AND_RETURN_F("Invalid value for MAXINT: %lld", CDA.maxint);
   }
 
+  if (CDA.nel8 < 0) {
+    CDA.nel8 = -CDA.nel8;
+    CDA.has_solid_extra_nodes = 1;
+  } else {
+    CDA.has_solid_extra_nodes = 0;
+  }
+
   if (idtdt < 100) {
     /* We need to compute ISTRN*/
     /*ISTRN can only be computed as follows and if NV2D > 0.
@@ -379,10 +404,18 @@ d3plot_file d3plot_open(const char *root_file_name) {
   if (CDA.numst != 0) {
     ERROR_AND_RETURN_F("NUMST (%llu) should be 0", CDA.numst);
   }
-  if (CDA.it != 0) {
-    /* TODO: IT*/
-    ERROR_AND_RETURN_F(
-        "IT (%llu) with a different value than 0 is not supported", CDA.it);
+
+  /* Calculate the thermal node data from IT*/
+  {
+    const int it = _get_nth_digit(CDA.it, 0);
+    if (it > 3) {
+      ERROR_AND_RETURN_F("IT (%llu) is not supported", CDA.it);
+    }
+    /* 1: temperature, 2: temperature and flux, 3: three temperatures (thick
+     * shells) and flux*/
+    CDA.num_temperatures = it == 3 ? 3 : (it > 0);
+    CDA.num_fluxes = it > 1 ? 3 : 0;
+    CDA.has_mass_scaling = _get_nth_digit(CDA.it, 1) == 1;
   }
 
   if (!_d3plot_read_geometry_data(&plot_file, &d3_ptr)) {
@@ -474,6 +507,32 @@ void d3plot_close(d3plot_file *plot_file) {
   free(plot_file->error_string);
   free(plot_file->initial_node_coords);
   free(plot_file->initial_node_coords_32);
+  free(plot_file->state_times);
+  free(plot_file->state_globals);
+  plot_file->state_times = NULL;
+  plot_file->state_globals = NULL;
+
+  size_t i = 0;
+  while (i < D3PLOT_ID_TYPE_COUNT) {
+    _d3plot_id_index_free(&plot_file->id_indices[i]);
+    i++;
+  }
+  if (plot_file->mesh) {
+    d3plot_free_mesh(plot_file->mesh);
+    free(plot_file->mesh);
+    plot_file->mesh = NULL;
+  }
+  if (plot_file->part_titles) {
+    d3plot_free_part_titles(plot_file->part_titles);
+    free(plot_file->part_titles);
+    plot_file->part_titles = NULL;
+  }
+#ifndef NO_THREAD_SAFETY
+  sync_destroy(&plot_file->id_indices_mutex);
+  sync_destroy(&plot_file->mesh_mutex);
+  sync_destroy(&plot_file->part_titles_mutex);
+  sync_destroy(&plot_file->initial_node_coords_mutex);
+#endif
 
   plot_file->num_states = 0;
   plot_file->error_string = NULL;
@@ -535,42 +594,46 @@ d3_word *d3plot_read_thick_shell_element_ids(d3plot_file *plot_file,
 }
 
 d3_word *d3plot_read_all_element_ids(d3plot_file *plot_file, size_t *num_ids) {
-  BEGIN_PROFILE_FUNC();
+  return d3plot_read_all_element_ids2(plot_file, num_ids, NULL, NULL);
+}
 
-  d3_word *all_ids = NULL;
-  *num_ids = 0;
+d3_word *d3plot_read_all_element_ids2(d3plot_file *plot_file, size_t *num_ids,
+                                      uint8_t **element_types,
+                                      size_t **element_indices) {
+  BEGIN_PROFILE_FUNC();
 
-  size_t num_ids_buffer;
-  d3_word *ids_buffer =
-      d3plot_read_solid_element_ids(plot_file, &num_ids_buffer);
   /* If an error occurs when trying to read the element ids, those specific
-   * elements will be ignored*/
-  if (num_ids_buffer > 0) {
-    all_ids = _insert_sorted(all_ids, *num_ids, ids_buffer, num_ids_buffer);
-    *num_ids += num_ids_buffer;
-    free(ids_buffer);
-  }
-
-  ids_buffer = d3plot_read_beam_element_ids(plot_file, &num_ids_buffer);
-  if (num_ids_buffer > 0) {
-    all_ids = _insert_sorted(all_ids, *num_ids, ids_buffer, num_ids_buffer);
-    *num_ids += num_ids_buffer;
-    free(ids_buffer);
+   * elements will be ignored. They are read in the order of D3PLOT_ID_TYPE*/
+  const d3_word *ids[4];
+  size_t sizes[4];
+  ids[0] = d3plot_read_solid_element_ids(plot_file, &sizes[0]);
+  ids[1] = d3plot_read_beam_element_ids(plot_file, &sizes[1]);
+  ids[2] = d3plot_read_shell_element_ids(plot_file, &sizes[2]);
+  ids[3] = d3plot_read_thick_shell_element_ids(plot_file, &sizes[3]);
+
+  *num_ids = sizes[0] + sizes[1] + sizes[2] + sizes[3];
+  d3_word *all_ids = malloc(*num_ids * sizeof(d3_word));
+  uint8_t *types = element_types ? malloc(*num_ids * sizeof(uint8_t)) : NULL;
+  size_t *indices = element_indices ? malloc(*num_ids * sizeof(size_t)) : NULL;
+
+  _merge_sorted(ids, sizes, 4, all_ids, types, indices);
+
+  if (types) {
+    size_t i = 0;
+    while (i < *num_ids) {
+      types[i] += D3PLOT_ID_TYPE_SOLID;
+      i++;
+    }
+    *element_types = types;
   }
-
-  ids_buffer = d3plot_read_shell_element_ids(plot_file, &num_ids_buffer);
-  if (num_ids_buffer > 0) {
-    all_ids = _insert_sorted(all_ids, *num_ids, ids_buffer, num_ids_buffer);
-    *num_ids += num_ids_buffer;
-    free(ids_buffer);
+  if (indices) {
+    *element_indices = indices;
   }
 
-  ids_buffer = d3plot_read_thick_shell_element_ids(plot_file, &num_ids_buffer);
-  if (num_ids_buffer > 0) {
-    all_ids = _insert_sorted(all_ids, *num_ids, ids_buffer, num_ids_buffer);
-    *num_ids += num_ids_buffer;
-    free(ids_buffer);
-  }
+  free((d3_word *)ids[0]);
+  free((d3_word *)ids[1]);
+  free((d3_word *)ids[2]);
+  free((d3_word *)ids[3]);
 
   END_PROFILE_FUNC();
   return all_ids;
@@ -686,71 +749,21 @@ double *d3plot_read_node_coordinates(d3plot_file *plot_file, size_t state,
   }
 
   if (plot_file->control_data.iu == 2) {
-    if (!plot_file->initial_node_coords) {
-      *num_nodes = plot_file->control_data.numnp;
-      plot_file->initial_node_coords = malloc(*num_nodes * 3 * sizeof(double));
-
-      if (plot_file->buffer.word_size == 8) {
-        d3_pointer d3_ptr = d3_buffer_read_words_at(
-            &plot_file->buffer, plot_file->initial_node_coords, *num_nodes * 3,
-            plot_file->data_pointers[D3PLT_PTR_NODE_COORDS]);
-        d3_pointer_close(&plot_file->buffer, &d3_ptr);
-
-        if (plot_file->buffer.error_string) {
-          free(data);
-          free(plot_file->initial_node_coords);
-          plot_file->initial_node_coords = NULL;
-
-          ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
-                                    plot_file->buffer.error_string);
-          END_PROFILE_FUNC();
-          return NULL;
-        }
-      } else {
-        if (!plot_file->initial_node_coords_32) {
-          plot_file->initial_node_coords_32 =
-              malloc(*num_nodes * 3 * sizeof(float));
-
-          d3_pointer d3_ptr = d3_buffer_read_words_at(
-              &plot_file->buffer, plot_file->initial_node_coords_32,
-              *num_nodes * 3, plot_file->data_pointers[D3PLT_PTR_NODE_COORDS]);
-          d3_pointer_close(&plot_file->buffer, &d3_ptr);
-
-          if (plot_file->buffer.error_string) {
-            free(data);
-            free(plot_file->initial_node_coords);
-            free(plot_file->initial_node_coords_32);
-            plot_file->initial_node_coords = NULL;
-            plot_file->initial_node_coords_32 = NULL;
-
-            ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
-                                      plot_file->buffer.error_string);
-            END_PROFILE_FUNC();
-            return NULL;
-          }
-        }
-
-        size_t i = 0;
-        while (i < *num_nodes * 3) {
-          plot_file->initial_node_coords[i + 0] =
-              plot_file->initial_node_coords_32[i + 0];
-          plot_file->initial_node_coords[i + 1] =
-              plot_file->initial_node_coords_32[i + 1];
-          plot_file->initial_node_coords[i + 2] =
-              plot_file->initial_node_coords_32[i + 2];
+    if (!_d3plot_read_initial_node_coords(plot_file)) {
+      free(data);
+      *num_nodes = 0;
 
-          i += 3;
-        }
-      }
+      END_PROFILE_FUNC();
+      return NULL;
+    }
 
-      size_t i = 0;
-      while (i < *num_nodes) {
-        data[i + 0] += plot_file->initial_node_coords[i + 0];
-        data[i + 1] += plot_file->initial_node_coords[i + 1];
-        data[i + 2] += plot_file->initial_node_coords[i + 2];
+    size_t i = 0;
+    while (i < *num_nodes * 3) {
+      data[i + 0] += plot_file->initial_node_coords[i + 0];
+      data[i + 1] += plot_file->initial_node_coords[i + 1];
+      data[i + 2] += plot_file->initial_node_coords[i + 2];
 
-        i += 3;
-      }
+      i += 3;
     }
   }
 
@@ -971,6 +984,270 @@ double *d3plot_read_all_node_acceleration(d3plot_file *plot_file,
   return big_data;
 }
 
+double *d3plot_read_node_displacement(d3plot_file *plot_file, size_t state,
+                                      size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data = d3plot_read_node_displacement_range(plot_file, state, 1,
+                                                     NULL, 0, num_nodes);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_all_node_displacement(d3plot_file *plot_file,
+                                          size_t *num_nodes,
+                                          size_t *num_time_steps) {
+  BEGIN_PROFILE_FUNC();
+
+  *num_time_steps = plot_file->num_states;
+  double *data = d3plot_read_node_displacement_range(
+      plot_file, 0, plot_file->num_states, NULL, 0, num_nodes);
+  if (plot_file->error_string) {
+    *num_time_steps = 0;
+  }
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_displacement_range(d3plot_file *plot_file,
+                                            size_t first_state,
+                                            size_t num_states,
+                                            const size_t *node_indices,
+                                            size_t num_node_indices,
+                                            size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_nodes = 0;
+
+  if (plot_file->data_pointers[D3PLT_PTR_STATE_NODE_COORDS] == 0) {
+    ERROR_AND_NO_RETURN_F_PTR("This node data is not present IU=%llu",
+                              plot_file->control_data.iu);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  if (first_state + num_states > plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states",
+                              first_state + num_states - 1);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  if (node_indices) {
+    size_t i = 0;
+    while (i < num_node_indices) {
+      if (node_indices[i] >= plot_file->control_data.numnp) {
+        ERROR_AND_NO_RETURN_F_PTR("The node index %zu is out of bounds",
+                                  node_indices[i]);
+        END_PROFILE_FUNC();
+        return NULL;
+      }
+      i++;
+    }
+  } else {
+    num_node_indices = plot_file->control_data.numnp;
+  }
+
+  /* With IU == 2 the states already contain the displacements*/
+  const double *initial_coords = NULL;
+  if (plot_file->control_data.iu != 2) {
+    if (!_d3plot_read_initial_node_coords(plot_file)) {
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+    initial_coords = plot_file->initial_node_coords;
+  }
+
+  const size_t num_values = num_node_indices * 3;
+  double *data = malloc(num_states * num_values * sizeof(double));
+  float *data32 = NULL;
+  if (plot_file->buffer.word_size == 4) {
+    data32 = malloc(num_values * sizeof(float));
+  }
+
+  size_t t = 0;
+  while (t < num_states) {
+    double *state_data = &data[t * num_values];
+    const size_t word_pos =
+        plot_file->data_pointers[D3PLT_PTR_STATES + first_state + t] +
+        plot_file->data_pointers[D3PLT_PTR_STATE_NODE_COORDS];
+
+    if (data32) {
+      _d3plot_read_words_of_indices(plot_file, data32, word_pos, 3,
+                                    node_indices, num_node_indices);
+    } else {
+      _d3plot_read_words_of_indices(plot_file, state_data, word_pos, 3,
+                                    node_indices, num_node_indices);
+    }
+
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      free(data32);
+      free(data);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    /* Convert the floats and subtract the initial coordinates in one pass*/
+    size_t i = 0;
+    while (i < num_node_indices) {
+      const size_t n = node_indices ? node_indices[i] : i;
+
+      size_t c = 0;
+      while (c < 3) {
+        double value = data32 ? data32[i * 3 + c] : state_data[i * 3 + c];
+        if (initial_coords) {
+          value -= initial_coords[n * 3 + c];
+        }
+        state_data[i * 3 + c] = value;
+
+        c++;
+      }
+
+      i++;
+    }
+
+    t++;
+  }
+
+  free(data32);
+
+  *num_nodes = num_node_indices;
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_relative_displacement(
+    d3plot_file *plot_file, size_t state, const size_t *node_indices,
+    size_t num_node_indices, const size_t *reference_indices,
+    size_t num_reference_indices, size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  *num_nodes = 0;
+
+  if (num_reference_indices == 0) {
+    D3PLOT_CLEAR_ERROR_STRING();
+    ERROR_AND_NO_RETURN_PTR("The reference node set is empty");
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  size_t num_reference_nodes;
+  double *reference = d3plot_read_node_displacement_range(
+      plot_file, state, 1, reference_indices, num_reference_indices,
+      &num_reference_nodes);
+  if (plot_file->error_string) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  /* The mean displacement of the reference nodes*/
+  double mean[3] = {0.0, 0.0, 0.0};
+  size_t i = 0;
+  while (i < num_reference_nodes) {
+    mean[0] += reference[i * 3 + 0];
+    mean[1] += reference[i * 3 + 1];
+    mean[2] += reference[i * 3 + 2];
+
+    i++;
+  }
+  free(reference);
+
+  mean[0] /= (double)num_reference_nodes;
+  mean[1] /= (double)num_reference_nodes;
+  mean[2] /= (double)num_reference_nodes;
+
+  double *data = d3plot_read_node_displacement_range(
+      plot_file, state, 1, node_indices, num_node_indices, num_nodes);
+  if (plot_file->error_string) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  i = 0;
+  while (i < *num_nodes) {
+    data[i * 3 + 0] -= mean[0];
+    data[i * 3 + 1] -= mean[1];
+    data[i * 3 + 2] -= mean[2];
+
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_temperature(d3plot_file *plot_file, size_t state,
+                                     size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data =
+      d3plot_read_node_temperature_range(plot_file, state, 1, NULL, 0,
+                                         num_nodes);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_temperature_range(d3plot_file *plot_file,
+                                           size_t first_state,
+                                           size_t num_states,
+                                           const size_t *node_indices,
+                                           size_t num_node_indices,
+                                           size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data = _d3plot_read_state_words(
+      plot_file, D3PLT_PTR_STATE_NODE_TEMP,
+      plot_file->control_data.num_temperatures, plot_file->control_data.numnp,
+      first_state, num_states, node_indices, num_node_indices, num_nodes);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_flux(d3plot_file *plot_file, size_t state,
+                              size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data = _d3plot_read_state_words(
+      plot_file, D3PLT_PTR_STATE_NODE_FLUX, plot_file->control_data.num_fluxes,
+      plot_file->control_data.numnp, state, 1, NULL, 0, num_nodes);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_node_mass_scaling(d3plot_file *plot_file, size_t state,
+                                      size_t *num_nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data = _d3plot_read_state_words(
+      plot_file, D3PLT_PTR_STATE_NODE_MASS_SCALING,
+      plot_file->control_data.has_mass_scaling, plot_file->control_data.numnp,
+      state, 1, NULL, 0, num_nodes);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+double *d3plot_read_solids_thermal_state(d3plot_file *plot_file, size_t state,
+                                         size_t *num_solids) {
+  BEGIN_PROFILE_FUNC();
+
+  double *data = _d3plot_read_state_words(
+      plot_file, D3PLT_PTR_STATE_ELEMENT_THERMAL, plot_file->control_data.nt3d,
+      plot_file->control_data.nel8, state, 1, NULL, 0, num_solids);
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
 float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
                                        size_t *num_nodes) {
   BEGIN_PROFILE_FUNC();
@@ -983,6 +1260,9 @@ float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
   }
 
   if (plot_file->control_data.iu == 2) {
+#ifndef NO_THREAD_SAFETY
+    sync_lock(&plot_file->initial_node_coords_mutex);
+#endif
     if (!plot_file->initial_node_coords_32) {
       *num_nodes = plot_file->control_data.numnp;
       plot_file->initial_node_coords_32 =
@@ -999,6 +1279,9 @@ float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
           free(plot_file->initial_node_coords_32);
           plot_file->initial_node_coords_32 = NULL;
 
+#ifndef NO_THREAD_SAFETY
+          sync_unlock(&plot_file->initial_node_coords_mutex);
+#endif
           ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
                                     plot_file->buffer.error_string);
           END_PROFILE_FUNC();
@@ -1021,6 +1304,9 @@ float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
             plot_file->initial_node_coords_32 = NULL;
             plot_file->initial_node_coords = NULL;
 
+#ifndef NO_THREAD_SAFETY
+            sync_unlock(&plot_file->initial_node_coords_mutex);
+#endif
             ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
                                       plot_file->buffer.error_string);
             END_PROFILE_FUNC();
@@ -1050,6 +1336,9 @@ float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
         i += 3;
       }
     }
+#ifndef NO_THREAD_SAFETY
+    sync_unlock(&plot_file->initial_node_coords_mutex);
+#endif
   }
 
   END_PROFILE_FUNC();
@@ -1281,30 +1570,8 @@ double d3plot_read_time(d3plot_file *plot_file, size_t state) {
     return -1.0;
   }
 
-  double time;
-  if (plot_file->buffer.word_size == 4) {
-    float time32;
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, &time32, 1,
-        plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    time = (double)time32;
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, &time, 1,
-        plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-  }
-
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
-
-    END_PROFILE_FUNC();
-    return -1.0;
-  }
+  /* The times have already been read in d3plot_open*/
+  const double time = plot_file->state_times[state];
 
   END_PROFILE_FUNC();
   return time;
@@ -1316,156 +1583,265 @@ double *d3plot_read_all_time(d3plot_file *plot_file, size_t *num_states) {
 
   *num_states = plot_file->num_states;
   double *times = malloc(plot_file->num_states * sizeof(double));
+  memcpy(times, plot_file->state_times,
+         plot_file->num_states * sizeof(double));
 
-  if (plot_file->buffer.word_size == 4) {
-    float time32;
-
-    size_t i = 0;
-    while (i < plot_file->num_states) {
-      d3_pointer d3_ptr = d3_buffer_read_words_at(
-          &plot_file->buffer, &time32, 1,
-          plot_file->data_pointers[D3PLT_PTR_STATES + i] +
-              plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-      d3_pointer_close(&plot_file->buffer, &d3_ptr);
-      if (plot_file->buffer.error_string) {
-        ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                  plot_file->buffer.error_string);
-        *num_states = 0;
-        free(times);
-        times = NULL;
-        break;
-      }
+  END_PROFILE_FUNC();
+  return times;
+}
 
-      times[i] = (double)time32;
+float d3plot_read_time_32(d3plot_file *plot_file, size_t state) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
 
-      i++;
-    }
-  } else {
-    size_t i = 0;
-    while (i < plot_file->num_states) {
-      d3_pointer d3_ptr = d3_buffer_read_words_at(
-          &plot_file->buffer, &times[i], 1,
-          plot_file->data_pointers[D3PLT_PTR_STATES + i] +
-              plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-      d3_pointer_close(&plot_file->buffer, &d3_ptr);
-      if (plot_file->buffer.error_string) {
-        ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                  plot_file->buffer.error_string);
-        *num_states = 0;
-        free(times);
-        times = NULL;
-        break;
-      }
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
 
-      i++;
-    }
+    END_PROFILE_FUNC();
+    return -1.0f;
+  }
+
+  const float time = (float)plot_file->state_times[state];
+
+  END_PROFILE_FUNC();
+  return time;
+}
+
+float *d3plot_read_all_time_32(d3plot_file *plot_file, size_t *num_states) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_states = plot_file->num_states;
+  float *times = malloc(plot_file->num_states * sizeof(float));
+
+  size_t i = 0;
+  while (i < plot_file->num_states) {
+    times[i] = (float)plot_file->state_times[i];
+    i++;
   }
 
   END_PROFILE_FUNC();
   return times;
 }
 
-float d3plot_read_time_32(d3plot_file *plot_file, size_t state) {
+d3plot_global d3plot_read_global(d3plot_file *plot_file, size_t state) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
+  d3plot_global global;
+  memset(&global, 0, sizeof(global));
+
   if (state >= plot_file->num_states) {
     ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    END_PROFILE_FUNC();
+    return global;
+  }
 
+  if (plot_file->control_data.nglbv < 6) {
+    ERROR_AND_NO_RETURN_F_PTR("GLOBAL only has %llu words",
+                              plot_file->control_data.nglbv);
     END_PROFILE_FUNC();
-    return -1.0f;
+    return global;
   }
 
-  float time;
-  if (plot_file->buffer.word_size == 8) {
-    double time64;
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, &time64, 1,
-        plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    time = (float)time64;
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, &time, 1,
-        plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  /* KE, IE, TE, X, Y and Z*/
+  const double *data =
+      &plot_file->state_globals[state * plot_file->control_data.nglbv];
+
+  global.kinetic_energy = data[0];
+  global.internal_energy = data[1];
+  global.total_energy = data[2];
+  global.velocity_x = data[3];
+  global.velocity_y = data[4];
+  global.velocity_z = data[5];
+
+  END_PROFILE_FUNC();
+  return global;
+}
+
+d3plot_global *d3plot_read_all_global(d3plot_file *plot_file,
+                                      size_t *num_states) {
+  BEGIN_PROFILE_FUNC();
+
+  *num_states = plot_file->num_states;
+  d3plot_global *globals = malloc(*num_states * sizeof(d3plot_global));
+
+  size_t i = 0;
+  while (i < *num_states) {
+    globals[i] = d3plot_read_global(plot_file, i);
+    if (plot_file->error_string) {
+      free(globals);
+      *num_states = 0;
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    i++;
   }
 
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
+  END_PROFILE_FUNC();
+  return globals;
+}
+
+double *d3plot_read_material_data(d3plot_file *plot_file, size_t state,
+                                  int quantity, size_t *num_materials) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_materials = _d3plot_num_global_materials(plot_file);
+
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    *num_materials = 0;
 
     END_PROFILE_FUNC();
-    return -1.0f;
+    return NULL;
+  }
+
+  if (quantity < 0 || quantity >= D3PLOT_MATERIAL_COUNT) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid material quantity: %d", quantity);
+    *num_materials = 0;
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  if (*num_materials == 0) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  double *data = malloc(*num_materials * sizeof(double));
+  if (!_d3plot_read_material_data(plot_file, state, quantity, data)) {
+    free(data);
+    *num_materials = 0;
+
+    END_PROFILE_FUNC();
+    return NULL;
   }
 
   END_PROFILE_FUNC();
-  return time;
+  return data;
 }
 
-float *d3plot_read_all_time_32(d3plot_file *plot_file, size_t *num_states) {
+double *d3plot_read_all_material_data(d3plot_file *plot_file, int quantity,
+                                      size_t *num_states,
+                                      size_t *num_materials) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
   *num_states = plot_file->num_states;
-  float *times = malloc(plot_file->num_states * sizeof(float));
+  *num_materials = _d3plot_num_global_materials(plot_file);
 
-  if (plot_file->buffer.word_size == 8) {
-    double time64;
+  if (quantity < 0 || quantity >= D3PLOT_MATERIAL_COUNT) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid material quantity: %d", quantity);
+    *num_states = 0;
+    *num_materials = 0;
 
-    size_t i = 0;
-    while (i < plot_file->num_states) {
-      d3_pointer d3_ptr = d3_buffer_read_words_at(
-          &plot_file->buffer, &time64, 1,
-          plot_file->data_pointers[D3PLT_PTR_STATES + i] +
-              plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-      d3_pointer_close(&plot_file->buffer, &d3_ptr);
-      if (plot_file->buffer.error_string) {
-        ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                  plot_file->buffer.error_string);
-        *num_states = 0;
-        free(times);
-        times = NULL;
-        break;
-      }
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      times[i] = (float)time64;
+  if (*num_states == 0 || *num_materials == 0) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      i++;
-    }
-  } else {
-    size_t i = 0;
-    while (i < plot_file->num_states) {
-      d3_pointer d3_ptr = d3_buffer_read_words_at(
-          &plot_file->buffer, &times[i], 1,
-          plot_file->data_pointers[D3PLT_PTR_STATES + i] +
-              plot_file->data_pointers[D3PLT_PTR_STATE_TIME]);
-      d3_pointer_close(&plot_file->buffer, &d3_ptr);
-      if (plot_file->buffer.error_string) {
-        ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                  plot_file->buffer.error_string);
-        *num_states = 0;
-        free(times);
-        times = NULL;
-        break;
-      }
+  double *data = malloc(*num_states * *num_materials * sizeof(double));
 
-      i++;
+  size_t i = 0;
+  while (i < *num_states) {
+    if (!_d3plot_read_material_data(plot_file, i, quantity,
+                                    &data[i * *num_materials])) {
+      free(data);
+      *num_states = 0;
+      *num_materials = 0;
+
+      END_PROFILE_FUNC();
+      return NULL;
     }
+
+    i++;
   }
 
   END_PROFILE_FUNC();
-  return times;
+  return data;
+}
+
+d3plot_rigid_wall *d3plot_read_rigid_walls(d3plot_file *plot_file,
+                                           size_t state,
+                                           size_t *num_rigid_walls) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_rigid_walls = _d3plot_num_rigid_walls(plot_file, NULL);
+
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    *num_rigid_walls = 0;
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  if (*num_rigid_walls == 0) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  d3plot_rigid_wall *rigid_walls =
+      malloc(*num_rigid_walls * sizeof(d3plot_rigid_wall));
+  _d3plot_read_rigid_walls(plot_file, state, rigid_walls);
+
+  END_PROFILE_FUNC();
+  return rigid_walls;
+}
+
+d3plot_rigid_wall *d3plot_read_all_rigid_walls(d3plot_file *plot_file,
+                                               size_t *num_states,
+                                               size_t *num_rigid_walls) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_states = plot_file->num_states;
+  *num_rigid_walls = _d3plot_num_rigid_walls(plot_file, NULL);
+
+  if (*num_states == 0 || *num_rigid_walls == 0) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  d3plot_rigid_wall *rigid_walls =
+      malloc(*num_states * *num_rigid_walls * sizeof(d3plot_rigid_wall));
+
+  /* The GLOBAL section of every state is already in memory, so this does not
+   * need to read anything from the files*/
+  size_t i = 0;
+  while (i < *num_states) {
+    _d3plot_read_rigid_walls(plot_file, i, &rigid_walls[i * *num_rigid_walls]);
+
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return rigid_walls;
 }
 
 d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
                                        size_t *num_solids) {
+  return _d3plot_read_solids_state(plot_file, state, num_solids, NULL, 0);
+}
+
+d3plot_solid *_d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
+                                        size_t *num_solids,
+                                        const size_t *indices,
+                                        size_t num_indices) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  *num_solids = plot_file->control_data.nel8;
+  *num_solids =
+      indices ? num_indices : (size_t)plot_file->control_data.nel8;
   if (*num_solids == 0) {
     END_PROFILE_FUNC();
     return NULL;
@@ -1482,15 +1858,13 @@ d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
   d3plot_solid *solids = malloc(*num_solids * sizeof(d3plot_solid));
   if (plot_file->buffer.word_size == 4) {
     float *data =
-        malloc((plot_file->control_data.nel8 * plot_file->control_data.nv3d) *
-               sizeof(float));
+        malloc((*num_solids * plot_file->control_data.nv3d) * sizeof(float));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel8 * plot_file->control_data.nv3d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SOLID]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SOLID],
+        plot_file->control_data.nv3d, indices, *num_solids);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -1558,12 +1932,12 @@ d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nel8 * plot_file->control_data.nv3d) {
+    if (o != *num_solids * plot_file->control_data.nv3d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from solids state. o=%zu NEL8 "
           "(%llu) * NV3D (%llu) = %llu",
-          o, plot_file->control_data.nel8, plot_file->control_data.nv3d,
-          plot_file->control_data.nel8 * plot_file->control_data.nv3d);
+          o, (d3_word)*num_solids, plot_file->control_data.nv3d,
+          *num_solids * plot_file->control_data.nv3d);
       *num_solids = 0;
       free(solids);
 
@@ -1572,15 +1946,13 @@ d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
     }
   } else {
     double *data =
-        malloc((plot_file->control_data.nel8 * plot_file->control_data.nv3d) *
-               sizeof(double));
+        malloc((*num_solids * plot_file->control_data.nv3d) * sizeof(double));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel8 * plot_file->control_data.nv3d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SOLID]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SOLID],
+        plot_file->control_data.nv3d, indices, *num_solids);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -1629,12 +2001,12 @@ d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nel8 * plot_file->control_data.nv3d) {
+    if (o != *num_solids * plot_file->control_data.nv3d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from solids state. o=%zu NEL8 "
           "(%llu) * NV3D (%llu) = %llu",
-          o, plot_file->control_data.nel8, plot_file->control_data.nv3d,
-          plot_file->control_data.nel8 * plot_file->control_data.nv3d);
+          o, (d3_word)*num_solids, plot_file->control_data.nv3d,
+          *num_solids * plot_file->control_data.nv3d);
       *num_solids = 0;
       free(solids);
 
@@ -1650,10 +2022,18 @@ d3plot_solid *d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
 d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
                                                    size_t state,
                                                    size_t *num_thick_shells) {
+  return _d3plot_read_thick_shells_state(plot_file, state, num_thick_shells,
+                                         NULL, 0);
+}
+
+d3plot_thick_shell *
+_d3plot_read_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                size_t *num_thick_shells,
+                                const size_t *indices, size_t num_indices) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  *num_thick_shells = plot_file->control_data.nelt;
+  *num_thick_shells = indices ? num_indices : plot_file->control_data.nelt;
   if (*num_thick_shells == 0) {
     END_PROFILE_FUNC();
     return NULL;
@@ -1685,15 +2065,14 @@ d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
   d3plot_thick_shell *thick_shells =
       malloc(*num_thick_shells * sizeof(d3plot_thick_shell));
   if (plot_file->buffer.word_size == 4) {
-    float *data = malloc(plot_file->control_data.nelt *
-                         plot_file->control_data.nv3dt * sizeof(float));
+    float *data = malloc(*num_thick_shells * plot_file->control_data.nv3dt *
+                         sizeof(float));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nelt * plot_file->control_data.nv3dt,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_THICK_SHELL]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_THICK_SHELL],
+        plot_file->control_data.nv3dt, indices, *num_thick_shells);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -1799,12 +2178,12 @@ d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
     }
 
     free(data);
-    if (o != plot_file->control_data.nelt * plot_file->control_data.nv3dt) {
+    if (o != *num_thick_shells * plot_file->control_data.nv3dt) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from thick shells state. o=%zu "
           "NELT (%llu) * NV3DT (%llu) = %llu",
-          o, plot_file->control_data.nelt, plot_file->control_data.nv3dt,
-          plot_file->control_data.nelt * plot_file->control_data.nv3dt);
+          o, (d3_word)*num_thick_shells, plot_file->control_data.nv3dt,
+          *num_thick_shells * plot_file->control_data.nv3dt);
       *num_thick_shells = 0;
       free(thick_shells);
       free(history_variables);
@@ -1814,15 +2193,14 @@ d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
       return NULL;
     }
   } else {
-    double *data = malloc(plot_file->control_data.nelt *
-                          plot_file->control_data.nv3dt * sizeof(double));
+    double *data = malloc(*num_thick_shells * plot_file->control_data.nv3dt *
+                          sizeof(double));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nelt * plot_file->control_data.nv3dt,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_THICK_SHELL]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_THICK_SHELL],
+        plot_file->control_data.nv3dt, indices, *num_thick_shells);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -1913,12 +2291,12 @@ d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
     }
 
     free(data);
-    if (o != plot_file->control_data.nelt * plot_file->control_data.nv3dt) {
+    if (o != *num_thick_shells * plot_file->control_data.nv3dt) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from thick shells state. o=%zu "
           "NELT (%llu) * NV3DT (%llu) = %llu",
-          o, plot_file->control_data.nelt, plot_file->control_data.nv3dt,
-          plot_file->control_data.nelt * plot_file->control_data.nv3dt);
+          o, (d3_word)*num_thick_shells, plot_file->control_data.nv3dt,
+          *num_thick_shells * plot_file->control_data.nv3dt);
       *num_thick_shells = 0;
       free(thick_shells);
       free(history_variables);
@@ -1935,10 +2313,16 @@ d3plot_thick_shell *d3plot_read_thick_shells_state(d3plot_file *plot_file,
 
 d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
                                      size_t *num_beams) {
+  return _d3plot_read_beams_state(plot_file, state, num_beams, NULL, 0);
+}
+
+d3plot_beam *_d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
+                                      size_t *num_beams, const size_t *indices,
+                                      size_t num_indices) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  *num_beams = plot_file->control_data.nel2;
+  *num_beams = indices ? num_indices : plot_file->control_data.nel2;
   if (*num_beams == 0) {
     END_PROFILE_FUNC();
     return NULL;
@@ -1979,15 +2363,14 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
 
   d3plot_beam *beams = malloc(*num_beams * sizeof(d3plot_beam));
   if (plot_file->buffer.word_size == 4) {
-    float *data = malloc(plot_file->control_data.nel2 *
-                         plot_file->control_data.nv1d * sizeof(float));
+    float *data = malloc(*num_beams * plot_file->control_data.nv1d *
+                         sizeof(float));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel2 * plot_file->control_data.nv1d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_BEAM]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_BEAM],
+        plot_file->control_data.nv1d, indices, *num_beams);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -2099,14 +2482,14 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nv1d * plot_file->control_data.nel2) {
+    if (o != *num_beams * plot_file->control_data.nv1d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from beams state. o=%zu "
           "BEAMIP=%u NEIPB=%u NEL2 "
           "(%llu) * NV1D (%llu) = %llu",
           o, num_integration_points, num_history_variables,
-          plot_file->control_data.nel2, plot_file->control_data.nv1d,
-          plot_file->control_data.nel2 * plot_file->control_data.nv1d);
+          (d3_word)*num_beams, plot_file->control_data.nv1d,
+          *num_beams * plot_file->control_data.nv1d);
       *num_beams = 0;
       free(beams);
 
@@ -2114,15 +2497,14 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
       return NULL;
     }
   } else {
-    double *data = malloc(plot_file->control_data.nel2 *
-                          plot_file->control_data.nv1d * sizeof(double));
+    double *data = malloc(*num_beams * plot_file->control_data.nv1d *
+                          sizeof(double));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel2 * plot_file->control_data.nv1d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_BEAM]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_BEAM],
+        plot_file->control_data.nv1d, indices, *num_beams);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -2220,14 +2602,14 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nv1d * plot_file->control_data.nel2) {
+    if (o != *num_beams * plot_file->control_data.nv1d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from beams state. o=%zu "
           "BEAMIP=%llu NEIPB=%llu NEL2 "
           "(%llu) * NV1D (%llu) = %llu",
           o, plot_file->control_data.beamip, plot_file->control_data.neipb,
-          plot_file->control_data.nel2, plot_file->control_data.nv1d,
-          plot_file->control_data.nel2 * plot_file->control_data.nv1d);
+          (d3_word)*num_beams, plot_file->control_data.nv1d,
+          *num_beams * plot_file->control_data.nv1d);
       *num_beams = 0;
       free(beams);
 
@@ -2242,10 +2624,17 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
 
 d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
                                        size_t *num_shells) {
+  return _d3plot_read_shells_state(plot_file, state, num_shells, NULL, 0);
+}
+
+d3plot_shell *_d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
+                                        size_t *num_shells,
+                                        const size_t *indices,
+                                        size_t num_indices) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  *num_shells = plot_file->control_data.nel4;
+  *num_shells = indices ? num_indices : plot_file->control_data.nel4;
   if (*num_shells == 0) {
     END_PROFILE_FUNC();
     return NULL;
@@ -2277,15 +2666,14 @@ d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
 
   d3plot_shell *shells = malloc(*num_shells * sizeof(d3plot_shell));
   if (plot_file->buffer.word_size == 4) {
-    float *data = malloc(plot_file->control_data.nel4 *
-                         plot_file->control_data.nv2d * sizeof(float));
+    float *data = malloc(*num_shells * plot_file->control_data.nv2d *
+                         sizeof(float));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel4 * plot_file->control_data.nv2d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SHELL]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SHELL],
+        plot_file->control_data.nv2d, indices, *num_shells);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -2407,12 +2795,12 @@ d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nel4 * plot_file->control_data.nv2d) {
+    if (o != *num_shells * plot_file->control_data.nv2d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from shells state. o=%zu NEL4 "
           "(%llu) * NV2D (%llu) = %llu",
-          o, plot_file->control_data.nel4, plot_file->control_data.nv2d,
-          plot_file->control_data.nel4 * plot_file->control_data.nv2d);
+          o, (d3_word)*num_shells, plot_file->control_data.nv2d,
+          *num_shells * plot_file->control_data.nv2d);
       *num_shells = 0;
       free(shells);
       free(history_variables);
@@ -2422,15 +2810,14 @@ d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
       return NULL;
     }
   } else {
-    double *data = malloc(plot_file->control_data.nel4 *
-                          plot_file->control_data.nv2d * sizeof(double));
+    double *data = malloc(*num_shells * plot_file->control_data.nv2d *
+                          sizeof(double));
 
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, data,
-        plot_file->control_data.nel4 * plot_file->control_data.nv2d,
+    _d3plot_read_words_of_indices(
+        plot_file, data,
         plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SHELL]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+            plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_SHELL],
+        plot_file->control_data.nv2d, indices, *num_shells);
     if (plot_file->buffer.error_string) {
       ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                                 plot_file->buffer.error_string);
@@ -2545,12 +2932,12 @@ d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
     }
 
     free(data);
-    if (o != plot_file->control_data.nel4 * plot_file->control_data.nv2d) {
+    if (o != *num_shells * plot_file->control_data.nv2d) {
       ERROR_AND_NO_RETURN_F_PTR(
           "Sanity Check: Did not read all data from shells state. o=%zu NEL4 "
           "(%llu) * NV2D (%llu) = %llu",
-          o, plot_file->control_data.nel4, plot_file->control_data.nv2d,
-          plot_file->control_data.nel4 * plot_file->control_data.nv2d);
+          o, (d3_word)*num_shells, plot_file->control_data.nv2d,
+          *num_shells * plot_file->control_data.nv2d);
       *num_shells = 0;
       free(shells);
       free(history_variables);
@@ -2565,532 +2952,1109 @@ d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
   return shells;
 }
 
-d3plot_solid_con *d3plot_read_solid_elements(d3plot_file *plot_file,
-                                             size_t *num_solids) {
+d3plot_solid *d3plot_read_part_solids_state(d3plot_file *plot_file,
+                                            size_t state,
+                                            const d3plot_part *part,
+                                            size_t *num_solids) {
   BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
 
-  if (plot_file->control_data.nel8 <= 0) {
-    /* nel8 represents the number of extra nodes for ten node solids*/
+  size_t *indices = _d3plot_part_element_indices(
+      plot_file, part->solid_ids, part->solid_indices, part->num_solids,
+      D3PLOT_ID_TYPE_SOLID, plot_file->control_data.nel8);
+  if (!indices) {
     *num_solids = 0;
+
     END_PROFILE_FUNC();
     return NULL;
   }
 
-  *num_solids = plot_file->control_data.nel8;
-  d3plot_solid_con *solids = malloc(*num_solids * sizeof(d3plot_solid_con));
-  if (plot_file->buffer.word_size == 4) {
-    uint32_t *solids32 = malloc(*num_solids * 9 * sizeof(uint32_t));
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, solids32, 9 * *num_solids,
-        plot_file->data_pointers[D3PLT_PTR_EL8_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_solids = 0;
-      free(solids32);
-      free(solids);
+  d3plot_solid *data = _d3plot_read_solids_state(plot_file, state, num_solids,
+                                                 indices, part->num_solids);
+  if (indices != part->solid_indices) {
+    free(indices);
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  END_PROFILE_FUNC();
+  return data;
+}
 
-    size_t i = 0;
-    while (i < *num_solids) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      solids[i].node_indices[0] = solids32[i * 9 + 0] - 1;
-      solids[i].node_indices[1] = solids32[i * 9 + 1] - 1;
-      solids[i].node_indices[2] = solids32[i * 9 + 2] - 1;
-      solids[i].node_indices[3] = solids32[i * 9 + 3] - 1;
-      solids[i].node_indices[4] = solids32[i * 9 + 4] - 1;
-      solids[i].node_indices[5] = solids32[i * 9 + 5] - 1;
-      solids[i].node_indices[6] = solids32[i * 9 + 6] - 1;
-      solids[i].node_indices[7] = solids32[i * 9 + 7] - 1;
-      solids[i].material_index = solids32[i * 9 + 8] - 1;
+d3plot_thick_shell *
+d3plot_read_part_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                    const d3plot_part *part,
+                                    size_t *num_thick_shells) {
+  BEGIN_PROFILE_FUNC();
 
-      i++;
-    }
+  size_t *indices = _d3plot_part_element_indices(
+      plot_file, part->thick_shell_ids, part->thick_shell_indices,
+      part->num_thick_shells, D3PLOT_ID_TYPE_THICK_SHELL,
+      plot_file->control_data.nelt);
+  if (!indices) {
+    *num_thick_shells = 0;
 
-    free(solids32);
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, solids, 9 * *num_solids,
-        plot_file->data_pointers[D3PLT_PTR_EL8_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_solids = 0;
-      free(solids);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  d3plot_thick_shell *data = _d3plot_read_thick_shells_state(
+      plot_file, state, num_thick_shells, indices, part->num_thick_shells);
+  if (indices != part->thick_shell_indices) {
+    free(indices);
+  }
 
-    size_t i = 0;
-    while (i < *num_solids) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      solids[i].node_indices[0] -= 1;
-      solids[i].node_indices[1] -= 1;
-      solids[i].node_indices[2] -= 1;
-      solids[i].node_indices[3] -= 1;
-      solids[i].node_indices[4] -= 1;
-      solids[i].node_indices[5] -= 1;
-      solids[i].node_indices[6] -= 1;
-      solids[i].node_indices[7] -= 1;
-      solids[i].material_index -= 1;
+  END_PROFILE_FUNC();
+  return data;
+}
 
-      i++;
-    }
+d3plot_beam *d3plot_read_part_beams_state(d3plot_file *plot_file, size_t state,
+                                          const d3plot_part *part,
+                                          size_t *num_beams) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t *indices = _d3plot_part_element_indices(
+      plot_file, part->beam_ids, part->beam_indices, part->num_beams,
+      D3PLOT_ID_TYPE_BEAM, plot_file->control_data.nel2);
+  if (!indices) {
+    *num_beams = 0;
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  d3plot_beam *data = _d3plot_read_beams_state(plot_file, state, num_beams,
+                                               indices, part->num_beams);
+  if (indices != part->beam_indices) {
+    free(indices);
   }
 
   END_PROFILE_FUNC();
-  return solids;
+  return data;
 }
 
-d3plot_thick_shell_con *
-d3plot_read_thick_shell_elements(d3plot_file *plot_file,
-                                 size_t *num_thick_shells) {
+d3plot_shell *d3plot_read_part_shells_state(d3plot_file *plot_file,
+                                            size_t state,
+                                            const d3plot_part *part,
+                                            size_t *num_shells) {
   BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
 
-  if (plot_file->control_data.nelt == 0) {
-    *num_thick_shells = 0;
+  size_t *indices = _d3plot_part_element_indices(
+      plot_file, part->shell_ids, part->shell_indices, part->num_shells,
+      D3PLOT_ID_TYPE_SHELL, plot_file->control_data.nel4);
+  if (!indices) {
+    *num_shells = 0;
+
     END_PROFILE_FUNC();
     return NULL;
   }
 
-  *num_thick_shells = plot_file->control_data.nelt;
-  d3plot_thick_shell_con *thick_shells =
-      malloc(*num_thick_shells * sizeof(d3plot_thick_shell_con));
-  if (plot_file->buffer.word_size == 4) {
-    uint32_t *thick_shells32 = malloc(*num_thick_shells * 9 * sizeof(uint32_t));
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, thick_shells32, 9 * *num_thick_shells,
-        plot_file->data_pointers[D3PLT_PTR_ELT_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_thick_shells = 0;
-      free(thick_shells32);
-      free(thick_shells);
+  d3plot_shell *data = _d3plot_read_shells_state(plot_file, state, num_shells,
+                                                 indices, part->num_shells);
+  if (indices != part->shell_indices) {
+    free(indices);
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  END_PROFILE_FUNC();
+  return data;
+}
 
-    size_t i = 0;
-    while (i < *num_thick_shells) {
-      size_t j = 0;
-      while (j < 8) {
-        /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-        thick_shells[i].node_indices[j + 0] = thick_shells32[i * 9 + j + 0] - 1;
-        thick_shells[i].node_indices[j + 1] = thick_shells32[i * 9 + j + 1] - 1;
-        thick_shells[i].node_indices[j + 2] = thick_shells32[i * 9 + j + 2] - 1;
-        thick_shells[i].node_indices[j + 3] = thick_shells32[i * 9 + j + 3] - 1;
+double *d3plot_read_part_node_coordinates2(
+    d3plot_file *plot_file, size_t state, const d3plot_part *part,
+    size_t *num_nodes, const d3_word *part_node_indices,
+    size_t num_part_node_indices) {
+  BEGIN_PROFILE_FUNC();
 
-        j += 4;
-      }
-      thick_shells[i].material_index = thick_shells32[i * 9 + 8] - 1;
+  double *data = _d3plot_read_part_node_data(
+      plot_file, state, part, num_nodes, part_node_indices,
+      num_part_node_indices, D3PLT_PTR_STATE_NODE_COORDS);
 
-      i++;
-    }
+  END_PROFILE_FUNC();
+  return data;
+}
 
-    free(thick_shells32);
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, thick_shells, 9 * *num_thick_shells,
-        plot_file->data_pointers[D3PLT_PTR_ELT_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_thick_shells = 0;
-      free(thick_shells);
+double *d3plot_read_part_node_velocity2(
+    d3plot_file *plot_file, size_t state, const d3plot_part *part,
+    size_t *num_nodes, const d3_word *part_node_indices,
+    size_t num_part_node_indices) {
+  BEGIN_PROFILE_FUNC();
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  double *data = _d3plot_read_part_node_data(
+      plot_file, state, part, num_nodes, part_node_indices,
+      num_part_node_indices, D3PLT_PTR_STATE_NODE_VEL);
 
-    size_t i = 0;
-    while (i < *num_thick_shells) {
-      size_t j = 0;
-      while (j < 8) {
-        /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-        thick_shells[i].node_indices[j + 0] -= 1;
-        thick_shells[i].node_indices[j + 1] -= 1;
-        thick_shells[i].node_indices[j + 2] -= 1;
-        thick_shells[i].node_indices[j + 3] -= 1;
+  END_PROFILE_FUNC();
+  return data;
+}
 
-        j += 4;
-      }
-      thick_shells[i].material_index -= 1;
+double *d3plot_read_part_node_acceleration2(
+    d3plot_file *plot_file, size_t state, const d3plot_part *part,
+    size_t *num_nodes, const d3_word *part_node_indices,
+    size_t num_part_node_indices) {
+  BEGIN_PROFILE_FUNC();
 
-      i++;
-    }
-  }
+  double *data = _d3plot_read_part_node_data(
+      plot_file, state, part, num_nodes, part_node_indices,
+      num_part_node_indices, D3PLT_PTR_STATE_NODE_ACC);
 
   END_PROFILE_FUNC();
-  return thick_shells;
+  return data;
 }
 
-d3plot_beam_con *d3plot_read_beam_elements(d3plot_file *plot_file,
-                                           size_t *num_beams) {
+uint8_t *d3plot_read_deleted_nodes(d3plot_file *plot_file, size_t state,
+                                   size_t *num_nodes) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  if (plot_file->control_data.nel2 == 0) {
-    *num_beams = 0;
+  *num_nodes = 0;
+  if (plot_file->control_data.mdlopt != 1) {
+    ERROR_AND_NO_RETURN_F_PTR(
+        "The deletion flags of the nodes are not present MDLOPT=%d",
+        (int)plot_file->control_data.mdlopt);
+
     END_PROFILE_FUNC();
     return NULL;
   }
 
-  *num_beams = plot_file->control_data.nel2;
-  d3plot_beam_con *beams = malloc(*num_beams * sizeof(d3plot_beam_con));
-  if (plot_file->buffer.word_size == 4) {
-    uint32_t *beams32 = malloc(*num_beams * 6 * sizeof(uint32_t));
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, beams32, 6 * *num_beams,
-        plot_file->data_pointers[D3PLT_PTR_EL2_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_beams = 0;
-      free(beams32);
-      free(beams);
+  uint8_t *deleted = _d3plot_read_deletion_flags(
+      plot_file, state, 0, plot_file->control_data.numnp);
+  if (!plot_file->error_string) {
+    *num_nodes = plot_file->control_data.numnp;
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  END_PROFILE_FUNC();
+  return deleted;
+}
 
-    size_t i = 0;
-    while (i < *num_beams) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      beams[i].node_indices[0] = beams32[i * 6 + 0] - 1;
-      beams[i].node_indices[1] = beams32[i * 6 + 1] - 1;
-      beams[i].orientation_node_index = beams32[i * 6 + 2] - 1;
-      beams[i]._null[0] = beams32[i * 6 + 3];
-      beams[i]._null[1] = beams32[i * 6 + 4];
-      beams[i].material_index = beams32[i * 6 + 5] - 1;
+uint8_t *d3plot_read_deleted_elements(d3plot_file *plot_file, size_t state,
+                                      int id_type, size_t *num_elements) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
 
-      i++;
-    }
+  *num_elements = 0;
+  if (plot_file->control_data.mdlopt != 2) {
+    ERROR_AND_NO_RETURN_F_PTR(
+        "The deletion flags of the elements are not present MDLOPT=%d",
+        (int)plot_file->control_data.mdlopt);
 
-    free(beams32);
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, beams, 6 * *num_beams,
-        plot_file->data_pointers[D3PLT_PTR_EL2_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_beams = 0;
-      free(beams);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  /* The flags are ordered solids, thick shells, shells and beams*/
+  const size_t nel8 = plot_file->control_data.nel8;
+  const size_t nelt = plot_file->control_data.nelt;
+  const size_t nel4 = plot_file->control_data.nel4;
+  size_t offset, count;
+  switch (id_type) {
+  case D3PLOT_ID_TYPE_SOLID:
+    offset = 0;
+    count = nel8;
+    break;
+  case D3PLOT_ID_TYPE_THICK_SHELL:
+    offset = nel8;
+    count = nelt;
+    break;
+  case D3PLOT_ID_TYPE_SHELL:
+    offset = nel8 + nelt;
+    count = nel4;
+    break;
+  case D3PLOT_ID_TYPE_BEAM:
+    offset = nel8 + nelt + nel4;
+    count = plot_file->control_data.nel2;
+    break;
+  default:
+    ERROR_AND_NO_RETURN_F_PTR("Invalid element type: %d", id_type);
 
-    size_t i = 0;
-    while (i < *num_beams) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      beams[i].node_indices[0] -= 1;
-      beams[i].node_indices[1] -= 1;
-      beams[i].orientation_node_index -= 1;
-      beams[i].material_index -= 1;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      i++;
-    }
+  uint8_t *deleted = _d3plot_read_deletion_flags(plot_file, state, offset,
+                                                  count);
+  if (!plot_file->error_string) {
+    *num_elements = count;
   }
 
   END_PROFILE_FUNC();
-  return beams;
+  return deleted;
 }
 
-d3plot_shell_con *d3plot_read_shell_elements(d3plot_file *plot_file,
-                                             size_t *num_shells) {
+d3plot_solid *d3plot_read_alive_solids_state(d3plot_file *plot_file,
+                                             size_t state,
+                                             size_t *num_solids,
+                                             size_t **solid_indices) {
   BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
 
-  if (plot_file->control_data.nel4 == 0) {
-    *num_shells = 0;
+  if (solid_indices) {
+    *solid_indices = NULL;
+  }
+
+  size_t num_alive;
+  size_t *alive = _d3plot_read_alive_element_indices(
+      plot_file, state, D3PLOT_ID_TYPE_SOLID, plot_file->control_data.nel8,
+      &num_alive);
+  if (plot_file->error_string || num_alive == 0) {
+    *num_solids = 0;
+    free(alive);
+
     END_PROFILE_FUNC();
     return NULL;
   }
 
-  *num_shells = plot_file->control_data.nel4;
-  d3plot_shell_con *shells = malloc(*num_shells * sizeof(d3plot_shell_con));
-  if (plot_file->buffer.word_size == 4) {
-    uint32_t *shells32 = malloc(*num_shells * 5 * sizeof(uint32_t));
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, shells32, 5 * *num_shells,
-        plot_file->data_pointers[D3PLT_PTR_EL4_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_shells = 0;
-      free(shells32);
-      free(shells);
-
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  d3plot_solid *data =
+      _d3plot_read_solids_state(plot_file, state, num_solids, alive, num_alive);
+  if (solid_indices && !plot_file->error_string) {
+    *solid_indices = alive;
+  } else {
+    free(alive);
+  }
 
-    size_t i = 0;
-    while (i < *num_shells) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      shells[i].node_indices[0] = shells32[i * 5 + 0] - 1;
-      shells[i].node_indices[1] = shells32[i * 5 + 1] - 1;
-      shells[i].node_indices[2] = shells32[i * 5 + 2] - 1;
-      shells[i].node_indices[3] = shells32[i * 5 + 3] - 1;
-      shells[i].material_index = shells32[i * 5 + 4] - 1;
+  END_PROFILE_FUNC();
+  return data;
+}
 
-      i++;
-    }
+d3plot_thick_shell *
+d3plot_read_alive_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                     size_t *num_thick_shells,
+                                     size_t **thick_shell_indices) {
+  BEGIN_PROFILE_FUNC();
 
-    free(shells32);
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, shells, 5 * *num_shells,
-        plot_file->data_pointers[D3PLT_PTR_EL4_CONNECT]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_shells = 0;
-      free(shells);
+  if (thick_shell_indices) {
+    *thick_shell_indices = NULL;
+  }
 
-      END_PROFILE_FUNC();
-      return NULL;
-    }
+  size_t num_alive;
+  size_t *alive = _d3plot_read_alive_element_indices(
+      plot_file, state, D3PLOT_ID_TYPE_THICK_SHELL,
+      plot_file->control_data.nelt, &num_alive);
+  if (plot_file->error_string || num_alive == 0) {
+    *num_thick_shells = 0;
+    free(alive);
 
-    size_t i = 0;
-    while (i < *num_shells) {
-      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
-      shells[i].node_indices[0] -= 1;
-      shells[i].node_indices[1] -= 1;
-      shells[i].node_indices[2] -= 1;
-      shells[i].node_indices[3] -= 1;
-      shells[i].material_index -= 1;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-      i++;
-    }
+  d3plot_thick_shell *data = _d3plot_read_thick_shells_state(
+      plot_file, state, num_thick_shells, alive, num_alive);
+  if (thick_shell_indices && !plot_file->error_string) {
+    *thick_shell_indices = alive;
+  } else {
+    free(alive);
   }
 
   END_PROFILE_FUNC();
-  return shells;
+  return data;
 }
 
-char *d3plot_read_title(d3plot_file *plot_file) {
+d3plot_beam *d3plot_read_alive_beams_state(d3plot_file *plot_file, size_t state,
+                                           size_t *num_beams,
+                                           size_t **beam_indices) {
   BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
 
-  char *title = malloc(10 * plot_file->buffer.word_size + 1);
-  /* We never set D3PLT_PTR_TITLE, but because the Title is at position 0 we
-   * don't need to*/
-  d3_pointer d3_ptr = d3_buffer_read_words_at(
-      &plot_file->buffer, title, 10, plot_file->data_pointers[D3PLT_PTR_TITLE]);
-  d3_pointer_close(&plot_file->buffer, &d3_ptr);
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
-    free(title);
+  if (beam_indices) {
+    *beam_indices = NULL;
+  }
+
+  size_t num_alive;
+  size_t *alive = _d3plot_read_alive_element_indices(
+      plot_file, state, D3PLOT_ID_TYPE_BEAM, plot_file->control_data.nel2,
+      &num_alive);
+  if (plot_file->error_string || num_alive == 0) {
+    *num_beams = 0;
+    free(alive);
 
     END_PROFILE_FUNC();
     return NULL;
   }
-  title[10 * plot_file->buffer.word_size] = '\0';
+
+  d3plot_beam *data =
+      _d3plot_read_beams_state(plot_file, state, num_beams, alive, num_alive);
+  if (beam_indices && !plot_file->error_string) {
+    *beam_indices = alive;
+  } else {
+    free(alive);
+  }
 
   END_PROFILE_FUNC();
-  return title;
+  return data;
 }
 
-struct tm *d3plot_read_run_time(d3plot_file *plot_file) {
+d3plot_shell *d3plot_read_alive_shells_state(d3plot_file *plot_file,
+                                             size_t state,
+                                             size_t *num_shells,
+                                             size_t **shell_indices) {
   BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
 
-  d3_word run_time = 0;
-  d3_pointer d3_ptr =
-      d3_buffer_read_words_at(&plot_file->buffer, &run_time, 1,
-                              plot_file->data_pointers[D3PLT_PTR_RUN_TIME]);
-  d3_pointer_close(&plot_file->buffer, &d3_ptr);
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
+  if (shell_indices) {
+    *shell_indices = NULL;
+  }
+
+  size_t num_alive;
+  size_t *alive = _d3plot_read_alive_element_indices(
+      plot_file, state, D3PLOT_ID_TYPE_SHELL, plot_file->control_data.nel4,
+      &num_alive);
+  if (plot_file->error_string || num_alive == 0) {
+    *num_shells = 0;
+    free(alive);
+
+    END_PROFILE_FUNC();
     return NULL;
   }
-  const time_t epoch_time = run_time;
-  struct tm *time_value = localtime(&epoch_time);
+
+  d3plot_shell *data =
+      _d3plot_read_shells_state(plot_file, state, num_shells, alive, num_alive);
+  if (shell_indices && !plot_file->error_string) {
+    *shell_indices = alive;
+  } else {
+    free(alive);
+  }
 
   END_PROFILE_FUNC();
-  return time_value;
+  return data;
 }
 
-time_t d3plot_read_epoch_run_time(d3plot_file *plot_file) {
+d3plot_solid_con *d3plot_read_solid_elements(d3plot_file *plot_file,
+                                             size_t *num_solids) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  d3_word run_time = 0;
-  d3_pointer d3_ptr =
-      d3_buffer_read_words_at(&plot_file->buffer, &run_time, 1,
-                              plot_file->data_pointers[D3PLT_PTR_RUN_TIME]);
-  d3_pointer_close(&plot_file->buffer, &d3_ptr);
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
-    return (time_t)0;
+  if (plot_file->control_data.nel8 == 0) {
+    *num_solids = 0;
+    END_PROFILE_FUNC();
+    return NULL;
   }
-  const time_t epoch_time = run_time;
 
-  END_PROFILE_FUNC();
-  return epoch_time;
-}
+  *num_solids = plot_file->control_data.nel8;
+  d3plot_solid_con *solids = malloc(*num_solids * sizeof(d3plot_solid_con));
+  if (plot_file->buffer.word_size == 4 &&
+      !plot_file->control_data.element_connectivity_packed) {
+    uint32_t *solids32 = malloc(*num_solids * 9 * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, solids32, 9 * *num_solids,
+        plot_file->data_pointers[D3PLT_PTR_EL8_CONNECT]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_solids = 0;
+      free(solids32);
+      free(solids);
 
-#define ADD_ELEMENTS_TO_PART(id_func, el_func, el_type, part_num, part_ids,    \
-                             part_indices)                                     \
-  ids = id_func(plot_file, &num_elements);                                     \
-  if (plot_file->error_string) {                                               \
-    /* Just ignore those elements*/                                            \
-    D3PLOT_CLEAR_ERROR_STRING();                                               \
-  } else if (num_elements > 0) {                                               \
-    el_type *els = el_func(plot_file, &num_elements);                          \
-    if (plot_file->error_string) {                                             \
-      /* Just ignore those elements*/                                          \
-      D3PLOT_CLEAR_ERROR_STRING();                                             \
-    } else {                                                                   \
-      size_t i = 0;                                                            \
-      while (i < num_elements) {                                               \
-        /* For some reason materials in d3plot are parts -_('_')_-*/           \
-        if (els[i].material_index == part_index) {                             \
-          /* TODO: Insert these element ids sorted*/                           \
-          part.part_num++;                                                     \
-          part.part_ids =                                                      \
-              realloc(part.part_ids, part.part_num * sizeof(d3_word));         \
-          part.part_indices =                                                  \
-              realloc(part.part_indices, part.part_num * sizeof(size_t));      \
-          part.part_ids[part.part_num - 1] = ids[i];                           \
-          part.part_indices[part.part_num - 1] = i;                            \
-        }                                                                      \
-                                                                               \
-        i++;                                                                   \
-      }                                                                        \
-    }                                                                          \
-                                                                               \
-    free(ids);                                                                 \
-    free(els);                                                                 \
-  }
+      END_PROFILE_FUNC();
+      return NULL;
+    }
 
-d3plot_part d3plot_read_part(d3plot_file *plot_file, size_t part_index) {
-  BEGIN_PROFILE_FUNC();
-  D3PLOT_CLEAR_ERROR_STRING();
+    size_t i = 0;
+    while (i < *num_solids) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      solids[i].node_indices[0] = solids32[i * 9 + 0] - 1;
+      solids[i].node_indices[1] = solids32[i * 9 + 1] - 1;
+      solids[i].node_indices[2] = solids32[i * 9 + 2] - 1;
+      solids[i].node_indices[3] = solids32[i * 9 + 3] - 1;
+      solids[i].node_indices[4] = solids32[i * 9 + 4] - 1;
+      solids[i].node_indices[5] = solids32[i * 9 + 5] - 1;
+      solids[i].node_indices[6] = solids32[i * 9 + 6] - 1;
+      solids[i].node_indices[7] = solids32[i * 9 + 7] - 1;
+      solids[i].material_index = solids32[i * 9 + 8] - 1;
 
-  d3plot_part part;
-  part.solid_ids = NULL;
-  part.thick_shell_ids = NULL;
-  part.beam_ids = NULL;
-  part.shell_ids = NULL;
-  part.solid_indices = NULL;
-  part.thick_shell_indices = NULL;
-  part.beam_indices = NULL;
-  part.shell_indices = NULL;
-  part.num_solids = 0;
-  part.num_thick_shells = 0;
-  part.num_beams = 0;
-  part.num_shells = 0;
+      i++;
+    }
 
-  size_t num_elements;
-  d3_word *ids;
+    free(solids32);
+  } else {
+    if (plot_file->control_data.element_connectivity_packed) {
+      _d3plot_read_packed_connectivity(
+          plot_file, (d3_word *)solids,
+          plot_file->data_pointers[D3PLT_PTR_EL8_CONNECT], 9, *num_solids);
+    } else {
+      d3_pointer d3_ptr = d3_buffer_read_words_at(
+          &plot_file->buffer, solids, 9 * *num_solids,
+          plot_file->data_pointers[D3PLT_PTR_EL8_CONNECT]);
+      d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    }
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_solids = 0;
+      free(solids);
 
-  ADD_ELEMENTS_TO_PART(d3plot_read_solid_element_ids,
-                       d3plot_read_solid_elements, d3plot_solid_con, num_solids,
-                       solid_ids, solid_indices);
-  ADD_ELEMENTS_TO_PART(d3plot_read_thick_shell_element_ids,
-                       d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
-                       num_thick_shells, thick_shell_ids, thick_shell_indices);
-  ADD_ELEMENTS_TO_PART(d3plot_read_beam_element_ids, d3plot_read_beam_elements,
-                       d3plot_beam_con, num_beams, beam_ids, beam_indices);
-  ADD_ELEMENTS_TO_PART(d3plot_read_shell_element_ids,
-                       d3plot_read_shell_elements, d3plot_shell_con, num_shells,
-                       shell_ids, shell_indices);
+      END_PROFILE_FUNC();
+      return NULL;
+    }
 
-  /* If no elements have been found, this means that the part with the given
-   * index does not exist*/
-  if (part.num_solids == 0 && part.num_thick_shells == 0 &&
-      part.num_beams == 0 && part.num_shells == 0) {
-    ERROR_AND_NO_RETURN_F_PTR("The part with index %zu does not exist",
-                              part_index);
-    END_PROFILE_FUNC();
-    return part;
+    size_t i = 0;
+    while (i < *num_solids) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      solids[i].node_indices[0] -= 1;
+      solids[i].node_indices[1] -= 1;
+      solids[i].node_indices[2] -= 1;
+      solids[i].node_indices[3] -= 1;
+      solids[i].node_indices[4] -= 1;
+      solids[i].node_indices[5] -= 1;
+      solids[i].node_indices[6] -= 1;
+      solids[i].node_indices[7] -= 1;
+      solids[i].material_index -= 1;
+
+      i++;
+    }
   }
 
   END_PROFILE_FUNC();
-  return part;
+  return solids;
 }
 
-d3plot_part d3plot_read_part_by_id(d3plot_file *plot_file, d3_word part_id,
-                                   const d3_word *part_ids, size_t num_parts) {
+d3_word *d3plot_read_solid_extra_nodes(d3plot_file *plot_file,
+                                       size_t *num_solids) {
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  d3plot_part part = {0};
-
-  d3_word *p_part_ids = part_ids ? (d3_word *)part_ids
-                                 : d3plot_read_part_ids(plot_file, &num_parts);
-  if (plot_file->error_string) {
+  if (!plot_file->control_data.has_solid_extra_nodes ||
+      plot_file->control_data.nel8 == 0) {
+    *num_solids = 0;
     END_PROFILE_FUNC();
-    return part;
+    return NULL;
   }
 
-  if (num_parts == 0) {
-    ERROR_AND_NO_RETURN_PTR("This d3plot does not have any parts");
-    END_PROFILE_FUNC();
-    return part;
-  }
+  *num_solids = plot_file->control_data.nel8;
+  d3_word *extra_nodes = malloc(*num_solids * 2 * sizeof(d3_word));
+  if (plot_file->buffer.word_size == 4) {
+    uint32_t *extra_nodes32 = malloc(*num_solids * 2 * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, extra_nodes32, 2 * *num_solids,
+        plot_file->data_pointers[D3PLT_PTR_EL8_EXTRA_NODES]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_solids = 0;
+      free(extra_nodes32);
+      free(extra_nodes);
 
-  const size_t index =
-      d3_word_binary_search(p_part_ids, 0, num_parts - 1, part_id);
-  if (!part_ids) {
-    free(p_part_ids);
-  }
+      END_PROFILE_FUNC();
+      return NULL;
+    }
 
-  if (index == ~0) {
-    ERROR_AND_NO_RETURN_F_PTR("The part id %llu has not been found", part_id);
-    END_PROFILE_FUNC();
-    return part;
-  }
+    size_t i = 0;
+    while (i < *num_solids * 2) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      extra_nodes[i] = extra_nodes32[i] - 1;
 
-  part = d3plot_read_part(plot_file, index);
+      i++;
+    }
 
-  END_PROFILE_FUNC();
-  return part;
-}
+    free(extra_nodes32);
+  } else {
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, extra_nodes, 2 * *num_solids,
+        plot_file->data_pointers[D3PLT_PTR_EL8_EXTRA_NODES]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_solids = 0;
+      free(extra_nodes);
 
-size_t d3plot_index_for_id(d3_word id, const d3_word *ids, size_t num_ids) {
-  BEGIN_PROFILE_FUNC();
+      END_PROFILE_FUNC();
+      return NULL;
+    }
 
-  const size_t index = d3_word_binary_search(ids, 0, num_ids - 1, id);
+    size_t i = 0;
+    while (i < *num_solids * 2) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      extra_nodes[i] -= 1;
+
+      i++;
+    }
+  }
 
   END_PROFILE_FUNC();
-  return index;
+  return extra_nodes;
 }
 
-const char *_d3plot_get_file_type_name(d3_word file_type) {
-  switch (file_type) {
-  case D3_FILE_TYPE_D3PLOT:
-    return "d3plot";
-  case D3_FILE_TYPE_D3DRLF:
-    return "d3drlf";
-  case D3_FILE_TYPE_D3THDT:
-    return "d3thdt";
-  case D3_FILE_TYPE_INTFOR:
-    return "intfor";
-  case D3_FILE_TYPE_D3PART:
-    return "d3part";
+d3plot_thick_shell_con *
+d3plot_read_thick_shell_elements(d3plot_file *plot_file,
+                                 size_t *num_thick_shells) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (plot_file->control_data.nelt == 0) {
+    *num_thick_shells = 0;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  *num_thick_shells = plot_file->control_data.nelt;
+  d3plot_thick_shell_con *thick_shells =
+      malloc(*num_thick_shells * sizeof(d3plot_thick_shell_con));
+  if (plot_file->buffer.word_size == 4 &&
+      !plot_file->control_data.element_connectivity_packed) {
+    uint32_t *thick_shells32 = malloc(*num_thick_shells * 9 * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, thick_shells32, 9 * *num_thick_shells,
+        plot_file->data_pointers[D3PLT_PTR_ELT_CONNECT]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_thick_shells = 0;
+      free(thick_shells32);
+      free(thick_shells);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_thick_shells) {
+      size_t j = 0;
+      while (j < 8) {
+        /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+        thick_shells[i].node_indices[j + 0] = thick_shells32[i * 9 + j + 0] - 1;
+        thick_shells[i].node_indices[j + 1] = thick_shells32[i * 9 + j + 1] - 1;
+        thick_shells[i].node_indices[j + 2] = thick_shells32[i * 9 + j + 2] - 1;
+        thick_shells[i].node_indices[j + 3] = thick_shells32[i * 9 + j + 3] - 1;
+
+        j += 4;
+      }
+      thick_shells[i].material_index = thick_shells32[i * 9 + 8] - 1;
+
+      i++;
+    }
+
+    free(thick_shells32);
+  } else {
+    if (plot_file->control_data.element_connectivity_packed) {
+      _d3plot_read_packed_connectivity(
+          plot_file, (d3_word *)thick_shells,
+          plot_file->data_pointers[D3PLT_PTR_ELT_CONNECT], 9,
+          *num_thick_shells);
+    } else {
+      d3_pointer d3_ptr = d3_buffer_read_words_at(
+          &plot_file->buffer, thick_shells, 9 * *num_thick_shells,
+          plot_file->data_pointers[D3PLT_PTR_ELT_CONNECT]);
+      d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    }
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_thick_shells = 0;
+      free(thick_shells);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_thick_shells) {
+      size_t j = 0;
+      while (j < 8) {
+        /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+        thick_shells[i].node_indices[j + 0] -= 1;
+        thick_shells[i].node_indices[j + 1] -= 1;
+        thick_shells[i].node_indices[j + 2] -= 1;
+        thick_shells[i].node_indices[j + 3] -= 1;
+
+        j += 4;
+      }
+      thick_shells[i].material_index -= 1;
+
+      i++;
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return thick_shells;
+}
+
+d3plot_beam_con *d3plot_read_beam_elements(d3plot_file *plot_file,
+                                           size_t *num_beams) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (plot_file->control_data.nel2 == 0) {
+    *num_beams = 0;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  *num_beams = plot_file->control_data.nel2;
+  d3plot_beam_con *beams = malloc(*num_beams * sizeof(d3plot_beam_con));
+  if (plot_file->buffer.word_size == 4 &&
+      !plot_file->control_data.element_connectivity_packed) {
+    uint32_t *beams32 = malloc(*num_beams * 6 * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, beams32, 6 * *num_beams,
+        plot_file->data_pointers[D3PLT_PTR_EL2_CONNECT]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_beams = 0;
+      free(beams32);
+      free(beams);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_beams) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      beams[i].node_indices[0] = beams32[i * 6 + 0] - 1;
+      beams[i].node_indices[1] = beams32[i * 6 + 1] - 1;
+      beams[i].orientation_node_index = beams32[i * 6 + 2] - 1;
+      beams[i]._null[0] = beams32[i * 6 + 3];
+      beams[i]._null[1] = beams32[i * 6 + 4];
+      beams[i].material_index = beams32[i * 6 + 5] - 1;
+
+      i++;
+    }
+
+    free(beams32);
+  } else {
+    if (plot_file->control_data.element_connectivity_packed) {
+      _d3plot_read_packed_connectivity(
+          plot_file, (d3_word *)beams,
+          plot_file->data_pointers[D3PLT_PTR_EL2_CONNECT], 6, *num_beams);
+    } else {
+      d3_pointer d3_ptr = d3_buffer_read_words_at(
+          &plot_file->buffer, beams, 6 * *num_beams,
+          plot_file->data_pointers[D3PLT_PTR_EL2_CONNECT]);
+      d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    }
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_beams = 0;
+      free(beams);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_beams) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      beams[i].node_indices[0] -= 1;
+      beams[i].node_indices[1] -= 1;
+      beams[i].orientation_node_index -= 1;
+      beams[i].material_index -= 1;
+
+      i++;
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return beams;
+}
+
+d3plot_shell_con *d3plot_read_shell_elements(d3plot_file *plot_file,
+                                             size_t *num_shells) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (plot_file->control_data.nel4 == 0) {
+    *num_shells = 0;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  *num_shells = plot_file->control_data.nel4;
+  d3plot_shell_con *shells = malloc(*num_shells * sizeof(d3plot_shell_con));
+  if (plot_file->buffer.word_size == 4 &&
+      !plot_file->control_data.element_connectivity_packed) {
+    uint32_t *shells32 = malloc(*num_shells * 5 * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, shells32, 5 * *num_shells,
+        plot_file->data_pointers[D3PLT_PTR_EL4_CONNECT]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_shells = 0;
+      free(shells32);
+      free(shells);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_shells) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      shells[i].node_indices[0] = shells32[i * 5 + 0] - 1;
+      shells[i].node_indices[1] = shells32[i * 5 + 1] - 1;
+      shells[i].node_indices[2] = shells32[i * 5 + 2] - 1;
+      shells[i].node_indices[3] = shells32[i * 5 + 3] - 1;
+      shells[i].material_index = shells32[i * 5 + 4] - 1;
+
+      i++;
+    }
+
+    free(shells32);
+  } else {
+    if (plot_file->control_data.element_connectivity_packed) {
+      _d3plot_read_packed_connectivity(
+          plot_file, (d3_word *)shells,
+          plot_file->data_pointers[D3PLT_PTR_EL4_CONNECT], 5, *num_shells);
+    } else {
+      d3_pointer d3_ptr = d3_buffer_read_words_at(
+          &plot_file->buffer, shells, 5 * *num_shells,
+          plot_file->data_pointers[D3PLT_PTR_EL4_CONNECT]);
+      d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    }
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_shells = 0;
+      free(shells);
+
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_shells) {
+      /* Subtract 1 because Fortran starts by 1 and C starts by 0*/
+      shells[i].node_indices[0] -= 1;
+      shells[i].node_indices[1] -= 1;
+      shells[i].node_indices[2] -= 1;
+      shells[i].node_indices[3] -= 1;
+      shells[i].material_index -= 1;
+
+      i++;
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return shells;
+}
+
+char *d3plot_read_title(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  char *title = malloc(10 * plot_file->buffer.word_size + 1);
+  /* We never set D3PLT_PTR_TITLE, but because the Title is at position 0 we
+   * don't need to*/
+  d3_pointer d3_ptr = d3_buffer_read_words_at(
+      &plot_file->buffer, title, 10, plot_file->data_pointers[D3PLT_PTR_TITLE]);
+  d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    free(title);
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+  title[10 * plot_file->buffer.word_size] = '\0';
+
+  END_PROFILE_FUNC();
+  return title;
+}
+
+struct tm *d3plot_read_run_time(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3_word run_time = 0;
+  d3_pointer d3_ptr =
+      d3_buffer_read_words_at(&plot_file->buffer, &run_time, 1,
+                              plot_file->data_pointers[D3PLT_PTR_RUN_TIME]);
+  d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    return NULL;
+  }
+  const time_t epoch_time = run_time;
+  struct tm *time_value = localtime(&epoch_time);
+
+  END_PROFILE_FUNC();
+  return time_value;
+}
+
+time_t d3plot_read_epoch_run_time(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3_word run_time = 0;
+  d3_pointer d3_ptr =
+      d3_buffer_read_words_at(&plot_file->buffer, &run_time, 1,
+                              plot_file->data_pointers[D3PLT_PTR_RUN_TIME]);
+  d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    return (time_t)0;
+  }
+  const time_t epoch_time = run_time;
+
+  END_PROFILE_FUNC();
+  return epoch_time;
+}
+
+#define ADD_ELEMENTS_TO_PART(id_func, el_func, el_type, part_num, part_ids,    \
+                             part_indices)                                     \
+  ids = id_func(plot_file, &num_elements);                                     \
+  if (plot_file->error_string) {                                               \
+    /* Just ignore those elements*/                                            \
+    D3PLOT_CLEAR_ERROR_STRING();                                               \
+  } else if (num_elements > 0) {                                               \
+    el_type *els = el_func(plot_file, &num_elements);                          \
+    if (plot_file->error_string) {                                             \
+      /* Just ignore those elements*/                                          \
+      D3PLOT_CLEAR_ERROR_STRING();                                             \
+    } else {                                                                   \
+      size_t i = 0;                                                            \
+      while (i < num_elements) {                                               \
+        /* For some reason materials in d3plot are parts -_('_')_-*/           \
+        if (els[i].material_index == part_index) {                             \
+          /* TODO: Insert these element ids sorted*/                           \
+          part.part_num++;                                                     \
+          part.part_ids =                                                      \
+              realloc(part.part_ids, part.part_num * sizeof(d3_word));         \
+          part.part_indices =                                                  \
+              realloc(part.part_indices, part.part_num * sizeof(size_t));      \
+          part.part_ids[part.part_num - 1] = ids[i];                           \
+          part.part_indices[part.part_num - 1] = i;                            \
+        }                                                                      \
+                                                                               \
+        i++;                                                                   \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    free(ids);                                                                 \
+    free(els);                                                                 \
+  }
+
+d3plot_part d3plot_read_part(d3plot_file *plot_file, size_t part_index) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_part part;
+  part.solid_ids = NULL;
+  part.thick_shell_ids = NULL;
+  part.beam_ids = NULL;
+  part.shell_ids = NULL;
+  part.solid_indices = NULL;
+  part.thick_shell_indices = NULL;
+  part.beam_indices = NULL;
+  part.shell_indices = NULL;
+  part.num_solids = 0;
+  part.num_thick_shells = 0;
+  part.num_beams = 0;
+  part.num_shells = 0;
+
+  size_t num_elements;
+  d3_word *ids;
+
+  ADD_ELEMENTS_TO_PART(d3plot_read_solid_element_ids,
+                       d3plot_read_solid_elements, d3plot_solid_con, num_solids,
+                       solid_ids, solid_indices);
+  ADD_ELEMENTS_TO_PART(d3plot_read_thick_shell_element_ids,
+                       d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
+                       num_thick_shells, thick_shell_ids, thick_shell_indices);
+  ADD_ELEMENTS_TO_PART(d3plot_read_beam_element_ids, d3plot_read_beam_elements,
+                       d3plot_beam_con, num_beams, beam_ids, beam_indices);
+  ADD_ELEMENTS_TO_PART(d3plot_read_shell_element_ids,
+                       d3plot_read_shell_elements, d3plot_shell_con, num_shells,
+                       shell_ids, shell_indices);
+
+  /* If no elements have been found, this means that the part with the given
+   * index does not exist*/
+  if (part.num_solids == 0 && part.num_thick_shells == 0 &&
+      part.num_beams == 0 && part.num_shells == 0) {
+    ERROR_AND_NO_RETURN_F_PTR("The part with index %zu does not exist",
+                              part_index);
+    END_PROFILE_FUNC();
+    return part;
+  }
+
+  END_PROFILE_FUNC();
+  return part;
+}
+
+d3plot_part d3plot_read_part_by_id(d3plot_file *plot_file, d3_word part_id,
+                                   const d3_word *part_ids, size_t num_parts) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_part part = {0};
+
+  size_t index;
+  if (part_ids) {
+    if (num_parts == 0) {
+      ERROR_AND_NO_RETURN_PTR("This d3plot does not have any parts");
+      END_PROFILE_FUNC();
+      return part;
+    }
+
+    index = d3_word_binary_search(part_ids, 0, num_parts - 1, part_id);
+  } else {
+    /* Use the index of plot_file so that the part ids only need to be read
+     * once*/
+    index = d3plot_id_to_index(plot_file, D3PLOT_ID_TYPE_PART, part_id);
+    if (plot_file->error_string) {
+      END_PROFILE_FUNC();
+      return part;
+    }
+  }
+
+  if (index == ~0) {
+    ERROR_AND_NO_RETURN_F_PTR("The part id %llu has not been found", part_id);
+    END_PROFILE_FUNC();
+    return part;
+  }
+
+  part = d3plot_read_part(plot_file, index);
+
+  END_PROFILE_FUNC();
+  return part;
+}
+
+#define BIN_ELEMENTS_BY_PART(id_func, el_func, el_type, part_ids,              \
+                             part_indices, part_offsets)                       \
+  parts.part_offsets = calloc(parts.num_parts + 1, sizeof(size_t));            \
+  ids = id_func(plot_file, &num_elements);                                     \
+  if (plot_file->error_string) {                                               \
+    /* Just ignore those elements*/                                            \
+    D3PLOT_CLEAR_ERROR_STRING();                                               \
+  } else if (num_elements > 0) {                                               \
+    el_type *els = el_func(plot_file, &num_elements);                          \
+    if (plot_file->error_string) {                                             \
+      /* Just ignore those elements*/                                          \
+      D3PLOT_CLEAR_ERROR_STRING();                                             \
+    } else {                                                                   \
+      /* Count the elements of every part*/                                    \
+      size_t i = 0;                                                            \
+      while (i < num_elements) {                                               \
+        if (els[i].material_index < parts.num_parts) {                         \
+          parts.part_offsets[els[i].material_index + 1]++;                     \
+        }                                                                      \
+        i++;                                                                   \
+      }                                                                        \
+                                                                               \
+      i = 0;                                                                   \
+      while (i < parts.num_parts) {                                            \
+        parts.part_offsets[i + 1] += parts.part_offsets[i];                    \
+        i++;                                                                   \
+      }                                                                        \
+                                                                               \
+      const size_t num_part_elements = parts.part_offsets[parts.num_parts];    \
+      parts.part_ids = malloc(num_part_elements * sizeof(d3_word));            \
+      parts.part_indices = malloc(num_part_elements * sizeof(size_t));         \
+                                                                               \
+      /* Put every element into the slot of its part. This keeps the elements \
+       * of each part in ascending order*/                                     \
+      memcpy(next_index, parts.part_offsets,                                   \
+             parts.num_parts * sizeof(size_t));                                \
+      i = 0;                                                                   \
+      while (i < num_elements) {                                               \
+        if (els[i].material_index < parts.num_parts) {                         \
+          const size_t j = next_index[els[i].material_index]++;                \
+          parts.part_ids[j] = ids[i];                                          \
+          parts.part_indices[j] = i;                                           \
+        }                                                                      \
+        i++;                                                                   \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    free(ids);                                                                 \
+    free(els);                                                                 \
+  }
+
+d3plot_parts d3plot_read_all_parts(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_parts parts = {0};
+  parts.num_parts = plot_file->control_data.nmmat;
+
+  size_t num_elements;
+  d3_word *ids;
+  size_t *next_index = malloc(parts.num_parts * sizeof(size_t));
+
+  BIN_ELEMENTS_BY_PART(d3plot_read_solid_element_ids,
+                       d3plot_read_solid_elements, d3plot_solid_con, solid_ids,
+                       solid_indices, solid_offsets);
+  BIN_ELEMENTS_BY_PART(d3plot_read_thick_shell_element_ids,
+                       d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
+                       thick_shell_ids, thick_shell_indices,
+                       thick_shell_offsets);
+  BIN_ELEMENTS_BY_PART(d3plot_read_beam_element_ids, d3plot_read_beam_elements,
+                       d3plot_beam_con, beam_ids, beam_indices, beam_offsets);
+  BIN_ELEMENTS_BY_PART(d3plot_read_shell_element_ids,
+                       d3plot_read_shell_elements, d3plot_shell_con, shell_ids,
+                       shell_indices, shell_offsets);
+
+  free(next_index);
+
+  END_PROFILE_FUNC();
+  return parts;
+}
+
+d3plot_part d3plot_parts_get_part(const d3plot_parts *parts,
+                                  size_t part_index) {
+  d3plot_part part = {0};
+  if (part_index >= parts->num_parts) {
+    return part;
+  }
+
+  part.num_solids = parts->solid_offsets[part_index + 1] -
+                    parts->solid_offsets[part_index];
+  part.num_thick_shells = parts->thick_shell_offsets[part_index + 1] -
+                          parts->thick_shell_offsets[part_index];
+  part.num_beams =
+      parts->beam_offsets[part_index + 1] - parts->beam_offsets[part_index];
+  part.num_shells =
+      parts->shell_offsets[part_index + 1] - parts->shell_offsets[part_index];
+
+  if (part.num_solids != 0) {
+    part.solid_ids = &parts->solid_ids[parts->solid_offsets[part_index]];
+    part.solid_indices =
+        &parts->solid_indices[parts->solid_offsets[part_index]];
+  }
+  if (part.num_thick_shells != 0) {
+    part.thick_shell_ids =
+        &parts->thick_shell_ids[parts->thick_shell_offsets[part_index]];
+    part.thick_shell_indices =
+        &parts->thick_shell_indices[parts->thick_shell_offsets[part_index]];
+  }
+  if (part.num_beams != 0) {
+    part.beam_ids = &parts->beam_ids[parts->beam_offsets[part_index]];
+    part.beam_indices = &parts->beam_indices[parts->beam_offsets[part_index]];
+  }
+  if (part.num_shells != 0) {
+    part.shell_ids = &parts->shell_ids[parts->shell_offsets[part_index]];
+    part.shell_indices =
+        &parts->shell_indices[parts->shell_offsets[part_index]];
+  }
+
+  return part;
+}
+
+size_t d3plot_index_for_id(d3_word id, const d3_word *ids, size_t num_ids) {
+  BEGIN_PROFILE_FUNC();
+
+  const size_t index = d3_word_binary_search(ids, 0, num_ids - 1, id);
+
+  END_PROFILE_FUNC();
+  return index;
+}
+
+const char *_d3plot_get_file_type_name(d3_word file_type) {
+  switch (file_type) {
+  case D3_FILE_TYPE_D3PLOT:
+    return "d3plot";
+  case D3_FILE_TYPE_D3DRLF:
+    return "d3drlf";
+  case D3_FILE_TYPE_D3THDT:
+    return "d3thdt";
+  case D3_FILE_TYPE_INTFOR:
+    return "intfor";
+  case D3_FILE_TYPE_D3PART:
+    return "d3part";
   case D3_FILE_TYPE_BLSTFOR:
     return "blstfor";
   case D3_FILE_TYPE_D3CPM:
@@ -3120,189 +4084,757 @@ const char *_d3plot_get_file_type_name(d3_word file_type) {
   };
 }
 
-int _get_nth_digit(d3_word value, int n) {
+int _get_nth_digit(d3_word value, int n) {
+  BEGIN_PROFILE_FUNC();
+
+  int i = 0;
+  while (1) {
+    d3_word last_value = value;
+    value /= 10;
+    if (i == n) {
+      value = last_value - value * 10;
+
+      END_PROFILE_FUNC();
+      return value;
+    }
+
+    i++;
+  }
+}
+
+double *_d3plot_read_node_data(d3plot_file *plot_file, size_t state,
+                               size_t *num_nodes, size_t data_type) {
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (plot_file->data_pointers[data_type] == 0) {
+    ERROR_AND_NO_RETURN_F_PTR(
+        "This node data is not present IU=%llu IV=%llu IA=%llu",
+        plot_file->control_data.iu, plot_file->control_data.iv,
+        plot_file->control_data.ia);
+
+    return NULL;
+  }
+
+  if (plot_file->buffer.word_size == 4) {
+    float *coords32 =
+        _d3plot_read_node_data_32(plot_file, state, num_nodes, data_type);
+    if (!coords32) {
+      return NULL;
+    }
+
+    double *coords = malloc(*num_nodes * 3 * sizeof(double));
+    size_t i = 0;
+    while (i < *num_nodes) {
+      coords[i * 3 + 0] = coords32[i * 3 + 0];
+      coords[i * 3 + 1] = coords32[i * 3 + 1];
+      coords[i * 3 + 2] = coords32[i * 3 + 2];
+
+      i++;
+    }
+
+    free(coords32);
+
+    return coords;
+  }
+
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    return NULL;
+  }
+
+  *num_nodes = plot_file->control_data.numnp;
+  double *coords = malloc(*num_nodes * 3 * sizeof(double));
+
+  d3_pointer d3_ptr = d3_buffer_read_words_at(
+      &plot_file->buffer, coords, *num_nodes * 3,
+      plot_file->data_pointers[D3PLT_PTR_STATES + state] +
+          plot_file->data_pointers[data_type]);
+  d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    *num_nodes = 0;
+    free(coords);
+    return NULL;
+  }
+
+  return coords;
+}
+
+float *_d3plot_read_node_data_32(d3plot_file *plot_file, size_t state,
+                                 size_t *num_nodes, size_t data_type) {
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (plot_file->data_pointers[data_type] == 0) {
+    ERROR_AND_NO_RETURN_F_PTR(
+        "This node data is not present IU=%llu IV=%llu IA=%llu",
+        plot_file->control_data.iu, plot_file->control_data.iv,
+        plot_file->control_data.ia);
+
+    return NULL;
+  }
+
+  if (plot_file->buffer.word_size == 8) {
+    double *coords64 =
+        _d3plot_read_node_data(plot_file, state, num_nodes, data_type);
+    if (!coords64) {
+      return NULL;
+    }
+
+    float *coords = malloc(*num_nodes * 3 * sizeof(float));
+    size_t i = 0;
+    while (i < *num_nodes) {
+      coords[i * 3 + 0] = coords64[i * 3 + 0];
+      coords[i * 3 + 1] = coords64[i * 3 + 1];
+      coords[i * 3 + 2] = coords64[i * 3 + 2];
+
+      i++;
+    }
+
+    free(coords64);
+
+    return coords;
+  }
+
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    return NULL;
+  }
+
+  *num_nodes = plot_file->control_data.numnp;
+  float *coords = malloc(*num_nodes * 3 * sizeof(float));
+
+  d3_pointer d3_ptr = d3_buffer_read_words_at(
+      &plot_file->buffer, coords, *num_nodes * 3,
+      plot_file->data_pointers[D3PLT_PTR_STATES + state] +
+          plot_file->data_pointers[data_type]);
+  d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    *num_nodes = 0;
+    free(coords);
+    return NULL;
+  }
+
+  return coords;
+}
+
+int _d3plot_read_initial_node_coords(d3plot_file *plot_file) {
+  /* The displacements of multiple threads may need the initial coordinates at
+   * the same time*/
+#ifndef NO_THREAD_SAFETY
+  sync_lock(&plot_file->initial_node_coords_mutex);
+#endif
+  const int read = plot_file->initial_node_coords != NULL ||
+                   _d3plot_load_initial_node_coords(plot_file);
+#ifndef NO_THREAD_SAFETY
+  sync_unlock(&plot_file->initial_node_coords_mutex);
+#endif
+  return read;
+}
+
+int _d3plot_load_initial_node_coords(d3plot_file *plot_file) {
+  const size_t num_nodes = plot_file->control_data.numnp;
+  plot_file->initial_node_coords = malloc(num_nodes * 3 * sizeof(double));
+
+  if (plot_file->buffer.word_size == 8) {
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, plot_file->initial_node_coords, num_nodes * 3,
+        plot_file->data_pointers[D3PLT_PTR_NODE_COORDS]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+
+    if (plot_file->buffer.error_string) {
+      free(plot_file->initial_node_coords);
+      plot_file->initial_node_coords = NULL;
+
+      ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
+                                plot_file->buffer.error_string);
+      return 0;
+    }
+  } else {
+    if (!plot_file->initial_node_coords_32) {
+      plot_file->initial_node_coords_32 =
+          malloc(num_nodes * 3 * sizeof(float));
+
+      d3_pointer d3_ptr = d3_buffer_read_words_at(
+          &plot_file->buffer, plot_file->initial_node_coords_32,
+          num_nodes * 3, plot_file->data_pointers[D3PLT_PTR_NODE_COORDS]);
+      d3_pointer_close(&plot_file->buffer, &d3_ptr);
+
+      if (plot_file->buffer.error_string) {
+        free(plot_file->initial_node_coords);
+        free(plot_file->initial_node_coords_32);
+        plot_file->initial_node_coords = NULL;
+        plot_file->initial_node_coords_32 = NULL;
+
+        ERROR_AND_NO_RETURN_F_PTR("failed to read initial node coords: %s",
+                                  plot_file->buffer.error_string);
+        return 0;
+      }
+    }
+
+    size_t i = 0;
+    while (i < num_nodes * 3) {
+      plot_file->initial_node_coords[i] = plot_file->initial_node_coords_32[i];
+
+      i++;
+    }
+  }
+
+  return 1;
+}
+
+double *_d3plot_read_state_words(d3plot_file *plot_file, size_t data_type,
+                                 size_t words_per_entry, size_t num_entries,
+                                 size_t first_state, size_t num_states,
+                                 const size_t *indices, size_t num_indices,
+                                 size_t *num_read) {
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_read = 0;
+
+  if (words_per_entry == 0 || plot_file->data_pointers[data_type] == 0) {
+    ERROR_AND_NO_RETURN_F_PTR("This state data is not present IT=%llu "
+                              "NT3D=%llu",
+                              plot_file->control_data.it,
+                              plot_file->control_data.nt3d);
+    return NULL;
+  }
+
+  if (first_state + num_states > plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states",
+                              first_state + num_states - 1);
+    return NULL;
+  }
+
+  if (indices) {
+    size_t i = 0;
+    while (i < num_indices) {
+      if (indices[i] >= num_entries) {
+        ERROR_AND_NO_RETURN_F_PTR("The index %zu is out of bounds",
+                                  indices[i]);
+        return NULL;
+      }
+      i++;
+    }
+  } else {
+    num_indices = num_entries;
+  }
+
+  const size_t words_per_state = num_indices * words_per_entry;
+  double *data = malloc(num_states * words_per_state * sizeof(double));
+
+  size_t t = 0;
+  while (t < num_states) {
+    /* Consecutive indices are read at once*/
+    if (!_d3plot_read_doubles_of_indices(
+            plot_file, &data[t * words_per_state],
+            plot_file->data_pointers[D3PLT_PTR_STATES + first_state + t] +
+                plot_file->data_pointers[data_type],
+            words_per_entry, indices, num_indices)) {
+      free(data);
+      return NULL;
+    }
+
+    t++;
+  }
+
+  *num_read = num_indices;
+  return data;
+}
+
+d3_word *_d3plot_read_ids(d3plot_file *plot_file, size_t *num_ids,
+                          size_t data_type, size_t num_ids_value) {
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  *num_ids = num_ids_value;
+  if (num_ids_value == 0) {
+    return NULL;
+  }
+
+  d3_word *ids = malloc(*num_ids * sizeof(d3_word));
+  if (plot_file->buffer.word_size == 4) {
+    uint32_t *ids32 = malloc(*num_ids * plot_file->buffer.word_size);
+    d3_pointer d3_ptr =
+        d3_buffer_read_words_at(&plot_file->buffer, ids32, *num_ids,
+                                plot_file->data_pointers[data_type]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_ids = 0;
+      free(ids32);
+      free(ids);
+      return NULL;
+    }
+
+    size_t i = 0;
+    while (i < *num_ids) {
+      ids[i] = ids32[i];
+
+      i++;
+    }
+
+    free(ids32);
+  } else {
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, ids, *num_ids, plot_file->data_pointers[data_type]);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                                plot_file->buffer.error_string);
+      *num_ids = 0;
+      free(ids);
+      return NULL;
+    }
+  }
+
+  return ids;
+}
+
+void _d3plot_read_words_of_indices(d3plot_file *plot_file, void *words,
+                                   size_t word_pos, size_t words_per_entry,
+                                   const size_t *indices, size_t num_indices) {
+  BEGIN_PROFILE_FUNC();
+
+  if (!indices) {
+    d3_pointer d3_ptr =
+        d3_buffer_read_words_at(&plot_file->buffer, words,
+                                num_indices * words_per_entry, word_pos);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+
+    END_PROFILE_FUNC();
+    return;
+  }
+
+  /* Read runs of consecutive indices with one call each*/
+  uint8_t *dst = words;
+  size_t i = 0;
+  while (i < num_indices) {
+    const size_t start = indices[i];
+    size_t run = 1;
+    while (i + run < num_indices && indices[i + run] == start + run) {
+      run++;
+    }
+
+    d3_pointer d3_ptr = d3_buffer_read_words_at(
+        &plot_file->buffer, dst, run * words_per_entry,
+        word_pos + start * words_per_entry);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+    if (plot_file->buffer.error_string) {
+      break;
+    }
+
+    dst += run * words_per_entry * plot_file->buffer.word_size;
+    i += run;
+  }
+
+  END_PROFILE_FUNC();
+}
+
+void _d3plot_read_packed_connectivity(d3plot_file *plot_file, d3_word *values,
+                                      size_t word_pos, size_t values_per_entry,
+                                      size_t num_entries) {
   BEGIN_PROFILE_FUNC();
 
-  int i = 0;
-  while (1) {
-    d3_word last_value = value;
-    value /= 10;
-    if (i == n) {
-      value = last_value - value * 10;
+  const size_t words_per_entry = (values_per_entry + 1) / 2;
+  const size_t num_words = words_per_entry * num_entries;
+  /* Every word holds two values, the first one in its lower half*/
+  const size_t half_bits = plot_file->buffer.word_size * 4;
+  const d3_word mask = ((d3_word)1 << half_bits) - 1;
+
+  d3_word *packed = malloc(num_words * sizeof(d3_word));
+  if (plot_file->buffer.word_size == 4) {
+    uint32_t *packed32 = malloc(num_words * sizeof(uint32_t));
+    d3_pointer d3_ptr = d3_buffer_read_words_at(&plot_file->buffer, packed32,
+                                                num_words, word_pos);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+
+    size_t i = 0;
+    while (i < num_words) {
+      packed[i] = packed32[i];
+      i++;
+    }
+    free(packed32);
+  } else {
+    d3_pointer d3_ptr = d3_buffer_read_words_at(&plot_file->buffer, packed,
+                                                num_words, word_pos);
+    d3_pointer_close(&plot_file->buffer, &d3_ptr);
+  }
+
+  if (plot_file->buffer.error_string) {
+    free(packed);
+
+    END_PROFILE_FUNC();
+    return;
+  }
 
-      END_PROFILE_FUNC();
-      return value;
+  size_t i = 0;
+  while (i < num_entries) {
+    const d3_word *entry = &packed[i * words_per_entry];
+    size_t j = 0;
+    while (j < values_per_entry) {
+      values[i * values_per_entry + j] =
+          (entry[j / 2] >> (half_bits * (j % 2))) & mask;
+      j++;
     }
 
     i++;
   }
+
+  free(packed);
+
+  END_PROFILE_FUNC();
 }
 
-double *_d3plot_read_node_data(d3plot_file *plot_file, size_t state,
-                               size_t *num_nodes, size_t data_type) {
+size_t *_d3plot_part_element_indices(d3plot_file *plot_file,
+                                     const d3_word *ids, size_t *indices,
+                                     size_t num_elements, int id_type,
+                                     d3_word max_elements) {
   D3PLOT_CLEAR_ERROR_STRING();
 
-  if (plot_file->data_pointers[data_type] == 0) {
-    ERROR_AND_NO_RETURN_F_PTR(
-        "This node data is not present IU=%llu IV=%llu IA=%llu",
-        plot_file->control_data.iu, plot_file->control_data.iv,
-        plot_file->control_data.ia);
-
+  if (num_elements == 0) {
     return NULL;
   }
 
-  if (plot_file->buffer.word_size == 4) {
-    float *coords32 =
-        _d3plot_read_node_data_32(plot_file, state, num_nodes, data_type);
-    if (!coords32) {
+  size_t *part_indices = indices;
+  if (!part_indices) {
+    if (!ids) {
+      ERROR_AND_NO_RETURN_PTR(
+          "The part contains neither ids nor indices of its elements");
       return NULL;
     }
 
-    double *coords = malloc(*num_nodes * 3 * sizeof(double));
-    size_t i = 0;
-    while (i < *num_nodes) {
-      coords[i * 3 + 0] = coords32[i * 3 + 0];
-      coords[i * 3 + 1] = coords32[i * 3 + 1];
-      coords[i * 3 + 2] = coords32[i * 3 + 2];
+    part_indices = malloc(num_elements * sizeof(size_t));
+    d3plot_ids_to_indices(plot_file, id_type, ids, num_elements,
+                          part_indices);
+    if (plot_file->error_string) {
+      free(part_indices);
+      return NULL;
+    }
+  }
 
-      i++;
+  size_t i = 0;
+  while (i < num_elements) {
+    if (part_indices[i] >= max_elements) {
+      ERROR_AND_NO_RETURN_F_PTR("Element %zu of the part is out of bounds",
+                                i);
+      if (part_indices != indices) {
+        free(part_indices);
+      }
+      return NULL;
     }
 
-    free(coords32);
+    i++;
+  }
 
-    return coords;
+  return part_indices;
+}
+
+size_t _d3plot_num_global_materials(const d3plot_file *plot_file) {
+  return plot_file->control_data.nummat8 + plot_file->control_data.nummat2 +
+         plot_file->control_data.nummat4 + plot_file->control_data.nummatt +
+         plot_file->control_data.numrbs;
+}
+
+int _d3plot_read_material_data(d3plot_file *plot_file, size_t state,
+                               int quantity, double *data) {
+  const size_t num_materials = _d3plot_num_global_materials(plot_file);
+  if (plot_file->control_data.nglbv <
+      6 + D3PLOT_MATERIAL_COUNT * num_materials) {
+    ERROR_AND_NO_RETURN_F_PTR("GLOBAL only has %llu words",
+                              plot_file->control_data.nglbv);
+    return 0;
   }
 
-  if (state >= plot_file->num_states) {
-    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
-    return NULL;
+  /* The 6 global values come before the materials*/
+  memcpy(data,
+         &plot_file->state_globals[state * plot_file->control_data.nglbv + 6 +
+                                   (size_t)quantity * num_materials],
+         num_materials * sizeof(double));
+  return 1;
+}
+
+size_t _d3plot_num_rigid_walls(const d3plot_file *plot_file,
+                               size_t *words_per_wall) {
+  const size_t global_words = 6 + D3PLOT_MATERIAL_COUNT *
+                                      _d3plot_num_global_materials(plot_file);
+  if (words_per_wall) {
+    *words_per_wall = 1;
   }
 
-  *num_nodes = plot_file->control_data.numnp;
-  double *coords = malloc(*num_nodes * 3 * sizeof(double));
+  if (plot_file->control_data.nglbv <= global_words) {
+    return 0;
+  }
+
+  /* NUMRW*N = NGLBV - 6 - 7*NUMMAT. N is 4 (force, x, y and z) starting with
+   * version 971 and 1 (only the force) before that*/
+  const size_t rw_words = plot_file->control_data.nglbv - global_words;
+  if (plot_file->control_data.version >= 971.0 && rw_words % 4 == 0) {
+    if (words_per_wall) {
+      *words_per_wall = 4;
+    }
+    return rw_words / 4;
+  }
+
+  return rw_words;
+}
+
+void _d3plot_read_rigid_walls(d3plot_file *plot_file, size_t state,
+                              d3plot_rigid_wall *rigid_walls) {
+  size_t words_per_wall;
+  const size_t num_rigid_walls =
+      _d3plot_num_rigid_walls(plot_file, &words_per_wall);
+  /* RW_FORCE comes after the materials and is followed by RW_POS*/
+  const double *forces =
+      &plot_file->state_globals[state * plot_file->control_data.nglbv +
+                                plot_file->control_data.nglbv -
+                                num_rigid_walls * words_per_wall];
+  const double *positions = &forces[num_rigid_walls];
+
+  size_t i = 0;
+  while (i < num_rigid_walls) {
+    rigid_walls[i].force = forces[i];
+    if (words_per_wall == 4) {
+      rigid_walls[i].position_x = positions[i * 3 + 0];
+      rigid_walls[i].position_y = positions[i * 3 + 1];
+      rigid_walls[i].position_z = positions[i * 3 + 2];
+    } else {
+      rigid_walls[i].position_x = 0.0;
+      rigid_walls[i].position_y = 0.0;
+      rigid_walls[i].position_z = 0.0;
+    }
+
+    i++;
+  }
+}
+
+int _d3plot_read_doubles_of_indices(d3plot_file *plot_file, double *data,
+                                    size_t word_pos, size_t words_per_entry,
+                                    const size_t *indices,
+                                    size_t num_indices) {
+  const size_t num_words = num_indices * words_per_entry;
+
+  if (plot_file->buffer.word_size == 4) {
+    float *data32 = malloc(num_words * sizeof(float));
+    _d3plot_read_words_of_indices(plot_file, data32, word_pos,
+                                  words_per_entry, indices, num_indices);
+
+    size_t i = 0;
+    while (i < num_words) {
+      data[i] = data32[i];
+
+      i++;
+    }
+
+    free(data32);
+  } else {
+    _d3plot_read_words_of_indices(plot_file, data, word_pos, words_per_entry,
+                                  indices, num_indices);
+  }
 
-  d3_pointer d3_ptr = d3_buffer_read_words_at(
-      &plot_file->buffer, coords, *num_nodes * 3,
-      plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-          plot_file->data_pointers[data_type]);
-  d3_pointer_close(&plot_file->buffer, &d3_ptr);
   if (plot_file->buffer.error_string) {
     ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
                               plot_file->buffer.error_string);
-    *num_nodes = 0;
-    free(coords);
-    return NULL;
+    return 0;
   }
 
-  return coords;
+  return 1;
 }
 
-float *_d3plot_read_node_data_32(d3plot_file *plot_file, size_t state,
-                                 size_t *num_nodes, size_t data_type) {
+double *_d3plot_read_part_node_data(d3plot_file *plot_file, size_t state,
+                                    const d3plot_part *part,
+                                    size_t *num_nodes,
+                                    const d3_word *part_node_indices,
+                                    size_t num_part_node_indices,
+                                    size_t data_type) {
+  BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
+  *num_nodes = 0;
+
   if (plot_file->data_pointers[data_type] == 0) {
     ERROR_AND_NO_RETURN_F_PTR(
         "This node data is not present IU=%llu IV=%llu IA=%llu",
         plot_file->control_data.iu, plot_file->control_data.iv,
         plot_file->control_data.ia);
 
+    END_PROFILE_FUNC();
     return NULL;
   }
 
-  if (plot_file->buffer.word_size == 8) {
-    double *coords64 =
-        _d3plot_read_node_data(plot_file, state, num_nodes, data_type);
-    if (!coords64) {
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  d3_word *node_indices = (d3_word *)part_node_indices;
+  size_t num_node_indices = num_part_node_indices;
+  if (!node_indices) {
+    node_indices =
+        d3plot_part_get_node_indices(plot_file, part, &num_node_indices);
+    if (plot_file->error_string || num_node_indices == 0) {
+      free(node_indices);
+
+      END_PROFILE_FUNC();
       return NULL;
     }
+  }
 
-    float *coords = malloc(*num_nodes * 3 * sizeof(float));
-    size_t i = 0;
-    while (i < *num_nodes) {
-      coords[i * 3 + 0] = coords64[i * 3 + 0];
-      coords[i * 3 + 1] = coords64[i * 3 + 1];
-      coords[i * 3 + 2] = coords64[i * 3 + 2];
+  size_t *indices = malloc(num_node_indices * sizeof(size_t));
+  size_t i = 0;
+  while (i < num_node_indices) {
+    if (node_indices[i] >= plot_file->control_data.numnp) {
+      ERROR_AND_NO_RETURN_F_PTR("Node index %llu is out of bounds",
+                                node_indices[i]);
+      break;
+    }
+    indices[i] = node_indices[i];
 
-      i++;
+    i++;
+  }
+
+  if (node_indices != part_node_indices) {
+    free(node_indices);
+  }
+
+  if (plot_file->error_string) {
+    free(indices);
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  double *data = malloc(num_node_indices * 3 * sizeof(double));
+  if (!_d3plot_read_doubles_of_indices(
+          plot_file, data,
+          plot_file->data_pointers[D3PLT_PTR_STATES + state] +
+              plot_file->data_pointers[data_type],
+          3, indices, num_node_indices)) {
+    free(indices);
+    free(data);
+
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  /* With IU=2 the initial coordinates need to be added*/
+  if (data_type == D3PLT_PTR_STATE_NODE_COORDS &&
+      plot_file->control_data.iu == 2) {
+    double *initial_coords = malloc(num_node_indices * 3 * sizeof(double));
+    if (!_d3plot_read_doubles_of_indices(
+            plot_file, initial_coords,
+            plot_file->data_pointers[D3PLT_PTR_NODE_COORDS], 3, indices,
+            num_node_indices)) {
+      free(initial_coords);
+      free(indices);
+      free(data);
+
+      END_PROFILE_FUNC();
+      return NULL;
     }
 
-    free(coords64);
+    i = 0;
+    while (i < num_node_indices * 3) {
+      data[i] += initial_coords[i];
 
-    return coords;
+      i++;
+    }
+
+    free(initial_coords);
   }
 
+  free(indices);
+
+  *num_nodes = num_node_indices;
+
+  END_PROFILE_FUNC();
+  return data;
+}
+
+uint8_t *_d3plot_read_deletion_flags(d3plot_file *plot_file, size_t state,
+                                     size_t offset, size_t count) {
+  BEGIN_PROFILE_FUNC();
+
   if (state >= plot_file->num_states) {
     ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+
+    END_PROFILE_FUNC();
     return NULL;
   }
 
-  *num_nodes = plot_file->control_data.numnp;
-  float *coords = malloc(*num_nodes * 3 * sizeof(float));
+  if (count == 0) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
 
-  d3_pointer d3_ptr = d3_buffer_read_words_at(
-      &plot_file->buffer, coords, *num_nodes * 3,
-      plot_file->data_pointers[D3PLT_PTR_STATES + state] +
-          plot_file->data_pointers[data_type]);
-  d3_pointer_close(&plot_file->buffer, &d3_ptr);
-  if (plot_file->buffer.error_string) {
-    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                              plot_file->buffer.error_string);
-    *num_nodes = 0;
-    free(coords);
+  double *flags = malloc(count * sizeof(double));
+  if (!_d3plot_read_doubles_of_indices(
+          plot_file, flags,
+          plot_file->data_pointers[D3PLT_PTR_STATES + state] +
+              plot_file->data_pointers[D3PLT_PTR_STATE_DELETION] + offset,
+          count, NULL, 1)) {
+    free(flags);
+
+    END_PROFILE_FUNC();
     return NULL;
   }
 
-  return coords;
+  /* A flag of zero means that the node or element has been deleted*/
+  uint8_t *deleted = calloc((count + 7) / 8, 1);
+  size_t i = 0;
+  while (i < count) {
+    if (flags[i] == 0.0) {
+      deleted[i / 8] |= (uint8_t)(1 << (i % 8));
+    }
+
+    i++;
+  }
+
+  free(flags);
+
+  END_PROFILE_FUNC();
+  return deleted;
 }
 
-d3_word *_d3plot_read_ids(d3plot_file *plot_file, size_t *num_ids,
-                          size_t data_type, size_t num_ids_value) {
+size_t *_d3plot_read_alive_element_indices(d3plot_file *plot_file,
+                                           size_t state, int id_type,
+                                           size_t num_elements,
+                                           size_t *num_alive) {
+  BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  *num_ids = num_ids_value;
-  if (num_ids_value == 0) {
-    return NULL;
-  }
+  *num_alive = 0;
 
-  d3_word *ids = malloc(*num_ids * sizeof(d3_word));
-  if (plot_file->buffer.word_size == 4) {
-    uint32_t *ids32 = malloc(*num_ids * plot_file->buffer.word_size);
-    d3_pointer d3_ptr =
-        d3_buffer_read_words_at(&plot_file->buffer, ids32, *num_ids,
-                                plot_file->data_pointers[data_type]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_ids = 0;
-      free(ids32);
-      free(ids);
+  /* Without deletion flags all elements are alive*/
+  uint8_t *deleted = NULL;
+  if (plot_file->control_data.mdlopt == 2) {
+    size_t num_flags;
+    deleted =
+        d3plot_read_deleted_elements(plot_file, state, id_type, &num_flags);
+    if (plot_file->error_string) {
+      END_PROFILE_FUNC();
       return NULL;
     }
+  }
 
-    size_t i = 0;
-    while (i < *num_ids) {
-      ids[i] = ids32[i];
-
-      i++;
+  size_t *alive = malloc(num_elements * sizeof(size_t));
+  size_t i = 0;
+  while (i < num_elements) {
+    if (!deleted || !(deleted[i / 8] & (1 << (i % 8)))) {
+      alive[(*num_alive)++] = i;
     }
 
-    free(ids32);
-  } else {
-    d3_pointer d3_ptr = d3_buffer_read_words_at(
-        &plot_file->buffer, ids, *num_ids, plot_file->data_pointers[data_type]);
-    d3_pointer_close(&plot_file->buffer, &d3_ptr);
-    if (plot_file->buffer.error_string) {
-      ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
-                                plot_file->buffer.error_string);
-      *num_ids = 0;
-      free(ids);
-      return NULL;
-    }
+    i++;
   }
 
-  return ids;
+  free(deleted);
+
+  END_PROFILE_FUNC();
+  return alive;
 }
 
 #define SWAP(lhs, rhs)                                                         \
@@ -3353,6 +4885,51 @@ d3_word *_insert_sorted(d3_word *dst, size_t dst_size, const d3_word *src,
   return dst;
 }
 
+void _merge_sorted(const d3_word *const *arrays, const size_t *sizes,
+                   size_t num_arrays, d3_word *dst, uint8_t *array_indices,
+                   size_t *element_indices) {
+  BEGIN_PROFILE_FUNC();
+
+  /* The number of arrays is small (one per element type), so just look at the
+   * head of every array to find the smallest one*/
+  size_t heads[8];
+  size_t i = 0;
+  while (i < num_arrays) {
+    heads[i] = 0;
+    i++;
+  }
+
+  size_t dst_size = 0;
+  while (1) {
+    size_t min_array = num_arrays;
+    i = 0;
+    while (i < num_arrays) {
+      if (heads[i] < sizes[i] &&
+          (min_array == num_arrays ||
+           arrays[i][heads[i]] < arrays[min_array][heads[min_array]])) {
+        min_array = i;
+      }
+      i++;
+    }
+
+    if (min_array == num_arrays) {
+      break;
+    }
+
+    dst[dst_size] = arrays[min_array][heads[min_array]];
+    if (array_indices) {
+      array_indices[dst_size] = (uint8_t)min_array;
+    }
+    if (element_indices) {
+      element_indices[dst_size] = heads[min_array];
+    }
+    heads[min_array]++;
+    dst_size++;
+  }
+
+  END_PROFILE_FUNC();
+}
+
 void d3plot_free_part(d3plot_part *part) {
   BEGIN_PROFILE_FUNC();
 
@@ -3382,6 +4959,29 @@ void d3plot_free_part(d3plot_part *part) {
   END_PROFILE_FUNC();
 }
 
+void d3plot_free_parts(d3plot_parts *parts) {
+  BEGIN_PROFILE_FUNC();
+
+  free(parts->solid_ids);
+  free(parts->thick_shell_ids);
+  free(parts->beam_ids);
+  free(parts->shell_ids);
+
+  free(parts->solid_indices);
+  free(parts->thick_shell_indices);
+  free(parts->beam_indices);
+  free(parts->shell_indices);
+
+  free(parts->solid_offsets);
+  free(parts->thick_shell_offsets);
+  free(parts->beam_offsets);
+  free(parts->shell_offsets);
+
+  memset(parts, 0, sizeof(d3plot_parts));
+
+  END_PROFILE_FUNC();
+}
+
 void d3plot_free_shells_state(d3plot_shell *shells) {
   BEGIN_PROFILE_FUNC();
 
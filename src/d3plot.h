@@ -116,12 +116,22 @@ typedef struct {
         maxint    /* Number of integration points dumped for each shell and the
                      MDLOPT flag*/
         ;
+    /* The LS-DYNA database version (e.g. 971.0)*/
+    double version;
     /* These values will also be calculated*/
     uint8_t mdlopt, istrn, iosol[2];
+    /* Calculated from IT. The number of temperatures (1 or 3 for the bottom,
+     * middle and top of thermal thick shells) and node fluxes per node and if
+     * the mass scaling of every node is written*/
+    uint8_t num_temperatures, num_fluxes, has_mass_scaling;
 
     /* These are some values also being calculated, but are not part of the
-     * documentation*/
+     * documentation. element_connectivity_packed is set for NDIM=3, where two
+     * values of the element connectivity are packed into every word*/
     uint8_t element_connectivity_packed;
+    /* NEL8 was negative, which means that every solid has two extra nodes
+     * (ten node tetrahedrons). NEL8 is set to its absolute value*/
+    uint8_t has_solid_extra_nodes;
   } control_data;
 
   /* This array holds the word locations of different data*/
@@ -134,8 +144,36 @@ typedef struct {
 
   double *initial_node_coords;
   float *initial_node_coords_32;
+
+  /* Lazily built by d3plot_ids_to_indices. One for every D3PLOT_ID_TYPE*/
+  d3plot_id_index id_indices[D3PLOT_ID_TYPE_COUNT];
+  /* Lazily built by d3plot_get_mesh*/
+  d3plot_mesh *mesh;
+  /* Lazily built by d3plot_get_part_titles*/
+  d3plot_part_titles *part_titles;
+#ifndef NO_THREAD_SAFETY
+  /* Guard the lazy builds above, so that they are only built once if multiple
+   * threads use them at the same time*/
+  sync_t id_indices_mutex;
+  sync_t mesh_mutex;
+  sync_t part_titles_mutex;
+  sync_t initial_node_coords_mutex;
+#endif
+  /* The time and the GLOBAL section (NGLBV words) of every state. They are
+   * read in d3plot_open*/
+  double *state_times;
+  double *state_globals;
 } d3plot_file;
 
+#define d3plot_read_part_node_coordinates(plot_file, state, part, num_nodes)   \
+  d3plot_read_part_node_coordinates2(plot_file, state, part, num_nodes, NULL, \
+                                     0)
+#define d3plot_read_part_node_velocity(plot_file, state, part, num_nodes)      \
+  d3plot_read_part_node_velocity2(plot_file, state, part, num_nodes, NULL, 0)
+#define d3plot_read_part_node_acceleration(plot_file, state, part, num_nodes)  \
+  d3plot_read_part_node_acceleration2(plot_file, state, part, num_nodes, NULL, \
+                                      0)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -198,6 +236,66 @@ double *d3plot_read_node_acceleration(d3plot_file *plot_file, size_t state,
 double *d3plot_read_all_node_acceleration(d3plot_file *plot_file,
                                           size_t *num_nodes,
                                           size_t *num_time_steps);
+/* Reads the displacements of all nodes of a given state. They are the node
+ * coordinates of the state minus the initial node coordinates of the geometry,
+ * which are subtracted while reading. Example: X,Y and Z values of node with
+ * index 20: rv[20*3+0], rv[20*3+1], rv[20*3+2]. The return value needs to be
+ * deallocated by free*/
+double *d3plot_read_node_displacement(d3plot_file *plot_file, size_t state,
+                                      size_t *num_nodes);
+/* The same as d3plot_read_node_displacement for every state. Format
+ * TimeStep0(XYZXYZ...)TimeStep1(XYZXYZ...)... Needs to be deallocated by
+ * free*/
+double *d3plot_read_all_node_displacement(d3plot_file *plot_file,
+                                          size_t *num_nodes,
+                                          size_t *num_time_steps);
+/* Reads the displacements of num_states states starting at first_state. If
+ * node_indices is not NULL only the num_node_indices nodes of node_indices are
+ * read, otherwise all nodes are read. The X,Y and Z values of node n at state
+ * s are located at [(s*num_nodes+n)*3+0..2]. The return value needs to be
+ * deallocated by free*/
+double *d3plot_read_node_displacement_range(d3plot_file *plot_file,
+                                            size_t first_state,
+                                            size_t num_states,
+                                            const size_t *node_indices,
+                                            size_t num_node_indices,
+                                            size_t *num_nodes);
+/* Reads the displacements of the nodes of node_indices (all nodes if it is
+ * NULL) relative to the mean displacement of the nodes of reference_indices
+ * (e.g. for intrusions). The return value needs to be deallocated by free*/
+double *d3plot_read_node_relative_displacement(
+    d3plot_file *plot_file, size_t state, const size_t *node_indices,
+    size_t num_node_indices, const size_t *reference_indices,
+    size_t num_reference_indices, size_t *num_nodes);
+/* Reads the temperatures (IT != 0) of all nodes of a given state. Every node
+ * has control_data.num_temperatures values. The return value needs to be
+ * deallocated by free*/
+double *d3plot_read_node_temperature(d3plot_file *plot_file, size_t state,
+                                     size_t *num_nodes);
+/* Reads the temperatures of num_states states starting at first_state. If
+ * node_indices is not NULL only the num_node_indices nodes of node_indices are
+ * read, otherwise all nodes are read. The temperature t of node n at state s
+ * is located at [(s*num_nodes+n)*num_temperatures+t]. The return value needs
+ * to be deallocated by free*/
+double *d3plot_read_node_temperature_range(d3plot_file *plot_file,
+                                           size_t first_state,
+                                           size_t num_states,
+                                           const size_t *node_indices,
+                                           size_t num_node_indices,
+                                           size_t *num_nodes);
+/* Reads the X, Y and Z node fluxes (IT == 2 or IT == 3) of all nodes of a
+ * given state. The return value needs to be deallocated by free*/
+double *d3plot_read_node_flux(d3plot_file *plot_file, size_t state,
+                              size_t *num_nodes);
+/* Reads the mass scaling (the tens digit of IT is 1) of all nodes of a given
+ * state. The return value needs to be deallocated by free*/
+double *d3plot_read_node_mass_scaling(d3plot_file *plot_file, size_t state,
+                                      size_t *num_nodes);
+/* Reads the NT3D thermal variables of all solids of a given state. The
+ * variable v of solid e is located at [e*NT3D+v]. The return value needs to
+ * be deallocated by free*/
+double *d3plot_read_solids_thermal_state(d3plot_file *plot_file, size_t state,
+                                         size_t *num_solids);
 /* The same as d3plot_read_node_coordinates but it does not convert floats to
  * double. It does the opposite if the word size is 8*/
 float *d3plot_read_node_coordinates_32(d3plot_file *plot_file, size_t state,
@@ -237,6 +335,36 @@ float d3plot_read_time_32(d3plot_file *plot_file, size_t state);
 /* Reads all time of every state (time step) in milliseconds. Needs to be
  * deallocated by free*/
 float *d3plot_read_all_time_32(d3plot_file *plot_file, size_t *num_states);
+/* Reads the global kinetic, internal and total energy and the average velocity
+ * of a state*/
+d3plot_global d3plot_read_global(d3plot_file *plot_file, size_t state);
+/* Reads the global data of every state. Needs to be deallocated by free*/
+d3plot_global *d3plot_read_all_global(d3plot_file *plot_file,
+                                      size_t *num_states);
+/* Reads a per material quantity (one of the D3PLOT_MATERIAL_* values) of a
+ * state. The materials are ordered as in the file: NUMMAT8 solid, NUMMAT2
+ * beam, NUMMAT4 shell and NUMMATT thick shell materials followed by NUMRBS
+ * rigid bodies. Needs to be deallocated by free*/
+double *d3plot_read_material_data(d3plot_file *plot_file, size_t state,
+                                  int quantity, size_t *num_materials);
+/* The same as d3plot_read_material_data for every state. The value of
+ * material m at state s is located at [s*num_materials+m]. Needs to be
+ * deallocated by free*/
+double *d3plot_read_all_material_data(d3plot_file *plot_file, int quantity,
+                                      size_t *num_states,
+                                      size_t *num_materials);
+/* Reads the forces and positions of all rigid walls of a state. The positions
+ * are 0 if the file only contains the forces. Needs to be deallocated by
+ * free*/
+d3plot_rigid_wall *d3plot_read_rigid_walls(d3plot_file *plot_file,
+                                           size_t state,
+                                           size_t *num_rigid_walls);
+/* The same as d3plot_read_rigid_walls for every state. The rigid wall w at
+ * state s is located at [s*num_rigid_walls+w]. Needs to be deallocated by
+ * free*/
+d3plot_rigid_wall *d3plot_read_all_rigid_walls(d3plot_file *plot_file,
+                                               size_t *num_states,
+                                               size_t *num_rigid_walls);
 
 /* Returns stress, strain (if NEIPH >= 6) for a given state. The return value
  * needs to be deallocated by free.*/
@@ -259,10 +387,99 @@ d3plot_beam *d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
  * deallocated by d3plot_free_shells_state.*/
 d3plot_shell *d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
                                        size_t *num_shells);
+/* The same as d3plot_read_solids_state, but only the solids of part are read.
+ * The solids are in the same order as the elements of the part. Only the
+ * consecutive runs of solids of the part are read from the file. If the part
+ * has no solid_indices they are looked up using solid_ids. The return value
+ * needs to be deallocated by free*/
+d3plot_solid *d3plot_read_part_solids_state(d3plot_file *plot_file,
+                                            size_t state,
+                                            const d3plot_part *part,
+                                            size_t *num_solids);
+/* The same as d3plot_read_part_solids_state for thick shells. The return value
+ * needs to be deallocated by d3plot_free_thick_shells_state*/
+d3plot_thick_shell *
+d3plot_read_part_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                    const d3plot_part *part,
+                                    size_t *num_thick_shells);
+/* The same as d3plot_read_part_solids_state for beams. The return value needs
+ * to be deallocated by d3plot_free_beams_state*/
+d3plot_beam *d3plot_read_part_beams_state(d3plot_file *plot_file, size_t state,
+                                          const d3plot_part *part,
+                                          size_t *num_beams);
+/* The same as d3plot_read_part_solids_state for shells. The return value needs
+ * to be deallocated by d3plot_free_shells_state*/
+d3plot_shell *d3plot_read_part_shells_state(d3plot_file *plot_file,
+                                            size_t state,
+                                            const d3plot_part *part,
+                                            size_t *num_shells);
+/* Returns the node coordinates of all nodes of part for a given state. The
+ * nodes are in the same order as part_node_indices, which can be set to the
+ * return value of d3plot_part_get_node_indices to avoid computing them for
+ * every state. If part_node_indices is NULL they are computed. The return
+ * value needs to be deallocated by free*/
+double *d3plot_read_part_node_coordinates2(
+    d3plot_file *plot_file, size_t state, const d3plot_part *part,
+    size_t *num_nodes, const d3_word *part_node_indices,
+    size_t num_part_node_indices);
+/* The same as d3plot_read_part_node_coordinates2 for the node velocities*/
+double *d3plot_read_part_node_velocity2(d3plot_file *plot_file, size_t state,
+                                        const d3plot_part *part,
+                                        size_t *num_nodes,
+                                        const d3_word *part_node_indices,
+                                        size_t num_part_node_indices);
+/* The same as d3plot_read_part_node_coordinates2 for the node accelerations*/
+double *d3plot_read_part_node_acceleration2(
+    d3plot_file *plot_file, size_t state, const d3plot_part *part,
+    size_t *num_nodes, const d3_word *part_node_indices,
+    size_t num_part_node_indices);
+/* Returns a bitset with one bit for every node, which is set if the node has
+ * been deleted in the given state. Bit i is (bitset[i / 8] >> (i % 8)) & 1.
+ * The flags are only present if MDLOPT is 1. The return value needs to be
+ * deallocated by free*/
+uint8_t *d3plot_read_deleted_nodes(d3plot_file *plot_file, size_t state,
+                                   size_t *num_nodes);
+/* The same as d3plot_read_deleted_nodes for elements of the given type
+ * (D3PLOT_ID_TYPE_SOLID, _BEAM, _SHELL or _THICK_SHELL). The flags are only
+ * present if MDLOPT is 2. The return value needs to be deallocated by free*/
+uint8_t *d3plot_read_deleted_elements(d3plot_file *plot_file, size_t state,
+                                      int id_type, size_t *num_elements);
+/* The same as d3plot_read_solids_state, but deleted solids are skipped. If
+ * solid_indices is not NULL the indices of the returned solids are written into
+ * it, which needs to be deallocated by free. Without deletion flags (MDLOPT
+ * is not 2) all solids are returned. The return value needs to be
+ * deallocated by free*/
+d3plot_solid *d3plot_read_alive_solids_state(d3plot_file *plot_file,
+                                             size_t state,
+                                             size_t *num_solids,
+                                             size_t **solid_indices);
+/* The same as d3plot_read_alive_solids_state for thick shells. The return
+ * value needs to be deallocated by d3plot_free_thick_shells_state*/
+d3plot_thick_shell *
+d3plot_read_alive_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                     size_t *num_thick_shells,
+                                     size_t **thick_shell_indices);
+/* The same as d3plot_read_alive_solids_state for beams. The return value
+ * needs to be deallocated by d3plot_free_beams_state*/
+d3plot_beam *d3plot_read_alive_beams_state(d3plot_file *plot_file, size_t state,
+                                           size_t *num_beams,
+                                           size_t **beam_indices);
+/* The same as d3plot_read_alive_solids_state for shells. The return value
+ * needs to be deallocated by d3plot_free_shells_state*/
+d3plot_shell *d3plot_read_alive_shells_state(d3plot_file *plot_file,
+                                             size_t state,
+                                             size_t *num_shells,
+                                             size_t **shell_indices);
 /* Returns the node connectivity + material number of all 8 node solid
  * elements. The return value needs to be deallocated by free*/
 d3plot_solid_con *d3plot_read_solid_elements(d3plot_file *plot_file,
                                              size_t *num_solids);
+/* Returns the two extra nodes (node 9 and 10) of every solid if the solids are
+ * ten node tetrahedrons (NEL8 < 0). The nodes of solid i are located at
+ * i*2 and i*2+1. Returns NULL if there are no extra nodes. The return value
+ * needs to be deallocated by free*/
+d3_word *d3plot_read_solid_extra_nodes(d3plot_file *plot_file,
+                                       size_t *num_solids);
 /* Returns the node connectivity + material number of all 8 node thick shell
  * elements. The return value needs to be deallocated by free*/
 d3plot_thick_shell_con *
@@ -295,6 +512,15 @@ d3plot_part d3plot_read_part(d3plot_file *plot_file, size_t part_index);
  * be deallocated by d3plot_free_part.*/
 d3plot_part d3plot_read_part_by_id(d3plot_file *plot_file, d3_word part_id,
                                    const d3_word *part_ids, size_t num_parts);
+/* Returns the elements of all parts at once. In contrast to calling
+ * d3plot_read_part for every part, the ids and connectivity of every element
+ * type are only read once. The part indices are the same as for
+ * d3plot_read_part. The return value needs to be deallocated by
+ * d3plot_free_parts*/
+d3plot_parts d3plot_read_all_parts(d3plot_file *plot_file);
+/* Returns the part with part_index of parts. The returned part points into the
+ * memory of parts and must not be deallocated*/
+d3plot_part d3plot_parts_get_part(const d3plot_parts *parts, size_t part_index);
 
 /* Returns the average of all integration points of the shell. Needs to be
  * deallocated by d3plot_free_surface */
@@ -309,6 +535,41 @@ d3plot_get_thick_shell_mean(const d3plot_thick_shell *thick_shell);
  * Should not be used on surfaces of d3plot_shell! */
 void d3plot_free_surface(d3plot_surface ip);
 
+/* Allocates the arrays of num_surfaces surfaces with num_history_variables
+ * history variables each. The return value needs to be deallocated by
+ * d3plot_free_surfaces*/
+d3plot_surfaces d3plot_alloc_surfaces(size_t num_surfaces,
+                                      size_t num_history_variables);
+/* Deallocates memory allocated by d3plot_alloc_surfaces*/
+void d3plot_free_surfaces(d3plot_surfaces *surfaces);
+/* Writes one layer (one of the D3PLOT_SHELL_SURFACE_* values) of all shells
+ * into surfaces, which needs to hold at least num_shells surfaces. History
+ * variables are written up to the number of surfaces. Does not allocate any
+ * memory. Returns 0 if layer is invalid or surfaces is too small*/
+int d3plot_get_shells_layer(const d3plot_shell *shells, size_t num_shells,
+                            int layer, d3plot_surfaces *surfaces);
+/* The same as d3plot_get_shells_layer for thick shells*/
+int d3plot_get_thick_shells_layer(const d3plot_thick_shell *thick_shells,
+                                  size_t num_thick_shells, int layer,
+                                  d3plot_surfaces *surfaces);
+/* Allocates the arrays of num_beams beams. If with_integration_points is 0
+ * the values of the integration points are not kept and only the resultants
+ * and the average, minimum and maximum of the history variables are read.
+ * Needs to be deallocated by d3plot_free_beams*/
+d3plot_beams d3plot_alloc_beams(size_t num_beams,
+                                size_t num_integration_points,
+                                size_t num_history_variables,
+                                int with_integration_points);
+/* Deallocates memory allocated by d3plot_alloc_beams*/
+void d3plot_free_beams(d3plot_beams *beams);
+/* Reads all beams of a state into beams, which needs to be allocated by
+ * d3plot_alloc_beams with NEL2 beams, BEAMIP integration points and NEIPB
+ * history variables. The same beams can be used for every state, so that
+ * reading does not allocate any memory. Returns 0 and sets the error string
+ * on failure*/
+int d3plot_read_beams_state_arrays(d3plot_file *plot_file, size_t state,
+                                   d3plot_beams *beams);
+
 /***** Data sections *******/
 /* GEOMETRY DATA pg. 17*/
 int _d3plot_read_geometry_data(d3plot_file *plot_file, d3_pointer *d3_ptr);
@@ -329,6 +590,28 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr);
 /***************************/
 
 /***** Private Functions ********/
+/* Used by d3plot_get_shells_layer and d3plot_get_thick_shells_layer.
+ * elements points to the first element and stride is the size of one element.
+ * offsets holds the offsets of mid, inner, outer and add_ips inside of an
+ * element*/
+int _d3plot_get_surfaces_layer(const uint8_t *elements, size_t stride,
+                               const size_t *offsets, size_t num_elements,
+                               size_t num_add_ips,
+                               size_t num_history_variables, int layer,
+                               d3plot_surfaces *surfaces);
+/* Returns the integration point ip (mid, inner, outer and then the additional
+ * ones) of a shell or thick shell. offsets are the same as for
+ * _d3plot_get_surfaces_layer*/
+const d3plot_surface *_d3plot_get_element_surface(const uint8_t *element,
+                                                  const size_t *offsets,
+                                                  size_t ip);
+/* Folds all values of s into the element i of surfaces using
+ * _d3plot_fold_surface_value*/
+void _d3plot_fold_surface(d3plot_surfaces *surfaces, size_t i,
+                          const d3plot_surface *s,
+                          size_t num_history_variables, int first);
+/* Writes value into out if first is not 0 and otherwise adds it to out*/
+void _d3plot_fold_surface_value(double *out, double value, int first);
 /* Return a string representing the given file type*/
 const char *_d3plot_get_file_type_name(d3_word file_type);
 /* Return the nth digit of an integer as an integer.
@@ -343,14 +626,114 @@ double *_d3plot_read_node_data(d3plot_file *plot_file, size_t state,
  * double. It does the opposite if the word size is 8*/
 float *_d3plot_read_node_data_32(d3plot_file *plot_file, size_t state,
                                  size_t *num_nodes, size_t data_type);
+/* Reads the node coordinates of the geometry into initial_node_coords if they
+ * have not been read yet. Returns 0 and sets the error string on failure*/
+int _d3plot_read_initial_node_coords(d3plot_file *plot_file);
+/* Reads the node coordinates of the geometry into initial_node_coords. Used
+ * by _d3plot_read_initial_node_coords while holding
+ * initial_node_coords_mutex*/
+int _d3plot_load_initial_node_coords(d3plot_file *plot_file);
+/* Reads words_per_entry words of num_entries entries (or of the num_indices
+ * entries of indices if it is not NULL) of the state data data_type (one of
+ * the D3PLT_PTR values) for num_states states starting at first_state.
+ * num_read is set to the number of entries read per state. The return value
+ * needs to be deallocated by free*/
+double *_d3plot_read_state_words(d3plot_file *plot_file, size_t data_type,
+                                 size_t words_per_entry, size_t num_entries,
+                                 size_t first_state, size_t num_states,
+                                 const size_t *indices, size_t num_indices,
+                                 size_t *num_read);
 /* A nice function to read node and element ids*/
 d3_word *_d3plot_read_ids(d3plot_file *plot_file, size_t *num_ids,
                           size_t data_type, size_t num_ids_value);
+/* Reads words_per_entry words for every entry of indices from the words
+ * starting at word_pos into words. Consecutive indices are read at once. If
+ * indices is NULL num_indices entries are read starting at word_pos*/
+void _d3plot_read_words_of_indices(d3plot_file *plot_file, void *words,
+                                   size_t word_pos, size_t words_per_entry,
+                                   const size_t *indices, size_t num_indices);
+/* Reads the packed connectivity (NDIM=3) of num_entries elements starting at
+ * word_pos and unpacks it into values_per_entry values per element. Every word
+ * holds two values, so that an element takes (values_per_entry+1)/2 words*/
+void _d3plot_read_packed_connectivity(d3plot_file *plot_file, d3_word *values,
+                                      size_t word_pos, size_t values_per_entry,
+                                      size_t num_entries);
+/* Returns indices if it is not NULL. Otherwise ids are translated into
+ * indices. Sets the error string and returns NULL if an index is not smaller
+ * than max_elements. If the return value is not indices, it needs to be
+ * deallocated by free*/
+size_t *_d3plot_part_element_indices(d3plot_file *plot_file,
+                                     const d3_word *ids, size_t *indices,
+                                     size_t num_elements, int id_type,
+                                     d3_word max_elements);
+/* Returns the number of materials of the GLOBAL section of a state*/
+size_t _d3plot_num_global_materials(const d3plot_file *plot_file);
+/* Copies a per material quantity of a state into data. Returns 0 and sets the
+ * error string on failure*/
+int _d3plot_read_material_data(d3plot_file *plot_file, size_t state,
+                               int quantity, double *data);
+/* Returns the number of rigid walls of the GLOBAL section of a state.
+ * words_per_wall is set to 1 if only the forces are written and to 4 if the
+ * positions are written as well*/
+size_t _d3plot_num_rigid_walls(const d3plot_file *plot_file,
+                               size_t *words_per_wall);
+/* Copies the rigid walls of a state into rigid_walls*/
+void _d3plot_read_rigid_walls(d3plot_file *plot_file, size_t state,
+                              d3plot_rigid_wall *rigid_walls);
+/* Uses _d3plot_read_words_of_indices to read the words as doubles. Returns 0
+ * and sets the error string on failure*/
+int _d3plot_read_doubles_of_indices(d3plot_file *plot_file, double *data,
+                                    size_t word_pos, size_t words_per_entry,
+                                    const size_t *indices,
+                                    size_t num_indices);
+/* Reads the node data (one of the D3PLT_PTR values) of the nodes of a part*/
+double *_d3plot_read_part_node_data(d3plot_file *plot_file, size_t state,
+                                    const d3plot_part *part,
+                                    size_t *num_nodes,
+                                    const d3_word *part_node_indices,
+                                    size_t num_part_node_indices,
+                                    size_t data_type);
+/* Reads count deletion flags starting at offset of a state and returns them
+ * as a bitset of the deleted entries*/
+uint8_t *_d3plot_read_deletion_flags(d3plot_file *plot_file, size_t state,
+                                     size_t offset, size_t count);
+/* Returns the indices of all elements of id_type which are not deleted in
+ * state. Needs to be deallocated by free*/
+size_t *_d3plot_read_alive_element_indices(d3plot_file *plot_file,
+                                           size_t state, int id_type,
+                                           size_t num_elements,
+                                           size_t *num_alive);
+/* The element state readers. If indices is not NULL only the num_indices
+ * elements of indices are read*/
+d3plot_solid *_d3plot_read_solids_state(d3plot_file *plot_file, size_t state,
+                                        size_t *num_solids,
+                                        const size_t *indices,
+                                        size_t num_indices);
+d3plot_thick_shell *
+_d3plot_read_thick_shells_state(d3plot_file *plot_file, size_t state,
+                                size_t *num_thick_shells,
+                                const size_t *indices, size_t num_indices);
+d3plot_beam *_d3plot_read_beams_state(d3plot_file *plot_file, size_t state,
+                                      size_t *num_beams, const size_t *indices,
+                                      size_t num_indices);
+d3plot_shell *_d3plot_read_shells_state(d3plot_file *plot_file, size_t state,
+                                        size_t *num_shells,
+                                        const size_t *indices,
+                                        size_t num_indices);
+/* Merges num_arrays (at most 8) sorted (ascending) arrays into dst, which
+ * needs to hold the sum of sizes elements. If array_indices or element_indices
+ * are not NULL, the index of the source array and the index inside of the
+ * source array are written into them for every element of dst*/
+void _merge_sorted(const d3_word *const *arrays, const size_t *sizes,
+                   size_t num_arrays, d3_word *dst, uint8_t *array_indices,
+                   size_t *element_indices);
 /* Insert a sorted (ascending) array (src) into a sorted array (dst)*/
 d3_word *_insert_sorted(d3_word *dst, size_t dst_size, const d3_word *src,
                         size_t src_size);
 /* Deallocates all memory of a d3plot_part*/
 void d3plot_free_part(d3plot_part *part);
+/* Deallocates all memory of d3plot_parts*/
+void d3plot_free_parts(d3plot_parts *parts);
 /* Deallocates all memory returned by d3plot_read_shells_state*/
 void d3plot_free_shells_state(d3plot_shell *shells);
 /* Deallocate all memory returned by d3plot_read_thick_shells_state*/
@@ -367,6 +750,14 @@ void d3plot_free_beams_state(d3plot_beam *beams);
 /* Read all ids of the solid, beam, shell and thick shell elements. The return
  * value needs to be deallocated by free*/
 d3_word *d3plot_read_all_element_ids(d3plot_file *plot_file, size_t *num_ids);
+/* The same as d3plot_read_all_element_ids, but it can also return the type
+ * (D3PLOT_ID_TYPE_SOLID, _BEAM, _SHELL or _THICK_SHELL) of every element and
+ * its index inside of the arrays of its type (e.g.
+ * d3plot_read_shell_element_ids). element_types and element_indices can be
+ * NULL. All return values need to be deallocated by free*/
+d3_word *d3plot_read_all_element_ids2(d3plot_file *plot_file, size_t *num_ids,
+                                      uint8_t **element_types,
+                                      size_t **element_indices);
 /* Returns the index of id in the array ids. If it cannot be found then
  * UINT64_MAX will be returned.*/
 size_t d3plot_index_for_id(d3_word id, const d3_word *ids, size_t num_ids);
@@ -376,6 +767,13 @@ size_t d3plot_index_for_id(d3_word id, const d3_word *ids, size_t num_ids);
 }
 #endif
 
+#include "d3plot_id_index.h"
+#include "d3plot_mesh.h"
 #include "d3plot_part_nodes.h"
+#include "d3plot_skin.h"
+#include "d3plot_part_titles.h"
+#include "d3plot_derived.h"
+#include "d3plot_reduce.h"
+#include "d3plot_resample.h"
 
 #endif
@@ -36,6 +36,10 @@
 #endif
 #define DT_PTR_SET(index) plot_file->data_pointers[index] = d3_ptr->cur_word
 #define DT_PTR_SET_DPTR(index) plot_file->data_pointers[index] = data_pointer
+/* The number of words of an element connectivity of num_values values. The
+ * packed connectivity (NDIM=3) stores two values in every word*/
+#define CON_WORDS(num_values)                                                  \
+  (CDP.element_connectivity_packed ? ((num_values) + 1) / 2 : (num_values))
 
 #include "d3plot_error_macros.h"
 
@@ -47,41 +51,29 @@ int _d3plot_read_geometry_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
   const size_t geometry_start_word = d3_ptr->cur_word;
   size_t data_pointer = geometry_start_word;
 
-  if (CDP.element_connectivity_packed) {
-    ERROR_AND_NO_RETURN_PTR("Packed Element Connectivity is not supported");
-    END_PROFILE_FUNC();
-    return 0;
-  }
-
   /* Here are the node coordinates*/
   DT_PTR_SET_DPTR(D3PLT_PTR_NODE_COORDS);
 
   data_pointer += CDP.numnp * CDP.ndim;
 
+  /* The extra nodes of ten node solids (NEL8 < 0) are stored in the EXTRA
+   * NODE CONNECTIVITY section and not here*/
   DT_PTR_SET_DPTR(D3PLT_PTR_EL8_CONNECT);
-  int64_t nel8;
-  if (CDP.nel8 > 0) {
-    nel8 = CDP.nel8;
-  } else {
-    nel8 = -CDP.nel8;
-    data_pointer += 2 * nel8;
-    /* TODO: read function for -nel8 data*/
-  }
-  data_pointer += 9 * nel8;
+  data_pointer += CON_WORDS(9) * CDP.nel8;
 
   if (CDP.nelt > 0) {
     DT_PTR_SET_DPTR(D3PLT_PTR_ELT_CONNECT);
-    data_pointer += 9 * CDP.nelt;
+    data_pointer += CON_WORDS(9) * CDP.nelt;
   }
 
   if (CDP.nel2 > 0) {
     DT_PTR_SET_DPTR(D3PLT_PTR_EL2_CONNECT);
-    data_pointer += 6 * CDP.nel2;
+    data_pointer += CON_WORDS(6) * CDP.nel2;
   }
 
   if (CDP.nel4 > 0) {
     DT_PTR_SET_DPTR(D3PLT_PTR_EL4_CONNECT);
-    data_pointer += 5 * CDP.nel4;
+    data_pointer += CON_WORDS(5) * CDP.nel4;
   }
 
   /* Skip the entire geometry section*/
@@ -256,10 +248,9 @@ int _d3plot_read_extra_node_connectivity(d3plot_file *plot_file,
 
   const size_t data_pointer_start = d3_ptr->cur_word;
   size_t data_pointer = data_pointer_start;
-  if (CDP.nel8 < 0) {
-    const int64_t nel8 = CDP.nel8 * -1;
-    data_pointer += 2 * nel8;
-    /* TODO: read function for -nel8 data*/
+  if (CDP.has_solid_extra_nodes) {
+    DT_PTR_SET_DPTR(D3PLT_PTR_EL8_EXTRA_NODES);
+    data_pointer += 2 * CDP.nel8;
   }
 
   if (CDP.nel48 > 0) {
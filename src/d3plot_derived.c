@@ -0,0 +1,246 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "profiling.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define DERIVED_PI 3.14159265358979323846
+/* The number of tensors which are computed together. The blocks are small
+ * enough to keep the intermediate arrays on the stack and in the cache*/
+#define DERIVED_BLOCK_SIZE 256
+
+double d3plot_tensor_derived(const d3plot_tensor *tensor, int quantity) {
+  const double *components[6];
+  double *outputs[D3PLOT_DERIVED_COUNT];
+  double value = 0.0;
+  if (quantity < 0 || quantity >= D3PLOT_DERIVED_COUNT) {
+    return value;
+  }
+
+  components[0] = &tensor->x;
+  components[1] = &tensor->y;
+  components[2] = &tensor->z;
+  components[3] = &tensor->xy;
+  components[4] = &tensor->yz;
+  components[5] = &tensor->zx;
+
+  int q = 0;
+  while (q < D3PLOT_DERIVED_COUNT) {
+    outputs[q] = q == quantity ? &value : NULL;
+    q++;
+  }
+
+  _d3plot_derived_compute_block(components, 1, outputs, 0);
+  return value;
+}
+
+void d3plot_compute_derived(const d3plot_tensor *tensors, size_t stride,
+                            size_t num_tensors, double *const *outputs) {
+  BEGIN_PROFILE_FUNC();
+
+  const uint8_t *data = (const uint8_t *)tensors;
+  double block[6][DERIVED_BLOCK_SIZE];
+  const double *components[6];
+  int c = 0;
+  while (c < 6) {
+    components[c] = block[c];
+    c++;
+  }
+
+  size_t offset = 0;
+  while (offset < num_tensors) {
+    size_t n = num_tensors - offset;
+    if (n > DERIVED_BLOCK_SIZE) {
+      n = DERIVED_BLOCK_SIZE;
+    }
+
+    /* Gather the strided tensors into one array per component, so that the
+     * quantities can be computed with unit stride loads*/
+    size_t i = 0;
+    while (i < n) {
+      const d3plot_tensor *t =
+          (const d3plot_tensor *)&data[(offset + i) * stride];
+      block[0][i] = t->x;
+      block[1][i] = t->y;
+      block[2][i] = t->z;
+      block[3][i] = t->xy;
+      block[4][i] = t->yz;
+      block[5][i] = t->zx;
+      i++;
+    }
+
+    _d3plot_derived_compute_block(components, n, outputs, offset);
+    offset += n;
+  }
+
+  END_PROFILE_FUNC();
+}
+
+void d3plot_compute_derived_soa(const double *const *components,
+                                size_t num_tensors, double *const *outputs) {
+  BEGIN_PROFILE_FUNC();
+
+  const double *block[6];
+  size_t offset = 0;
+  while (offset < num_tensors) {
+    size_t n = num_tensors - offset;
+    if (n > DERIVED_BLOCK_SIZE) {
+      n = DERIVED_BLOCK_SIZE;
+    }
+
+    int c = 0;
+    while (c < 6) {
+      block[c] = &components[c][offset];
+      c++;
+    }
+
+    _d3plot_derived_compute_block(block, n, outputs, offset);
+    offset += n;
+  }
+
+  END_PROFILE_FUNC();
+}
+
+void _d3plot_derived_compute_block(const double *const *components, size_t n,
+                                   double *const *outputs, size_t offset) {
+  const double *x = components[0], *y = components[1], *z = components[2];
+  const double *xy = components[3], *yz = components[4], *zx = components[5];
+  /* Intermediate values which are needed by other quantities, but have not
+   * been requested*/
+  double von_mises_block[DERIVED_BLOCK_SIZE], max_block[DERIVED_BLOCK_SIZE],
+      mid_block[DERIVED_BLOCK_SIZE], min_block[DERIVED_BLOCK_SIZE];
+  size_t i;
+
+  double *von_mises = outputs[D3PLOT_DERIVED_VON_MISES]
+                          ? &outputs[D3PLOT_DERIVED_VON_MISES][offset]
+                          : von_mises_block;
+  if (outputs[D3PLOT_DERIVED_VON_MISES] ||
+      outputs[D3PLOT_DERIVED_TRIAXIALITY]) {
+    i = 0;
+    while (i < n) {
+      von_mises[i] = sqrt(0.5 * ((x[i] - y[i]) * (x[i] - y[i]) +
+                                 (y[i] - z[i]) * (y[i] - z[i]) +
+                                 (z[i] - x[i]) * (z[i] - x[i])) +
+                          3.0 * (xy[i] * xy[i] + yz[i] * yz[i] +
+                                 zx[i] * zx[i]));
+      i++;
+    }
+  }
+
+  if (outputs[D3PLOT_DERIVED_PRESSURE]) {
+    double *pressure = &outputs[D3PLOT_DERIVED_PRESSURE][offset];
+    i = 0;
+    while (i < n) {
+      pressure[i] = -(x[i] + y[i] + z[i]) / 3.0;
+      i++;
+    }
+  }
+
+  if (outputs[D3PLOT_DERIVED_TRIAXIALITY]) {
+    double *triaxiality = &outputs[D3PLOT_DERIVED_TRIAXIALITY][offset];
+    i = 0;
+    while (i < n) {
+      /* Written without a branch so that the loop can be vectorized. A von
+       * mises stress of 0 yields 0 / 1*/
+      const double positive = (double)(von_mises[i] > 0.0);
+      triaxiality[i] = positive * ((x[i] + y[i] + z[i]) / 3.0) /
+                       (von_mises[i] + (1.0 - positive));
+      i++;
+    }
+  }
+
+  if (!_d3plot_derived_needs_principal(outputs)) {
+    return;
+  }
+
+  double *max = outputs[D3PLOT_DERIVED_MAX_PRINCIPAL]
+                    ? &outputs[D3PLOT_DERIVED_MAX_PRINCIPAL][offset]
+                    : max_block;
+  double *mid = outputs[D3PLOT_DERIVED_MID_PRINCIPAL]
+                    ? &outputs[D3PLOT_DERIVED_MID_PRINCIPAL][offset]
+                    : mid_block;
+  double *min = outputs[D3PLOT_DERIVED_MIN_PRINCIPAL]
+                    ? &outputs[D3PLOT_DERIVED_MIN_PRINCIPAL][offset]
+                    : min_block;
+
+  /* acos and cos are not vectorized by the compiler, so this loop stays
+   * scalar*/
+  i = 0;
+  while (i < n) {
+    _d3plot_derived_principal(x[i], y[i], z[i], xy[i], yz[i], zx[i], &max[i],
+                              &mid[i], &min[i]);
+    i++;
+  }
+
+  if (outputs[D3PLOT_DERIVED_MAX_SHEAR]) {
+    double *max_shear = &outputs[D3PLOT_DERIVED_MAX_SHEAR][offset];
+    i = 0;
+    while (i < n) {
+      max_shear[i] = 0.5 * (max[i] - min[i]);
+      i++;
+    }
+  }
+}
+
+void _d3plot_derived_principal(double x, double y, double z, double xy,
+                               double yz, double zx, double *max, double *mid,
+                               double *min) {
+  /* Closed form eigenvalues of a symmetric 3x3 matrix (Smith 1961). The
+   * deviator is scaled by 1/p, so that the half of its determinant is the
+   * cosine of three times the angle of the largest eigenvalue*/
+  const double mean = (x + y + z) / 3.0;
+  const double dx = x - mean, dy = y - mean, dz = z - mean;
+  const double p2 =
+      dx * dx + dy * dy + dz * dz + 2.0 * (xy * xy + yz * yz + zx * zx);
+  if (p2 <= 0.0) {
+    *max = *mid = *min = mean;
+    return;
+  }
+
+  const double p = sqrt(p2 / 6.0);
+  const double bx = dx / p, by = dy / p, bz = dz / p;
+  const double bxy = xy / p, byz = yz / p, bzx = zx / p;
+  double r = 0.5 * (bx * (by * bz - byz * byz) - bxy * (bxy * bz - byz * bzx) +
+                    bzx * (bxy * byz - by * bzx));
+  if (r < -1.0) {
+    r = -1.0;
+  } else if (r > 1.0) {
+    r = 1.0;
+  }
+
+  const double phi = acos(r) / 3.0;
+  *max = mean + 2.0 * p * cos(phi);
+  *min = mean + 2.0 * p * cos(phi + 2.0 * DERIVED_PI / 3.0);
+  *mid = 3.0 * mean - *max - *min;
+}
+
+int _d3plot_derived_needs_principal(double *const *outputs) {
+  return outputs[D3PLOT_DERIVED_MAX_PRINCIPAL] ||
+         outputs[D3PLOT_DERIVED_MID_PRINCIPAL] ||
+         outputs[D3PLOT_DERIVED_MIN_PRINCIPAL] ||
+         outputs[D3PLOT_DERIVED_MAX_SHEAR];
+}
@@ -0,0 +1,70 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_DERIVED_H
+#define D3PLOT_DERIVED_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Computes one of the D3PLOT_DERIVED_* quantities of a single tensor*/
+double d3plot_tensor_derived(const d3plot_tensor *tensor, int quantity);
+/* Computes derived quantities of num_tensors tensors in one pass. tensors
+ * points to the first tensor and stride is the number of bytes from one tensor
+ * to the next, so that the tensors can be used in place (e.g. &solids[0].stress
+ * and sizeof(d3plot_solid) for the solids of d3plot_read_solids_state).
+ * outputs holds D3PLOT_DERIVED_COUNT pointers indexed by the D3PLOT_DERIVED_*
+ * values. Every pointer is either NULL, in which case the quantity is not
+ * computed, or needs to hold num_tensors elements*/
+void d3plot_compute_derived(const d3plot_tensor *tensors, size_t stride,
+                            size_t num_tensors, double *const *outputs);
+/* The same as d3plot_compute_derived, but the tensors are given as 6 arrays
+ * (x, y, z, xy, yz and zx) of num_tensors elements each*/
+void d3plot_compute_derived_soa(const double *const *components,
+                                size_t num_tensors, double *const *outputs);
+
+/***** Private Functions ********/
+/* Computes the requested outputs of at most DERIVED_BLOCK_SIZE tensors given as
+ * 6 arrays. Every quantity is computed by its own loop over the block and
+ * written to outputs[q] + offset*/
+void _d3plot_derived_compute_block(const double *const *components, size_t n,
+                                   double *const *outputs, size_t offset);
+/* Computes the principal values of a tensor in descending order*/
+void _d3plot_derived_principal(double x, double y, double z, double xy,
+                               double yz, double zx, double *max, double *mid,
+                               double *min);
+/* Returns 1 if any of the outputs needs the principal values*/
+int _d3plot_derived_needs_principal(double *const *outputs);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
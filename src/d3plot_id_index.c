@@ -0,0 +1,225 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Fibonacci hashing multiplier (2^64 / golden ratio)*/
+#define D3PLOT_ID_INDEX_MULTIPLIER ((d3_word)11400714819323198485ULL)
+/* Use a direct table if it has at most this many slots per id*/
+#define D3PLOT_ID_INDEX_MAX_DIRECT_RATIO 4
+
+void d3plot_ids_to_indices(d3plot_file *plot_file, int id_type,
+                           const d3_word *ids, size_t num_ids,
+                           size_t *indices) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (id_type < 0 || id_type >= D3PLOT_ID_TYPE_COUNT) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid id type: %d", id_type);
+    END_PROFILE_FUNC();
+    return;
+  }
+
+  /* The index is not modified after it has been built, so only the build
+   * needs to be guarded*/
+  const d3plot_id_index *index = &plot_file->id_indices[id_type];
+#ifndef NO_THREAD_SAFETY
+  sync_lock(&plot_file->id_indices_mutex);
+#endif
+  const int built = index->built || _d3plot_id_index_build(plot_file, id_type);
+#ifndef NO_THREAD_SAFETY
+  sync_unlock(&plot_file->id_indices_mutex);
+#endif
+  if (!built) {
+    END_PROFILE_FUNC();
+    return;
+  }
+
+  size_t i = 0;
+  while (i < num_ids) {
+    indices[i] = _d3plot_id_index_get(index, ids[i]);
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+}
+
+size_t d3plot_id_to_index(d3plot_file *plot_file, int id_type, d3_word id) {
+  size_t index = (size_t)~0;
+  d3plot_ids_to_indices(plot_file, id_type, &id, 1, &index);
+  return index;
+}
+
+int _d3plot_id_index_build(d3plot_file *plot_file, int id_type) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t num_ids = 0;
+  d3_word *ids;
+  switch (id_type) {
+  case D3PLOT_ID_TYPE_NODE:
+    ids = d3plot_read_node_ids(plot_file, &num_ids);
+    break;
+  case D3PLOT_ID_TYPE_SOLID:
+    ids = d3plot_read_solid_element_ids(plot_file, &num_ids);
+    break;
+  case D3PLOT_ID_TYPE_BEAM:
+    ids = d3plot_read_beam_element_ids(plot_file, &num_ids);
+    break;
+  case D3PLOT_ID_TYPE_SHELL:
+    ids = d3plot_read_shell_element_ids(plot_file, &num_ids);
+    break;
+  case D3PLOT_ID_TYPE_THICK_SHELL:
+    ids = d3plot_read_thick_shell_element_ids(plot_file, &num_ids);
+    break;
+  default:
+    ids = d3plot_read_part_ids(plot_file, &num_ids);
+    break;
+  }
+
+  if (plot_file->error_string) {
+    free(ids);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  plot_file->id_indices[id_type] = _d3plot_id_index_new(ids, num_ids);
+  free(ids);
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+d3plot_id_index _d3plot_id_index_new(const d3_word *ids, size_t num_ids) {
+  BEGIN_PROFILE_FUNC();
+
+  d3plot_id_index index;
+  memset(&index, 0, sizeof(index));
+  index.num_ids = num_ids;
+  index.built = 1;
+
+  if (num_ids == 0) {
+    END_PROFILE_FUNC();
+    return index;
+  }
+
+  d3_word min_id = ids[0], max_id = ids[0];
+  size_t i = 1;
+  while (i < num_ids) {
+    if (ids[i] < min_id) {
+      min_id = ids[i];
+    }
+    if (ids[i] > max_id) {
+      max_id = ids[i];
+    }
+    i++;
+  }
+
+  /* Most models number their entities (almost) contiguously, in which case a
+   * direct table is both smaller and faster than a hash table*/
+  if ((max_id - min_id) / D3PLOT_ID_INDEX_MAX_DIRECT_RATIO < num_ids) {
+    index.direct = 1;
+    index.min_id = min_id;
+    index.num_buckets = (size_t)(max_id - min_id) + 1;
+    index.values = malloc(index.num_buckets * sizeof(size_t));
+    memset(index.values, 0xFF, index.num_buckets * sizeof(size_t));
+
+    /* Go backwards so that the first of duplicated ids wins*/
+    i = num_ids;
+    while (i > 0) {
+      i--;
+      index.values[ids[i] - min_id] = i;
+    }
+
+    END_PROFILE_FUNC();
+    return index;
+  }
+
+  /* Keep the load factor at or below 0.5*/
+  index.num_buckets = 1;
+  while (index.num_buckets < num_ids * 2) {
+    index.num_buckets <<= 1;
+  }
+  index.keys = malloc(index.num_buckets * sizeof(d3_word));
+  index.values = malloc(index.num_buckets * sizeof(size_t));
+  memset(index.values, 0xFF, index.num_buckets * sizeof(size_t));
+
+  const size_t mask = index.num_buckets - 1;
+  i = 0;
+  while (i < num_ids) {
+    size_t bucket = _d3plot_id_index_hash(ids[i], index.num_buckets);
+    while (index.values[bucket] != (size_t)~0 && index.keys[bucket] != ids[i]) {
+      bucket = (bucket + 1) & mask;
+    }
+    if (index.values[bucket] == (size_t)~0) {
+      index.keys[bucket] = ids[i];
+      index.values[bucket] = i;
+    }
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return index;
+}
+
+size_t _d3plot_id_index_get(const d3plot_id_index *index, d3_word id) {
+  if (index->num_ids == 0) {
+    return (size_t)~0;
+  }
+
+  if (index->direct) {
+    if (id < index->min_id || id - index->min_id >= index->num_buckets) {
+      return (size_t)~0;
+    }
+    return index->values[id - index->min_id];
+  }
+
+  const size_t mask = index->num_buckets - 1;
+  size_t bucket = _d3plot_id_index_hash(id, index->num_buckets);
+  while (index->values[bucket] != (size_t)~0) {
+    if (index->keys[bucket] == id) {
+      return index->values[bucket];
+    }
+    bucket = (bucket + 1) & mask;
+  }
+
+  return (size_t)~0;
+}
+
+size_t _d3plot_id_index_hash(d3_word id, size_t num_buckets) {
+  /* Fold the upper bits of the product in, since they are the best
+   * distributed ones*/
+  const d3_word hash = id * D3PLOT_ID_INDEX_MULTIPLIER;
+  return (size_t)(hash ^ (hash >> 32)) & (num_buckets - 1);
+}
+
+void _d3plot_id_index_free(d3plot_id_index *index) {
+  free(index->keys);
+  free(index->values);
+  memset(index, 0, sizeof(*index));
+}
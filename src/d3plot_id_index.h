@@ -0,0 +1,67 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_ID_INDEX_H
+#define D3PLOT_ID_INDEX_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Translates num_ids ids of the given type (one of D3PLOT_ID_TYPE_*) into
+ * indices and writes them into indices, which needs to hold num_ids elements.
+ * The indices are the same as the ones of the arrays returned by the read
+ * functions (e.g. d3plot_read_shell_element_ids). For parts they are the
+ * part_index of d3plot_read_part. Ids which do not exist are translated to
+ * (size_t)~0. On the first call for a type the ids are read and an index is
+ * built, which is kept until d3plot_close is called.*/
+void d3plot_ids_to_indices(d3plot_file *plot_file, int id_type,
+                           const d3_word *ids, size_t num_ids, size_t *indices);
+/* The same as d3plot_ids_to_indices for a single id. Returns (size_t)~0 if the
+ * id does not exist*/
+size_t d3plot_id_to_index(d3plot_file *plot_file, int id_type, d3_word id);
+
+/***** Private Functions ********/
+/* Reads the ids of id_type and builds the index in plot_file->id_indices.
+ * Returns 0 on failure*/
+int _d3plot_id_index_build(d3plot_file *plot_file, int id_type);
+/* Builds an index out of num_ids ids*/
+d3plot_id_index _d3plot_id_index_new(const d3_word *ids, size_t num_ids);
+/* Returns the index of id or (size_t)~0 if it does not exist*/
+size_t _d3plot_id_index_get(const d3plot_id_index *index, d3_word id);
+/* Returns the bucket of id. num_buckets needs to be a power of two*/
+size_t _d3plot_id_index_hash(d3_word id, size_t num_buckets);
+/* Deallocates all memory of index*/
+void _d3plot_id_index_free(d3plot_id_index *index);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,388 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MESH_READ_ELEMENTS(el_func, el_type, els, num_els, name)               \
+  el_type *els = NULL;                                                         \
+  size_t num_els = 0;                                                          \
+  if (!plot_file->error_string) {                                              \
+    els = el_func(plot_file, &num_els);                                        \
+    if (plot_file->error_string) {                                             \
+      char *read_error = plot_file->error_string;                              \
+      plot_file->error_string = NULL;                                          \
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read the " name " elements: %s",    \
+                                read_error);                                   \
+      free(read_error);                                                        \
+    }                                                                          \
+  }
+
+#define MESH_STRIDE(el_type) (sizeof(el_type) / sizeof(d3_word))
+
+const d3plot_mesh *d3plot_get_mesh(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+#ifndef NO_THREAD_SAFETY
+  sync_lock(&plot_file->mesh_mutex);
+#endif
+  if (!plot_file->mesh) {
+    const d3plot_mesh mesh = d3plot_read_mesh(plot_file);
+    if (!plot_file->error_string) {
+      plot_file->mesh = malloc(sizeof(d3plot_mesh));
+      *plot_file->mesh = mesh;
+    }
+  }
+  const d3plot_mesh *mesh = plot_file->mesh;
+#ifndef NO_THREAD_SAFETY
+  sync_unlock(&plot_file->mesh_mutex);
+#endif
+
+  END_PROFILE_FUNC();
+  return mesh;
+}
+
+d3plot_mesh d3plot_read_mesh(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_mesh mesh;
+  memset(&mesh, 0, sizeof(d3plot_mesh));
+
+  MESH_READ_ELEMENTS(d3plot_read_solid_elements, d3plot_solid_con, solids,
+                     num_solids, "solid");
+  MESH_READ_ELEMENTS(d3plot_read_beam_elements, d3plot_beam_con, beams,
+                     num_beams, "beam");
+  MESH_READ_ELEMENTS(d3plot_read_shell_elements, d3plot_shell_con, shells,
+                     num_shells, "shell");
+  MESH_READ_ELEMENTS(d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
+                     thick_shells, num_thick_shells, "thick shell");
+
+  const size_t num_elements =
+      num_solids + num_beams + num_shells + num_thick_shells;
+  if (!plot_file->error_string &&
+      (num_elements > UINT32_MAX ||
+       plot_file->control_data.numnp > UINT32_MAX ||
+       plot_file->control_data.nmmat > UINT32_MAX)) {
+    ERROR_AND_NO_RETURN_PTR("The model is too large to be stored with 32-bit "
+                            "indices");
+  }
+
+  if (plot_file->error_string) {
+    free(solids);
+    free(beams);
+    free(shells);
+    free(thick_shells);
+
+    END_PROFILE_FUNC();
+    return mesh;
+  }
+
+  mesh.num_nodes = plot_file->control_data.numnp;
+  mesh.num_parts = plot_file->control_data.nmmat;
+
+  /* Every element type has a fixed number of nodes*/
+  const size_t num_element_nodes = num_solids * 8 + num_beams * 2 +
+                                   num_shells * 4 + num_thick_shells * 8;
+  mesh.element_node_offsets = malloc((num_elements + 1) * sizeof(size_t));
+  mesh.element_node_offsets[0] = 0;
+  mesh.element_nodes = malloc(num_element_nodes * sizeof(uint32_t));
+  mesh.element_parts = malloc(num_elements * sizeof(uint32_t));
+
+  mesh.type_offsets[0] = 0;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)solids, num_solids,
+                            MESH_STRIDE(d3plot_solid_con), 8);
+  mesh.type_offsets[1] = mesh.num_elements;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)beams, num_beams,
+                            MESH_STRIDE(d3plot_beam_con), 2);
+  mesh.type_offsets[2] = mesh.num_elements;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)shells, num_shells,
+                            MESH_STRIDE(d3plot_shell_con), 4);
+  mesh.type_offsets[3] = mesh.num_elements;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)thick_shells,
+                            num_thick_shells,
+                            MESH_STRIDE(d3plot_thick_shell_con), 8);
+  mesh.type_offsets[4] = mesh.num_elements;
+
+  free(solids);
+  free(beams);
+  free(shells);
+  free(thick_shells);
+
+  _d3plot_mesh_build_adjacency(&mesh);
+
+  END_PROFILE_FUNC();
+  return mesh;
+}
+
+void d3plot_free_mesh(d3plot_mesh *mesh) {
+  BEGIN_PROFILE_FUNC();
+
+  free(mesh->element_node_offsets);
+  free(mesh->element_nodes);
+  free(mesh->element_parts);
+  free(mesh->node_element_offsets);
+  free(mesh->node_elements);
+  free(mesh->part_element_offsets);
+  free(mesh->part_elements);
+  free(mesh->part_node_offsets);
+  free(mesh->part_nodes);
+
+  memset(mesh, 0, sizeof(d3plot_mesh));
+
+  END_PROFILE_FUNC();
+}
+
+size_t d3plot_mesh_get_element_index(const d3plot_mesh *mesh, int id_type,
+                                     size_t index) {
+  if (id_type < D3PLOT_ID_TYPE_SOLID || id_type > D3PLOT_ID_TYPE_THICK_SHELL) {
+    return (size_t)~0;
+  }
+
+  const size_t type = (size_t)(id_type - D3PLOT_ID_TYPE_SOLID);
+  if (index >= mesh->type_offsets[type + 1] - mesh->type_offsets[type]) {
+    return (size_t)~0;
+  }
+
+  return mesh->type_offsets[type] + index;
+}
+
+int d3plot_mesh_get_element_type(const d3plot_mesh *mesh, size_t element_index,
+                                 size_t *index) {
+  if (element_index >= mesh->num_elements) {
+    return -1;
+  }
+
+  size_t type = 0;
+  while (element_index >= mesh->type_offsets[type + 1]) {
+    type++;
+  }
+
+  *index = element_index - mesh->type_offsets[type];
+  return D3PLOT_ID_TYPE_SOLID + (int)type;
+}
+
+const uint32_t *d3plot_mesh_get_element_nodes(const d3plot_mesh *mesh,
+                                              size_t element_index,
+                                              size_t *num_nodes) {
+  return _d3plot_mesh_get_row(mesh->element_node_offsets, mesh->element_nodes,
+                              mesh->num_elements, element_index, num_nodes);
+}
+
+const uint32_t *d3plot_mesh_get_node_elements(const d3plot_mesh *mesh,
+                                              size_t node_index,
+                                              size_t *num_elements) {
+  return _d3plot_mesh_get_row(mesh->node_element_offsets, mesh->node_elements,
+                              mesh->num_nodes, node_index, num_elements);
+}
+
+const uint32_t *d3plot_mesh_get_part_elements(const d3plot_mesh *mesh,
+                                              size_t part_index,
+                                              size_t *num_elements) {
+  return _d3plot_mesh_get_row(mesh->part_element_offsets, mesh->part_elements,
+                              mesh->num_parts, part_index, num_elements);
+}
+
+const uint32_t *d3plot_mesh_get_part_nodes(const d3plot_mesh *mesh,
+                                           size_t part_index,
+                                           size_t *num_nodes) {
+  return _d3plot_mesh_get_row(mesh->part_node_offsets, mesh->part_nodes,
+                              mesh->num_parts, part_index, num_nodes);
+}
+
+void _d3plot_mesh_add_elements(d3plot_mesh *mesh, const d3_word *cons,
+                               size_t num_elements, size_t stride,
+                               size_t num_el_nodes) {
+  size_t i = 0;
+  while (i < num_elements) {
+    const d3_word *con = &cons[i * stride];
+    const size_t el_index = mesh->num_elements + i;
+    const size_t offset = mesh->element_node_offsets[el_index];
+
+    size_t j = 0;
+    while (j < num_el_nodes) {
+      mesh->element_nodes[offset + j] = (uint32_t)con[j];
+      j++;
+    }
+
+    mesh->element_node_offsets[el_index + 1] = offset + num_el_nodes;
+    mesh->element_parts[el_index] = (uint32_t)con[stride - 1];
+
+    i++;
+  }
+
+  mesh->num_elements += num_elements;
+}
+
+void _d3plot_mesh_build_adjacency(d3plot_mesh *mesh) {
+  BEGIN_PROFILE_FUNC();
+
+  mesh->node_element_offsets = calloc(mesh->num_nodes + 1, sizeof(size_t));
+  mesh->part_element_offsets = calloc(mesh->num_parts + 1, sizeof(size_t));
+  mesh->part_node_offsets = calloc(mesh->num_parts + 1, sizeof(size_t));
+
+  /* Count the elements of every node and every part. Degenerated elements may
+   * contain the same node multiple times, which is only counted once*/
+  size_t e = 0;
+  while (e < mesh->num_elements) {
+    const size_t begin = mesh->element_node_offsets[e];
+    const size_t end = mesh->element_node_offsets[e + 1];
+    size_t i = begin;
+    while (i < end) {
+      const uint32_t node = mesh->element_nodes[i];
+      size_t j = begin;
+      while (j < i && mesh->element_nodes[j] != node) {
+        j++;
+      }
+      if (j == i && node < mesh->num_nodes) {
+        mesh->node_element_offsets[node + 1]++;
+      }
+      i++;
+    }
+
+    if (mesh->element_parts[e] < mesh->num_parts) {
+      mesh->part_element_offsets[mesh->element_parts[e] + 1]++;
+    }
+    e++;
+  }
+
+  size_t i = 0;
+  while (i < mesh->num_nodes) {
+    mesh->node_element_offsets[i + 1] += mesh->node_element_offsets[i];
+    i++;
+  }
+  i = 0;
+  while (i < mesh->num_parts) {
+    mesh->part_element_offsets[i + 1] += mesh->part_element_offsets[i];
+    i++;
+  }
+
+  mesh->node_elements =
+      malloc(mesh->node_element_offsets[mesh->num_nodes] * sizeof(uint32_t));
+  mesh->part_elements =
+      malloc(mesh->part_element_offsets[mesh->num_parts] * sizeof(uint32_t));
+
+  /* Since the elements are visited in ascending order every row is sorted*/
+  size_t *next_node = malloc(mesh->num_nodes * sizeof(size_t));
+  size_t *next_part = malloc(mesh->num_parts * sizeof(size_t));
+  memcpy(next_node, mesh->node_element_offsets,
+         mesh->num_nodes * sizeof(size_t));
+  memcpy(next_part, mesh->part_element_offsets,
+         mesh->num_parts * sizeof(size_t));
+
+  e = 0;
+  while (e < mesh->num_elements) {
+    const size_t begin = mesh->element_node_offsets[e];
+    const size_t end = mesh->element_node_offsets[e + 1];
+    i = begin;
+    while (i < end) {
+      const uint32_t node = mesh->element_nodes[i];
+      size_t j = begin;
+      while (j < i && mesh->element_nodes[j] != node) {
+        j++;
+      }
+      if (j == i && node < mesh->num_nodes) {
+        mesh->node_elements[next_node[node]++] = (uint32_t)e;
+      }
+      i++;
+    }
+
+    if (mesh->element_parts[e] < mesh->num_parts) {
+      mesh->part_elements[next_part[mesh->element_parts[e]]++] = (uint32_t)e;
+    }
+    e++;
+  }
+
+  free(next_node);
+
+  /* Collect the nodes of every part by going over the elements of every node.
+   * last_node stores the last node + 1 which has been added to a part, so
+   * that every node is only added once*/
+  size_t *last_node = next_part;
+  memset(last_node, 0, mesh->num_parts * sizeof(size_t));
+
+  size_t n = 0;
+  while (n < mesh->num_nodes) {
+    i = mesh->node_element_offsets[n];
+    while (i < mesh->node_element_offsets[n + 1]) {
+      const uint32_t part = mesh->element_parts[mesh->node_elements[i]];
+      if (part < mesh->num_parts && last_node[part] != n + 1) {
+        last_node[part] = n + 1;
+        mesh->part_node_offsets[part + 1]++;
+      }
+      i++;
+    }
+    n++;
+  }
+
+  i = 0;
+  while (i < mesh->num_parts) {
+    mesh->part_node_offsets[i + 1] += mesh->part_node_offsets[i];
+    i++;
+  }
+
+  mesh->part_nodes =
+      malloc(mesh->part_node_offsets[mesh->num_parts] * sizeof(uint32_t));
+
+  size_t *next_part_node = malloc(mesh->num_parts * sizeof(size_t));
+  memcpy(next_part_node, mesh->part_node_offsets,
+         mesh->num_parts * sizeof(size_t));
+  memset(last_node, 0, mesh->num_parts * sizeof(size_t));
+
+  n = 0;
+  while (n < mesh->num_nodes) {
+    i = mesh->node_element_offsets[n];
+    while (i < mesh->node_element_offsets[n + 1]) {
+      const uint32_t part = mesh->element_parts[mesh->node_elements[i]];
+      if (part < mesh->num_parts && last_node[part] != n + 1) {
+        last_node[part] = n + 1;
+        mesh->part_nodes[next_part_node[part]++] = (uint32_t)n;
+      }
+      i++;
+    }
+    n++;
+  }
+
+  free(next_part_node);
+  free(last_node);
+
+  END_PROFILE_FUNC();
+}
+
+const uint32_t *_d3plot_mesh_get_row(const size_t *offsets,
+                                     const uint32_t *values, size_t num_rows,
+                                     size_t row, size_t *row_size) {
+  if (row >= num_rows) {
+    *row_size = 0;
+    return NULL;
+  }
+
+  *row_size = offsets[row + 1] - offsets[row];
+  return &values[offsets[row]];
+}
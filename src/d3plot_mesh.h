@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_MESH_H
+#define D3PLOT_MESH_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns the mesh of plot_file. It is built on the first call and kept until
+ * d3plot_close is called, so it must not be deallocated. Since the mesh is
+ * never modified after it has been built, it can be read from multiple threads
+ * at once. Returns NULL and sets error_string on failure*/
+const d3plot_mesh *d3plot_get_mesh(d3plot_file *plot_file);
+/* Reads the connectivity of all elements and builds a new mesh. Prefer
+ * d3plot_get_mesh which only builds the mesh once. The return value needs to
+ * be deallocated by d3plot_free_mesh*/
+d3plot_mesh d3plot_read_mesh(d3plot_file *plot_file);
+/* Deallocates all memory of a mesh returned by d3plot_read_mesh*/
+void d3plot_free_mesh(d3plot_mesh *mesh);
+
+/* Returns the index of an element inside of the mesh. id_type is one of
+ * D3PLOT_ID_TYPE_SOLID, D3PLOT_ID_TYPE_BEAM, D3PLOT_ID_TYPE_SHELL and
+ * D3PLOT_ID_TYPE_THICK_SHELL and index is the index of the element in the
+ * arrays of its type (e.g. d3plot_read_shell_elements). Returns (size_t)~0 if
+ * it does not exist*/
+size_t d3plot_mesh_get_element_index(const d3plot_mesh *mesh, int id_type,
+                                     size_t index);
+/* The opposite of d3plot_mesh_get_element_index. Returns the type of an element
+ * and writes its index inside of the arrays of its type into index. Returns -1
+ * if element_index is out of bounds*/
+int d3plot_mesh_get_element_type(const d3plot_mesh *mesh, size_t element_index,
+                                 size_t *index);
+/* Returns the node indices of an element in the order of its connectivity*/
+const uint32_t *d3plot_mesh_get_element_nodes(const d3plot_mesh *mesh,
+                                              size_t element_index,
+                                              size_t *num_nodes);
+/* Returns the indices of all elements which contain a node*/
+const uint32_t *d3plot_mesh_get_node_elements(const d3plot_mesh *mesh,
+                                              size_t node_index,
+                                              size_t *num_elements);
+/* Returns the indices of all elements of a part*/
+const uint32_t *d3plot_mesh_get_part_elements(const d3plot_mesh *mesh,
+                                              size_t part_index,
+                                              size_t *num_elements);
+/* Returns the indices of all nodes of a part*/
+const uint32_t *d3plot_mesh_get_part_nodes(const d3plot_mesh *mesh,
+                                           size_t part_index,
+                                           size_t *num_nodes);
+
+/***** Private Functions ********/
+/* Appends num_elements elements to the element arrays of mesh. cons points to
+ * an array of connectivity structs, which consist of stride words, of which the
+ * first num_el_nodes are the node indices and the last one is the material
+ * index*/
+void _d3plot_mesh_add_elements(d3plot_mesh *mesh, const d3_word *cons,
+                               size_t num_elements, size_t stride,
+                               size_t num_el_nodes);
+/* Builds the node -> element and part -> element, node adjacency out of the
+ * element arrays of mesh*/
+void _d3plot_mesh_build_adjacency(d3plot_mesh *mesh);
+/* Returns the row of a CSR array*/
+const uint32_t *_d3plot_mesh_get_row(const size_t *offsets,
+                                     const uint32_t *values, size_t num_rows,
+                                     size_t row, size_t *row_size);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
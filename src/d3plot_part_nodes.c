@@ -50,28 +50,49 @@ d3_word *d3plot_part_get_node_ids2(
     }
   }
 
-  const size_t part_node_ids_cap = part->num_solids * 8 + part->num_beams * 2 +
-                                   part->num_shells * 4 +
-                                   part->num_thick_shells * 8;
-  *num_part_node_ids = 0;
-  d3_word *part_node_ids = malloc(part_node_ids_cap * sizeof(d3_word));
+  /* Mark every node of the part in a bitmap with one bit per node*/
+  const d3_word numnp = plot_file->control_data.numnp;
+  uint8_t *node_bitmap = calloc((numnp + 7) / 8, 1);
+
+  PGNI_MARK_SOLIDS();
+  PGNI_MARK_BEAMS();
+  PGNI_MARK_SHELLS();
+  PGNI_MARK_THICK_SHELLS();
+
+  d3_word *part_node_ids =
+      _d3plot_part_collect_node_indices(node_bitmap, numnp, num_part_node_ids);
+  free(node_bitmap);
+
+  /* Convert the indices into ids. This can be done in place. Indices without
+   * a node id are skipped*/
+  int sorted = 1;
+  size_t num_valid = 0;
+  size_t i = 0;
+  while (i < *num_part_node_ids) {
+    if (part_node_ids[i] < num_nodes) {
+      part_node_ids[num_valid] = node_ids[part_node_ids[i]];
+      if (num_valid != 0 &&
+          part_node_ids[num_valid] < part_node_ids[num_valid - 1]) {
+        sorted = 0;
+      }
+      num_valid++;
+    }
+    i++;
+  }
+  *num_part_node_ids = num_valid;
 
-  PGNI_ADD_SOLIDS();
-  PGNI_ADD_BEAMS();
-  PGNI_ADD_SHELLS();
-  PGNI_ADD_THICK_SHELLS();
+  /* The node ids are usually already ascending, since they are stored sorted
+   * in the d3plot file. Only sort them if this is not the case*/
+  if (!sorted) {
+    qsort(part_node_ids, *num_part_node_ids, sizeof(d3_word),
+          _d3plot_part_compare_node_ids);
+  }
 
   /*unload node_ids*/
   if (node_ids_loaded) {
     free((d3_word *)node_ids);
   }
 
-  /* Shrink to fit*/
-  if (part_node_ids_cap != *num_part_node_ids) {
-    part_node_ids =
-        realloc(part_node_ids, *num_part_node_ids * sizeof(d3_word));
-  }
-
   END_PROFILE_FUNC();
   return part_node_ids;
 }
@@ -87,22 +108,18 @@ d3_word *d3plot_part_get_node_indices2(
   BEGIN_PROFILE_FUNC();
   D3PLOT_CLEAR_ERROR_STRING();
 
-  const size_t part_node_indices_cap =
-      part->num_solids * 8 + part->num_beams * 2 + part->num_shells * 4 +
-      part->num_thick_shells * 8;
-  *num_part_node_indices = 0;
-  d3_word *part_node_indices = malloc(part_node_indices_cap * sizeof(d3_word));
-
-  PGNIND_ADD_SOLIDS();
-  PGNIND_ADD_BEAMS();
-  PGNIND_ADD_SHELLS();
-  PGNIND_ADD_THICK_SHELLS();
-
-  /* Shrink to fit*/
-  if (part_node_indices_cap != *num_part_node_indices) {
-    part_node_indices =
-        realloc(part_node_indices, *num_part_node_indices * sizeof(d3_word));
-  }
+  /* Mark every node of the part in a bitmap with one bit per node*/
+  const d3_word numnp = plot_file->control_data.numnp;
+  uint8_t *node_bitmap = calloc((numnp + 7) / 8, 1);
+
+  PGNI_MARK_SOLIDS();
+  PGNI_MARK_BEAMS();
+  PGNI_MARK_SHELLS();
+  PGNI_MARK_THICK_SHELLS();
+
+  d3_word *part_node_indices = _d3plot_part_collect_node_indices(
+      node_bitmap, numnp, num_part_node_indices);
+  free(node_bitmap);
 
   END_PROFILE_FUNC();
   return part_node_indices;
@@ -141,47 +158,67 @@ d3_word *d3plot_part_get_all_element_ids(const d3plot_part *part,
 
   d3_word *all_ids = malloc(*num_ids * sizeof(d3_word));
 
-  int empty = 1;
-  size_t all_ids_size = 0;
+  const d3_word *ids[4];
+  size_t sizes[4];
+  ids[0] = part->solid_ids;
+  sizes[0] = part->num_solids;
+  ids[1] = part->thick_shell_ids;
+  sizes[1] = part->num_thick_shells;
+  ids[2] = part->beam_ids;
+  sizes[2] = part->num_beams;
+  ids[3] = part->shell_ids;
+  sizes[3] = part->num_shells;
 
-  if (part->num_solids != 0) {
-    memcpy(all_ids, part->solid_ids, part->num_solids * sizeof(d3_word));
-    empty = 0;
-    all_ids_size += part->num_solids;
-  }
+  _merge_sorted(ids, sizes, 4, all_ids, NULL, NULL);
 
-  if (part->num_thick_shells != 0) {
-    if (empty) {
-      memcpy(all_ids, part->thick_shell_ids,
-             part->num_thick_shells * sizeof(d3_word));
-    } else {
-      _insert_sorted(all_ids, all_ids_size, part->thick_shell_ids,
-                     part->num_thick_shells);
-    }
-    empty = 0;
-    all_ids_size += part->num_thick_shells;
-  }
+  END_PROFILE_FUNC();
+  return all_ids;
+}
+
+d3_word *_d3plot_part_collect_node_indices(const uint8_t *node_bitmap,
+                                           d3_word num_nodes,
+                                           size_t *num_node_indices) {
+  BEGIN_PROFILE_FUNC();
 
-  if (part->num_beams != 0) {
-    if (empty) {
-      memcpy(all_ids, part->beam_ids, part->num_beams * sizeof(d3_word));
-    } else {
-      _insert_sorted(all_ids, all_ids_size, part->beam_ids, part->num_beams);
+  /* Count the set bits first so that the array can be allocated exactly*/
+  const size_t num_bytes = (num_nodes + 7) / 8;
+  size_t count = 0;
+  size_t i = 0;
+  while (i < num_bytes) {
+    uint8_t byte = node_bitmap[i];
+    while (byte) {
+      byte &= (uint8_t)(byte - 1);
+      count++;
     }
-    empty = 0;
-    all_ids_size += part->num_beams;
+    i++;
   }
 
-  if (part->num_shells != 0) {
-    if (empty) {
-      memcpy(all_ids, part->shell_ids, part->num_shells * sizeof(d3_word));
-    } else {
-      _insert_sorted(all_ids, all_ids_size, part->shell_ids, part->num_shells);
+  *num_node_indices = count;
+  d3_word *node_indices = malloc(count * sizeof(d3_word));
+
+  /* Walking the bitmap in order yields the indices ascending*/
+  count = 0;
+  i = 0;
+  while (i < num_bytes) {
+    const uint8_t byte = node_bitmap[i];
+    if (byte) {
+      uint8_t j = 0;
+      while (j < 8) {
+        if (byte & (1 << j)) {
+          node_indices[count++] = (d3_word)(i * 8 + j);
+        }
+        j++;
+      }
     }
-    empty = 0;
-    all_ids_size += part->num_shells;
+    i++;
   }
 
   END_PROFILE_FUNC();
-  return all_ids;
-}
\ No newline at end of file
+  return node_indices;
+}
+
+int _d3plot_part_compare_node_ids(const void *lhs, const void *rhs) {
+  const d3_word l = *(const d3_word *)lhs;
+  const d3_word r = *(const d3_word *)rhs;
+  return (l > r) - (l < r);
+}
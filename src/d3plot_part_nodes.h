@@ -54,7 +54,8 @@ extern "C" {
  * The return value needs to be deallocated by free. This functions takes a
  * d3plot_part_get_node_ids_params struct. You can set the values of the struct
  * to optimize the functions performance. If you set params to NULL all data
- * will be retrieved, allocated and deallocated inside this one function call*/
+ * will be retrieved, allocated and deallocated inside this one function call.
+ * Nodes whose index is out of the bounds of node_ids are skipped*/
 d3_word *d3plot_part_get_node_ids2(
     d3plot_file *plot_file, const d3plot_part *part, size_t *num_part_node_ids,
     const d3_word *node_ids, size_t num_nodes, const d3_word *solid_ids,
@@ -94,6 +95,16 @@ size_t d3plot_part_get_num_elements(const d3plot_part *part);
 d3_word *d3plot_part_get_all_element_ids(const d3plot_part *part,
                                          size_t *num_ids);
 
+/***** Private Functions ********/
+
+/* Returns all indices of the bits that are set in node_bitmap in ascending
+ * order. node_bitmap needs to hold at least (num_nodes+7)/8 bytes*/
+d3_word *_d3plot_part_collect_node_indices(const uint8_t *node_bitmap,
+                                           d3_word num_nodes,
+                                           size_t *num_node_indices);
+/* qsort comparison function for d3_word*/
+int _d3plot_part_compare_node_ids(const void *lhs, const void *rhs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,351 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* PTITLE is always 72 bytes*/
+#define PART_TITLE_LENGTH 72
+
+typedef struct {
+  const char *title;
+  size_t index;
+} d3plot_part_titles_entry;
+
+const d3plot_part_titles *d3plot_get_part_titles(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+#ifndef NO_THREAD_SAFETY
+  sync_lock(&plot_file->part_titles_mutex);
+#endif
+  if (!plot_file->part_titles) {
+    d3plot_part_titles titles;
+    if (_d3plot_part_titles_read(plot_file, &titles)) {
+      plot_file->part_titles = malloc(sizeof(d3plot_part_titles));
+      *plot_file->part_titles = titles;
+    }
+  }
+  const d3plot_part_titles *titles = plot_file->part_titles;
+#ifndef NO_THREAD_SAFETY
+  sync_unlock(&plot_file->part_titles_mutex);
+#endif
+
+  END_PROFILE_FUNC();
+  return titles;
+}
+
+const char *d3plot_part_titles_get(const d3plot_part_titles *titles,
+                                   size_t part_index) {
+  return &titles->title_pool[titles->title_offsets[part_index]];
+}
+
+size_t d3plot_find_part(d3plot_file *plot_file, const char *title) {
+  BEGIN_PROFILE_FUNC();
+
+  const d3plot_part_titles *titles = d3plot_get_part_titles(plot_file);
+  if (!titles) {
+    END_PROFILE_FUNC();
+    return (size_t)~0;
+  }
+
+  size_t n = strlen(title);
+  while (n > 0 && title[n - 1] == ' ') {
+    n--;
+  }
+
+  /* The title itself is sorted before all titles which only start with it*/
+  const size_t i = _d3plot_part_titles_lower_bound(titles, title, n);
+  if (i < titles->num_parts) {
+    const char *part_title =
+        d3plot_part_titles_get(titles, titles->sorted_indices[i]);
+    if (strncmp(part_title, title, n) == 0 && part_title[n] == '\0') {
+      END_PROFILE_FUNC();
+      return titles->sorted_indices[i];
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return (size_t)~0;
+}
+
+size_t *d3plot_search_parts(d3plot_file *plot_file, const char *pattern,
+                            int mode, size_t *num_parts) {
+  BEGIN_PROFILE_FUNC();
+  *num_parts = 0;
+
+  const d3plot_part_titles *titles = d3plot_get_part_titles(plot_file);
+  if (!titles) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  const int ignore_case = (mode & D3PLOT_PART_SEARCH_IGNORE_CASE) != 0;
+  mode &= ~D3PLOT_PART_SEARCH_IGNORE_CASE;
+  if (mode != D3PLOT_PART_SEARCH_EXACT && mode != D3PLOT_PART_SEARCH_PREFIX &&
+      mode != D3PLOT_PART_SEARCH_WILDCARD) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid part search mode: %d", mode);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  size_t n = strlen(pattern);
+  if (mode == D3PLOT_PART_SEARCH_EXACT) {
+    while (n > 0 && pattern[n - 1] == ' ') {
+      n--;
+    }
+  }
+
+  /* Mark the matching parts first, so that the indices are returned in
+   * ascending order*/
+  uint8_t *matches = calloc(titles->num_parts, sizeof(uint8_t));
+
+  if (mode != D3PLOT_PART_SEARCH_WILDCARD && !ignore_case) {
+    /* All titles starting with pattern are next to each other in
+     * sorted_indices*/
+    size_t i = _d3plot_part_titles_lower_bound(titles, pattern, n);
+    while (i < titles->num_parts) {
+      const size_t index = titles->sorted_indices[i];
+      const char *title = d3plot_part_titles_get(titles, index);
+      if (strncmp(title, pattern, n) != 0) {
+        break;
+      }
+      if (mode == D3PLOT_PART_SEARCH_PREFIX || title[n] == '\0') {
+        matches[index] = 1;
+        (*num_parts)++;
+      }
+      i++;
+    }
+  } else {
+    size_t i = 0;
+    while (i < titles->num_parts) {
+      const char *title = d3plot_part_titles_get(titles, i);
+      int match;
+      if (mode == D3PLOT_PART_SEARCH_WILDCARD) {
+        match = _d3plot_part_titles_match(pattern, title, ignore_case);
+      } else {
+        size_t j = 0;
+        while (j < n && title[j] != '\0' &&
+               tolower((unsigned char)title[j]) ==
+                   tolower((unsigned char)pattern[j])) {
+          j++;
+        }
+        match = j == n && (mode == D3PLOT_PART_SEARCH_PREFIX ||
+                           title[n] == '\0');
+      }
+
+      if (match) {
+        matches[i] = 1;
+        (*num_parts)++;
+      }
+      i++;
+    }
+  }
+
+  size_t *indices = NULL;
+  if (*num_parts > 0) {
+    indices = malloc(*num_parts * sizeof(size_t));
+    size_t i = 0, j = 0;
+    while (i < titles->num_parts) {
+      if (matches[i]) {
+        indices[j++] = i;
+      }
+      i++;
+    }
+  }
+  free(matches);
+
+  END_PROFILE_FUNC();
+  return indices;
+}
+
+void d3plot_free_part_titles(d3plot_part_titles *titles) {
+  free(titles->ids);
+  free(titles->title_pool);
+  free(titles->title_offsets);
+  free(titles->sorted_indices);
+
+  titles->ids = NULL;
+  titles->title_pool = NULL;
+  titles->title_offsets = NULL;
+  titles->sorted_indices = NULL;
+  titles->num_parts = 0;
+}
+
+int _d3plot_part_titles_read(d3plot_file *plot_file,
+                             d3plot_part_titles *titles) {
+  BEGIN_PROFILE_FUNC();
+
+  memset(titles, 0, sizeof(d3plot_part_titles));
+
+  titles->ids = d3plot_read_part_ids(plot_file, &titles->num_parts);
+  if (plot_file->error_string) {
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  titles->title_pool = malloc(titles->num_parts * (PART_TITLE_LENGTH + 1) + 1);
+  titles->title_offsets = malloc(titles->num_parts * sizeof(size_t));
+  titles->sorted_indices = malloc(titles->num_parts * sizeof(size_t));
+
+  /* Without part titles every title is empty*/
+  char **part_titles = NULL;
+  if (plot_file->data_pointers[D3PLT_PTR_PART_TITLES] != 0) {
+    size_t num_titles;
+    part_titles = d3plot_read_part_titles(plot_file, &num_titles);
+    if (plot_file->error_string) {
+      d3plot_free_part_titles(titles);
+      END_PROFILE_FUNC();
+      return 0;
+    }
+    if (num_titles != titles->num_parts) {
+      size_t i = 0;
+      while (i < num_titles) {
+        free(part_titles[i]);
+        i++;
+      }
+      free(part_titles);
+      ERROR_AND_NO_RETURN_F_PTR("The number of part titles (%zu) does not "
+                                "match the number of parts (%zu)",
+                                num_titles, titles->num_parts);
+      d3plot_free_part_titles(titles);
+      END_PROFILE_FUNC();
+      return 0;
+    }
+  }
+
+  size_t pool_size = 0;
+  size_t i = 0;
+  while (i < titles->num_parts) {
+    size_t n = 0;
+    if (part_titles) {
+      n = PART_TITLE_LENGTH;
+      while (n > 0 &&
+             (part_titles[i][n - 1] == ' ' || part_titles[i][n - 1] == '\0')) {
+        n--;
+      }
+      memcpy(&titles->title_pool[pool_size], part_titles[i], n);
+      free(part_titles[i]);
+    }
+
+    titles->title_offsets[i] = pool_size;
+    titles->title_pool[pool_size + n] = '\0';
+    pool_size += n + 1;
+    i++;
+  }
+  free(part_titles);
+
+  /* Give the unused memory of the pool back*/
+  titles->title_pool = realloc(titles->title_pool, pool_size + 1);
+
+  d3plot_part_titles_entry *entries =
+      malloc(titles->num_parts * sizeof(d3plot_part_titles_entry));
+  i = 0;
+  while (i < titles->num_parts) {
+    entries[i].title = d3plot_part_titles_get(titles, i);
+    entries[i].index = i;
+    i++;
+  }
+  qsort(entries, titles->num_parts, sizeof(d3plot_part_titles_entry),
+        _d3plot_part_titles_compare);
+  i = 0;
+  while (i < titles->num_parts) {
+    titles->sorted_indices[i] = entries[i].index;
+    i++;
+  }
+  free(entries);
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+size_t _d3plot_part_titles_lower_bound(const d3plot_part_titles *titles,
+                                       const char *str, size_t n) {
+  size_t low = 0, high = titles->num_parts;
+  while (low < high) {
+    const size_t mid = low + (high - low) / 2;
+    const char *title =
+        d3plot_part_titles_get(titles, titles->sorted_indices[mid]);
+    if (strncmp(title, str, n) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+int _d3plot_part_titles_compare(const void *lhs, const void *rhs) {
+  const d3plot_part_titles_entry *l = (const d3plot_part_titles_entry *)lhs;
+  const d3plot_part_titles_entry *r = (const d3plot_part_titles_entry *)rhs;
+
+  const int cmp = strcmp(l->title, r->title);
+  if (cmp != 0) {
+    return cmp;
+  }
+  return (l->index > r->index) - (l->index < r->index);
+}
+
+int _d3plot_part_titles_match(const char *pattern, const char *title,
+                              int ignore_case) {
+  /* The position after the last '*' and the title position it is matched
+   * against, so that we can backtrack if the rest does not match*/
+  const char *star = NULL;
+  const char *star_title = NULL;
+
+  while (*title != '\0') {
+    if (*pattern == '*') {
+      star = ++pattern;
+      star_title = title;
+      continue;
+    }
+
+    if (*pattern != '\0' &&
+        (*pattern == '?' || *pattern == *title ||
+         (ignore_case && tolower((unsigned char)*pattern) ==
+                             tolower((unsigned char)*title)))) {
+      pattern++;
+      title++;
+      continue;
+    }
+
+    if (!star) {
+      return 0;
+    }
+
+    /* Let the last '*' match one more character*/
+    pattern = star;
+    title = ++star_title;
+  }
+
+  while (*pattern == '*') {
+    pattern++;
+  }
+  return *pattern == '\0';
+}
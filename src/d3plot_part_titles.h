@@ -0,0 +1,77 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_PART_TITLES_H
+#define D3PLOT_PART_TITLES_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns the ids and titles of all parts. They are read on the first call and
+ * kept until d3plot_close is called, so the return value must not be
+ * deallocated. Returns NULL and sets error_string on failure*/
+const d3plot_part_titles *d3plot_get_part_titles(d3plot_file *plot_file);
+/* Returns the title of a part with its trailing spaces removed. part_index is
+ * the same as the one of d3plot_read_part*/
+const char *d3plot_part_titles_get(const d3plot_part_titles *titles,
+                                   size_t part_index);
+/* Returns the index of the first part whose title equals title or (size_t)~0
+ * if there is no such part. Trailing spaces of title are ignored*/
+size_t d3plot_find_part(d3plot_file *plot_file, const char *title);
+/* Returns the indices of all parts whose title matches pattern, sorted
+ * ascending. mode is one of the D3PLOT_PART_SEARCH_* values. With
+ * D3PLOT_PART_SEARCH_WILDCARD '*' matches any number of characters and '?'
+ * matches a single character. The return value needs to be deallocated by
+ * free*/
+size_t *d3plot_search_parts(d3plot_file *plot_file, const char *pattern,
+                            int mode, size_t *num_parts);
+/* Deallocates all memory of titles, but not titles itself*/
+void d3plot_free_part_titles(d3plot_part_titles *titles);
+
+/***** Private Functions ********/
+/* Reads the ids and titles of all parts. Returns 0 on failure*/
+int _d3plot_part_titles_read(d3plot_file *plot_file,
+                             d3plot_part_titles *titles);
+/* Returns the index into sorted_indices of the first title which is greater
+ * than or equal to the first n characters of str*/
+size_t _d3plot_part_titles_lower_bound(const d3plot_part_titles *titles,
+                                       const char *str, size_t n);
+/* Compares two d3plot_part_titles_entry by their titles and then by their
+ * indices. Used for qsort*/
+int _d3plot_part_titles_compare(const void *lhs, const void *rhs);
+/* Returns 1 if title matches the wildcard pattern*/
+int _d3plot_part_titles_match(const char *pattern, const char *title,
+                              int ignore_case);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,415 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+d3plot_reduction d3plot_reduce_elements(d3plot_file *plot_file, int id_type,
+                                        int quantity, int surface, int op,
+                                        size_t first_state,
+                                        size_t num_states) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_reduction reduction;
+  memset(&reduction, 0, sizeof(reduction));
+
+  if (op < D3PLOT_REDUCE_MAX || op > D3PLOT_REDUCE_LAST) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid reduce operation: %d", op);
+    END_PROFILE_FUNC();
+    return reduction;
+  }
+
+  if (num_states == 0 || first_state >= plot_file->num_states ||
+      num_states > plot_file->num_states - first_state) {
+    ERROR_AND_NO_RETURN_F_PTR("The states [%zu, %zu) are out of bounds",
+                              first_state, first_state + num_states);
+    END_PROFILE_FUNC();
+    return reduction;
+  }
+
+  size_t num_chunks = 1;
+#if !defined(NO_THREAD_SAFETY) && !defined(PROFILING)
+  /* Every thread reads whole states, so that one state per thread is already
+   * worth it. The profiling can not be used on multiple threads*/
+  num_chunks = thread_num_processors();
+  if (num_chunks > num_states) {
+    num_chunks = num_states;
+  }
+  if (num_chunks == 0) {
+    num_chunks = 1;
+  }
+#endif
+
+  reduction = _d3plot_reduce_elements(plot_file, id_type, quantity, surface,
+                                      op, first_state, num_states, num_chunks);
+
+  END_PROFILE_FUNC();
+  return reduction;
+}
+
+d3plot_reduction _d3plot_reduce_elements(d3plot_file *plot_file, int id_type,
+                                         int quantity, int surface, int op,
+                                         size_t first_state, size_t num_states,
+                                         size_t num_chunks) {
+  if (num_chunks <= 1) {
+    return _d3plot_reduce_states(plot_file, id_type, quantity, surface, op,
+                                 first_state, num_states);
+  }
+  if (num_chunks > num_states) {
+    num_chunks = num_states;
+  }
+
+  d3plot_reduce_chunk *chunks =
+      malloc(num_chunks * sizeof(d3plot_reduce_chunk));
+  size_t c = 0;
+  while (c < num_chunks) {
+    d3plot_reduce_chunk *chunk = &chunks[c];
+    chunk->plot_file = *plot_file;
+    chunk->plot_file.error_string = NULL;
+    chunk->plot_file.buffer.error_string = NULL;
+    chunk->id_type = id_type;
+    chunk->quantity = quantity;
+    chunk->surface = surface;
+    chunk->op = op;
+    chunk->first_state = first_state + num_states * c / num_chunks;
+    chunk->num_states =
+        first_state + num_states * (c + 1) / num_chunks - chunk->first_state;
+    c++;
+  }
+
+#ifndef NO_THREAD_SAFETY
+  /* The first chunk is reduced by this thread*/
+  thread_t *threads = malloc(num_chunks * sizeof(thread_t));
+  uint8_t *started = calloc(num_chunks, sizeof(uint8_t));
+  c = 1;
+  while (c < num_chunks) {
+    started[c] =
+        thread_create(&threads[c], _d3plot_reduce_chunk, &chunks[c]) == 0;
+    c++;
+  }
+  _d3plot_reduce_chunk(&chunks[0]);
+  c = 1;
+  while (c < num_chunks) {
+    if (started[c]) {
+      thread_join(&threads[c]);
+    } else {
+      _d3plot_reduce_chunk(&chunks[c]);
+    }
+    c++;
+  }
+  free(threads);
+  free(started);
+#else
+  c = 0;
+  while (c < num_chunks) {
+    _d3plot_reduce_chunk(&chunks[c]);
+    c++;
+  }
+#endif
+
+  /* Combine the chunks in the order of their states, so that the first state
+   * of equal values is kept*/
+  d3plot_reduction reduction = chunks[0].reduction;
+  c = 0;
+  while (c < num_chunks) {
+    d3plot_reduce_chunk *chunk = &chunks[c];
+    if (chunk->plot_file.error_string && !plot_file->error_string) {
+      plot_file->error_string = chunk->plot_file.error_string;
+      chunk->plot_file.error_string = NULL;
+    } else if (c != 0 && !plot_file->error_string &&
+               !d3plot_combine_reductions(&reduction, &chunk->reduction,
+                                          op)) {
+      ERROR_AND_NO_RETURN_F_PTR(
+          "The states from %zu have %zu instead of %zu elements",
+          chunk->first_state, chunk->reduction.num_elements,
+          reduction.num_elements);
+    }
+
+    if (c != 0) {
+      d3plot_free_reduction(&chunk->reduction);
+    }
+    free(chunk->plot_file.error_string);
+    free(chunk->plot_file.buffer.error_string);
+    c++;
+  }
+  free(chunks);
+
+  if (plot_file->error_string) {
+    d3plot_free_reduction(&reduction);
+  }
+
+  return reduction;
+}
+
+void _d3plot_reduce_chunk(void *chunk) {
+  d3plot_reduce_chunk *c = (d3plot_reduce_chunk *)chunk;
+  c->reduction =
+      _d3plot_reduce_states(&c->plot_file, c->id_type, c->quantity,
+                            c->surface, c->op, c->first_state, c->num_states);
+}
+
+d3plot_reduction _d3plot_reduce_states(d3plot_file *plot_file, int id_type,
+                                       int quantity, int surface, int op,
+                                       size_t first_state, size_t num_states) {
+  d3plot_reduction reduction;
+  memset(&reduction, 0, sizeof(reduction));
+
+  /* The first state initializes the reduction*/
+  reduction.values =
+      _d3plot_read_element_quantity(plot_file, first_state, id_type, quantity,
+                                    surface, NULL, &reduction.num_elements);
+  if (plot_file->error_string || reduction.num_elements == 0) {
+    return reduction;
+  }
+
+  reduction.states = malloc(reduction.num_elements * sizeof(size_t));
+  size_t i = 0;
+  while (i < reduction.num_elements) {
+    reduction.states[i] = first_state;
+    i++;
+  }
+
+  /* Reuse one array for the values of all other states*/
+  double *state_values = NULL;
+  if (num_states > 1) {
+    state_values = malloc(reduction.num_elements * sizeof(double));
+  }
+
+  size_t state = first_state + 1;
+  while (state < first_state + num_states) {
+    size_t num_elements = reduction.num_elements;
+    _d3plot_read_element_quantity(plot_file, state, id_type, quantity, surface,
+                                  state_values, &num_elements);
+    if (plot_file->error_string) {
+      free(state_values);
+      d3plot_free_reduction(&reduction);
+      return reduction;
+    }
+
+    i = 0;
+    while (i < reduction.num_elements) {
+      _d3plot_reduce_fold(&reduction, i, state_values[i], state, op);
+      i++;
+    }
+
+    state++;
+  }
+
+  free(state_values);
+
+  return reduction;
+}
+
+int d3plot_combine_reductions(d3plot_reduction *reduction,
+                              const d3plot_reduction *other, int op) {
+  if (reduction->num_elements != other->num_elements) {
+    return 0;
+  }
+
+  size_t i = 0;
+  while (i < reduction->num_elements) {
+    _d3plot_reduce_fold(reduction, i, other->values[i], other->states[i], op);
+    i++;
+  }
+
+  return 1;
+}
+
+void d3plot_free_reduction(d3plot_reduction *reduction) {
+  free(reduction->values);
+  free(reduction->states);
+
+  reduction->values = NULL;
+  reduction->states = NULL;
+  reduction->num_elements = 0;
+}
+
+double *_d3plot_read_element_quantity(d3plot_file *plot_file, size_t state,
+                                      int id_type, int quantity, int surface,
+                                      double *values, size_t *num_elements) {
+  BEGIN_PROFILE_FUNC();
+
+  /* A given array can only hold as many elements as it has been given for*/
+  const size_t capacity = values ? *num_elements : 0;
+  *num_elements = 0;
+
+  if (quantity < 0 || quantity > D3PLOT_REDUCE_PLASTIC_STRAIN) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid quantity: %d", quantity);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+  if (id_type != D3PLOT_ID_TYPE_SOLID &&
+      (surface < D3PLOT_SHELL_SURFACE_MID ||
+       surface > D3PLOT_SHELL_SURFACE_ABS_MAX)) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid shell surface: %d", surface);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  d3plot_solid *solids = NULL;
+  d3plot_thick_shell *thick_shells = NULL;
+  d3plot_shell *shells = NULL;
+  const d3plot_surface *surfaces = NULL;
+  const d3plot_tensor *tensors = NULL;
+  const double *strains = NULL;
+  size_t stride;
+
+  switch (id_type) {
+  case D3PLOT_ID_TYPE_SOLID:
+    solids = d3plot_read_solids_state(plot_file, state, num_elements);
+    if (solids) {
+      tensors = &solids[0].stress;
+      strains = &solids[0].effective_plastic_strain;
+    }
+    stride = sizeof(d3plot_solid);
+    break;
+  case D3PLOT_ID_TYPE_THICK_SHELL:
+    thick_shells =
+        d3plot_read_thick_shells_state(plot_file, state, num_elements);
+    if (thick_shells) {
+      surfaces = &thick_shells[0].mid;
+      if (surface == D3PLOT_SHELL_SURFACE_INNER) {
+        surfaces = &thick_shells[0].inner;
+      } else if (surface == D3PLOT_SHELL_SURFACE_OUTER) {
+        surfaces = &thick_shells[0].outer;
+      }
+    }
+    stride = sizeof(d3plot_thick_shell);
+    break;
+  case D3PLOT_ID_TYPE_SHELL:
+    shells = d3plot_read_shells_state(plot_file, state, num_elements);
+    if (shells) {
+      surfaces = &shells[0].mid;
+      if (surface == D3PLOT_SHELL_SURFACE_INNER) {
+        surfaces = &shells[0].inner;
+      } else if (surface == D3PLOT_SHELL_SURFACE_OUTER) {
+        surfaces = &shells[0].outer;
+      }
+    }
+    stride = sizeof(d3plot_shell);
+    break;
+  default:
+    ERROR_AND_NO_RETURN_F_PTR("Can not reduce elements of id type %d",
+                              id_type);
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  if (plot_file->error_string || *num_elements == 0) {
+    END_PROFILE_FUNC();
+    return values;
+  }
+
+  if (values && *num_elements != capacity) {
+    ERROR_AND_NO_RETURN_F_PTR("State %zu has %zu instead of %zu elements",
+                              state, *num_elements, capacity);
+    free(solids);
+    d3plot_free_thick_shells_state(thick_shells);
+    d3plot_free_shells_state(shells);
+    END_PROFILE_FUNC();
+    return values;
+  }
+
+  if (surfaces) {
+    tensors = &surfaces->stress;
+    strains = &surfaces->effective_plastic_strain;
+  }
+
+  if (!values) {
+    values = malloc(*num_elements * sizeof(double));
+  }
+
+  if (id_type != D3PLOT_ID_TYPE_SOLID &&
+      (surface == D3PLOT_SHELL_SURFACE_MEAN ||
+       surface == D3PLOT_SHELL_SURFACE_ABS_MAX)) {
+    /* Aggregate all integration points first*/
+    d3plot_surfaces aggregated = d3plot_alloc_surfaces(*num_elements, 0);
+    if (shells) {
+      d3plot_get_shells_layer(shells, *num_elements, surface, &aggregated);
+    } else {
+      d3plot_get_thick_shells_layer(thick_shells, *num_elements, surface,
+                                    &aggregated);
+    }
+
+    if (quantity == D3PLOT_REDUCE_PLASTIC_STRAIN) {
+      memcpy(values, aggregated.effective_plastic_strain,
+             *num_elements * sizeof(double));
+    } else {
+      double *outputs[D3PLOT_DERIVED_COUNT] = {NULL};
+      outputs[quantity] = values;
+      d3plot_compute_derived_soa((const double *const *)aggregated.stress,
+                                 *num_elements, outputs);
+    }
+
+    d3plot_free_surfaces(&aggregated);
+  } else if (quantity == D3PLOT_REDUCE_PLASTIC_STRAIN) {
+    const uint8_t *data = (const uint8_t *)strains;
+    size_t i = 0;
+    while (i < *num_elements) {
+      values[i] = *(const double *)&data[i * stride];
+      i++;
+    }
+  } else {
+    double *outputs[D3PLOT_DERIVED_COUNT] = {NULL};
+    outputs[quantity] = values;
+    d3plot_compute_derived(tensors, stride, *num_elements, outputs);
+  }
+
+  free(solids);
+  d3plot_free_thick_shells_state(thick_shells);
+  d3plot_free_shells_state(shells);
+
+  END_PROFILE_FUNC();
+  return values;
+}
+
+void _d3plot_reduce_fold(d3plot_reduction *reduction, size_t i, double value,
+                         size_t state, int op) {
+  int replace;
+  switch (op) {
+  case D3PLOT_REDUCE_MAX:
+    replace = value > reduction->values[i];
+    break;
+  case D3PLOT_REDUCE_MIN:
+    replace = value < reduction->values[i];
+    break;
+  case D3PLOT_REDUCE_ABS_MAX:
+    replace = fabs(value) > fabs(reduction->values[i]);
+    break;
+  default:
+    replace = state >= reduction->states[i];
+    break;
+  }
+
+  if (replace) {
+    reduction->values[i] = value;
+    reduction->states[i] = state;
+  }
+}
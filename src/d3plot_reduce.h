@@ -0,0 +1,100 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_REDUCE_H
+#define D3PLOT_REDUCE_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reduces a quantity of all elements of a type over the states [first_state,
+ * first_state+num_states) using op (one of D3PLOT_REDUCE_MAX,
+ * D3PLOT_REDUCE_MIN, D3PLOT_REDUCE_ABS_MAX and D3PLOT_REDUCE_LAST). id_type is
+ * one of D3PLOT_ID_TYPE_SOLID, D3PLOT_ID_TYPE_THICK_SHELL and
+ * D3PLOT_ID_TYPE_SHELL. quantity is one of the D3PLOT_DERIVED_* values, which
+ * are computed out of the stresses, or D3PLOT_REDUCE_PLASTIC_STRAIN. surface
+ * is one of the D3PLOT_SHELL_SURFACE_* values and is ignored for solids. The
+ * states are split into ranges which are reduced on multiple threads, each of
+ * which holds one state in memory at a time. If the same value occurs in
+ * multiple states the first one is returned. The return value needs to be
+ * deallocated by d3plot_free_reduction*/
+d3plot_reduction d3plot_reduce_elements(d3plot_file *plot_file, int id_type,
+                                        int quantity, int surface, int op,
+                                        size_t first_state, size_t num_states);
+/* Combines the reduction of states which come after the ones of reduction into
+ * reduction. d3plot_reduce_elements uses it to join the state ranges reduced
+ * by its threads, and it can also join the results of multiple d3plot_file
+ * handles. Returns 0 if the number of elements differ*/
+int d3plot_combine_reductions(d3plot_reduction *reduction,
+                              const d3plot_reduction *other, int op);
+/* Deallocates all memory of reduction*/
+void d3plot_free_reduction(d3plot_reduction *reduction);
+
+/***** Private Functions ********/
+typedef struct {
+  /* A shallow copy of the d3plot_file with its own error strings. It shares
+   * the files, which can be read on multiple threads*/
+  d3plot_file plot_file;
+  int id_type, quantity, surface, op;
+  size_t first_state, num_states;
+  d3plot_reduction reduction;
+} d3plot_reduce_chunk;
+
+/* The same as d3plot_reduce_elements, but the states are split into
+ * num_chunks chunks which are reduced on their own threads and then combined.
+ * The arguments need to be valid*/
+d3plot_reduction _d3plot_reduce_elements(d3plot_file *plot_file, int id_type,
+                                         int quantity, int surface, int op,
+                                         size_t first_state, size_t num_states,
+                                         size_t num_chunks);
+/* Reduces the states of a d3plot_reduce_chunk into its reduction. Takes a void
+ * pointer so that it can be used as a thread function*/
+void _d3plot_reduce_chunk(void *chunk);
+/* Reduces the states one after the other into a new reduction*/
+d3plot_reduction _d3plot_reduce_states(d3plot_file *plot_file, int id_type,
+                                       int quantity, int surface, int op,
+                                       size_t first_state, size_t num_states);
+/* Reads quantity of all elements of id_type at state and writes it into values.
+ * If values is NULL a new array is allocated. Otherwise num_elements needs to
+ * hold the number of elements values can store and it is an error if the
+ * state has a different number of elements. Returns values or NULL on
+ * failure*/
+double *_d3plot_read_element_quantity(d3plot_file *plot_file, size_t state,
+                                      int id_type, int quantity, int surface,
+                                      double *values, size_t *num_elements);
+/* Folds the value of a state into the reduction using op*/
+void _d3plot_reduce_fold(d3plot_reduction *reduction, size_t i, double value,
+                         size_t state, int op);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
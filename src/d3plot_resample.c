@@ -0,0 +1,260 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int d3plot_find_time_interval(const d3plot_file *plot_file, double time,
+                              size_t *state, double *weight) {
+  BEGIN_PROFILE_FUNC();
+
+  *state = 0;
+  *weight = 0.0;
+
+  if (plot_file->num_states == 0) {
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  const double *times = plot_file->state_times;
+  const size_t last = plot_file->num_states - 1;
+  if (time <= times[0]) {
+    END_PROFILE_FUNC();
+    return 1;
+  }
+  if (time >= times[last]) {
+    *state = last;
+    END_PROFILE_FUNC();
+    return 1;
+  }
+
+  /* The last state whose time is not larger than time*/
+  size_t low = 0, high = last;
+  while (high - low > 1) {
+    const size_t mid = low + (high - low) / 2;
+    if (times[mid] <= time) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+
+  *state = low;
+  const double dt = times[low + 1] - times[low];
+  if (dt > 0.0) {
+    *weight = (time - times[low]) / dt;
+  }
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+size_t d3plot_resample_num_values(const d3plot_file *plot_file, int id_type,
+                                  int quantity) {
+  switch (id_type) {
+  case D3PLOT_ID_TYPE_NODE:
+    if (quantity == D3PLOT_RESAMPLE_NODE_TEMPERATURE) {
+      return plot_file->control_data.numnp *
+             plot_file->control_data.num_temperatures;
+    }
+    return plot_file->control_data.numnp * 3;
+  case D3PLOT_ID_TYPE_SOLID:
+    return plot_file->control_data.nel8;
+  case D3PLOT_ID_TYPE_THICK_SHELL:
+    return plot_file->control_data.nelt;
+  case D3PLOT_ID_TYPE_SHELL:
+    return plot_file->control_data.nel4;
+  default:
+    return 0;
+  }
+}
+
+int d3plot_resample_nodes(d3plot_file *plot_file, int quantity,
+                          const double *times, size_t num_times,
+                          double *values) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (quantity < D3PLOT_RESAMPLE_NODE_COORDINATES ||
+      quantity > D3PLOT_RESAMPLE_NODE_TEMPERATURE) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid node quantity: %d", quantity);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  const int rv = _d3plot_resample(plot_file, D3PLOT_ID_TYPE_NODE, quantity, 0,
+                                  times, num_times, values);
+
+  END_PROFILE_FUNC();
+  return rv;
+}
+
+int d3plot_resample_elements(d3plot_file *plot_file, int id_type,
+                             int quantity, int surface, const double *times,
+                             size_t num_times, double *values) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (id_type != D3PLOT_ID_TYPE_SOLID &&
+      id_type != D3PLOT_ID_TYPE_THICK_SHELL &&
+      id_type != D3PLOT_ID_TYPE_SHELL) {
+    ERROR_AND_NO_RETURN_F_PTR("Invalid id type: %d", id_type);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  const int rv = _d3plot_resample(plot_file, id_type, quantity, surface, times,
+                                  num_times, values);
+
+  END_PROFILE_FUNC();
+  return rv;
+}
+
+double *_d3plot_read_node_quantity(d3plot_file *plot_file, size_t state,
+                                   int quantity, size_t *num_values) {
+  size_t num_nodes;
+  double *data;
+
+  switch (quantity) {
+  case D3PLOT_RESAMPLE_NODE_COORDINATES:
+    data = d3plot_read_node_coordinates(plot_file, state, &num_nodes);
+    break;
+  case D3PLOT_RESAMPLE_NODE_VELOCITY:
+    data = d3plot_read_node_velocity(plot_file, state, &num_nodes);
+    break;
+  case D3PLOT_RESAMPLE_NODE_ACCELERATION:
+    data = d3plot_read_node_acceleration(plot_file, state, &num_nodes);
+    break;
+  case D3PLOT_RESAMPLE_NODE_DISPLACEMENT:
+    data = d3plot_read_node_displacement(plot_file, state, &num_nodes);
+    break;
+  default:
+    data = d3plot_read_node_temperature(plot_file, state, &num_nodes);
+    break;
+  }
+
+  if (plot_file->error_string) {
+    free(data);
+    *num_values = 0;
+    return NULL;
+  }
+
+  *num_values = d3plot_resample_num_values(plot_file, D3PLOT_ID_TYPE_NODE,
+                                           quantity);
+  return data;
+}
+
+int _d3plot_resample(d3plot_file *plot_file, int id_type, int quantity,
+                     int surface, const double *times, size_t num_times,
+                     double *values) {
+  const size_t num_values =
+      d3plot_resample_num_values(plot_file, id_type, quantity);
+
+  /* The two most recently read states. Consecutive times mostly need the
+   * same states or share one of them*/
+  double *buffers[2] = {NULL, NULL};
+  size_t buffer_states[2] = {SIZE_MAX, SIZE_MAX};
+
+  size_t i = 0;
+  while (i < num_times) {
+    size_t state;
+    double weight;
+    if (!d3plot_find_time_interval(plot_file, times[i], &state, &weight)) {
+      ERROR_AND_NO_RETURN_PTR("There are no states to resample");
+      break;
+    }
+
+    const size_t needed[2] = {state, weight > 0.0 ? state + 1 : state};
+
+    size_t n = 0;
+    while (n < 2) {
+      if (buffer_states[0] != needed[n] && buffer_states[1] != needed[n]) {
+        /* Replace the buffer, which is not needed by this time*/
+        const size_t b = buffer_states[0] == needed[1 - n] ? 1 : 0;
+        size_t num_read = num_values;
+
+        if (id_type == D3PLOT_ID_TYPE_NODE) {
+          free(buffers[b]);
+          buffers[b] = _d3plot_read_node_quantity(plot_file, needed[n],
+                                                  quantity, &num_read);
+        } else {
+          double *data = _d3plot_read_element_quantity(
+              plot_file, needed[n], id_type, quantity, surface, buffers[b],
+              &num_read);
+          if (!data) {
+            free(buffers[b]);
+          }
+          buffers[b] = data;
+        }
+
+        /* The element readers return the reused buffer on failure, so check
+         * the error before the number of values to keep the real error*/
+        if (!buffers[b] || plot_file->error_string) {
+          buffer_states[b] = SIZE_MAX;
+          break;
+        }
+        if (num_read != num_values) {
+          ERROR_AND_NO_RETURN_F_PTR("State %zu has %zu instead of %zu values",
+                                    needed[n], num_read, num_values);
+          break;
+        }
+
+        buffer_states[b] = needed[n];
+      }
+
+      n++;
+    }
+
+    if (plot_file->error_string) {
+      break;
+    }
+
+    const double *a = buffers[buffer_states[0] == needed[0] ? 0 : 1];
+    const double *b = buffers[buffer_states[0] == needed[1] ? 0 : 1];
+    _d3plot_lerp(a, b, weight, num_values, &values[i * num_values]);
+
+    i++;
+  }
+
+  free(buffers[0]);
+  free(buffers[1]);
+
+  return plot_file->error_string == NULL;
+}
+
+void _d3plot_lerp(const double *a, const double *b, double weight,
+                  size_t num_values, double *values) {
+  /* A simple loop, which can be vectorized by the compiler*/
+  size_t i = 0;
+  while (i < num_values) {
+    values[i] = a[i] + weight * (b[i] - a[i]);
+
+    i++;
+  }
+}
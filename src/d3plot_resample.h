@@ -0,0 +1,80 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_RESAMPLE_H
+#define D3PLOT_RESAMPLE_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Finds the states which surround time. The value at time is
+ * (1-weight)*value[state]+weight*value[state+1]. Times before the first or
+ * after the last state are clamped to them (weight is 0). Returns 0 if there
+ * are no states*/
+int d3plot_find_time_interval(const d3plot_file *plot_file, double time,
+                              size_t *state, double *weight);
+/* Returns the number of values per time of d3plot_resample_nodes
+ * (id_type == D3PLOT_ID_TYPE_NODE) or d3plot_resample_elements (solids, thick
+ * shells or shells)*/
+size_t d3plot_resample_num_values(const d3plot_file *plot_file, int id_type,
+                                  int quantity);
+/* Linearly interpolates a node quantity (one of the D3PLOT_RESAMPLE_NODE_*
+ * values) of all nodes at every time of times and writes them into values,
+ * which needs to hold num_times*d3plot_resample_num_values values. Every
+ * state is only read once as long as times is sorted, since the states of
+ * the previous time are reused. Returns 0 and sets the error string on
+ * failure*/
+int d3plot_resample_nodes(d3plot_file *plot_file, int quantity,
+                          const double *times, size_t num_times,
+                          double *values);
+/* The same as d3plot_resample_nodes for a quantity of all elements of
+ * id_type. The arguments are the same as for d3plot_reduce_elements*/
+int d3plot_resample_elements(d3plot_file *plot_file, int id_type,
+                             int quantity, int surface, const double *times,
+                             size_t num_times, double *values);
+
+/***** Private Functions ********/
+/* Reads quantity of all nodes at state. Returns NULL on failure. The return
+ * value needs to be deallocated by free*/
+double *_d3plot_read_node_quantity(d3plot_file *plot_file, size_t state,
+                                   int quantity, size_t *num_values);
+/* Resamples a node (id_type == D3PLOT_ID_TYPE_NODE) or element quantity*/
+int _d3plot_resample(d3plot_file *plot_file, int id_type, int quantity,
+                     int surface, const double *times, size_t num_times,
+                     double *values);
+/* values = a + weight * (b - a)*/
+void _d3plot_lerp(const double *a, const double *b, double weight,
+                  size_t num_values, double *values);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
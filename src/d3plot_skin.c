@@ -0,0 +1,508 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "d3plot.h"
+#include "d3plot_error_macros.h"
+#include "profiling.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SKIN_NUM_SIDES 6
+#define SKIN_EMPTY ((size_t)~0)
+/* Set on a bucket if a second face with the same nodes has been found*/
+#define SKIN_MATCHED ((size_t)1 << (sizeof(size_t) * 8 - 1))
+#define SKIN_HASH_MULTIPLIER ((d3_word)11400714819323198485ULL)
+/* Hash the faces on multiple threads only if every thread gets at least this
+ * many elements*/
+#define SKIN_MIN_ELEMENTS_PER_THREAD 16384
+
+#define SKIN_ELEMENT_NODES(e)                                                  \
+  ((e) < num_solids ? solids[e].node_indices                                   \
+                    : thick_shells[(e) - num_solids].node_indices)
+
+#define SKIN_READ_ELEMENTS(el_func, el_type, els, num_els, name)               \
+  el_type *els = NULL;                                                         \
+  size_t num_els = 0;                                                          \
+  if (!plot_file->error_string) {                                              \
+    els = el_func(plot_file, &num_els);                                        \
+    if (plot_file->error_string) {                                             \
+      char *read_error = plot_file->error_string;                              \
+      plot_file->error_string = NULL;                                          \
+      ERROR_AND_NO_RETURN_F_PTR("Failed to read the " name " elements: %s",    \
+                                read_error);                                   \
+      free(read_error);                                                        \
+    }                                                                          \
+  }
+
+d3plot_skin d3plot_read_skin(d3plot_file *plot_file) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_skin skin;
+  memset(&skin, 0, sizeof(d3plot_skin));
+
+  SKIN_READ_ELEMENTS(d3plot_read_solid_elements, d3plot_solid_con, solids,
+                     num_solids, "solid");
+  SKIN_READ_ELEMENTS(d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
+                     thick_shells, num_thick_shells, "thick shell");
+
+  if (!plot_file->error_string) {
+    skin = d3plot_extract_skin(solids, num_solids, thick_shells,
+                               num_thick_shells);
+  }
+
+  free(solids);
+  free(thick_shells);
+
+  END_PROFILE_FUNC();
+  return skin;
+}
+
+d3plot_skin d3plot_read_part_skin(d3plot_file *plot_file,
+                                  const d3plot_part *part) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  d3plot_skin skin;
+  memset(&skin, 0, sizeof(d3plot_skin));
+
+  SKIN_READ_ELEMENTS(d3plot_read_solid_elements, d3plot_solid_con, solids,
+                     num_solids, "solid");
+  SKIN_READ_ELEMENTS(d3plot_read_thick_shell_elements, d3plot_thick_shell_con,
+                     thick_shells, num_thick_shells, "thick shell");
+
+  size_t *solid_indices = NULL, *thick_shell_indices = NULL;
+  if (!plot_file->error_string) {
+    solid_indices = _d3plot_part_element_indices(
+        plot_file, part->solid_ids, part->solid_indices, part->num_solids,
+        D3PLOT_ID_TYPE_SOLID, num_solids);
+  }
+  if (!plot_file->error_string) {
+    thick_shell_indices = _d3plot_part_element_indices(
+        plot_file, part->thick_shell_ids, part->thick_shell_indices,
+        part->num_thick_shells, D3PLOT_ID_TYPE_THICK_SHELL, num_thick_shells);
+  }
+
+  if (!plot_file->error_string) {
+    /* Gather the elements of the part so that only their faces are hashed*/
+    d3plot_solid_con *part_solids =
+        malloc(part->num_solids * sizeof(d3plot_solid_con));
+    d3plot_thick_shell_con *part_thick_shells =
+        malloc(part->num_thick_shells * sizeof(d3plot_thick_shell_con));
+
+    size_t i = 0;
+    while (i < part->num_solids) {
+      part_solids[i] = solids[solid_indices[i]];
+      i++;
+    }
+    i = 0;
+    while (i < part->num_thick_shells) {
+      part_thick_shells[i] = thick_shells[thick_shell_indices[i]];
+      i++;
+    }
+
+    skin = d3plot_extract_skin(part_solids, part->num_solids,
+                               part_thick_shells, part->num_thick_shells);
+
+    /* Let the faces refer to all elements instead of the ones of the part*/
+    i = 0;
+    while (i < skin.num_faces) {
+      if (skin.face_element_types[i] == D3PLOT_ID_TYPE_SOLID) {
+        skin.face_elements[i] = solid_indices[skin.face_elements[i]];
+      } else {
+        skin.face_elements[i] = thick_shell_indices[skin.face_elements[i]];
+      }
+      i++;
+    }
+
+    free(part_solids);
+    free(part_thick_shells);
+  }
+
+  if (solid_indices != part->solid_indices) {
+    free(solid_indices);
+  }
+  if (thick_shell_indices != part->thick_shell_indices) {
+    free(thick_shell_indices);
+  }
+  free(solids);
+  free(thick_shells);
+
+  END_PROFILE_FUNC();
+  return skin;
+}
+
+d3plot_skin d3plot_extract_skin(const d3plot_solid_con *solids,
+                                size_t num_solids,
+                                const d3plot_thick_shell_con *thick_shells,
+                                size_t num_thick_shells) {
+  size_t num_ranges = 1;
+#ifndef NO_THREAD_SAFETY
+  /* Only use as many threads as are worth it*/
+  num_ranges = thread_num_processors();
+  const size_t max_ranges =
+      (num_solids + num_thick_shells) / SKIN_MIN_ELEMENTS_PER_THREAD;
+  if (num_ranges > max_ranges) {
+    num_ranges = max_ranges;
+  }
+  if (num_ranges == 0) {
+    num_ranges = 1;
+  }
+#endif
+
+  return _d3plot_extract_skin(solids, num_solids, thick_shells,
+                              num_thick_shells, num_ranges);
+}
+
+d3plot_skin _d3plot_extract_skin(const d3plot_solid_con *solids,
+                                 size_t num_solids,
+                                 const d3plot_thick_shell_con *thick_shells,
+                                 size_t num_thick_shells, size_t num_ranges) {
+  BEGIN_PROFILE_FUNC();
+
+  d3plot_skin skin;
+  memset(&skin, 0, sizeof(d3plot_skin));
+
+  const size_t num_elements = num_solids + num_thick_shells;
+  const size_t num_all_faces = num_elements * SKIN_NUM_SIDES;
+  if (num_all_faces == 0) {
+    END_PROFILE_FUNC();
+    return skin;
+  }
+  if (num_ranges > num_elements) {
+    num_ranges = num_elements;
+  }
+
+  /* Every range of elements removes the faces which are shared inside of it.
+   * The faces that remain are matched against each other afterwards*/
+  d3plot_skin_range *ranges = malloc(num_ranges * sizeof(d3plot_skin_range));
+  size_t r = 0;
+  while (r < num_ranges) {
+    const size_t first_element = num_elements * r / num_ranges;
+    const size_t end_element = num_elements * (r + 1) / num_ranges;
+
+    ranges[r].solids = solids;
+    ranges[r].num_solids = num_solids;
+    ranges[r].thick_shells = thick_shells;
+    ranges[r].faces = NULL;
+    ranges[r].first_face = first_element * SKIN_NUM_SIDES;
+    ranges[r].num_faces = (end_element - first_element) * SKIN_NUM_SIDES;
+    r++;
+  }
+
+#ifndef NO_THREAD_SAFETY
+  /* The first range is hashed by this thread*/
+  thread_t *threads = malloc(num_ranges * sizeof(thread_t));
+  uint8_t *started = calloc(num_ranges, sizeof(uint8_t));
+  r = 1;
+  while (r < num_ranges) {
+    started[r] =
+        thread_create(&threads[r], _d3plot_skin_hash_faces, &ranges[r]) == 0;
+    r++;
+  }
+  _d3plot_skin_hash_faces(&ranges[0]);
+  r = 1;
+  while (r < num_ranges) {
+    if (started[r]) {
+      thread_join(&threads[r]);
+    } else {
+      _d3plot_skin_hash_faces(&ranges[r]);
+    }
+    r++;
+  }
+  free(threads);
+  free(started);
+#else
+  r = 0;
+  while (r < num_ranges) {
+    _d3plot_skin_hash_faces(&ranges[r]);
+    r++;
+  }
+#endif
+
+  d3plot_skin_range merged = ranges[0];
+  if (num_ranges > 1) {
+    /* Match the faces which are shared by elements of different ranges*/
+    size_t num_faces = 0;
+    r = 0;
+    while (r < num_ranges) {
+      num_faces += ranges[r].num_remaining_faces;
+      r++;
+    }
+
+    size_t *faces = malloc(num_faces * sizeof(size_t));
+    num_faces = 0;
+    r = 0;
+    while (r < num_ranges) {
+      memcpy(&faces[num_faces], ranges[r].remaining_faces,
+             ranges[r].num_remaining_faces * sizeof(size_t));
+      num_faces += ranges[r].num_remaining_faces;
+      free(ranges[r].remaining_faces);
+      r++;
+    }
+
+    merged.faces = faces;
+    merged.first_face = 0;
+    merged.num_faces = num_faces;
+    _d3plot_skin_hash_faces(&merged);
+    free(faces);
+  }
+  free(ranges);
+
+  skin.num_faces = merged.num_remaining_faces;
+
+  /* Mark the remaining faces in a bitmap so that they are returned in the
+   * order of the elements*/
+  uint8_t *face_bitmap = calloc((num_all_faces + 7) / 8, 1);
+  size_t i = 0;
+  while (i < skin.num_faces) {
+    const size_t f = merged.remaining_faces[i];
+    face_bitmap[f / 8] |= (uint8_t)(1 << (f % 8));
+    i++;
+  }
+  free(merged.remaining_faces);
+
+  skin.faces = malloc(skin.num_faces * 4 * sizeof(size_t));
+  skin.face_elements = malloc(skin.num_faces * sizeof(size_t));
+  skin.face_element_types = malloc(skin.num_faces * sizeof(uint8_t));
+
+  d3_word face[4], key[4], max_node = 0;
+  i = 0;
+  size_t f = 0;
+  while (f < num_all_faces) {
+    if (face_bitmap[f / 8] & (1 << (f % 8))) {
+      const size_t element = f / SKIN_NUM_SIDES;
+      _d3plot_skin_get_face(SKIN_ELEMENT_NODES(element), f % SKIN_NUM_SIDES,
+                            face, key);
+
+      size_t j = 0;
+      while (j < 4) {
+        skin.faces[i * 4 + j] = (size_t)face[j];
+        if (face[j] > max_node) {
+          max_node = face[j];
+        }
+        j++;
+      }
+
+      if (element < num_solids) {
+        skin.face_elements[i] = element;
+        skin.face_element_types[i] = D3PLOT_ID_TYPE_SOLID;
+      } else {
+        skin.face_elements[i] = element - num_solids;
+        skin.face_element_types[i] = D3PLOT_ID_TYPE_THICK_SHELL;
+      }
+
+      i++;
+    }
+
+    f++;
+  }
+  free(face_bitmap);
+
+  if (skin.num_faces == 0) {
+    END_PROFILE_FUNC();
+    return skin;
+  }
+
+  /* Compact the nodes to only the ones used by the skin*/
+  const size_t num_node_slots = (size_t)max_node + 1;
+  size_t *node_map = malloc(num_node_slots * sizeof(size_t));
+  memset(node_map, 0xFF, num_node_slots * sizeof(size_t));
+
+  i = 0;
+  while (i < skin.num_faces * 4) {
+    if (node_map[skin.faces[i]] == SKIN_EMPTY) {
+      node_map[skin.faces[i]] = 0;
+      skin.num_nodes++;
+    }
+    i++;
+  }
+
+  skin.node_indices = malloc(skin.num_nodes * sizeof(size_t));
+  size_t n = 0;
+  i = 0;
+  while (i < num_node_slots) {
+    if (node_map[i] != SKIN_EMPTY) {
+      node_map[i] = n;
+      skin.node_indices[n++] = i;
+    }
+    i++;
+  }
+
+  i = 0;
+  while (i < skin.num_faces * 4) {
+    skin.faces[i] = node_map[skin.faces[i]];
+    i++;
+  }
+  free(node_map);
+
+  END_PROFILE_FUNC();
+  return skin;
+}
+
+void d3plot_free_skin(d3plot_skin *skin) {
+  free(skin->node_indices);
+  free(skin->faces);
+  free(skin->face_elements);
+  free(skin->face_element_types);
+  memset(skin, 0, sizeof(d3plot_skin));
+}
+
+void _d3plot_skin_hash_faces(void *range_ptr) {
+  /* Not profiled, since it runs on multiple threads at once*/
+  d3plot_skin_range *range = (d3plot_skin_range *)range_ptr;
+  const d3plot_solid_con *solids = range->solids;
+  const size_t num_solids = range->num_solids;
+  const d3plot_thick_shell_con *thick_shells = range->thick_shells;
+
+  range->remaining_faces = NULL;
+  range->num_remaining_faces = 0;
+  if (range->num_faces == 0) {
+    return;
+  }
+
+  /* Keep the load factor at or below 0.5*/
+  size_t num_buckets = 1;
+  while (num_buckets < range->num_faces * 2) {
+    num_buckets <<= 1;
+  }
+  const size_t mask = num_buckets - 1;
+  size_t *buckets = malloc(num_buckets * sizeof(size_t));
+  memset(buckets, 0xFF, num_buckets * sizeof(size_t));
+
+  d3_word face[4], key[4], other_face[4], other_key[4];
+  size_t k = 0;
+  while (k < range->num_faces) {
+    const size_t f = range->faces ? range->faces[k] : range->first_face + k;
+    const size_t num_face_nodes = _d3plot_skin_get_face(
+        SKIN_ELEMENT_NODES(f / SKIN_NUM_SIDES), f % SKIN_NUM_SIDES, face, key);
+    /* Collapsed faces of degenerated elements have no area*/
+    if (num_face_nodes < 3) {
+      k++;
+      continue;
+    }
+
+    size_t bucket = _d3plot_skin_hash(key, num_buckets);
+    while (buckets[bucket] != SKIN_EMPTY) {
+      if (!(buckets[bucket] & SKIN_MATCHED)) {
+        const size_t other = buckets[bucket];
+        _d3plot_skin_get_face(SKIN_ELEMENT_NODES(other / SKIN_NUM_SIDES),
+                              other % SKIN_NUM_SIDES, other_face, other_key);
+        if (memcmp(key, other_key, sizeof(key)) == 0) {
+          buckets[bucket] |= SKIN_MATCHED;
+          break;
+        }
+      }
+
+      bucket = (bucket + 1) & mask;
+    }
+
+    if (buckets[bucket] == SKIN_EMPTY) {
+      buckets[bucket] = f;
+      range->num_remaining_faces++;
+    } else {
+      range->num_remaining_faces--;
+    }
+
+    k++;
+  }
+
+  range->remaining_faces =
+      malloc(range->num_remaining_faces * sizeof(size_t));
+  size_t n = 0;
+  size_t i = 0;
+  while (i < num_buckets) {
+    if (buckets[i] != SKIN_EMPTY && !(buckets[i] & SKIN_MATCHED)) {
+      range->remaining_faces[n++] = buckets[i];
+    }
+    i++;
+  }
+  free(buckets);
+}
+
+size_t _d3plot_skin_get_face(const d3_word *element_nodes, size_t side,
+                             d3_word *face, d3_word *key) {
+  /* Node order of the sides of an 8 node element with outward normals*/
+  const uint8_t sides[SKIN_NUM_SIDES][4] = {{0, 3, 2, 1}, {4, 5, 6, 7},
+                                            {0, 1, 5, 4}, {1, 2, 6, 5},
+                                            {2, 3, 7, 6}, {3, 0, 4, 7}};
+
+  /* Remove repeated nodes, which appear in degenerated elements*/
+  size_t num_face_nodes = 0;
+  size_t i = 0;
+  while (i < 4) {
+    const d3_word node = element_nodes[sides[side][i]];
+    if (num_face_nodes == 0 || face[num_face_nodes - 1] != node) {
+      face[num_face_nodes++] = node;
+    }
+    i++;
+  }
+  if (num_face_nodes > 1 && face[num_face_nodes - 1] == face[0]) {
+    num_face_nodes--;
+  }
+
+  /* Insertion sort the nodes into the key*/
+  size_t num_key_nodes = 0;
+  i = 0;
+  while (i < num_face_nodes) {
+    size_t j = num_key_nodes;
+    while (j > 0 && key[j - 1] > face[i]) {
+      key[j] = key[j - 1];
+      j--;
+    }
+    if (j > 0 && key[j - 1] == face[i]) {
+      /* Undo the shift since the node is already part of the key*/
+      while (j < num_key_nodes) {
+        key[j] = key[j + 1];
+        j++;
+      }
+    } else {
+      key[j] = face[i];
+      num_key_nodes++;
+    }
+    i++;
+  }
+
+  i = num_face_nodes;
+  while (i < 4) {
+    face[i] = face[num_face_nodes - 1];
+    i++;
+  }
+  i = num_key_nodes;
+  while (i < 4) {
+    key[i] = key[num_key_nodes - 1];
+    i++;
+  }
+
+  return num_key_nodes;
+}
+
+size_t _d3plot_skin_hash(const d3_word *key, size_t num_buckets) {
+  d3_word hash = key[0];
+  hash = hash * SKIN_HASH_MULTIPLIER + key[1];
+  hash = hash * SKIN_HASH_MULTIPLIER + key[2];
+  hash = hash * SKIN_HASH_MULTIPLIER + key[3];
+  return _d3plot_id_index_hash(hash, num_buckets);
+}
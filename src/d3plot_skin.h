@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef D3PLOT_SKIN_H
+#define D3PLOT_SKIN_H
+
+#include "d3_defines.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns the skin (all faces which are not shared by two elements) of all
+ * solid and thick shell elements. Degenerated elements (e.g. tetrahedrons)
+ * are supported, their collapsed faces are skipped. The return value needs to
+ * be deallocated by d3plot_free_skin*/
+d3plot_skin d3plot_read_skin(d3plot_file *plot_file);
+/* The same as d3plot_read_skin, but only the solids and thick shells of part
+ * are used. Therefore faces between part and other parts are also part of
+ * the skin. face_elements still index into the arrays of all elements. The
+ * return value needs to be deallocated by d3plot_free_skin*/
+d3plot_skin d3plot_read_part_skin(d3plot_file *plot_file,
+                                  const d3plot_part *part);
+/* Extracts the skin out of the return values of d3plot_read_solid_elements and
+ * d3plot_read_thick_shell_elements. Faces are found by hashing the sorted
+ * node indices of every face. Large models are split into ranges of elements
+ * which are hashed on multiple threads. The return value needs to be
+ * deallocated by d3plot_free_skin*/
+d3plot_skin d3plot_extract_skin(const d3plot_solid_con *solids,
+                                size_t num_solids,
+                                const d3plot_thick_shell_con *thick_shells,
+                                size_t num_thick_shells);
+/* Deallocates all memory of a skin*/
+void d3plot_free_skin(d3plot_skin *skin);
+
+/***** Private Functions ********/
+/* The faces which are hashed by one thread of d3plot_extract_skin*/
+typedef struct {
+  const d3plot_solid_con *solids;
+  size_t num_solids;
+  const d3plot_thick_shell_con *thick_shells;
+  const size_t *faces; /* The faces (element * 6 + side) to hash. If NULL the
+                          faces [first_face, first_face + num_faces) are
+                          hashed*/
+  size_t first_face;
+  size_t num_faces;
+  size_t *remaining_faces; /* Set by _d3plot_skin_hash_faces to the faces which
+                              are not shared by two elements. Needs to be
+                              deallocated by free*/
+  size_t num_remaining_faces;
+} d3plot_skin_range;
+
+/* The same as d3plot_extract_skin, but the elements are split into num_ranges
+ * ranges whose faces are hashed on their own threads*/
+d3plot_skin _d3plot_extract_skin(const d3plot_solid_con *solids,
+                                 size_t num_solids,
+                                 const d3plot_thick_shell_con *thick_shells,
+                                 size_t num_thick_shells, size_t num_ranges);
+/* Hashes the faces of a d3plot_skin_range and sets its remaining faces. Takes
+ * a void pointer so that it can be used as a thread function*/
+void _d3plot_skin_hash_faces(void *range);
+/* Writes the nodes of a side (0-5) of an 8 node element into face and its
+ * sorted nodes into key. Both are padded with their last node. Returns the
+ * number of distinct nodes of the face*/
+size_t _d3plot_skin_get_face(const d3_word *element_nodes, size_t side,
+                             d3_word *face, d3_word *key);
+/* Returns the bucket of a face key. num_buckets needs to be a power of two*/
+size_t _d3plot_skin_hash(const d3_word *key, size_t num_buckets);
+/********************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
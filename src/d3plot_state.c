@@ -25,7 +25,10 @@
 
 #include "d3plot.h"
 #include "profiling.h"
+#include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef CDP
 #define CDP plot_file->control_data
@@ -59,128 +62,54 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
   }
 
   /* GLOBAL*/
-  const size_t global_start = d3_ptr->cur_word;
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, 6);
-  /* TODO: read functions for KE, IE, TE, X, Y and Z*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 IE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 IE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 IE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT IE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS IE*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 KE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 KE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 KE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT KE*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS KE*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 X*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 X*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 X*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT X*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS X*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 Y*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 Y*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 Y*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT Y*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS Y*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 Z*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 Z*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 Z*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT Z*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS Z*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 MASS*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 MASS*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 MASS*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT MASS*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS MASS*/
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat8);
-  /* TODO: read function for MAT8 HOURGLASS ENERGY*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat2);
-  /* TODO: read function for MAT2 HOURGLASS ENERGY*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummat4);
-  /* TODO: read function for MAT4 HOURGLASS ENERGY*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nummatt);
-  /* TODO: read function for MATT HOURGLASS ENERGY*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numrbs);
-  /* TODO: read function for RBS HOURGLASS ENERGY*/
+  DT_PTR_SET(D3PLT_PTR_STATE_GLOBAL);
 
-  if (plot_file->buffer.error_string) {
-    free(plot_file->buffer.error_string);
-    plot_file->buffer.error_string = NULL;
-    END_PROFILE_FUNC();
-    return 0;
-  }
-
-  /* Assume that N is one*/
-  const size_t RWN = 1;
-  size_t numrw;
-  {
-    numrw = (CDP.nglbv - 6 -
-             7 * (CDP.nummat8 + CDP.nummat2 + CDP.nummat4 + CDP.nummatt +
-                  CDP.numrbs)) /
-            RWN;
-  }
-
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, numrw);
-  /* TODO: read function for RW_FORCE*/
-
-  if (RWN == 4) {
-    d3_buffer_skip_words(&plot_file->buffer, d3_ptr, numrw * 3);
-    /* TODO: read function for RW_POS*/
-  }
-
-  if (plot_file->buffer.error_string) {
-    free(plot_file->buffer.error_string);
-    plot_file->buffer.error_string = NULL;
-    END_PROFILE_FUNC();
-    return 0;
-  }
+  /**** Order of GLOBAL ********
+   * KE, IE, TE, X, Y, Z,
+   * IE, KE, X, Y, Z, MASS and HOURGLASS ENERGY of MAT8, MAT2, MAT4, MATT and
+   * RBS, RW_FORCE (and RW_POS if N == 4)
+   ******************************/
+  /* Keep the whole section of every state in memory, so that
+   * d3plot_read_global and similar functions do not need to read the file*/
+  if (CDP.nglbv != 0) {
+    /* The material values and rigid walls are located by their offsets, so
+     * make sure that the materials fit*/
+    const size_t global_size =
+        6 + D3PLOT_MATERIAL_COUNT * _d3plot_num_global_materials(plot_file);
+    if (global_size > CDP.nglbv) {
+      ERROR_AND_NO_RETURN_F_PTR("Size of GLOBAL is %zu instead of %llu",
+                                global_size, CDP.nglbv);
+      END_PROFILE_FUNC();
+      return 0;
+    }
 
-  const size_t global_end = d3_ptr->cur_word;
-  const size_t global_size = global_end - global_start;
+    plot_file->state_globals =
+        realloc(plot_file->state_globals,
+                (plot_file->num_states + 1) * CDP.nglbv * sizeof(double));
+    double *global =
+        &plot_file->state_globals[plot_file->num_states * CDP.nglbv];
+
+    if (plot_file->buffer.word_size == 4) {
+      float *global32 = malloc(CDP.nglbv * sizeof(float));
+      d3_buffer_read_words(&plot_file->buffer, d3_ptr, global32, CDP.nglbv);
+
+      size_t i = 0;
+      while (i < CDP.nglbv) {
+        global[i] = global32[i];
+        i++;
+      }
+
+      free(global32);
+    } else {
+      d3_buffer_read_words(&plot_file->buffer, d3_ptr, global, CDP.nglbv);
+    }
 
-  if (global_size != CDP.nglbv) {
-    ERROR_AND_NO_RETURN_F_PTR("Size of GLOBAL is %zu instead of %llu",
-                              global_size, CDP.nglbv);
-    END_PROFILE_FUNC();
-    return 0;
+    if (plot_file->buffer.error_string) {
+      free(plot_file->buffer.error_string);
+      plot_file->buffer.error_string = NULL;
+      END_PROFILE_FUNC();
+      return 0;
+    }
   }
 
   /* NODEDATA*/
@@ -190,30 +119,26 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
 
   const size_t node_data_start = d3_ptr->cur_word;
 
-  uint8_t it = _get_nth_digit(CDP.it, 0);
-  uint8_t N = it * (it > 1);
-  if (N == 2) {
-    it = 1;
-    N = 3;
-  }
-  const uint8_t mass_N = _get_nth_digit(CDP.it, 1) == 1;
+  const size_t NND = ((CDP.num_temperatures + CDP.num_fluxes +
+                       CDP.has_mass_scaling) +
+                      CDP.ndim * (CDP.iu + CDP.iv + CDP.ia)) *
+                     CDP.numnp;
 
-  const size_t NND =
-      ((it + N + mass_N) + CDP.ndim * (CDP.iu + CDP.iv + CDP.ia)) * CDP.numnp;
-
-  if (it > 0) {
-    d3_buffer_skip_words(&plot_file->buffer, d3_ptr, it * CDP.numnp);
-    /* TODO: read function for IT data*/
+  if (CDP.num_temperatures > 0) {
+    DT_PTR_SET(D3PLT_PTR_STATE_NODE_TEMP);
+    d3_buffer_skip_words(&plot_file->buffer, d3_ptr,
+                         CDP.num_temperatures * CDP.numnp);
   }
 
-  if (N > 0) {
-    d3_buffer_skip_words(&plot_file->buffer, d3_ptr, N * CDP.numnp);
-    /* TODO: read function for NODE FLUX data*/
+  if (CDP.num_fluxes > 0) {
+    DT_PTR_SET(D3PLT_PTR_STATE_NODE_FLUX);
+    d3_buffer_skip_words(&plot_file->buffer, d3_ptr,
+                         CDP.num_fluxes * CDP.numnp);
   }
 
-  if (mass_N) {
+  if (CDP.has_mass_scaling) {
+    DT_PTR_SET(D3PLT_PTR_STATE_NODE_MASS_SCALING);
     d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.numnp);
-    /* TODO: read function for MASS SCALING*/
   }
 
   if (CDP.iu) {
@@ -248,8 +173,10 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
   }
 
   /* THERMDATA*/
-  d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nt3d * CDP.nel8);
-  /* TODO: read function for nt3d data*/
+  if (CDP.nt3d > 0) {
+    DT_PTR_SET(D3PLT_PTR_STATE_ELEMENT_THERMAL);
+    d3_buffer_skip_words(&plot_file->buffer, d3_ptr, CDP.nt3d * CDP.nel8);
+  }
 
   if (plot_file->buffer.error_string) {
     free(plot_file->buffer.error_string);
@@ -312,6 +239,7 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
   }
 
   if (skip_words > 0) {
+    DT_PTR_SET(D3PLT_PTR_STATE_DELETION);
     d3_buffer_skip_words(&plot_file->buffer, d3_ptr, skip_words);
     if (plot_file->buffer.error_string) {
       free(plot_file->buffer.error_string);
@@ -321,6 +249,10 @@ int _d3plot_read_state_data(d3plot_file *plot_file, d3_pointer *d3_ptr) {
     }
   }
 
+  plot_file->state_times = realloc(
+      plot_file->state_times, (plot_file->num_states + 1) * sizeof(double));
+  plot_file->state_times[plot_file->num_states] = time;
+
   plot_file->num_states++;
   plot_file->data_pointers =
       realloc(plot_file->data_pointers,
@@ -471,4 +403,408 @@ void d3plot_free_surface(d3plot_surface ip) {
   free(ip.history_variables);
 
   END_PROFILE_FUNC();
+}
+
+d3plot_surfaces d3plot_alloc_surfaces(size_t num_surfaces,
+                                      size_t num_history_variables) {
+  BEGIN_PROFILE_FUNC();
+
+  d3plot_surfaces surfaces;
+  surfaces.num_surfaces = num_surfaces;
+  surfaces.num_history_variables = num_history_variables;
+
+  double *data =
+      malloc((7 + num_history_variables) * num_surfaces * sizeof(double));
+  size_t i = 0;
+  while (i < 6) {
+    surfaces.stress[i] = &data[i * num_surfaces];
+    i++;
+  }
+  surfaces.effective_plastic_strain = &data[6 * num_surfaces];
+  surfaces.history_variables = &data[7 * num_surfaces];
+
+  END_PROFILE_FUNC();
+  return surfaces;
+}
+
+void d3plot_free_surfaces(d3plot_surfaces *surfaces) {
+  BEGIN_PROFILE_FUNC();
+
+  /* All arrays are one allocation starting with the x stresses*/
+  free(surfaces->stress[0]);
+  memset(surfaces, 0, sizeof(d3plot_surfaces));
+
+  END_PROFILE_FUNC();
+}
+
+int d3plot_get_shells_layer(const d3plot_shell *shells, size_t num_shells,
+                            int layer, d3plot_surfaces *surfaces) {
+  if (num_shells == 0) {
+    return 1;
+  }
+
+  const size_t offsets[4] = {
+      offsetof(d3plot_shell, mid), offsetof(d3plot_shell, inner),
+      offsetof(d3plot_shell, outer), offsetof(d3plot_shell, add_ips)};
+  return _d3plot_get_surfaces_layer(
+      (const uint8_t *)shells, sizeof(d3plot_shell), offsets, num_shells,
+      shells[0].num_additional_integration_points,
+      shells[0].num_history_variables, layer, surfaces);
+}
+
+int d3plot_get_thick_shells_layer(const d3plot_thick_shell *thick_shells,
+                                  size_t num_thick_shells, int layer,
+                                  d3plot_surfaces *surfaces) {
+  if (num_thick_shells == 0) {
+    return 1;
+  }
+
+  const size_t offsets[4] = {offsetof(d3plot_thick_shell, mid),
+                             offsetof(d3plot_thick_shell, inner),
+                             offsetof(d3plot_thick_shell, outer),
+                             offsetof(d3plot_thick_shell, add_ips)};
+  return _d3plot_get_surfaces_layer(
+      (const uint8_t *)thick_shells, sizeof(d3plot_thick_shell), offsets,
+      num_thick_shells, thick_shells[0].num_additional_integration_points,
+      thick_shells[0].num_history_variables, layer, surfaces);
+}
+
+d3plot_beams d3plot_alloc_beams(size_t num_beams,
+                                size_t num_integration_points,
+                                size_t num_history_variables,
+                                int with_integration_points) {
+  BEGIN_PROFILE_FUNC();
+
+  d3plot_beams beams;
+  memset(&beams, 0, sizeof(beams));
+  beams.num_beams = num_beams;
+  beams.num_integration_points = num_integration_points;
+  beams.num_history_variables = num_history_variables;
+
+  /* NV1D = 6 + 5*BEAMIP + NEIPB*(3+BEAMIP)*/
+  const size_t num_words = 6 + 5 * num_integration_points +
+                           num_history_variables * (3 + num_integration_points);
+  size_t num_values = 6 + 3 * num_history_variables;
+  if (with_integration_points) {
+    num_values += num_integration_points * (5 + num_history_variables);
+  }
+
+  double *data = malloc((num_values + num_words) * num_beams * sizeof(double));
+
+  size_t i = 0;
+  while (i < 6) {
+    beams.resultants[i] = &data[i * num_beams];
+    i++;
+  }
+  size_t o = 6 * num_beams;
+  beams.history_average = &data[o];
+  o += num_history_variables * num_beams;
+  beams.history_min = &data[o];
+  o += num_history_variables * num_beams;
+  beams.history_max = &data[o];
+  o += num_history_variables * num_beams;
+
+  if (with_integration_points) {
+    i = 0;
+    while (i < 5) {
+      beams.ip_values[i] = &data[o];
+      o += num_integration_points * num_beams;
+      i++;
+    }
+    beams.ip_history_variables = &data[o];
+    o += num_integration_points * num_history_variables * num_beams;
+  }
+
+  beams.words = &data[o];
+
+  END_PROFILE_FUNC();
+  return beams;
+}
+
+void d3plot_free_beams(d3plot_beams *beams) {
+  BEGIN_PROFILE_FUNC();
+
+  /* All arrays are one allocation starting with the axial forces*/
+  free(beams->resultants[0]);
+  memset(beams, 0, sizeof(d3plot_beams));
+
+  END_PROFILE_FUNC();
+}
+
+int d3plot_read_beams_state_arrays(d3plot_file *plot_file, size_t state,
+                                   d3plot_beams *beams) {
+  BEGIN_PROFILE_FUNC();
+  D3PLOT_CLEAR_ERROR_STRING();
+
+  if (state >= plot_file->num_states) {
+    ERROR_AND_NO_RETURN_F_PTR("%zu is out of bounds for the states", state);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  if (beams->num_beams != CDP.nel2 ||
+      beams->num_integration_points != CDP.beamip ||
+      beams->num_history_variables != CDP.neipb) {
+    ERROR_AND_NO_RETURN_F_PTR("The beams need to be allocated with NEL2=%llu "
+                              "BEAMIP=%llu and NEIPB=%llu",
+                              CDP.nel2, CDP.beamip, CDP.neipb);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  const size_t n = beams->num_beams;
+  if (n == 0) {
+    END_PROFILE_FUNC();
+    return 1;
+  }
+
+  /* The words buffer is sized for NV1D = 6 + 5*BEAMIP + NEIPB*(3+BEAMIP)*/
+  if (CDP.nv1d != 6 + 5 * CDP.beamip + CDP.neipb * (3 + CDP.beamip)) {
+    ERROR_AND_NO_RETURN_F_PTR("NV1D (%llu) does not match BEAMIP (%llu) and "
+                              "NEIPB (%llu)",
+                              CDP.nv1d, CDP.beamip, CDP.neipb);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  _d3plot_read_words_of_indices(
+      plot_file, beams->words,
+      plot_file->data_pointers[D3PLT_PTR_STATES + state] +
+          plot_file->data_pointers[D3PLT_PTR_STATE_ELEMENT_BEAM],
+      CDP.nv1d, NULL, n);
+  if (plot_file->buffer.error_string) {
+    ERROR_AND_NO_RETURN_F_PTR("Failed to read words: %s",
+                              plot_file->buffer.error_string);
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  if (plot_file->buffer.word_size == 4) {
+    /* Convert the floats in place. Going backwards never overwrites a float
+     * which has not been converted yet*/
+    const float *words32 = (const float *)beams->words;
+    size_t i = n * CDP.nv1d;
+    while (i > 0) {
+      i--;
+      beams->words[i] = words32[i];
+    }
+  }
+
+  const size_t num_ips = beams->num_integration_points;
+  const size_t num_his = beams->num_history_variables;
+
+  size_t i = 0;
+  while (i < n) {
+    const double *words = &beams->words[i * CDP.nv1d];
+
+    size_t j = 0;
+    while (j < 6) {
+      beams->resultants[j][i] = words[j];
+      j++;
+    }
+    size_t o = 6;
+
+    if (beams->ip_values[0]) {
+      j = 0;
+      while (j < num_ips) {
+        size_t v = 0;
+        while (v < 5) {
+          beams->ip_values[v][j * n + i] = words[o + v];
+          v++;
+        }
+        o += 5;
+        j++;
+      }
+    } else {
+      o += 5 * num_ips;
+    }
+
+    size_t k = 0;
+    while (k < num_his) {
+      beams->history_average[k * n + i] = words[o + k];
+      beams->history_min[k * n + i] = words[o + num_his + k];
+      beams->history_max[k * n + i] = words[o + 2 * num_his + k];
+      k++;
+    }
+    o += 3 * num_his;
+
+    if (beams->ip_history_variables) {
+      j = 0;
+      while (j < num_ips) {
+        k = 0;
+        while (k < num_his) {
+          beams->ip_history_variables[(j * num_his + k) * n + i] = words[o++];
+          k++;
+        }
+        j++;
+      }
+    }
+
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+int _d3plot_get_surfaces_layer(const uint8_t *elements, size_t stride,
+                               const size_t *offsets, size_t num_elements,
+                               size_t num_add_ips,
+                               size_t num_history_variables, int layer,
+                               d3plot_surfaces *surfaces) {
+  BEGIN_PROFILE_FUNC();
+
+  if (layer < D3PLOT_SHELL_SURFACE_MID ||
+      layer > D3PLOT_SHELL_SURFACE_ABS_MAX ||
+      surfaces->num_surfaces < num_elements) {
+    END_PROFILE_FUNC();
+    return 0;
+  }
+
+  /* A single layer is just copied*/
+  size_t first_ip = (size_t)layer, num_ips = 1;
+  if (layer == D3PLOT_SHELL_SURFACE_MEAN ||
+      layer == D3PLOT_SHELL_SURFACE_ABS_MAX) {
+    first_ip = 0;
+    num_ips = 3 + num_add_ips;
+  }
+  if (num_history_variables > surfaces->num_history_variables) {
+    num_history_variables = surfaces->num_history_variables;
+  }
+
+  if (layer == D3PLOT_SHELL_SURFACE_ABS_MAX) {
+    /* Take all values from the integration point with the largest von Mises
+     * stress, so that the stress tensor is not mixed together out of multiple
+     * integration points. The squares of the von Mises stresses are compared,
+     * since they have the same order*/
+    double *von_mises = malloc(2 * num_elements * sizeof(double));
+    double *max_von_mises = &von_mises[num_elements];
+    size_t *max_ips = malloc(num_elements * sizeof(size_t));
+
+    size_t ip = 0;
+    while (ip < num_ips) {
+      size_t i = 0;
+      while (i < num_elements) {
+        const d3plot_tensor *t =
+            &_d3plot_get_element_surface(&elements[i * stride], offsets, ip)
+                 ->stress;
+        von_mises[i] = 0.5 * ((t->x - t->y) * (t->x - t->y) +
+                              (t->y - t->z) * (t->y - t->z) +
+                              (t->z - t->x) * (t->z - t->x)) +
+                       3.0 * (t->xy * t->xy + t->yz * t->yz + t->zx * t->zx);
+        i++;
+      }
+
+      if (ip == 0) {
+        memcpy(max_von_mises, von_mises, num_elements * sizeof(double));
+        memset(max_ips, 0, num_elements * sizeof(size_t));
+      } else {
+        i = 0;
+        while (i < num_elements) {
+          const int larger = von_mises[i] > max_von_mises[i];
+          max_von_mises[i] = larger ? von_mises[i] : max_von_mises[i];
+          max_ips[i] = larger ? ip : max_ips[i];
+          i++;
+        }
+      }
+
+      ip++;
+    }
+
+    size_t i = 0;
+    while (i < num_elements) {
+      const d3plot_surface *s =
+          _d3plot_get_element_surface(&elements[i * stride], offsets,
+                                      max_ips[i]);
+      _d3plot_fold_surface(surfaces, i, s, num_history_variables, 1);
+      i++;
+    }
+
+    free(max_ips);
+    free(von_mises);
+
+    END_PROFILE_FUNC();
+    return 1;
+  }
+
+  size_t k = 0;
+  while (k < num_ips) {
+    const size_t ip = first_ip + k;
+    const int first = k == 0;
+
+    size_t i = 0;
+    while (i < num_elements) {
+      const d3plot_surface *s =
+          _d3plot_get_element_surface(&elements[i * stride], offsets, ip);
+      _d3plot_fold_surface(surfaces, i, s, num_history_variables, first);
+      i++;
+    }
+
+    k++;
+  }
+
+  if (layer == D3PLOT_SHELL_SURFACE_MEAN) {
+    const size_t n = surfaces->num_surfaces;
+    const double factor = 1.0 / (double)num_ips;
+    double *arrays[7] = {surfaces->stress[0],
+                         surfaces->stress[1],
+                         surfaces->stress[2],
+                         surfaces->stress[3],
+                         surfaces->stress[4],
+                         surfaces->stress[5],
+                         surfaces->effective_plastic_strain};
+
+    size_t a = 0;
+    while (a < 7 + num_history_variables) {
+      double *values =
+          a < 7 ? arrays[a] : &surfaces->history_variables[(a - 7) * n];
+      size_t i = 0;
+      while (i < num_elements) {
+        values[i] *= factor;
+        i++;
+      }
+      a++;
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+const d3plot_surface *_d3plot_get_element_surface(const uint8_t *element,
+                                                  const size_t *offsets,
+                                                  size_t ip) {
+  if (ip < 3) {
+    return (const d3plot_surface *)&element[offsets[ip]];
+  }
+  return &(*(d3plot_surface *const *)&element[offsets[3]])[ip - 3];
+}
+
+void _d3plot_fold_surface(d3plot_surfaces *surfaces, size_t i,
+                          const d3plot_surface *s,
+                          size_t num_history_variables, int first) {
+  const size_t n = surfaces->num_surfaces;
+  _d3plot_fold_surface_value(&surfaces->stress[0][i], s->stress.x, first);
+  _d3plot_fold_surface_value(&surfaces->stress[1][i], s->stress.y, first);
+  _d3plot_fold_surface_value(&surfaces->stress[2][i], s->stress.z, first);
+  _d3plot_fold_surface_value(&surfaces->stress[3][i], s->stress.xy, first);
+  _d3plot_fold_surface_value(&surfaces->stress[4][i], s->stress.yz, first);
+  _d3plot_fold_surface_value(&surfaces->stress[5][i], s->stress.zx, first);
+  _d3plot_fold_surface_value(&surfaces->effective_plastic_strain[i],
+                             s->effective_plastic_strain, first);
+
+  size_t j = 0;
+  while (j < num_history_variables) {
+    _d3plot_fold_surface_value(&surfaces->history_variables[j * n + i],
+                               s->history_variables[j], first);
+    j++;
+  }
+}
+
+void _d3plot_fold_surface_value(double *out, double value, int first) {
+  if (first) {
+    *out = value;
+  } else {
+    *out += value;
+  }
 }
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include "binary_search.h"
 #include "line.h"
 #include "profiling.h"
+#include <ctype.h>
 #include <errno.h>
 #include <math.h>
 #include <stdarg.h>
@@ -78,12 +79,6 @@ key_parse_config_t key_default_parse_config() {
   return c;
 }
 
-typedef struct {
-  keyword_t *current_keyword;
-  keyword_t *keywords;
-  size_t *num_keywords;
-} key_file_parse_data;
-
 void key_file_parse_callback(key_parse_info_t info, const char *keyword_name,
                              card_t *card, size_t card_index, void *user_data) {
   key_file_parse_data *data = (key_file_parse_data *)user_data;
@@ -210,25 +205,7 @@ void key_file_parse_with_callback(const char *file_name,
   key_parse_recursion_t *rec_ptr = NULL;
 
   if (!rec) {
-    rec_ptr = malloc(sizeof(key_parse_recursion_t));
-    rec_ptr->include_paths = NULL;
-    rec_ptr->num_include_paths = 0;
-    rec_ptr->extra_include_paths_applied = 0;
-
-    const size_t index = path_move_up_real(file_name);
-    if (index == (size_t)~0) {
-      rec_ptr->root_folder = path_working_directory();
-    } else {
-      if (path_is_abs(file_name)) {
-        rec_ptr->root_folder = string_clone_len(file_name, index + 1);
-      } else {
-        char *current_wd = path_working_directory();
-        rec_ptr->root_folder = path_join_real(current_wd, file_name);
-        rec_ptr->root_folder[path_move_up_real(rec_ptr->root_folder) + 1] =
-            '\0';
-        free(current_wd);
-      }
-    }
+    rec_ptr = _key_parse_recursion_new(file_name);
   } else {
     rec_ptr = rec;
   }
@@ -274,6 +251,7 @@ void key_file_parse_with_callback(const char *file_name,
 
   size_t current_keyword_length = 0;
   size_t current_keyword_line = (size_t)~0;
+  int skip_keyword = 0;
   size_t card_index = 0;
   size_t line_count = 0;
 
@@ -309,7 +287,7 @@ void key_file_parse_with_callback(const char *file_name,
     if (is_keyword) {
       /* If we already read a keyword we need to call the callback if the
        * keyword had no cards*/
-      if (current_keyword_length != 0 && card_index == 0) {
+      if (current_keyword_length != 0 && card_index == 0 && !skip_keyword) {
         char *keyword_name;
         if (current_keyword_length < EXTRA_STRING_BUFFER_SIZE) {
           keyword_name = current_keyword_name.buffer;
@@ -352,6 +330,27 @@ void key_file_parse_with_callback(const char *file_name,
       }
 
       card_index = 0;
+
+      /* Check the keyword filter once, so that the cards of skipped keywords
+       * can be ignored without looking at them*/
+      if (parse_config.num_include_keywords != 0 ||
+          parse_config.num_exclude_keywords != 0) {
+        if (current_keyword_length < EXTRA_STRING_BUFFER_SIZE) {
+          skip_keyword = !_key_keyword_is_wanted(&parse_config,
+                                                 current_keyword_name.buffer);
+        } else {
+          char *keyword_name = malloc(current_keyword_length + 1);
+          extra_string_copy_to_string(keyword_name, &current_keyword_name,
+                                      current_keyword_length);
+          keyword_name[current_keyword_length] = '\0';
+          skip_keyword = !_key_keyword_is_wanted(&parse_config, keyword_name);
+          free(keyword_name);
+        }
+      }
+    } else if (skip_keyword &&
+               !extra_string_starts_with(&current_keyword_name, "INCLUDE")) {
+      /* The keyword has been filtered out*/
+      continue;
     } else {
       /* -------- 🃏 Card Parsing 🃏 ----------*/
       card_t card;
@@ -397,12 +396,34 @@ void key_file_parse_with_callback(const char *file_name,
                 i++;
               }
 
+              /* Give the include callback the chance to skip the file*/
+              if (full_include_file_name && rec_ptr->include_callback) {
+                KEY_PARSE_INFO();
+                if (rec_ptr->include_callback(info, full_include_file_name, 0,
+                                              user_data)) {
+                  free(full_include_file_name);
+                  full_include_file_name = NULL;
+                  string_builder_free(&current_multi_line_string);
+                  card_index++;
+                  if (card.string != line_reader.line.buffer) {
+                    free(card.string);
+                  }
+                  continue;
+                }
+              }
+
               if (full_include_file_name) {
                 char *include_error, *include_warning;
                 /* Call the function recursively*/
                 key_file_parse_with_callback(
                     full_include_file_name, callback, &parse_config,
                     &include_error, &include_warning, user_data, rec_ptr);
+
+                if (rec_ptr->include_callback) {
+                  KEY_PARSE_INFO();
+                  rec_ptr->include_callback(info, full_include_file_name, 1,
+                                            user_data);
+                }
                 free(full_include_file_name);
 
                 /* Add the error to the error stack if an error occurred in
@@ -597,8 +618,10 @@ void key_file_parse_with_callback(const char *file_name,
         keyword_name[current_keyword_length] = '\0';
       }
 
-      KEY_PARSE_INFO();
-      callback(info, keyword_name, &card, card_index, user_data);
+      if (!skip_keyword) {
+        KEY_PARSE_INFO();
+        callback(info, keyword_name, &card, card_index, user_data);
+      }
 
       if (card.string != line_reader.line.buffer) {
         free(card.string);
@@ -619,7 +642,7 @@ void key_file_parse_with_callback(const char *file_name,
   } else {
     /* Call the callback for the last keyword if it is not "END", because some
      * keywords can have no cards*/
-    if (card_index == 0 &&
+    if (card_index == 0 && !skip_keyword &&
         (current_keyword_length != 3 ||
          extra_string_compare(&current_keyword_name, "END") != 0)) {
       char *keyword_name;
@@ -654,15 +677,7 @@ void key_file_parse_with_callback(const char *file_name,
 
   /* Free all recursion data (include paths, root folder)*/
   if (!rec) {
-    size_t i = 0;
-    while (i < rec_ptr->num_include_paths) {
-      free(rec_ptr->include_paths[i]);
-
-      i++;
-    }
-    free(rec_ptr->include_paths);
-    free(rec_ptr->root_folder);
-    free(rec_ptr);
+    _key_parse_recursion_free(rec_ptr);
   }
 
   free(line_reader.line.extra);
@@ -687,6 +702,49 @@ void key_file_parse_with_callback(const char *file_name,
   END_PROFILE_FUNC();
 }
 
+key_parse_recursion_t *_key_parse_recursion_new(const char *file_name) {
+  BEGIN_PROFILE_FUNC();
+
+  key_parse_recursion_t *rec = malloc(sizeof(key_parse_recursion_t));
+  rec->include_paths = NULL;
+  rec->num_include_paths = 0;
+  rec->extra_include_paths_applied = 0;
+  rec->include_callback = NULL;
+
+  const size_t index = path_move_up_real(file_name);
+  if (index == (size_t)~0) {
+    rec->root_folder = path_working_directory();
+  } else {
+    if (path_is_abs(file_name)) {
+      rec->root_folder = string_clone_len(file_name, index + 1);
+    } else {
+      char *current_wd = path_working_directory();
+      rec->root_folder = path_join_real(current_wd, file_name);
+      rec->root_folder[path_move_up_real(rec->root_folder) + 1] = '\0';
+      free(current_wd);
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return rec;
+}
+
+void _key_parse_recursion_free(key_parse_recursion_t *rec) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t i = 0;
+  while (i < rec->num_include_paths) {
+    free(rec->include_paths[i]);
+
+    i++;
+  }
+  free(rec->include_paths);
+  free(rec->root_folder);
+  free(rec);
+
+  END_PROFILE_FUNC();
+}
+
 void key_file_free(keyword_t *keywords, size_t num_keywords) {
   BEGIN_PROFILE_FUNC();
 
@@ -911,200 +969,8 @@ float card_parse_float32(const card_t *card) {
 float card_parse_float32_width(const card_t *card, uint8_t value_width) {
   BEGIN_PROFILE_FUNC();
 
-  errno = 0;
-
-  float result = 0.0f;
-  float fraction = 0.0f;
-  float exponent = 1.0f;
-  float sign = 1.0f;
-  int has_integer = 0;
-  int has_fraction = 0;
-  int has_exponent = 0;
-  int exponent_sign = 1;
-  int exponent_value = 0;
-
-  uint8_t i = card->current_index;
-  /* Loop until leading whitespace is trimmed*/
-  while (i < card->current_index + value_width && card->string[i] == ' ') {
-    i++;
-  }
-
-  /* The string is completely empty or just spaces*/
-  if (i == card->current_index + value_width || card->string[i] == '\0') {
-    errno = EINVAL;
-
-    END_PROFILE_FUNC();
-    return 0.0f;
-  }
-
-  /* Check for sign*/
-  if (card->string[i] == '-') {
-    sign = -1.0f;
-    i++;
-  } else if (card->string[i] == '+') {
-    i++;
-  }
-
-  if (i == card->current_index + value_width || card->string[i] == '\0' ||
-      card->string[i] == ' ') {
-    errno = EINVAL;
-
-    END_PROFILE_FUNC();
-    return 0.0f;
-  }
-
-  /* Parse integer part*/
-  while (i < card->current_index + value_width && card->string[i] != '\0' &&
-         card->string[i] != '.' && card->string[i] != 'e' &&
-         card->string[i] != 'E') {
-    if (card->string[i] >= '0' && card->string[i] <= '9') {
-      has_integer = 1;
-
-      result = result * 10.0f + (card->string[i] - '0');
-    } else if (card->string[i] == ' ') {
-      /* Quit when encountering whitespace*/
-      result *= sign;
-
-      END_PROFILE_FUNC();
-      return result;
-    } else {
-      /* Invalid character*/
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return 0.0f;
-    }
-    i++;
-  }
-
-  /* If we already reached the end*/
-  if (i == card->current_index + value_width || card->string[i] == '\0') {
-    result *= sign;
-
-    END_PROFILE_FUNC();
-    return result;
-  }
-
-  /* Parse fraction part*/
-  if (card->string[i] == '.') {
-    i++;
-    has_fraction = 1;
-    while (i < card->current_index + value_width && card->string[i] != '\0' &&
-           card->string[i] != 'e' && card->string[i] != 'E') {
-      if (card->string[i] >= '0' && card->string[i] <= '9') {
-        fraction = fraction * 10.0f + (card->string[i] - '0');
-        exponent *= 10.0f;
-        i++;
-      } else if (card->string[i] == ' ') {
-        /* Quit when encountering whitespace*/
-        fraction /= exponent;
-        result += fraction;
-        result *= sign;
-
-        END_PROFILE_FUNC();
-        return result;
-      } else {
-        /* Invalid character*/
-        errno = EINVAL;
-
-        return 0.0;
-      }
-    }
-
-    /* If we already reached the end*/
-    if (i == card->current_index + value_width || card->string[i] == '\0') {
-      fraction /= exponent;
-      result += fraction;
-      result *= sign;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-  }
-
-  /* Parse exponent part*/
-  if (card->string[i] == 'e' || card->string[i] == 'E') {
-    if (!has_integer) {
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return 0.0f;
-    }
-
-    i++;
-    if (card->string[i] == '-') {
-      exponent_sign = -1;
-      i++;
-    } else if (card->string[i] == '+') {
-      i++;
-    }
-
-    if (i == card->current_index + value_width || card->string[i] == '\0' ||
-        card->string[i] == ' ') {
-      if (has_fraction) {
-        fraction /= exponent;
-        result += fraction;
-      }
-
-      result *= sign;
-
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-
-    while (i < card->current_index + value_width && card->string[i] != '\0') {
-      if (card->string[i] >= '0' && card->string[i] <= '9') {
-        has_exponent = 1;
-
-        exponent_value = exponent_value * 10 + (card->string[i] - '0');
-        i++;
-      } else if (card->string[i] == ' ') {
-        /* Quit when encountering whitespace*/
-        if (has_fraction) {
-          fraction /= exponent;
-          result += fraction;
-        }
-        result *= pow(10, exponent_sign * exponent_value);
-        result *= sign;
-
-        END_PROFILE_FUNC();
-        return result;
-      } else {
-        /* Invalid character*/
-        errno = EINVAL;
-
-        END_PROFILE_FUNC();
-        return 0.0f;
-      }
-    }
-
-    if (!has_exponent) {
-      if (has_fraction) {
-        fraction /= exponent;
-        result += fraction;
-      }
-
-      result *= sign;
-
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-  }
-
-  /* Combine integer, fraction, and exponent parts */
-  if (has_fraction) {
-    fraction /= exponent;
-    result += fraction;
-  }
-  if (has_exponent) {
-    result *= pow(10, exponent_sign * exponent_value);
-  }
-
-  result *= sign;
+  const float result = (float)_parse_float64_field(
+      &card->string[card->current_index], value_width);
 
   END_PROFILE_FUNC();
   return result;
@@ -1117,200 +983,8 @@ double card_parse_float64(const card_t *card) {
 double card_parse_float64_width(const card_t *card, uint8_t value_width) {
   BEGIN_PROFILE_FUNC();
 
-  errno = 0;
-
-  double result = 0.0;
-  double fraction = 0.0;
-  double exponent = 1.0;
-  double sign = 1.0;
-  int has_integer = 0;
-  int has_fraction = 0;
-  int has_exponent = 0;
-  int exponent_sign = 1;
-  int exponent_value = 0;
-
-  uint8_t i = card->current_index;
-  /* Loop until leading whitespace is trimmed*/
-  while (i < card->current_index + value_width && card->string[i] == ' ') {
-    i++;
-  }
-
-  /* The string is completely empty or just spaces*/
-  if (i == card->current_index + value_width || card->string[i] == '\0') {
-    errno = EINVAL;
-
-    END_PROFILE_FUNC();
-    return 0.0;
-  }
-
-  /* Check for sign*/
-  if (card->string[i] == '-') {
-    sign = -1.0;
-    i++;
-  } else if (card->string[i] == '+') {
-    i++;
-  }
-
-  if (i == card->current_index + value_width || card->string[i] == '\0' ||
-      card->string[i] == ' ') {
-    errno = EINVAL;
-
-    END_PROFILE_FUNC();
-    return 0.0;
-  }
-
-  /* Parse integer part*/
-  while (i < card->current_index + value_width && card->string[i] != '\0' &&
-         card->string[i] != '.' && card->string[i] != 'e' &&
-         card->string[i] != 'E') {
-    if (card->string[i] >= '0' && card->string[i] <= '9') {
-      has_integer = 1;
-
-      result = result * 10.0 + (card->string[i] - '0');
-    } else if (card->string[i] == ' ') {
-      /* Quit when encountering whitespace*/
-      result *= sign;
-
-      END_PROFILE_FUNC();
-      return result;
-    } else {
-      /* Invalid character*/
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return 0.0;
-    }
-    i++;
-  }
-
-  /* If we already reached the end*/
-  if (i == card->current_index + value_width || card->string[i] == '\0') {
-    result *= sign;
-
-    END_PROFILE_FUNC();
-    return result;
-  }
-
-  /* Parse fraction part*/
-  if (card->string[i] == '.') {
-    i++;
-    has_fraction = 1;
-    while (i < card->current_index + value_width && card->string[i] != '\0' &&
-           card->string[i] != 'e' && card->string[i] != 'E') {
-      if (card->string[i] >= '0' && card->string[i] <= '9') {
-        fraction = fraction * 10.0 + (card->string[i] - '0');
-        exponent *= 10.0;
-        i++;
-      } else if (card->string[i] == ' ') {
-        /* Quit when encountering whitespace*/
-        fraction /= exponent;
-        result += fraction;
-        result *= sign;
-
-        END_PROFILE_FUNC();
-        return result;
-      } else {
-        /* Invalid character*/
-        errno = EINVAL;
-
-        return 0.0;
-      }
-    }
-
-    /* If we already reached the end*/
-    if (i == card->current_index + value_width || card->string[i] == '\0') {
-      fraction /= exponent;
-      result += fraction;
-      result *= sign;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-  }
-
-  /* Parse exponent part*/
-  if (card->string[i] == 'e' || card->string[i] == 'E') {
-    if (!has_integer) {
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return 0.0;
-    }
-
-    i++;
-    if (card->string[i] == '-') {
-      exponent_sign = -1;
-      i++;
-    } else if (card->string[i] == '+') {
-      i++;
-    }
-
-    if (i == card->current_index + value_width || card->string[i] == '\0' ||
-        card->string[i] == ' ') {
-      if (has_fraction) {
-        fraction /= exponent;
-        result += fraction;
-      }
-
-      result *= sign;
-
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-
-    while (i < card->current_index + value_width && card->string[i] != '\0') {
-      if (card->string[i] >= '0' && card->string[i] <= '9') {
-        has_exponent = 1;
-
-        exponent_value = exponent_value * 10 + (card->string[i] - '0');
-        i++;
-      } else if (card->string[i] == ' ') {
-        /* Quit when encountering whitespace*/
-        if (has_fraction) {
-          fraction /= exponent;
-          result += fraction;
-        }
-        result *= pow(10, exponent_sign * exponent_value);
-        result *= sign;
-
-        END_PROFILE_FUNC();
-        return result;
-      } else {
-        /* Invalid character*/
-        errno = EINVAL;
-
-        END_PROFILE_FUNC();
-        return 0.0;
-      }
-    }
-
-    if (!has_exponent) {
-      if (has_fraction) {
-        fraction /= exponent;
-        result += fraction;
-      }
-
-      result *= sign;
-
-      errno = EINVAL;
-
-      END_PROFILE_FUNC();
-      return result;
-    }
-  }
-
-  /* Combine integer, fraction, and exponent parts */
-  if (has_fraction) {
-    fraction /= exponent;
-    result += fraction;
-  }
-  if (has_exponent) {
-    result *= pow(10, exponent_sign * exponent_value);
-  }
-
-  result *= sign;
+  const double result =
+      _parse_float64_field(&card->string[card->current_index], value_width);
 
   END_PROFILE_FUNC();
   return result;
@@ -1476,8 +1150,11 @@ card_parse_type card_parse_get_type_width(const card_t *card,
       return CARD_PARSE_FLOAT;
     }
 
-    if (card->string[i] == 'e' || card->string[i] == 'E') {
-      i++;
+    if (_is_exponent_char(card->string[i])) {
+      /* Fortran style exponents (e.g. 1.0-3) start directly with the sign*/
+      if (card->string[i] != '+' && card->string[i] != '-') {
+        i++;
+      }
       if (card->string[i] == '+' || card->string[i] == '-') {
         i++;
       }
@@ -1500,8 +1177,10 @@ card_parse_type card_parse_get_type_width(const card_t *card,
         return CARD_PARSE_FLOAT;
       }
     }
-  } else if (card->string[i] == 'e' || card->string[i] == 'E') {
-    i++;
+  } else if (_is_exponent_char(card->string[i])) {
+    if (card->string[i] != '+' && card->string[i] != '-') {
+      i++;
+    }
     if (card->string[i] == '+' || card->string[i] == '-') {
       i++;
     }
@@ -1612,3 +1291,335 @@ int _parse_multi_line_string(string_builder_t *multi_line_string,
   END_PROFILE_FUNC();
   return 1;
 }
+
+/* All powers of ten that can be represented exactly by a double*/
+static const double _exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* The maximum amount of digits that always fit into an uint64_t*/
+#define MAX_MANTISSA_DIGITS 19
+/* Every integer up to this value can be represented exactly by a double*/
+#define MAX_EXACT_MANTISSA ((uint64_t)1 << 53)
+/* Exponents are clamped to this value to prevent overflows. Every double
+ * overflows or underflows long before that anyway*/
+#define MAX_EXPONENT 100000
+
+/* Loading eight characters into an uint64_t and interpreting them as digits
+ * only works if the first character ends up in the lowest byte*/
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_WIN32)
+#define SWAR_DIGITS
+#endif
+
+#define BROADCAST_BYTE(b)                                                      \
+  ((uint64_t)(b) * ((((uint64_t)0x01010101) << 32) | 0x01010101))
+
+int _is_exponent_char(char c) {
+  return c == 'e' || c == 'E' || c == 'd' || c == 'D' || c == '+' || c == '-';
+}
+
+int _is_eight_digits(uint64_t chunk) {
+  /* Every byte needs to be 0x30 to 0x39*/
+  return (((chunk & BROADCAST_BYTE(0xF0)) |
+           (((chunk + BROADCAST_BYTE(0x06)) & BROADCAST_BYTE(0xF0)) >> 4)) ==
+          BROADCAST_BYTE(0x33));
+}
+
+uint32_t _parse_eight_digits(uint64_t chunk) {
+  const uint64_t mask = ((uint64_t)0x000000FF << 32) | 0x000000FF;
+  const uint64_t mul1 = ((uint64_t)1000000 << 32) | 100;
+  const uint64_t mul2 = ((uint64_t)10000 << 32) | 1;
+
+  /* Combine pairs of digits, then pairs of two digit numbers and so on*/
+  chunk -= BROADCAST_BYTE('0');
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+  return (uint32_t)chunk;
+}
+
+double _parse_float64_field(const char *field, size_t field_width) {
+  BEGIN_PROFILE_FUNC();
+
+  errno = 0;
+
+  /* The field ends at field_width or the end of the string*/
+  size_t length = 0;
+  while (length < field_width && field[length] != '\0') {
+    length++;
+  }
+
+  size_t i = 0;
+  /* Loop until leading whitespace is trimmed*/
+  while (i < length && field[i] == ' ') {
+    i++;
+  }
+
+  /* The field is completely empty or just spaces*/
+  if (i == length) {
+    errno = EINVAL;
+
+    END_PROFILE_FUNC();
+    return 0.0;
+  }
+
+  int negative = 0;
+  if (field[i] == '-') {
+    negative = 1;
+    i++;
+  } else if (field[i] == '+') {
+    i++;
+  }
+
+  const size_t mantissa_start = i;
+  uint64_t mantissa = 0;
+  int num_digits = 0; /* The number of significant digits in mantissa*/
+  int exponent = 0;
+  int has_digits = 0;
+  int truncated = 0; /* Wether some digits did not fit into mantissa*/
+
+  /* Parse integer part. Leading zeros are not significant*/
+  while (i < length && field[i] == '0') {
+    has_digits = 1;
+    i++;
+  }
+
+#ifdef SWAR_DIGITS
+  while (i + 8 <= length && num_digits + 8 <= MAX_MANTISSA_DIGITS) {
+    uint64_t chunk;
+    memcpy(&chunk, &field[i], 8);
+    if (!_is_eight_digits(chunk)) {
+      break;
+    }
+
+    mantissa = mantissa * 100000000 + _parse_eight_digits(chunk);
+    num_digits += 8;
+    has_digits = 1;
+    i += 8;
+  }
+#endif
+
+  while (i < length && field[i] >= '0' && field[i] <= '9') {
+    if (num_digits < MAX_MANTISSA_DIGITS) {
+      mantissa = mantissa * 10 + (field[i] - '0');
+      num_digits += mantissa != 0;
+    } else {
+      exponent++;
+      truncated = 1;
+    }
+    has_digits = 1;
+    i++;
+  }
+
+  /* Parse fraction part*/
+  if (i < length && field[i] == '.') {
+    i++;
+
+    /* Leading zeros of the fraction are not significant either*/
+    if (mantissa == 0) {
+      while (i < length && field[i] == '0') {
+        exponent--;
+        has_digits = 1;
+        i++;
+      }
+    }
+
+#ifdef SWAR_DIGITS
+    while (i + 8 <= length && num_digits + 8 <= MAX_MANTISSA_DIGITS) {
+      uint64_t chunk;
+      memcpy(&chunk, &field[i], 8);
+      if (!_is_eight_digits(chunk)) {
+        break;
+      }
+
+      mantissa = mantissa * 100000000 + _parse_eight_digits(chunk);
+      num_digits += 8;
+      exponent -= 8;
+      has_digits = 1;
+      i += 8;
+    }
+#endif
+
+    while (i < length && field[i] >= '0' && field[i] <= '9') {
+      if (num_digits < MAX_MANTISSA_DIGITS) {
+        mantissa = mantissa * 10 + (field[i] - '0');
+        num_digits += mantissa != 0;
+        exponent--;
+      } else {
+        truncated = 1;
+      }
+      has_digits = 1;
+      i++;
+    }
+  }
+
+  const size_t mantissa_end = i;
+
+  if (!has_digits) {
+    errno = EINVAL;
+
+    END_PROFILE_FUNC();
+    return 0.0;
+  }
+
+  /* Parse exponent part. Supports 1.0e-3, 1.0E-3, 1.0d-3, 1.0D-3 and the
+   * Fortran style 1.0-3*/
+  int exponent_value = 0;
+  if (i < length && _is_exponent_char(field[i])) {
+    if (field[i] != '+' && field[i] != '-') {
+      i++;
+    }
+
+    int exponent_negative = 0;
+    if (i < length && field[i] == '-') {
+      exponent_negative = 1;
+      i++;
+    } else if (i < length && field[i] == '+') {
+      i++;
+    }
+
+    if (i == length || field[i] < '0' || field[i] > '9') {
+      errno = EINVAL;
+
+      END_PROFILE_FUNC();
+      return 0.0;
+    }
+
+    while (i < length && field[i] >= '0' && field[i] <= '9') {
+      if (exponent_value < MAX_EXPONENT) {
+        exponent_value = exponent_value * 10 + (field[i] - '0');
+      }
+      i++;
+    }
+
+    if (exponent_negative) {
+      exponent_value = -exponent_value;
+    }
+  }
+
+  /* Only whitespace may follow*/
+  if (i < length && field[i] != ' ') {
+    errno = EINVAL;
+
+    END_PROFILE_FUNC();
+    return 0.0;
+  }
+
+  double result;
+  if (mantissa == 0) {
+    result = 0.0;
+  } else {
+    exponent += exponent_value;
+
+    if (!truncated && mantissa <= MAX_EXACT_MANTISSA && exponent >= -22 &&
+        exponent <= 22) {
+      /* Both the mantissa and the power of ten are exact, so that the result
+       * is correctly rounded*/
+      result = (double)mantissa;
+      if (exponent < 0) {
+        result /= _exact_powers_of_ten[-exponent];
+      } else {
+        result *= _exact_powers_of_ten[exponent];
+      }
+    } else {
+      result = _parse_float64_slow(&field[mantissa_start],
+                                   mantissa_end - mantissa_start,
+                                   exponent_value);
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return negative ? -result : result;
+}
+
+double _parse_float64_slow(const char *mantissa, size_t mantissa_length,
+                           int exponent) {
+  BEGIN_PROFILE_FUNC();
+
+  /* Build a string of the form <digits>e<exponent> without a decimal point, so
+   * that strtod does not depend on the locale*/
+  char stack_buffer[64];
+  const size_t buffer_size = mantissa_length + 16;
+  char *buffer =
+      buffer_size <= sizeof(stack_buffer) ? stack_buffer : malloc(buffer_size);
+
+  size_t buffer_length = 0;
+  size_t i = 0;
+  while (i < mantissa_length) {
+    if (mantissa[i] == '.') {
+      /* Every digit after the decimal point decreases the exponent*/
+      exponent -= (int)(mantissa_length - i - 1);
+    } else {
+      buffer[buffer_length++] = mantissa[i];
+    }
+    i++;
+  }
+  sprintf(&buffer[buffer_length], "e%d", exponent);
+
+  const double result = strtod(buffer, NULL);
+
+  if (buffer != stack_buffer) {
+    free(buffer);
+  }
+
+  END_PROFILE_FUNC();
+  return result;
+}
+
+int _key_glob_match(const char *pattern, const char *string) {
+  BEGIN_PROFILE_FUNC();
+
+  /* Position after the last '*' and the position in string where it was
+   * matched, so that we can backtrack*/
+  const char *star_pattern = NULL;
+  const char *star_string = NULL;
+
+  while (*string != '\0') {
+    if (*pattern == '*') {
+      star_pattern = ++pattern;
+      star_string = string;
+    } else if (*pattern != '\0' &&
+               (*pattern == '?' ||
+                toupper((unsigned char)*pattern) ==
+                    toupper((unsigned char)*string))) {
+      pattern++;
+      string++;
+    } else if (star_pattern) {
+      /* Let the last '*' match one more character*/
+      pattern = star_pattern;
+      string = ++star_string;
+    } else {
+      END_PROFILE_FUNC();
+      return 0;
+    }
+  }
+
+  while (*pattern == '*') {
+    pattern++;
+  }
+
+  END_PROFILE_FUNC();
+  return *pattern == '\0';
+}
+
+int _key_keyword_is_wanted(const key_parse_config_t *parse_config,
+                           const char *keyword_name) {
+  BEGIN_PROFILE_FUNC();
+
+  int wanted = parse_config->num_include_keywords == 0;
+
+  size_t i = 0;
+  while (!wanted && i < parse_config->num_include_keywords) {
+    wanted = _key_glob_match(parse_config->include_keywords[i], keyword_name);
+    i++;
+  }
+
+  i = 0;
+  while (wanted && i < parse_config->num_exclude_keywords) {
+    wanted = !_key_glob_match(parse_config->exclude_keywords[i], keyword_name);
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return wanted;
+}
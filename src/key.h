@@ -69,22 +69,20 @@ typedef struct {
                                  keyword and such*/
   size_t num_extra_include_paths; /* The number of strings in the
                                      extra_include_paths array*/
+  char **include_keywords; /* Glob patterns (supporting '*' and '?') of the
+                              keywords that should be parsed (e.g. "MAT_*"). If
+                              empty every keyword is parsed. Matching ignores
+                              case*/
+  size_t num_include_keywords; /* The number of strings in the
+                                  include_keywords array*/
+  char **exclude_keywords; /* Glob patterns of keywords that should be skipped
+                              (e.g. "ELEMENT_*"). The cards of skipped keywords
+                              are neither given to the callback nor stored.
+                              INCLUDE keywords are still followed*/
+  size_t num_exclude_keywords; /* The number of strings in the
+                                  exclude_keywords array*/
 } key_parse_config_t;
 
-/* Holds all variables used for recursion*/
-typedef struct {
-  char **include_paths;     /* Holds all paths that are added with INCLUDE_PATH
-                               keywords and such*/
-  size_t num_include_paths; /* The number of include paths*/
-  char *root_folder;        /* The folder which contains the file with which the
-                               function was invoked first*/
-  int extra_include_paths_applied; /* Wether the additional include paths of the
-                                      parse config have already been applied*/
-} key_parse_recursion_t;
-
-/* Returns a key_parse_config_t with all values set to the default*/
-key_parse_config_t key_default_parse_config();
-
 /* Holds information about the current state when parsing a key file*/
 typedef struct {
   const char *file_name;      /* Name of the current file*/
@@ -102,10 +100,41 @@ typedef void (*key_file_callback)(key_parse_info_t info,
                                   const char *keyword_name, card_t *card,
                                   size_t card_index, void *user_data);
 
+/* The type of the callback that is called before (end = 0) and after (end = 1)
+ * an include file is parsed. If it returns a non zero value before the include
+ * file is parsed, the file will be skipped and the callback will not be called
+ * after it*/
+typedef int (*key_file_include_callback)(key_parse_info_t info,
+                                         const char *include_file_name, int end,
+                                         void *user_data);
+
+/* Holds all variables used for recursion*/
+typedef struct {
+  char **include_paths;     /* Holds all paths that are added with INCLUDE_PATH
+                               keywords and such*/
+  size_t num_include_paths; /* The number of include paths*/
+  char *root_folder;        /* The folder which contains the file with which the
+                               function was invoked first*/
+  int extra_include_paths_applied; /* Wether the additional include paths of the
+                                      parse config have already been applied*/
+  key_file_include_callback include_callback; /* Called around every include
+                                                 file. Can be NULL*/
+} key_parse_recursion_t;
+
+/* The user data of key_file_parse_callback*/
+typedef struct {
+  keyword_t *current_keyword;
+  keyword_t *keywords;
+  size_t *num_keywords;
+} key_file_parse_data;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Returns a key_parse_config_t with all values set to the default*/
+key_parse_config_t key_default_parse_config();
+
 /* Parses a LS Dyna key file for keywords and their respective cards. Returns an
  * array of keyword_t and sets num_keywords to the number of elements in the
  * array. Needs to be deallocated by key_file_free.
@@ -240,12 +269,45 @@ int card_parse_is_empty(const card_t *card);
 int card_parse_is_empty_width(const card_t *card, uint8_t value_width);
 
 /* ----- Private Functions -----*/
+/* Appends msg to stack and separates it from the previous message with a new
+ * line*/
+void _message_stack_push(string_builder_t *stack, const char *msg);
+/* Allocates the recursion data for a parse call starting at file_name*/
+key_parse_recursion_t *_key_parse_recursion_new(const char *file_name);
+/* Deallocates everything of rec including rec itself*/
+void _key_parse_recursion_free(key_parse_recursion_t *rec);
+/* The callback used by key_file_parse to collect all keywords into a sorted
+ * array. user_data needs to be a key_file_parse_data*/
+void key_file_parse_callback(key_parse_info_t info, const char *keyword_name,
+                             card_t *card, size_t card_index, void *user_data);
 /* Copy the contents of the card as a string directly into dst.*/
 void _card_cpy(const card_t *card, char *dst, size_t len);
+/* Returns wether string matches the glob pattern. '*' matches any number of
+ * characters and '?' matches exactly one character. Ignores case.*/
+int _key_glob_match(const char *pattern, const char *string);
+/* Returns wether a keyword should be given to the callback according to the
+ * include_keywords and exclude_keywords of parse_config*/
+int _key_keyword_is_wanted(const key_parse_config_t *parse_config,
+                           const char *keyword_name);
 /* Handles the parsing of multi line string for include file names. Returns
  * wether the multi line string has been completely parsed.*/
 int _parse_multi_line_string(string_builder_t *multi_line_string,
                              const card_t *card, size_t line_length);
+/* Parses a LS Dyna number field of at most field_width characters (or until
+ * the end of the string) as a double. Supports exponents in the form of 1.0e-3,
+ * 1.0d-3 and the Fortran style 1.0-3. Sets errno to EINVAL if the field is
+ * blank or not a number. Digits are accumulated eight at a time and the result
+ * is computed exactly for mantissas of up to 15 digits*/
+double _parse_float64_field(const char *field, size_t field_width);
+/* Fallback of _parse_float64_field for long mantissas and large exponents*/
+double _parse_float64_slow(const char *mantissa, size_t mantissa_length,
+                           int exponent);
+/* Returns wether c can start the exponent of a number (e, E, d, D, + or -)*/
+int _is_exponent_char(char c);
+/* Returns wether all eight characters loaded into chunk are digits*/
+int _is_eight_digits(uint64_t chunk);
+/* Converts eight digit characters loaded into chunk into their value*/
+uint32_t _parse_eight_digits(uint64_t chunk);
 /* -----------------------------*/
 
 #ifdef __cplusplus
@@ -0,0 +1,634 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "key_incremental.h"
+#include "path.h"
+#include "profiling.h"
+#include "string_builder.h"
+#include <stdlib.h>
+#include <string.h>
+
+key_incremental_t key_incremental_new() {
+  key_incremental_t incremental;
+  memset(&incremental, 0, sizeof(incremental));
+  return incremental;
+}
+
+void key_incremental_parse_with_callback(key_incremental_t *incremental,
+                                         const char *file_name,
+                                         key_file_callback callback,
+                                         const key_parse_config_t *parse_config,
+                                         char **error_string,
+                                         char **warning_string,
+                                         void *user_data) {
+  BEGIN_PROFILE_FUNC();
+
+  key_incremental_parse_data data;
+  data.incremental = incremental;
+  data.callback = callback;
+  data.user_data = user_data;
+  data.parse_config = parse_config;
+  data.file_stack = NULL;
+  data.file_stack_size = 0;
+  data.parsed_files = NULL;
+  data.num_parsed_files = 0;
+  data.error_stack = string_builder_new();
+  data.warning_stack = string_builder_new();
+
+  incremental->num_parsed_files = 0;
+  incremental->num_reused_files = 0;
+
+  const key_parse_config_t config =
+      parse_config ? *parse_config : key_default_parse_config();
+
+  /* A different root file or parse config can not reuse anything*/
+  if (incremental->num_files != 0 &&
+      (strcmp(incremental->files[0].file_name, file_name) != 0 ||
+       !_key_incremental_config_equal(&incremental->parse_config, &config))) {
+    key_incremental_free(incremental);
+  }
+
+  if (incremental->num_files == 0) {
+    _key_incremental_free_config(&incremental->parse_config);
+    incremental->parse_config = _key_incremental_copy_config(&config);
+    _key_incremental_add_file(incremental, file_name, NULL, 0);
+    incremental->files[0].reparse = 1;
+  }
+
+  key_incremental_file_t *root = &incremental->files[0];
+  if (root->reparse || _key_incremental_file_changed(root)) {
+    /* The root file uses the same recursion data as
+     * key_file_parse_with_callback so that the extra include paths of the
+     * parse config are applied*/
+    key_parse_recursion_t *rec = _key_parse_recursion_new(file_name);
+    free(incremental->root_folder);
+    incremental->root_folder = string_clone(rec->root_folder);
+
+    _key_incremental_parse_file(&data, 0, rec);
+
+    /* Store the include paths for replaying*/
+    root = &incremental->files[0];
+    size_t i = 0;
+    while (i < root->num_include_paths) {
+      free(root->include_paths[i]);
+      i++;
+    }
+    free(root->include_paths);
+    root->num_include_paths = rec->num_include_paths;
+    root->include_paths = malloc(rec->num_include_paths * sizeof(char *));
+    i = 0;
+    while (i < rec->num_include_paths) {
+      root->include_paths[i] = string_clone(rec->include_paths[i]);
+      i++;
+    }
+
+    _key_parse_recursion_free(rec);
+  } else {
+    _key_incremental_replay_file(&data, 0);
+  }
+
+  _key_incremental_remove_unused_files(incremental);
+
+  free(data.file_stack);
+  free(data.parsed_files);
+
+  if (error_string) {
+    *error_string = string_builder_move(&data.error_stack);
+  }
+  if (warning_string) {
+    *warning_string = string_builder_move(&data.warning_stack);
+  }
+  string_builder_free(&data.error_stack);
+  string_builder_free(&data.warning_stack);
+
+  END_PROFILE_FUNC();
+}
+
+keyword_t *key_incremental_parse(key_incremental_t *incremental,
+                                 const char *file_name, size_t *num_keywords,
+                                 const key_parse_config_t *parse_config,
+                                 char **error_string, char **warning_string) {
+  BEGIN_PROFILE_FUNC();
+
+  key_file_parse_data data;
+  data.current_keyword = NULL;
+  data.keywords = NULL;
+  data.num_keywords = num_keywords;
+  *num_keywords = 0;
+
+  char *internal_error_string;
+
+  key_incremental_parse_with_callback(
+      incremental, file_name, key_file_parse_callback, parse_config,
+      &internal_error_string, warning_string, &data);
+
+  /* Deallocate the memory if an error occurred*/
+  if (internal_error_string) {
+    key_file_free(data.keywords, *data.num_keywords);
+    data.keywords = NULL;
+    *data.num_keywords = 0;
+    if (error_string) {
+      *error_string = internal_error_string;
+    } else {
+      free(internal_error_string);
+    }
+  } else if (error_string) {
+    *error_string = NULL;
+  }
+
+  END_PROFILE_FUNC();
+  return data.keywords;
+}
+
+void key_incremental_free(key_incremental_t *incremental) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t i = 0;
+  while (i < incremental->num_files) {
+    _key_incremental_free_file(&incremental->files[i]);
+    i++;
+  }
+  free(incremental->files);
+  free(incremental->root_folder);
+  _key_incremental_free_config(&incremental->parse_config);
+
+  incremental->files = NULL;
+  incremental->num_files = 0;
+  incremental->root_folder = NULL;
+
+  END_PROFILE_FUNC();
+}
+
+void _key_incremental_callback(key_parse_info_t info, const char *keyword_name,
+                               card_t *card, size_t card_index,
+                               void *user_data) {
+  key_incremental_parse_data *data = (key_incremental_parse_data *)user_data;
+
+  key_incremental_file_t *file =
+      &data->incremental->files[data->file_stack[data->file_stack_size - 1]];
+
+  if (file->num_events == file->events_capacity) {
+    file->events_capacity =
+        file->events_capacity == 0 ? 64 : file->events_capacity * 2;
+    file->events = realloc(file->events, file->events_capacity *
+                                             sizeof(key_incremental_event_t));
+  }
+
+  key_incremental_event_t *event = &file->events[file->num_events];
+  const key_incremental_event_t *previous =
+      file->num_events != 0 ? &file->events[file->num_events - 1] : NULL;
+
+  /* Cards of the same keyword share the name*/
+  if (previous && previous->keyword_name && card_index != 0 &&
+      card_index != (size_t)~0 &&
+      strcmp(previous->keyword_name, keyword_name) == 0) {
+    event->keyword_name = previous->keyword_name;
+  } else {
+    event->keyword_name = string_clone(keyword_name);
+  }
+  event->card = card ? string_clone(card->string) : NULL;
+  event->card_index = card_index;
+  event->line_number = info.line_number;
+  file->num_events++;
+
+  data->callback(info, keyword_name, card, card_index, data->user_data);
+}
+
+int _key_incremental_include_callback(key_parse_info_t info,
+                                      const char *include_file_name, int end,
+                                      void *user_data) {
+  key_incremental_parse_data *data = (key_incremental_parse_data *)user_data;
+  key_incremental_t *incremental = data->incremental;
+
+  if (end) {
+    data->file_stack_size--;
+    return 0;
+  }
+
+  size_t file_index =
+      _key_incremental_find_file(incremental, include_file_name);
+  const int reuse = file_index != (size_t)~0 &&
+                    !incremental->files[file_index].reparse &&
+                    !_key_incremental_file_changed(
+                        &incremental->files[file_index]);
+
+  if (file_index == (size_t)~0) {
+    file_index = _key_incremental_add_file(incremental, include_file_name,
+                                           info.include_paths,
+                                           info.num_include_paths);
+  } else if (!reuse) {
+    /* The include paths could have changed with the parent file*/
+    key_incremental_file_t *file = &incremental->files[file_index];
+    size_t i = 0;
+    while (i < file->num_include_paths) {
+      free(file->include_paths[i]);
+      i++;
+    }
+    free(file->include_paths);
+    file->num_include_paths = info.num_include_paths;
+    file->include_paths = malloc(info.num_include_paths * sizeof(char *));
+    i = 0;
+    while (i < info.num_include_paths) {
+      file->include_paths[i] = string_clone(info.include_paths[i]);
+      i++;
+    }
+  }
+
+  /* Record the include in the parent file*/
+  key_incremental_file_t *parent =
+      &incremental->files[data->file_stack[data->file_stack_size - 1]];
+  if (parent->num_events == parent->events_capacity) {
+    parent->events_capacity =
+        parent->events_capacity == 0 ? 64 : parent->events_capacity * 2;
+    parent->events =
+        realloc(parent->events,
+                parent->events_capacity * sizeof(key_incremental_event_t));
+  }
+  key_incremental_event_t *event = &parent->events[parent->num_events];
+  event->keyword_name = NULL;
+  event->card = NULL;
+  event->card_index = file_index;
+  event->line_number = info.line_number;
+  parent->num_events++;
+
+  if (reuse) {
+    _key_incremental_replay_file(data, file_index);
+    return 1;
+  }
+
+  /* Let key_file_parse_with_callback parse the file and record it*/
+  key_incremental_file_t *file = &incremental->files[file_index];
+  _key_incremental_free_events(file);
+  file->file_size = path_get_file_size(file->file_name);
+  file->modification_time = path_get_modification_time(file->file_name);
+  file->reparse = 0;
+
+  data->file_stack =
+      realloc(data->file_stack, (data->file_stack_size + 1) * sizeof(size_t));
+  data->file_stack[data->file_stack_size++] = file_index;
+  data->parsed_files = realloc(data->parsed_files,
+                               (data->num_parsed_files + 1) * sizeof(size_t));
+  data->parsed_files[data->num_parsed_files++] = file_index;
+  incremental->num_parsed_files++;
+
+  return 0;
+}
+
+void _key_incremental_parse_file(key_incremental_parse_data *data,
+                                 size_t file_index,
+                                 key_parse_recursion_t *rec) {
+  BEGIN_PROFILE_FUNC();
+
+  key_incremental_t *incremental = data->incremental;
+  key_incremental_file_t *file = &incremental->files[file_index];
+  _key_incremental_free_events(file);
+  file->file_size = path_get_file_size(file->file_name);
+  file->modification_time = path_get_modification_time(file->file_name);
+  file->reparse = 0;
+
+  data->file_stack =
+      realloc(data->file_stack, (data->file_stack_size + 1) * sizeof(size_t));
+  data->file_stack[data->file_stack_size++] = file_index;
+  const size_t first_parsed_file = data->num_parsed_files;
+  data->parsed_files = realloc(data->parsed_files,
+                               (data->num_parsed_files + 1) * sizeof(size_t));
+  data->parsed_files[data->num_parsed_files++] = file_index;
+  incremental->num_parsed_files++;
+
+  rec->include_callback = _key_incremental_include_callback;
+
+  /* The file name is cloned, since the files array can be reallocated while
+   * parsing*/
+  char *file_name = string_clone(file->file_name);
+  char *error_string, *warning_string;
+  key_file_parse_with_callback(file_name, _key_incremental_callback,
+                               data->parse_config, &error_string,
+                               &warning_string, data, rec);
+  free(file_name);
+
+  data->file_stack_size--;
+
+  if (error_string) {
+    _message_stack_push(&data->error_stack, error_string);
+    free(error_string);
+  }
+  if (warning_string) {
+    _message_stack_push(&data->warning_stack, warning_string);
+    free(warning_string);
+  }
+
+  /* The messages can not be traced back to a single file, so every file read
+   * by this call is read again next time to reproduce them*/
+  if (error_string || warning_string) {
+    size_t i = first_parsed_file;
+    while (i < data->num_parsed_files) {
+      incremental->files[data->parsed_files[i]].reparse = 1;
+      i++;
+    }
+  }
+
+  END_PROFILE_FUNC();
+}
+
+void _key_incremental_replay_file(key_incremental_parse_data *data,
+                                  size_t file_index) {
+  BEGIN_PROFILE_FUNC();
+
+  key_incremental_t *incremental = data->incremental;
+  key_incremental_file_t *file = &incremental->files[file_index];
+
+  if (file->reparse || _key_incremental_file_changed(file)) {
+    key_parse_recursion_t *rec = malloc(sizeof(key_parse_recursion_t));
+    rec->num_include_paths = file->num_include_paths;
+    rec->include_paths = malloc(file->num_include_paths * sizeof(char *));
+    size_t i = 0;
+    while (i < file->num_include_paths) {
+      rec->include_paths[i] = string_clone(file->include_paths[i]);
+      i++;
+    }
+    rec->root_folder = string_clone(incremental->root_folder);
+    rec->extra_include_paths_applied = 1;
+
+    _key_incremental_parse_file(data, file_index, rec);
+    _key_parse_recursion_free(rec);
+
+    END_PROFILE_FUNC();
+    return;
+  }
+
+  incremental->num_reused_files++;
+
+  size_t i = 0;
+  while (i < incremental->files[file_index].num_events) {
+    /* Replaying an include can reallocate the files array*/
+    file = &incremental->files[file_index];
+    const key_incremental_event_t *event = &file->events[i];
+
+    if (!event->keyword_name) {
+      _key_incremental_replay_file(data, event->card_index);
+    } else {
+      key_parse_info_t info;
+      info.file_name = file->file_name;
+      info.line_number = event->line_number;
+      info.include_paths = file->include_paths;
+      info.num_include_paths = file->num_include_paths;
+      info.root_folder = incremental->root_folder;
+
+      card_t card;
+      card.string = event->card;
+      data->callback(info, event->keyword_name, event->card ? &card : NULL,
+                     event->card_index, data->user_data);
+    }
+
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+}
+
+int _key_incremental_file_changed(const key_incremental_file_t *file) {
+  return path_get_file_size(file->file_name) != file->file_size ||
+         path_get_modification_time(file->file_name) !=
+             file->modification_time;
+}
+
+key_parse_config_t
+_key_incremental_copy_config(const key_parse_config_t *parse_config) {
+  key_parse_config_t copy = *parse_config;
+  copy.extra_include_paths = _key_incremental_copy_strings(
+      parse_config->extra_include_paths, parse_config->num_extra_include_paths);
+  copy.include_keywords = _key_incremental_copy_strings(
+      parse_config->include_keywords, parse_config->num_include_keywords);
+  copy.exclude_keywords = _key_incremental_copy_strings(
+      parse_config->exclude_keywords, parse_config->num_exclude_keywords);
+  return copy;
+}
+
+void _key_incremental_free_config(key_parse_config_t *parse_config) {
+  char **arrays[3] = {parse_config->extra_include_paths,
+                      parse_config->include_keywords,
+                      parse_config->exclude_keywords};
+  const size_t sizes[3] = {parse_config->num_extra_include_paths,
+                           parse_config->num_include_keywords,
+                           parse_config->num_exclude_keywords};
+
+  size_t a = 0;
+  while (a < 3) {
+    size_t i = 0;
+    while (i < sizes[a]) {
+      free(arrays[a][i]);
+      i++;
+    }
+    free(arrays[a]);
+    a++;
+  }
+
+  memset(parse_config, 0, sizeof(key_parse_config_t));
+}
+
+int _key_incremental_config_equal(const key_parse_config_t *lhs,
+                                  const key_parse_config_t *rhs) {
+  return lhs->parse_includes == rhs->parse_includes &&
+         lhs->ignore_not_found_includes == rhs->ignore_not_found_includes &&
+         _key_incremental_strings_equal(
+             lhs->extra_include_paths, lhs->num_extra_include_paths,
+             rhs->extra_include_paths, rhs->num_extra_include_paths) &&
+         _key_incremental_strings_equal(
+             lhs->include_keywords, lhs->num_include_keywords,
+             rhs->include_keywords, rhs->num_include_keywords) &&
+         _key_incremental_strings_equal(
+             lhs->exclude_keywords, lhs->num_exclude_keywords,
+             rhs->exclude_keywords, rhs->num_exclude_keywords);
+}
+
+char **_key_incremental_copy_strings(char *const *strings,
+                                     size_t num_strings) {
+  if (num_strings == 0) {
+    return NULL;
+  }
+
+  char **copy = malloc(num_strings * sizeof(char *));
+  size_t i = 0;
+  while (i < num_strings) {
+    copy[i] = string_clone(strings[i]);
+    i++;
+  }
+  return copy;
+}
+
+int _key_incremental_strings_equal(char *const *lhs, size_t num_lhs,
+                                   char *const *rhs, size_t num_rhs) {
+  if (num_lhs != num_rhs) {
+    return 0;
+  }
+
+  size_t i = 0;
+  while (i < num_lhs) {
+    if (strcmp(lhs[i], rhs[i]) != 0) {
+      return 0;
+    }
+    i++;
+  }
+
+  return 1;
+}
+
+size_t _key_incremental_find_file(const key_incremental_t *incremental,
+                                  const char *file_name) {
+  size_t i = 0;
+  while (i < incremental->num_files) {
+    if (strcmp(incremental->files[i].file_name, file_name) == 0) {
+      return i;
+    }
+    i++;
+  }
+
+  return (size_t)~0;
+}
+
+size_t _key_incremental_add_file(key_incremental_t *incremental,
+                                 const char *file_name,
+                                 char *const *include_paths,
+                                 size_t num_include_paths) {
+  incremental->num_files++;
+  incremental->files =
+      realloc(incremental->files,
+              incremental->num_files * sizeof(key_incremental_file_t));
+
+  key_incremental_file_t *file =
+      &incremental->files[incremental->num_files - 1];
+  memset(file, 0, sizeof(key_incremental_file_t));
+  file->file_name = string_clone(file_name);
+  file->num_include_paths = num_include_paths;
+  if (num_include_paths != 0) {
+    file->include_paths = malloc(num_include_paths * sizeof(char *));
+    size_t i = 0;
+    while (i < num_include_paths) {
+      file->include_paths[i] = string_clone(include_paths[i]);
+      i++;
+    }
+  }
+
+  return incremental->num_files - 1;
+}
+
+void _key_incremental_free_events(key_incremental_file_t *file) {
+  size_t i = 0;
+  while (i < file->num_events) {
+    key_incremental_event_t *event = &file->events[i];
+    if (event->keyword_name &&
+        (i == 0 || file->events[i - 1].keyword_name != event->keyword_name)) {
+      free(event->keyword_name);
+    }
+    free(event->card);
+    i++;
+  }
+  free(file->events);
+
+  file->events = NULL;
+  file->num_events = 0;
+  file->events_capacity = 0;
+}
+
+void _key_incremental_free_file(key_incremental_file_t *file) {
+  _key_incremental_free_events(file);
+
+  size_t i = 0;
+  while (i < file->num_include_paths) {
+    free(file->include_paths[i]);
+    i++;
+  }
+  free(file->include_paths);
+  free(file->file_name);
+}
+
+void _key_incremental_remove_unused_files(key_incremental_t *incremental) {
+  BEGIN_PROFILE_FUNC();
+
+  if (incremental->num_files == 0) {
+    END_PROFILE_FUNC();
+    return;
+  }
+
+  size_t *new_indices = malloc(incremental->num_files * sizeof(size_t));
+  size_t i = 0;
+  while (i < incremental->num_files) {
+    new_indices[i] = (size_t)~0;
+    i++;
+  }
+
+  _key_incremental_mark_used(incremental, 0, new_indices);
+
+  /* Move all used files to the front*/
+  size_t num_used_files = 0;
+  i = 0;
+  while (i < incremental->num_files) {
+    if (new_indices[i] == (size_t)~0) {
+      _key_incremental_free_file(&incremental->files[i]);
+    } else {
+      new_indices[i] = num_used_files;
+      incremental->files[num_used_files] = incremental->files[i];
+      num_used_files++;
+    }
+    i++;
+  }
+  incremental->num_files = num_used_files;
+
+  /* Update the indices of the includes*/
+  i = 0;
+  while (i < incremental->num_files) {
+    const key_incremental_file_t *file = &incremental->files[i];
+    size_t j = 0;
+    while (j < file->num_events) {
+      if (!file->events[j].keyword_name) {
+        file->events[j].card_index = new_indices[file->events[j].card_index];
+      }
+      j++;
+    }
+    i++;
+  }
+
+  free(new_indices);
+
+  END_PROFILE_FUNC();
+}
+
+void _key_incremental_mark_used(const key_incremental_t *incremental,
+                                size_t file_index, size_t *new_indices) {
+  if (new_indices[file_index] != (size_t)~0) {
+    return;
+  }
+  new_indices[file_index] = 0;
+
+  const key_incremental_file_t *file = &incremental->files[file_index];
+  size_t i = 0;
+  while (i < file->num_events) {
+    if (!file->events[i].keyword_name) {
+      _key_incremental_mark_used(incremental, file->events[i].card_index,
+                                 new_indices);
+    }
+    i++;
+  }
+}
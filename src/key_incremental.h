@@ -0,0 +1,171 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef KEY_INCREMENTAL_H
+#define KEY_INCREMENTAL_H
+
+#include "key.h"
+#include <stdint.h>
+
+/* One card, empty keyword or include of a recorded file*/
+typedef struct {
+  char *keyword_name; /* Name of the keyword. Consecutive cards of the same
+                         keyword share the string. NULL for includes*/
+  char *card;         /* The string of the card. NULL if the keyword has no
+                         cards*/
+  size_t card_index;  /* The card_index given to the callback. For includes
+                         this is the index into key_incremental_t::files*/
+  size_t line_number; /* The line of the card in the file*/
+} key_incremental_event_t;
+
+/* Everything that the parsing of one file produced, excluding the contents of
+ * its include files which are recorded separately*/
+typedef struct {
+  char *file_name;            /* The path with which the file has been opened*/
+  uint64_t file_size;         /* The size of the file when it was parsed*/
+  uint64_t modification_time; /* The modification time of the file when it was
+                                 parsed (see path_get_modification_time)*/
+  int reparse; /* Wether the file needs to be parsed again regardless of its
+                  modification time, because errors or warnings occurred*/
+  char **include_paths; /* The include paths at the start of the file*/
+  size_t num_include_paths;
+  key_incremental_event_t *events;
+  size_t num_events;
+  size_t events_capacity;
+} key_incremental_file_t;
+
+/* Holds the recorded results of a key file and all of its include files, so
+ * that parsing the same file again only needs to read the files that have
+ * been modified (by size or modification time) since the last call. The files
+ * that did not change are replayed from memory. If a different parse_config is
+ * used than in the previous call everything is parsed again*/
+typedef struct {
+  key_incremental_file_t *files; /* All recorded files. The first one is the
+                                    root file*/
+  size_t num_files;
+  char *root_folder; /* The folder which contains the root file*/
+  key_parse_config_t parse_config; /* A copy of the parse config with which
+                                      the files have been recorded*/
+
+  size_t num_parsed_files; /* The number of files that have been read from
+                              disk by the last parse call*/
+  size_t num_reused_files; /* The number of files that have been replayed from
+                              memory by the last parse call*/
+} key_incremental_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns an empty key_incremental_t. Needs to be deallocated by
+ * key_incremental_free*/
+key_incremental_t key_incremental_new();
+/* Same as key_file_parse_with_callback, but records the cards of every file
+ * into incremental and reuses them on the next call with the same file_name if
+ * the file has not been modified. If file_name differs from the previous call
+ * everything is parsed again*/
+void key_incremental_parse_with_callback(key_incremental_t *incremental,
+                                         const char *file_name,
+                                         key_file_callback callback,
+                                         const key_parse_config_t *parse_config,
+                                         char **error_string,
+                                         char **warning_string,
+                                         void *user_data);
+/* Same as key_file_parse, but uses key_incremental_parse_with_callback. The
+ * returned array needs to be deallocated by key_file_free*/
+keyword_t *key_incremental_parse(key_incremental_t *incremental,
+                                 const char *file_name, size_t *num_keywords,
+                                 const key_parse_config_t *parse_config,
+                                 char **error_string, char **warning_string);
+void key_incremental_free(key_incremental_t *incremental);
+
+/* ----- Private Functions ----- */
+
+/* Holds the state of one call to key_incremental_parse_with_callback*/
+typedef struct {
+  key_incremental_t *incremental;
+  key_file_callback callback;
+  void *user_data;
+  const key_parse_config_t *parse_config;
+  size_t *file_stack; /* Indices of the files which are currently parsed*/
+  size_t file_stack_size;
+  size_t *parsed_files; /* Indices of all files which have been parsed*/
+  size_t num_parsed_files;
+  string_builder_t error_stack;
+  string_builder_t warning_stack;
+} key_incremental_parse_data;
+
+/* Records the card into the current file and calls the callback of the user*/
+void _key_incremental_callback(key_parse_info_t info, const char *keyword_name,
+                               card_t *card, size_t card_index,
+                               void *user_data);
+/* Replays include files that did not change and starts recording the others*/
+int _key_incremental_include_callback(key_parse_info_t info,
+                                      const char *include_file_name, int end,
+                                      void *user_data);
+/* Reads the file with the given index from disk. rec holds the include paths*/
+void _key_incremental_parse_file(key_incremental_parse_data *data,
+                                 size_t file_index, key_parse_recursion_t *rec);
+/* Calls the callback for all recorded cards of the file and its includes.
+ * Files that changed are parsed again*/
+void _key_incremental_replay_file(key_incremental_parse_data *data,
+                                  size_t file_index);
+/* Returns wether the file has been modified since it has been recorded*/
+int _key_incremental_file_changed(const key_incremental_file_t *file);
+/* Returns the index of the file with file_name or ~0 if it has not been
+ * recorded*/
+size_t _key_incremental_find_file(const key_incremental_t *incremental,
+                                  const char *file_name);
+/* Returns a deep copy of parse_config. Needs to be deallocated by
+ * _key_incremental_free_config*/
+key_parse_config_t
+_key_incremental_copy_config(const key_parse_config_t *parse_config);
+void _key_incremental_free_config(key_parse_config_t *parse_config);
+/* Returns wether both parse configs parse a file in the same way*/
+int _key_incremental_config_equal(const key_parse_config_t *lhs,
+                                  const key_parse_config_t *rhs);
+/* Returns a deep copy of the string array or NULL if it is empty*/
+char **_key_incremental_copy_strings(char *const *strings, size_t num_strings);
+/* Returns wether both string arrays hold the same strings in the same order*/
+int _key_incremental_strings_equal(char *const *lhs, size_t num_lhs,
+                                   char *const *rhs, size_t num_rhs);
+/* Adds an empty file record and returns its index*/
+size_t _key_incremental_add_file(key_incremental_t *incremental,
+                                 const char *file_name,
+                                 char *const *include_paths,
+                                 size_t num_include_paths);
+void _key_incremental_free_events(key_incremental_file_t *file);
+void _key_incremental_free_file(key_incremental_file_t *file);
+/* Removes all files which are no longer included by the root file*/
+void _key_incremental_remove_unused_files(key_incremental_t *incremental);
+/* Marks the file and all of its includes as used*/
+void _key_incremental_mark_used(const key_incremental_t *incremental,
+                                size_t file_index, size_t *new_indices);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
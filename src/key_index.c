@@ -0,0 +1,305 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "key_index.h"
+#include "profiling.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET_BASIS ((size_t)14695981039346656037ULL)
+#define FNV_PRIME ((size_t)1099511628211ULL)
+
+key_index_t key_index_new(keyword_t *keywords, size_t num_keywords) {
+  BEGIN_PROFILE_FUNC();
+
+  key_index_t index;
+  memset(&index, 0, sizeof(index));
+  index.keywords = keywords;
+  index.num_keywords = num_keywords;
+
+  if (num_keywords == 0) {
+    END_PROFILE_FUNC();
+    return index;
+  }
+
+  /* Collect the unique names. Since the keywords are sorted all keywords with
+   * the same name are next to each other. Also count the '_' characters to
+   * know how many prefixes there can be at most*/
+  index.names = malloc(num_keywords * sizeof(key_index_entry_t));
+  size_t max_prefixes = 0;
+
+  size_t i = 0;
+  while (i < num_keywords) {
+    if (index.num_names == 0 ||
+        strcmp(index.names[index.num_names - 1].name, keywords[i].name) != 0) {
+      key_index_entry_t *entry = &index.names[index.num_names];
+      entry->name = keywords[i].name;
+      entry->name_length = strlen(entry->name);
+      entry->hash = _key_index_hash(entry->name, entry->name_length);
+      entry->start = i;
+      entry->size = 1;
+      index.num_names++;
+
+      size_t j = 0;
+      while (j < entry->name_length) {
+        max_prefixes += entry->name[j] == '_';
+        j++;
+      }
+    } else {
+      index.names[index.num_names - 1].size++;
+    }
+
+    i++;
+  }
+
+  index.names =
+      realloc(index.names, index.num_names * sizeof(key_index_entry_t));
+
+  /* Collect all prefixes ending in '_'. A prefix is new if the previous name
+   * does not start with it, after which all following names which share the
+   * prefix belong to it*/
+  if (max_prefixes != 0) {
+    index.prefixes = malloc(max_prefixes * sizeof(key_index_entry_t));
+
+    i = 0;
+    while (i < index.num_names) {
+      const key_index_entry_t *name = &index.names[i];
+
+      size_t j = 0;
+      while (j < name->name_length) {
+        if (name->name[j] != '_') {
+          j++;
+          continue;
+        }
+
+        const size_t prefix_length = j + 1;
+        if (i != 0 && strncmp(index.names[i - 1].name, name->name,
+                              prefix_length) == 0) {
+          j++;
+          continue;
+        }
+
+        key_index_entry_t *prefix = &index.prefixes[index.num_prefixes];
+        prefix->name = name->name;
+        prefix->name_length = prefix_length;
+        prefix->hash = _key_index_hash(name->name, prefix_length);
+        prefix->start = name->start;
+        prefix->size = name->size;
+
+        size_t k = i + 1;
+        while (k < index.num_names &&
+               strncmp(index.names[k].name, name->name, prefix_length) == 0) {
+          prefix->size += index.names[k].size;
+          k++;
+        }
+
+        index.num_prefixes++;
+        j++;
+      }
+
+      i++;
+    }
+
+    index.prefixes = realloc(index.prefixes,
+                             index.num_prefixes * sizeof(key_index_entry_t));
+  }
+
+  /* Keep the load factor of the tables at or below 0.5*/
+  const size_t max_entries = index.num_names > index.num_prefixes
+                                 ? index.num_names
+                                 : index.num_prefixes;
+  index.num_buckets = 8;
+  while (index.num_buckets < max_entries * 2) {
+    index.num_buckets *= 2;
+  }
+
+  index.name_buckets = calloc(index.num_buckets, sizeof(size_t));
+  i = 0;
+  while (i < index.num_names) {
+    _key_index_insert(index.name_buckets, index.num_buckets, index.names, i);
+    i++;
+  }
+
+  index.prefix_buckets = calloc(index.num_buckets, sizeof(size_t));
+  i = 0;
+  while (i < index.num_prefixes) {
+    _key_index_insert(index.prefix_buckets, index.num_buckets, index.prefixes,
+                      i);
+    i++;
+  }
+
+  END_PROFILE_FUNC();
+  return index;
+}
+
+keyword_t *key_index_get(const key_index_t *index, const char *name,
+                         size_t keyword_index) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t slice_size;
+  keyword_t *slice = key_index_get_slice(index, name, &slice_size);
+  if (!slice || keyword_index >= slice_size) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  END_PROFILE_FUNC();
+  return &slice[keyword_index];
+}
+
+keyword_t *key_index_get_slice(const key_index_t *index, const char *name,
+                               size_t *slice_size) {
+  BEGIN_PROFILE_FUNC();
+
+  const key_index_entry_t *entry =
+      _key_index_find(index->name_buckets, index->num_buckets, index->names,
+                      name, strlen(name));
+  if (!entry) {
+    *slice_size = 0;
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  *slice_size = entry->size;
+  END_PROFILE_FUNC();
+  return &index->keywords[entry->start];
+}
+
+keyword_t *key_index_get_prefix(const key_index_t *index, const char *prefix,
+                                size_t *slice_size) {
+  BEGIN_PROFILE_FUNC();
+
+  *slice_size = 0;
+
+  const size_t prefix_length = strlen(prefix);
+  if (prefix_length == 0) {
+    *slice_size = index->num_keywords;
+    END_PROFILE_FUNC();
+    return index->num_keywords != 0 ? index->keywords : NULL;
+  }
+
+  /* Every prefix ending in '_' is part of the table*/
+  if (prefix[prefix_length - 1] == '_') {
+    const key_index_entry_t *entry =
+        _key_index_find(index->prefix_buckets, index->num_buckets,
+                        index->prefixes, prefix, prefix_length);
+    if (!entry) {
+      END_PROFILE_FUNC();
+      return NULL;
+    }
+
+    *slice_size = entry->size;
+    END_PROFILE_FUNC();
+    return &index->keywords[entry->start];
+  }
+
+  /* Binary search for the first and one past the last name with the prefix*/
+  size_t low = 0, high = index->num_names;
+  while (low < high) {
+    const size_t half = low + (high - low) / 2;
+    if (strncmp(index->names[half].name, prefix, prefix_length) < 0) {
+      low = half + 1;
+    } else {
+      high = half;
+    }
+  }
+  const size_t first = low;
+
+  high = index->num_names;
+  while (low < high) {
+    const size_t half = low + (high - low) / 2;
+    if (strncmp(index->names[half].name, prefix, prefix_length) <= 0) {
+      low = half + 1;
+    } else {
+      high = half;
+    }
+  }
+
+  if (first == low) {
+    END_PROFILE_FUNC();
+    return NULL;
+  }
+
+  const key_index_entry_t *last = &index->names[low - 1];
+  *slice_size = last->start + last->size - index->names[first].start;
+  END_PROFILE_FUNC();
+  return &index->keywords[index->names[first].start];
+}
+
+void key_index_free(key_index_t *index) {
+  BEGIN_PROFILE_FUNC();
+
+  free(index->names);
+  free(index->prefixes);
+  free(index->name_buckets);
+  free(index->prefix_buckets);
+  memset(index, 0, sizeof(key_index_t));
+
+  END_PROFILE_FUNC();
+}
+
+size_t _key_index_hash(const char *string, size_t length) {
+  size_t hash = FNV_OFFSET_BASIS;
+  size_t i = 0;
+  while (i < length) {
+    hash ^= (unsigned char)string[i];
+    hash *= FNV_PRIME;
+    i++;
+  }
+  return hash;
+}
+
+void _key_index_insert(size_t *buckets, size_t num_buckets,
+                       const key_index_entry_t *entries, size_t entry_index) {
+  const size_t mask = num_buckets - 1;
+  size_t i = entries[entry_index].hash & mask;
+  while (buckets[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  buckets[i] = entry_index + 1;
+}
+
+const key_index_entry_t *_key_index_find(const size_t *buckets,
+                                         size_t num_buckets,
+                                         const key_index_entry_t *entries,
+                                         const char *string, size_t length) {
+  if (num_buckets == 0) {
+    return NULL;
+  }
+
+  const size_t hash = _key_index_hash(string, length);
+  const size_t mask = num_buckets - 1;
+  size_t i = hash & mask;
+  while (buckets[i] != 0) {
+    const key_index_entry_t *entry = &entries[buckets[i] - 1];
+    if (entry->hash == hash && entry->name_length == length &&
+        memcmp(entry->name, string, length) == 0) {
+      return entry;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return NULL;
+}
@@ -0,0 +1,101 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef KEY_INDEX_H
+#define KEY_INDEX_H
+
+#include "key.h"
+
+/* A contiguous range of keywords which share the same name or name prefix*/
+typedef struct {
+  const char *name;   /* Points into the name of the first keyword of the
+                         range. Not null terminated for prefixes*/
+  size_t name_length; /* The length of the name or prefix*/
+  size_t hash;        /* The hash of the name or prefix*/
+  size_t start;       /* Index of the first keyword of the range*/
+  size_t size;        /* The number of keywords in the range*/
+} key_index_entry_t;
+
+/* A hash table of all names, and all name prefixes which end in '_' (e.g.
+ * "MAT_"), of a sorted keyword array as returned by key_file_parse. Allows
+ * looking up the slice of a name in constant time. The keywords need to outlive
+ * the index*/
+typedef struct {
+  keyword_t *keywords;
+  size_t num_keywords;
+
+  key_index_entry_t *names; /* One entry per unique name in sorted order*/
+  size_t num_names;
+  key_index_entry_t *prefixes; /* One entry per unique prefix*/
+  size_t num_prefixes;
+
+  /* Open addressing tables containing the index + 1 into names and prefixes.
+   * 0 means an empty bucket. Both have num_buckets elements which is a power
+   * of two*/
+  size_t *name_buckets;
+  size_t *prefix_buckets;
+  size_t num_buckets;
+} key_index_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Builds the index for keywords. keywords needs to be sorted by name like the
+ * array returned by key_file_parse. Needs to be deallocated by
+ * key_index_free*/
+key_index_t key_index_new(keyword_t *keywords, size_t num_keywords);
+/* Same as key_file_get, but uses the index*/
+keyword_t *key_index_get(const key_index_t *index, const char *name,
+                         size_t keyword_index);
+/* Same as key_file_get_slice, but uses the index*/
+keyword_t *key_index_get_slice(const key_index_t *index, const char *name,
+                               size_t *slice_size);
+/* Returns a pointer to the first keyword whose name starts with prefix and sets
+ * slice_size to the number of keywords with this prefix (e.g. "MAT_" returns
+ * all materials). Prefixes ending in '_' are looked up in constant time, all
+ * others with a binary search. Returns NULL if no keyword has been found*/
+keyword_t *key_index_get_prefix(const key_index_t *index, const char *prefix,
+                                size_t *slice_size);
+void key_index_free(key_index_t *index);
+
+/* ----- Private Functions ----- */
+
+/* FNV-1a hash of the first length characters of string*/
+size_t _key_index_hash(const char *string, size_t length);
+/* Inserts the entry with entry_index into buckets*/
+void _key_index_insert(size_t *buckets, size_t num_buckets,
+                       const key_index_entry_t *entries, size_t entry_index);
+/* Looks up string in buckets and returns the matching entry or NULL*/
+const key_index_entry_t *_key_index_find(const size_t *buckets,
+                                         size_t num_buckets,
+                                         const key_index_entry_t *entries,
+                                         const char *string, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
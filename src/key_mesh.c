@@ -0,0 +1,569 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#include "key_mesh.h"
+#include "profiling.h"
+#include "string_builder.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Returns the number of additional cards that follow the first card of every
+ * element or (size_t)~0 if the keyword has unsupported options*/
+typedef size_t (*_key_option_cards_func)(const char *keyword_name);
+
+void _key_mesh_error(char **error_string, const char *f, ...) {
+  if (!error_string) {
+    return;
+  }
+
+  va_list args;
+
+  char buffer[1024];
+
+  va_start(args, f);
+  vsprintf(buffer, f, args);
+  va_end(args);
+
+  *error_string = string_clone(buffer);
+}
+
+/* Returns wether all options of the keyword (everything after the first
+ * num_base_parts parts) are contained in options*/
+int _key_keyword_options_supported(const char *keyword_name,
+                                   size_t num_base_parts,
+                                   const char *const *options,
+                                   size_t num_options) {
+  BEGIN_PROFILE_FUNC();
+
+  size_t part_index = 0;
+  const char *part = keyword_name;
+  while (*part != '\0') {
+    size_t part_length = 0;
+    while (part[part_length] != '\0' && part[part_length] != '_') {
+      part_length++;
+    }
+
+    if (part_index >= num_base_parts) {
+      size_t i = 0;
+      while (i < num_options) {
+        if (strlen(options[i]) == part_length &&
+            strncmp(options[i], part, part_length) == 0) {
+          break;
+        }
+
+        i++;
+      }
+
+      if (i == num_options) {
+        END_PROFILE_FUNC();
+        return 0;
+      }
+    }
+
+    part += part_length;
+    if (*part == '_') {
+      part++;
+    }
+    part_index++;
+  }
+
+  END_PROFILE_FUNC();
+  return 1;
+}
+
+size_t _key_solid_option_cards(const char *keyword_name) {
+  static const char *const options[] = {"ORTHO", "DOF"};
+  if (!_key_keyword_options_supported(keyword_name, 2, options, 2)) {
+    return (size_t)~0;
+  }
+
+  return _key_keyword_has_option(keyword_name, "ORTHO") * 2 +
+         _key_keyword_has_option(keyword_name, "DOF");
+}
+
+size_t _key_shell_option_cards(const char *keyword_name) {
+  static const char *const options[] = {"THICKNESS", "BETA", "MCID", "OFFSET",
+                                        "DOF"};
+  if (!_key_keyword_options_supported(keyword_name, 2, options, 5)) {
+    return (size_t)~0;
+  }
+
+  /* THICKNESS, BETA, MCID and OFFSET share the same card*/
+  return (_key_keyword_has_option(keyword_name, "THICKNESS") ||
+          _key_keyword_has_option(keyword_name, "BETA") ||
+          _key_keyword_has_option(keyword_name, "MCID") ||
+          _key_keyword_has_option(keyword_name, "OFFSET")) +
+         _key_keyword_has_option(keyword_name, "DOF");
+}
+
+size_t _key_beam_option_cards(const char *keyword_name) {
+  static const char *const options[] = {
+      "THICKNESS", "SCALAR",      "SCALR",   "SECTION", "PID",
+      "OFFSET",    "ORIENTATION", "WARPAGE", "ELBOW"};
+  if (!_key_keyword_options_supported(keyword_name, 2, options, 9)) {
+    return (size_t)~0;
+  }
+
+  /* THICKNESS, SCALAR, SCALR and SECTION share the same card*/
+  return (_key_keyword_has_option(keyword_name, "THICKNESS") ||
+          _key_keyword_has_option(keyword_name, "SCALAR") ||
+          _key_keyword_has_option(keyword_name, "SCALR") ||
+          _key_keyword_has_option(keyword_name, "SECTION")) +
+         _key_keyword_has_option(keyword_name, "PID") +
+         _key_keyword_has_option(keyword_name, "OFFSET") +
+         _key_keyword_has_option(keyword_name, "ORIENTATION") +
+         _key_keyword_has_option(keyword_name, "WARPAGE") +
+         _key_keyword_has_option(keyword_name, "ELBOW");
+}
+
+key_elements_t _key_parse_elements(const keyword_t *keywords,
+                                   size_t num_keywords,
+                                   size_t nodes_per_element,
+                                   int separate_node_card,
+                                   _key_option_cards_func option_cards,
+                                   char **error_string) {
+  BEGIN_PROFILE_FUNC();
+
+  if (error_string) {
+    *error_string = NULL;
+  }
+
+  key_elements_t elements;
+  elements.num_elements = 0;
+  elements.nodes_per_element = nodes_per_element;
+
+  /* Every element needs at least one card. So allocate enough memory for the
+   * worst case once instead of growing the arrays*/
+  size_t max_elements = 0;
+  size_t k = 0;
+  while (k < num_keywords) {
+    max_elements += keywords[k].num_cards;
+    k++;
+  }
+
+  if (max_elements == 0) {
+    elements.ids = NULL;
+    elements.part_ids = NULL;
+    elements.connectivity = NULL;
+
+    END_PROFILE_FUNC();
+    return elements;
+  }
+
+  elements.ids = malloc(max_elements * sizeof(int64_t));
+  elements.part_ids = malloc(max_elements * sizeof(int64_t));
+  elements.connectivity =
+      malloc(max_elements * nodes_per_element * sizeof(int64_t));
+
+  /* EID, PID, N1, ..., N10*/
+  const char *values[12];
+  size_t value_lengths[12];
+  const size_t max_values = 2 + nodes_per_element;
+
+  k = 0;
+  while (k < num_keywords) {
+    const keyword_t *keyword = &keywords[k];
+
+    const size_t num_option_cards = option_cards(keyword->name);
+    if (num_option_cards == (size_t)~0) {
+      _key_mesh_error(error_string, "The keyword %s is not supported",
+                      keyword->name);
+      key_free_elements(&elements);
+
+      END_PROFILE_FUNC();
+      return elements;
+    }
+
+    size_t i = 0;
+    while (i < keyword->num_cards) {
+      const size_t card_index = i;
+      size_t num_values =
+          _key_card_split(&keyword->cards[i], ELEMENT_VALUE_WIDTH,
+                          ELEMENT_VALUE_WIDTH, max_values, values,
+                          value_lengths);
+      i++;
+
+      /* Ignore cards without an id*/
+      if (num_values == 0 || _key_value_is_blank(values[0], value_lengths[0])) {
+        continue;
+      }
+
+      int64_t *id = &elements.ids[elements.num_elements];
+      int64_t *part_id = &elements.part_ids[elements.num_elements];
+      int64_t *nodes =
+          &elements.connectivity[elements.num_elements * nodes_per_element];
+
+      int valid = _key_value_parse_int(values[0], value_lengths[0], id);
+      *part_id = 0;
+      if (valid && num_values > 1) {
+        valid = _key_value_parse_int(values[1], value_lengths[1], part_id);
+      }
+
+      /* Two card format: the first card only contains EID and PID*/
+      size_t first_node_value = 2;
+      if (valid && separate_node_card && num_values <= 2 && i < keyword->num_cards) {
+        num_values = _key_card_split(&keyword->cards[i], ELEMENT_VALUE_WIDTH,
+                                     ELEMENT_VALUE_WIDTH, nodes_per_element,
+                                     values, value_lengths);
+        first_node_value = 0;
+        i++;
+      }
+
+      size_t j = 0;
+      while (valid && j < nodes_per_element) {
+        if (first_node_value + j < num_values) {
+          valid = _key_value_parse_int(values[first_node_value + j],
+                                       value_lengths[first_node_value + j],
+                                       &nodes[j]);
+        } else {
+          nodes[j] = 0;
+        }
+
+        j++;
+      }
+
+      if (!valid) {
+        _key_mesh_error(error_string,
+                        "Failed to parse card %lu of %s: \"%.80s\"",
+                        (unsigned long)card_index, keyword->name,
+                        keyword->cards[card_index].string);
+        key_free_elements(&elements);
+
+        END_PROFILE_FUNC();
+        return elements;
+      }
+
+      elements.num_elements++;
+      i += num_option_cards;
+    }
+
+    k++;
+  }
+
+  if (elements.num_elements == 0) {
+    key_free_elements(&elements);
+    elements.nodes_per_element = nodes_per_element;
+  } else if (elements.num_elements != max_elements) {
+    elements.ids =
+        realloc(elements.ids, elements.num_elements * sizeof(int64_t));
+    elements.part_ids =
+        realloc(elements.part_ids, elements.num_elements * sizeof(int64_t));
+    elements.connectivity =
+        realloc(elements.connectivity, elements.num_elements *
+                                           nodes_per_element * sizeof(int64_t));
+  }
+
+  END_PROFILE_FUNC();
+  return elements;
+}
+
+key_nodes_t key_parse_nodes(const keyword_t *keywords, size_t num_keywords,
+                            char **error_string) {
+  BEGIN_PROFILE_FUNC();
+
+  if (error_string) {
+    *error_string = NULL;
+  }
+
+  key_nodes_t nodes;
+  nodes.num_nodes = 0;
+
+  /* Allocate the arrays once with the number of all cards*/
+  size_t max_nodes = 0;
+  size_t k = 0;
+  while (k < num_keywords) {
+    max_nodes += keywords[k].num_cards;
+    k++;
+  }
+
+  if (max_nodes == 0) {
+    nodes.ids = NULL;
+    nodes.xyz = NULL;
+
+    END_PROFILE_FUNC();
+    return nodes;
+  }
+
+  nodes.ids = malloc(max_nodes * sizeof(int64_t));
+  nodes.xyz = malloc(max_nodes * 3 * sizeof(double));
+
+  /* NID, X, Y, Z (TC and RC are ignored)*/
+  const char *values[4];
+  size_t value_lengths[4];
+
+  k = 0;
+  while (k < num_keywords) {
+    const keyword_t *keyword = &keywords[k];
+
+    size_t i = 0;
+    while (i < keyword->num_cards) {
+      const size_t num_values =
+          _key_card_split(&keyword->cards[i], NODE_VALUE_WIDTH,
+                          NODE_COORD_VALUE_WIDTH, 4, values, value_lengths);
+      /* Ignore cards without an id*/
+      if (num_values == 0 || _key_value_is_blank(values[0], value_lengths[0])) {
+        i++;
+        continue;
+      }
+
+      double *xyz = &nodes.xyz[nodes.num_nodes * 3];
+      xyz[0] = 0.0;
+      xyz[1] = 0.0;
+      xyz[2] = 0.0;
+
+      int valid = _key_value_parse_int(values[0], value_lengths[0],
+                                       &nodes.ids[nodes.num_nodes]);
+      size_t j = 1;
+      while (valid && j < num_values) {
+        valid =
+            _key_value_parse_float64(values[j], value_lengths[j], &xyz[j - 1]);
+        j++;
+      }
+
+      if (!valid) {
+        _key_mesh_error(error_string,
+                        "Failed to parse card %lu of %s: \"%.80s\"",
+                        (unsigned long)i, keyword->name,
+                        keyword->cards[i].string);
+        key_free_nodes(&nodes);
+
+        END_PROFILE_FUNC();
+        return nodes;
+      }
+
+      nodes.num_nodes++;
+      i++;
+    }
+
+    k++;
+  }
+
+  if (nodes.num_nodes == 0) {
+    key_free_nodes(&nodes);
+  } else if (nodes.num_nodes != max_nodes) {
+    nodes.ids = realloc(nodes.ids, nodes.num_nodes * sizeof(int64_t));
+    nodes.xyz = realloc(nodes.xyz, nodes.num_nodes * 3 * sizeof(double));
+  }
+
+  END_PROFILE_FUNC();
+  return nodes;
+}
+
+key_elements_t key_parse_element_solid(const keyword_t *keywords,
+                                       size_t num_keywords,
+                                       char **error_string) {
+  return _key_parse_elements(keywords, num_keywords, KEY_SOLID_NUM_NODES, 1,
+                             _key_solid_option_cards, error_string);
+}
+
+key_elements_t key_parse_element_shell(const keyword_t *keywords,
+                                       size_t num_keywords,
+                                       char **error_string) {
+  return _key_parse_elements(keywords, num_keywords, KEY_SHELL_NUM_NODES, 0,
+                             _key_shell_option_cards, error_string);
+}
+
+key_elements_t key_parse_element_beam(const keyword_t *keywords,
+                                      size_t num_keywords,
+                                      char **error_string) {
+  return _key_parse_elements(keywords, num_keywords, KEY_BEAM_NUM_NODES, 0,
+                             _key_beam_option_cards, error_string);
+}
+
+void key_free_nodes(key_nodes_t *nodes) {
+  BEGIN_PROFILE_FUNC();
+
+  free(nodes->ids);
+  free(nodes->xyz);
+  nodes->ids = NULL;
+  nodes->xyz = NULL;
+  nodes->num_nodes = 0;
+
+  END_PROFILE_FUNC();
+}
+
+void key_free_elements(key_elements_t *elements) {
+  BEGIN_PROFILE_FUNC();
+
+  free(elements->ids);
+  free(elements->part_ids);
+  free(elements->connectivity);
+  elements->ids = NULL;
+  elements->part_ids = NULL;
+  elements->connectivity = NULL;
+  elements->num_elements = 0;
+
+  END_PROFILE_FUNC();
+}
+
+size_t _key_card_split(const card_t *card, size_t first_value_width,
+                       size_t value_width, size_t max_values,
+                       const char **values, size_t *value_lengths) {
+  BEGIN_PROFILE_FUNC();
+
+  const char *string = card->string;
+  const size_t length = strlen(string);
+  size_t num_values = 0;
+
+  if (memchr(string, ',', length)) {
+    /* Free format*/
+    size_t start = 0;
+    while (num_values < max_values && start <= length) {
+      size_t end = start;
+      while (end < length && string[end] != ',') {
+        end++;
+      }
+
+      values[num_values] = &string[start];
+      value_lengths[num_values] = end - start;
+      num_values++;
+
+      start = end + 1;
+    }
+  } else {
+    /* Cards which are longer than any card in the standard format need to be
+     * in the long format. The first value of a card is always an id, so if
+     * it is blank it has to be wider than in the standard format*/
+    size_t i = 0;
+    while (i < first_value_width && i < length && string[i] == ' ') {
+      i++;
+    }
+
+    if (length > STANDARD_CARD_MAX_LENGTH || i == first_value_width) {
+      first_value_width = LONG_VALUE_WIDTH;
+      value_width = LONG_VALUE_WIDTH;
+    }
+
+    size_t start = 0;
+    size_t width = first_value_width;
+    while (num_values < max_values && start < length) {
+      values[num_values] = &string[start];
+      value_lengths[num_values] =
+          (length - start) < width ? (length - start) : width;
+      num_values++;
+
+      start += width;
+      width = value_width;
+    }
+  }
+
+  END_PROFILE_FUNC();
+  return num_values;
+}
+
+int _key_value_is_blank(const char *value, size_t value_length) {
+  size_t i = 0;
+  while (i < value_length && (value[i] == ' ' || value[i] == '\t')) {
+    i++;
+  }
+
+  return i == value_length;
+}
+
+int _key_value_parse_int(const char *value, size_t value_length,
+                         int64_t *result) {
+  size_t i = 0;
+  while (i < value_length && (value[i] == ' ' || value[i] == '\t')) {
+    i++;
+  }
+
+  if (i == value_length) {
+    *result = 0;
+    return 1;
+  }
+
+  int64_t sign = 1;
+  if (value[i] == '-') {
+    sign = -1;
+    i++;
+  } else if (value[i] == '+') {
+    i++;
+  }
+
+  if (i == value_length || value[i] < '0' || value[i] > '9') {
+    return 0;
+  }
+
+  int64_t integer = 0;
+  while (i < value_length && value[i] >= '0' && value[i] <= '9') {
+    integer = integer * 10 + (value[i] - '0');
+    i++;
+  }
+
+  /* Only trailing whitespace is allowed*/
+  while (i < value_length && (value[i] == ' ' || value[i] == '\t')) {
+    i++;
+  }
+  if (i != value_length) {
+    return 0;
+  }
+
+  *result = integer * sign;
+  return 1;
+}
+
+int _key_value_parse_float64(const char *value, size_t value_length,
+                             double *result) {
+  size_t i = 0;
+  while (i < value_length && (value[i] == ' ' || value[i] == '\t')) {
+    i++;
+  }
+
+  if (i == value_length) {
+    *result = 0.0;
+    return 1;
+  }
+
+  *result = _parse_float64_field(&value[i], value_length - i);
+  return errno == 0;
+}
+
+int _key_keyword_has_option(const char *keyword_name, const char *option) {
+  BEGIN_PROFILE_FUNC();
+
+  const size_t option_length = strlen(option);
+  const char *part = keyword_name;
+  while (1) {
+    part = strstr(part, option);
+    if (!part) {
+      break;
+    }
+
+    /* The option needs to be a complete part of the name*/
+    if ((part == keyword_name || part[-1] == '_') &&
+        (part[option_length] == '\0' || part[option_length] == '_')) {
+      END_PROFILE_FUNC();
+      return 1;
+    }
+
+    part++;
+  }
+
+  END_PROFILE_FUNC();
+  return 0;
+}
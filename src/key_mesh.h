@@ -0,0 +1,134 @@
+/***********************************************************************************
+ *                         This file is part of dynareadout
+ *                    https://github.com/PucklaJ/dynareadout
+ ***********************************************************************************
+ * Copyright (c) 2022 Jonas Pucher
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ ************************************************************************************/
+
+#ifndef KEY_MESH_H
+#define KEY_MESH_H
+
+#include "key.h"
+#include <stdint.h>
+
+/* The width of the coordinates of a NODE card in the standard format*/
+#define NODE_COORD_VALUE_WIDTH 16
+/* The width of all values of an ELEMENT card in the standard format*/
+#define ELEMENT_VALUE_WIDTH 8
+/* The width of all values of a card in the long format (e.g. "*NODE +")*/
+#define LONG_VALUE_WIDTH 20
+/* Cards longer than this are assumed to be in the long format*/
+#define STANDARD_CARD_MAX_LENGTH 80
+
+/* The number of nodes stored per element in key_elements_t::connectivity*/
+#define KEY_SOLID_NUM_NODES 8
+#define KEY_SHELL_NUM_NODES 4
+#define KEY_BEAM_NUM_NODES 3
+
+/* All nodes of one or more NODE keywords stored in contiguous arrays*/
+typedef struct {
+  int64_t *ids;     /* The ids of all nodes*/
+  double *xyz;      /* The coordinates of all nodes. Every node has three
+                       values (x, y, z) so that the size is 3 * num_nodes*/
+  size_t num_nodes; /* The number of nodes*/
+} key_nodes_t;
+
+/* All elements of one or more ELEMENT keywords stored in contiguous arrays*/
+typedef struct {
+  int64_t *ids;          /* The ids of all elements*/
+  int64_t *part_ids;     /* The ids of the parts of all elements*/
+  int64_t *connectivity; /* The node ids of all elements. Every element has
+                            nodes_per_element values so that the size is
+                            nodes_per_element * num_elements. Unused nodes are
+                            0*/
+  size_t num_elements;      /* The number of elements*/
+  size_t nodes_per_element; /* The number of node ids per element*/
+} key_elements_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Decodes all cards of the given NODE keywords (e.g. the slice returned by
+ * key_file_get_slice) in one pass. Cards can be in the standard, long or comma
+ * separated free format. Needs to be deallocated by key_free_nodes.
+ * error_string: if set to a non NULL value an error message will be set if an
+ * error occurred. In this case the returned value is empty. If it gets set to
+ * a non NULL value it needs to be deallocated by free.*/
+key_nodes_t key_parse_nodes(const keyword_t *keywords, size_t num_keywords,
+                            char **error_string);
+/* Same as key_parse_nodes but for ELEMENT_SOLID keywords. Both the one card
+ * and two card format are supported, as are the ORTHO and DOF options.
+ * connectivity stores KEY_SOLID_NUM_NODES per element. Needs to be deallocated
+ * by key_free_elements.*/
+key_elements_t key_parse_element_solid(const keyword_t *keywords,
+                                       size_t num_keywords,
+                                       char **error_string);
+/* Same as key_parse_nodes but for ELEMENT_SHELL keywords. Supports the
+ * THICKNESS, BETA, MCID, OFFSET and DOF options. connectivity stores
+ * KEY_SHELL_NUM_NODES per element. Needs to be deallocated by
+ * key_free_elements.*/
+key_elements_t key_parse_element_shell(const keyword_t *keywords,
+                                       size_t num_keywords,
+                                       char **error_string);
+/* Same as key_parse_nodes but for ELEMENT_BEAM keywords. Supports the
+ * THICKNESS, SCALAR, SCALR, SECTION, PID, OFFSET, ORIENTATION, WARPAGE and
+ * ELBOW options. connectivity stores KEY_BEAM_NUM_NODES (n1, n2, n3) per
+ * element. Needs to be deallocated by key_free_elements.*/
+key_elements_t key_parse_element_beam(const keyword_t *keywords,
+                                      size_t num_keywords,
+                                      char **error_string);
+/* Deallocates all memory of nodes*/
+void key_free_nodes(key_nodes_t *nodes);
+/* Deallocates all memory of elements*/
+void key_free_elements(key_elements_t *elements);
+
+/* ----- Private Functions -----*/
+/* Splits a card into its values. If the card contains a comma it is treated as
+ * free format, otherwise value_width is used for every value except the first
+ * one, which uses first_value_width. If the card is longer than
+ * STANDARD_CARD_MAX_LENGTH or the first value is blank, LONG_VALUE_WIDTH is
+ * used for all values instead. Stores the start and length of every value and
+ * returns the number of values (at most max_values).*/
+size_t _key_card_split(const card_t *card, size_t first_value_width,
+                       size_t value_width, size_t max_values,
+                       const char **values, size_t *value_lengths);
+/* Returns wether a value returned by _key_card_split consists only of
+ * whitespace*/
+int _key_value_is_blank(const char *value, size_t value_length);
+/* Parses a value returned by _key_card_split as an int. Empty values are 0.
+ * Returns 0 if the value is not an int*/
+int _key_value_parse_int(const char *value, size_t value_length,
+                         int64_t *result);
+/* Parses a value returned by _key_card_split as a double. Empty values are 0.
+ * Returns 0 if the value is not a number*/
+int _key_value_parse_float64(const char *value, size_t value_length,
+                             double *result);
+/* Returns wether the keyword name contains option as one of its underscore
+ * separated parts (e.g. "THICKNESS" in "ELEMENT_SHELL_THICKNESS")*/
+int _key_keyword_has_option(const char *keyword_name, const char *option);
+/* -----------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
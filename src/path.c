@@ -23,6 +23,11 @@
  * 3. This notice may not be removed or altered from any source distribution.
  ************************************************************************************/
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+/* Needed for the nanoseconds of the modification time (st_mtim)*/
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "path.h"
 #include "profiling.h"
 #include <assert.h>
@@ -367,4 +372,42 @@ uint64_t path_get_file_size(const char *path_name) {
   END_PROFILE_FUNC();
   return size;
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef _WIN32
+uint64_t path_get_modification_time(const char *path_name) {
+  BEGIN_PROFILE_FUNC();
+
+  ULONGLONG modification_time = 0;
+  WIN32_FILE_ATTRIBUTE_DATA file_info;
+  if (GetFileAttributesEx(path_name, GetFileExInfoStandard, &file_info)) {
+    modification_time =
+        ((ULONGLONG)file_info.ftLastWriteTime.dwHighDateTime << 32) |
+        file_info.ftLastWriteTime.dwLowDateTime;
+  }
+
+  END_PROFILE_FUNC();
+  return (uint64_t)modification_time;
+}
+#else
+uint64_t path_get_modification_time(const char *path_name) {
+  BEGIN_PROFILE_FUNC();
+
+  uint64_t modification_time = 0;
+  struct stat st;
+  if (stat(path_name, &st) == 0) {
+    /* Use nanoseconds, since files can be modified multiple times inside of
+     * one second without changing their size*/
+#ifdef __APPLE__
+    modification_time = (uint64_t)st.st_mtimespec.tv_sec * 1000000000 +
+                        (uint64_t)st.st_mtimespec.tv_nsec;
+#else
+    modification_time = (uint64_t)st.st_mtim.tv_sec * 1000000000 +
+                        (uint64_t)st.st_mtim.tv_nsec;
+#endif
+  }
+
+  END_PROFILE_FUNC();
+  return modification_time;
+}
+#endif
@@ -78,6 +78,12 @@ int path_is_abs(const char *path_name);
  * fails it returns 0.*/
 uint64_t path_get_file_size(const char *path_name);
 
+/* Returns the time of the last modification of the file given by path_name.
+ * The unit is platform dependent (nanoseconds on posix, 100 nanoseconds on
+ * windows), so only use it to compare two values. If the retrieval fails it
+ * returns 0.*/
+uint64_t path_get_modification_time(const char *path_name);
+
 #ifdef __cplusplus
 }
 #endif
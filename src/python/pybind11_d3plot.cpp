@@ -36,6 +36,8 @@ inline void add_d3plot_arrays_to_module(py::module_ &m) {
   dro::add_array_type_to_module<d3plot_beam_con>(m);
   dro::add_array_type_to_module<d3plot_shell_con>(m);
   dro::add_array_type_to_module<d3plot_solid>(m);
+  dro::add_array_type_to_module<d3plot_global>(m);
+  dro::add_array_type_to_module<d3plot_rigid_wall>(m);
   dro::add_array_type_to_module<d3plot_surface>(m);
   dro::add_array_type_to_module<d3plot_beam_ip>(m);
   dro::add_array_type_to_module<dro::D3plotShell>(m);
@@ -86,6 +88,24 @@ void add_d3plot_library_to_module(py::module_ &m) {
 
       ;
 
+  py::class_<d3plot_global>(m, "d3plot_global")
+      .def_readonly("kinetic_energy", &d3plot_global::kinetic_energy)
+      .def_readonly("internal_energy", &d3plot_global::internal_energy)
+      .def_readonly("total_energy", &d3plot_global::total_energy)
+      .def_readonly("velocity_x", &d3plot_global::velocity_x)
+      .def_readonly("velocity_y", &d3plot_global::velocity_y)
+      .def_readonly("velocity_z", &d3plot_global::velocity_z)
+
+      ;
+
+  py::class_<d3plot_rigid_wall>(m, "d3plot_rigid_wall")
+      .def_readonly("force", &d3plot_rigid_wall::force)
+      .def_readonly("position_x", &d3plot_rigid_wall::position_x)
+      .def_readonly("position_y", &d3plot_rigid_wall::position_y)
+      .def_readonly("position_z", &d3plot_rigid_wall::position_z)
+
+      ;
+
   py::class_<d3plot_tensor>(m, "d3plot_tensor")
       .def_readonly("x", &d3plot_tensor::x)
       .def_readonly("y", &d3plot_tensor::y)
@@ -229,6 +249,172 @@ void add_d3plot_library_to_module(py::module_ &m) {
       .def("__str__", &dro::stream_to_string<dro::D3plotShell>,
            py::return_value_policy::take_ownership);
 
+  py::enum_<dro::IdType>(m, "IdType")
+      .value("Node", dro::IdType::Node)
+      .value("Solid", dro::IdType::Solid)
+      .value("Beam", dro::IdType::Beam)
+      .value("Shell", dro::IdType::Shell)
+      .value("ThickShell", dro::IdType::ThickShell)
+      .value("Part", dro::IdType::Part)
+
+      ;
+
+  py::enum_<dro::MaterialQuantity>(m, "MaterialQuantity")
+      .value("InternalEnergy", dro::MaterialQuantity::InternalEnergy)
+      .value("KineticEnergy", dro::MaterialQuantity::KineticEnergy)
+      .value("VelocityX", dro::MaterialQuantity::VelocityX)
+      .value("VelocityY", dro::MaterialQuantity::VelocityY)
+      .value("VelocityZ", dro::MaterialQuantity::VelocityZ)
+      .value("Mass", dro::MaterialQuantity::Mass)
+      .value("HourglassEnergy", dro::MaterialQuantity::HourglassEnergy)
+
+      ;
+
+  py::enum_<dro::PartSearch>(m, "PartSearch")
+      .value("Exact", dro::PartSearch::Exact)
+      .value("Prefix", dro::PartSearch::Prefix)
+      .value("Wildcard", dro::PartSearch::Wildcard)
+      .value("Regex", dro::PartSearch::Regex)
+
+      ;
+
+  py::enum_<dro::ElementQuantity>(m, "ElementQuantity")
+      .value("VonMises", dro::ElementQuantity::VonMises)
+      .value("Pressure", dro::ElementQuantity::Pressure)
+      .value("MaxPrincipal", dro::ElementQuantity::MaxPrincipal)
+      .value("MidPrincipal", dro::ElementQuantity::MidPrincipal)
+      .value("MinPrincipal", dro::ElementQuantity::MinPrincipal)
+      .value("MaxShear", dro::ElementQuantity::MaxShear)
+      .value("Triaxiality", dro::ElementQuantity::Triaxiality)
+      .value("PlasticStrain", dro::ElementQuantity::PlasticStrain)
+
+      ;
+
+  py::enum_<dro::ReduceOp>(m, "ReduceOp")
+      .value("Max", dro::ReduceOp::Max)
+      .value("Min", dro::ReduceOp::Min)
+      .value("AbsMax", dro::ReduceOp::AbsMax)
+      .value("Last", dro::ReduceOp::Last)
+
+      ;
+
+  py::enum_<dro::NodeQuantity>(m, "NodeQuantity")
+      .value("Coordinates", dro::NodeQuantity::Coordinates)
+      .value("Velocity", dro::NodeQuantity::Velocity)
+      .value("Acceleration", dro::NodeQuantity::Acceleration)
+      .value("Displacement", dro::NodeQuantity::Displacement)
+      .value("Temperature", dro::NodeQuantity::Temperature)
+
+      ;
+
+  py::enum_<dro::DerivedQuantity>(m, "DerivedQuantity")
+      .value("VonMises", dro::DerivedQuantity::VonMises)
+      .value("Pressure", dro::DerivedQuantity::Pressure)
+      .value("MaxPrincipal", dro::DerivedQuantity::MaxPrincipal)
+      .value("MidPrincipal", dro::DerivedQuantity::MidPrincipal)
+      .value("MinPrincipal", dro::DerivedQuantity::MinPrincipal)
+      .value("MaxShear", dro::DerivedQuantity::MaxShear)
+      .value("Triaxiality", dro::DerivedQuantity::Triaxiality)
+
+      ;
+
+  py::enum_<dro::ShellSurface>(m, "ShellSurface")
+      .value("Mid", dro::ShellSurface::Mid)
+      .value("Inner", dro::ShellSurface::Inner)
+      .value("Outer", dro::ShellSurface::Outer)
+      .value("Mean", dro::ShellSurface::Mean)
+      .value("AbsMax", dro::ShellSurface::AbsMax)
+
+      ;
+
+  py::class_<dro::D3plotSurfaces>(m, "D3plotSurfaces")
+      .def("__len__", &dro::D3plotSurfaces::size)
+      .def("get_stress", &dro::D3plotSurfaces::get_stress,
+           "Returns one component of the stresses. 0: x, 1: y, 2: z, 3: xy, "
+           "4: yz and 5: zx.",
+           py::arg("component"), py::keep_alive<0, 1>())
+      .def("get_effective_plastic_strain",
+           &dro::D3plotSurfaces::get_effective_plastic_strain,
+           py::keep_alive<0, 1>())
+      .def("get_history_variables",
+           &dro::D3plotSurfaces::get_history_variables,
+           "Returns the history variable with history_index of all surfaces.",
+           py::arg("history_index"), py::keep_alive<0, 1>())
+
+      ;
+
+  py::class_<dro::D3plotBeams>(m, "D3plotBeams")
+      .def("__len__", &dro::D3plotBeams::size)
+      .def("get_resultant", &dro::D3plotBeams::get_resultant,
+           "Returns one resultant. 0: axial force, 1: s shear resultant, 2: t "
+           "shear resultant, 3: s bending moment, 4: t bending moment and 5: "
+           "torsional resultant.",
+           py::arg("component"), py::keep_alive<0, 1>())
+      .def("get_ip_value", &dro::D3plotBeams::get_ip_value,
+           "Returns one value of an integration point. 0: rs shear stress, 1: "
+           "tr shear stress, 2: axial stress, 3: plastic strain and 4: axial "
+           "strain.",
+           py::arg("integration_point"), py::arg("value"),
+           py::keep_alive<0, 1>())
+      .def("get_ip_history_variables",
+           &dro::D3plotBeams::get_ip_history_variables,
+           "Returns the history variable with history_index of an integration "
+           "point.",
+           py::arg("integration_point"), py::arg("history_index"),
+           py::keep_alive<0, 1>())
+      .def("get_history_average", &dro::D3plotBeams::get_history_average,
+           py::arg("history_index"), py::keep_alive<0, 1>())
+      .def("get_history_min", &dro::D3plotBeams::get_history_min,
+           py::arg("history_index"), py::keep_alive<0, 1>())
+      .def("get_history_max", &dro::D3plotBeams::get_history_max,
+           py::arg("history_index"), py::keep_alive<0, 1>())
+
+      ;
+
+  m.def("get_shells_layer", &dro::get_shells_layer,
+        "Returns one layer (or an aggregate of all integration points) of all "
+        "shells at once.",
+        py::arg("shells"), py::arg("layer"));
+  m.def("get_thick_shells_layer", &dro::get_thick_shells_layer,
+        "Returns one layer (or an aggregate of all integration points) of all "
+        "thick shells at once.",
+        py::arg("thick_shells"), py::arg("layer"));
+  m.def("compute_derived",
+        py::overload_cast<const dro::D3plotSurfaces &, dro::DerivedQuantity>(
+            &dro::compute_derived),
+        "Computes a derived quantity of the stresses of surfaces.",
+        py::arg("surfaces"), py::arg("quantity"),
+        py::return_value_policy::take_ownership);
+  m.def("compute_derived",
+        py::overload_cast<const d3plot_tensor &, dro::DerivedQuantity>(
+            &dro::compute_derived),
+        "Computes a derived quantity of a single tensor.", py::arg("tensor"),
+        py::arg("quantity"));
+  m.def("compute_derived",
+        py::overload_cast<const dro::Array<d3plot_solid> &,
+                          dro::DerivedQuantity>(&dro::compute_derived),
+        "Computes a derived quantity of the stresses of solids.",
+        py::arg("solids"), py::arg("quantity"),
+        py::return_value_policy::take_ownership);
+  m.def("compute_derived",
+        py::overload_cast<const dro::Array<dro::D3plotThickShell> &,
+                          dro::DerivedQuantity, dro::ShellSurface>(
+            &dro::compute_derived),
+        "Computes a derived quantity of the stresses of one surface of thick "
+        "shells.",
+        py::arg("thick_shells"), py::arg("quantity"),
+        py::arg("surface") = dro::ShellSurface::Mid,
+        py::return_value_policy::take_ownership);
+  m.def("compute_derived",
+        py::overload_cast<const dro::Array<dro::D3plotShell> &,
+                          dro::DerivedQuantity, dro::ShellSurface>(
+            &dro::compute_derived),
+        "Computes a derived quantity of the stresses of one surface of "
+        "shells.",
+        py::arg("shells"), py::arg("quantity"),
+        py::arg("surface") = dro::ShellSurface::Mid,
+        py::return_value_policy::take_ownership);
+
   py::class_<dro::D3plot>(m, "D3plot")
       .def(py::init<const std::string &>(),
            "Open a d3plot file family by giving the root file name\nExample: "
@@ -253,6 +439,10 @@ void add_d3plot_library_to_module(py::module_ &m) {
       .def("read_all_element_ids", &dro::D3plot::read_all_element_ids,
            "Read all ids of the solid, beam, shell and thick shell elements.",
            py::return_value_policy::take_ownership)
+      .def("read_all_element_ids2", &dro::D3plot::read_all_element_ids2,
+           "The same as read_all_element_ids, but also returns the type (one "
+           "of IdType) of every element and its index inside of the arrays of "
+           "its type. Returns a tuple of (ids, types, indices).")
       .def("read_part_ids", &dro::D3plot::read_part_ids,
            "Read all ids of the parts.",
            py::return_value_policy::take_ownership)
@@ -286,18 +476,106 @@ void add_d3plot_library_to_module(py::module_ &m) {
            "Read all node accelerations of all time steps and returns the as "
            "one big array.",
            py::return_value_policy::take_ownership)
+      .def("read_node_displacement",
+           py::overload_cast<size_t>(&dro::D3plot::read_node_displacement),
+           "Reads the displacements of all nodes of a given state. They are "
+           "the node coordinates minus the initial node coordinates of the "
+           "geometry.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_node_displacement",
+           py::overload_cast<size_t, size_t, const dro::Array<size_t> &>(
+               &dro::D3plot::read_node_displacement),
+           "Reads the displacements of the nodes of node_indices for "
+           "num_states states starting at first_state.",
+           py::arg("first_state"), py::arg("num_states"),
+           py::arg("node_indices"), py::return_value_policy::take_ownership)
+      .def("read_all_node_displacement",
+           &dro::D3plot::read_all_node_displacement,
+           "Reads the displacements of all nodes of all time steps.",
+           py::return_value_policy::take_ownership)
+      .def("read_node_relative_displacement",
+           &dro::D3plot::read_node_relative_displacement,
+           "Reads the displacements of the nodes of node_indices relative to "
+           "the mean displacement of the nodes of reference_indices.",
+           py::arg("state"), py::arg("node_indices"),
+           py::arg("reference_indices"),
+           py::return_value_policy::take_ownership)
+      .def("read_node_temperature",
+           py::overload_cast<size_t>(&dro::D3plot::read_node_temperature),
+           "Reads the temperatures (IT != 0) of all nodes of a given state.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_node_temperature",
+           py::overload_cast<size_t, size_t>(
+               &dro::D3plot::read_node_temperature),
+           "Reads the temperatures of all nodes for num_states states "
+           "starting at first_state.",
+           py::arg("first_state"), py::arg("num_states"),
+           py::return_value_policy::take_ownership)
+      .def("read_node_temperature",
+           py::overload_cast<size_t, size_t, const dro::Array<size_t> &>(
+               &dro::D3plot::read_node_temperature),
+           "Reads the temperatures of the nodes of node_indices for "
+           "num_states states starting at first_state.",
+           py::arg("first_state"), py::arg("num_states"),
+           py::arg("node_indices"), py::return_value_policy::take_ownership)
+      .def("read_node_flux", &dro::D3plot::read_node_flux,
+           "Reads the node fluxes (IT == 2 or IT == 3) of all nodes of a "
+           "given state.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_node_mass_scaling", &dro::D3plot::read_node_mass_scaling,
+           "Reads the mass scaling of all nodes of a given state.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_solids_thermal_state",
+           &dro::D3plot::read_solids_thermal_state,
+           "Reads the NT3D thermal variables of all solids of a given state.",
+           py::arg("state"), py::return_value_policy::take_ownership)
       .def("read_time", &dro::D3plot::read_time,
            "Read the time of a given state (time step) in milliseconds.",
            py::arg("state"), py::return_value_policy::take_ownership)
       .def("read_all_time", &dro::D3plot::read_all_time,
            "Reads all time of every state (time step) in milliseconds.",
            py::return_value_policy::take_ownership)
+      .def("read_global", &dro::D3plot::read_global,
+           "Reads the global kinetic, internal and total energy and the "
+           "average velocity of a state.",
+           py::arg("state"))
+      .def("read_all_global", &dro::D3plot::read_all_global,
+           "Reads the global data of every state.",
+           py::return_value_policy::take_ownership)
+      .def("read_material_data", &dro::D3plot::read_material_data,
+           "Reads a per material quantity of a state. The materials are "
+           "ordered as in the file: solid, beam, shell and thick shell "
+           "materials followed by the rigid bodies.",
+           py::arg("state"), py::arg("quantity"),
+           py::return_value_policy::take_ownership)
+      .def("read_all_material_data", &dro::D3plot::read_all_material_data,
+           "The same as read_material_data for every state.",
+           py::arg("quantity"), py::return_value_policy::take_ownership)
+      .def("read_rigid_walls", &dro::D3plot::read_rigid_walls,
+           "Reads the forces and positions of all rigid walls of a state. "
+           "The positions are 0 if the file only contains the forces.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_all_rigid_walls", &dro::D3plot::read_all_rigid_walls,
+           "The same as read_rigid_walls for every state.",
+           py::return_value_policy::take_ownership)
       .def("read_solids_state", &dro::D3plot::read_solids_state,
            "Returns stress, strain (if NEIPH >= 6) for a given state.",
            py::arg("state"), py::return_value_policy::take_ownership)
       .def("read_thick_shells_state", &dro::D3plot::read_thick_shells_state,
            "Returns stress, strain (if ISTRN == 1) for a given state.",
            py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_beams_state_arrays",
+           py::overload_cast<size_t, bool>(
+               &dro::D3plot::read_beams_state_arrays),
+           "Reads all beams of a state into one array per value. If "
+           "with_integration_points is False only the resultants and the "
+           "average, minimum and maximum of the history variables are kept.",
+           py::arg("state"), py::arg("with_integration_points") = true)
+      .def("read_beams_state_arrays",
+           py::overload_cast<size_t, dro::D3plotBeams &>(
+               &dro::D3plot::read_beams_state_arrays),
+           "The same as above, but the beams of a previous call are reused.",
+           py::arg("state"), py::arg("beams"))
       .def("read_beams_state", &dro::D3plot::read_beams_state,
            "Returns Axial Force, S shear resultant, T shear resultant, S "
            "bending moment, T bending moment and Torsional resultant of all "
@@ -307,11 +585,83 @@ void add_d3plot_library_to_module(py::module_ &m) {
            "Returns stress, strain (if ISTRN == 1) and some other variables "
            "(see docs pg. 36) of all shells for a given state.",
            py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_part_solids_state", &dro::D3plot::read_part_solids_state,
+           "The same as read_solids_state but only the solids of part are "
+           "read.",
+           py::arg("state"), py::arg("part"),
+           py::return_value_policy::take_ownership)
+      .def("read_part_thick_shells_state",
+           &dro::D3plot::read_part_thick_shells_state,
+           "The same as read_thick_shells_state but only the thick shells of "
+           "part are read.",
+           py::arg("state"), py::arg("part"),
+           py::return_value_policy::take_ownership)
+      .def("read_part_beams_state", &dro::D3plot::read_part_beams_state,
+           "The same as read_beams_state but only the beams of part are read.",
+           py::arg("state"), py::arg("part"),
+           py::return_value_policy::take_ownership)
+      .def("read_part_shells_state", &dro::D3plot::read_part_shells_state,
+           "The same as read_shells_state but only the shells of part are "
+           "read.",
+           py::arg("state"), py::arg("part"),
+           py::return_value_policy::take_ownership)
+      .def("read_part_node_coordinates",
+           &dro::D3plot::read_part_node_coordinates,
+           "Read the node coordinates of all nodes of part. The nodes are in "
+           "the same order as part_node_indices. If it is None they are "
+           "computed using D3plotPart.get_node_indices.",
+           py::arg("state"), py::arg("part"),
+           py::arg("part_node_indices") =
+               static_cast<dro::Array<d3_word> *>(nullptr),
+           py::return_value_policy::take_ownership)
+      .def("read_part_node_velocity", &dro::D3plot::read_part_node_velocity,
+           "The same as read_part_node_coordinates for the node velocity.",
+           py::arg("state"), py::arg("part"),
+           py::arg("part_node_indices") =
+               static_cast<dro::Array<d3_word> *>(nullptr),
+           py::return_value_policy::take_ownership)
+      .def("read_part_node_acceleration",
+           &dro::D3plot::read_part_node_acceleration,
+           "The same as read_part_node_coordinates for the node acceleration.",
+           py::arg("state"), py::arg("part"),
+           py::arg("part_node_indices") =
+               static_cast<dro::Array<d3_word> *>(nullptr),
+           py::return_value_policy::take_ownership)
+      .def("read_deleted_nodes", &dro::D3plot::read_deleted_nodes,
+           "Returns a bitset of all nodes, in which the bits of deleted nodes "
+           "are set. Only present if MDLOPT is 1.",
+           py::arg("state"), py::return_value_policy::take_ownership)
+      .def("read_deleted_elements", &dro::D3plot::read_deleted_elements,
+           "Returns a bitset of all elements of a type, in which the bits of "
+           "deleted elements are set. Only present if MDLOPT is 2.",
+           py::arg("state"), py::arg("id_type"),
+           py::return_value_policy::take_ownership)
+      .def("read_alive_solids_state", &dro::D3plot::read_alive_solids_state,
+           "The same as read_solids_state but deleted solids are skipped. "
+           "Returns a tuple of (solids, indices).",
+           py::arg("state"))
+      .def("read_alive_thick_shells_state",
+           &dro::D3plot::read_alive_thick_shells_state,
+           "The same as read_thick_shells_state but deleted thick shells are "
+           "skipped. Returns a tuple of (thick_shells, indices).",
+           py::arg("state"))
+      .def("read_alive_beams_state", &dro::D3plot::read_alive_beams_state,
+           "The same as read_beams_state but deleted beams are skipped. "
+           "Returns a tuple of (beams, indices).",
+           py::arg("state"))
+      .def("read_alive_shells_state", &dro::D3plot::read_alive_shells_state,
+           "The same as read_shells_state but deleted shells are skipped. "
+           "Returns a tuple of (shells, indices).",
+           py::arg("state"))
 
       .def("read_solid_elements", &dro::D3plot::read_solid_elements,
            "Returns the node connectivity + material number of all 8 node "
            "solid elements.",
            py::return_value_policy::take_ownership)
+      .def("read_solid_extra_nodes", &dro::D3plot::read_solid_extra_nodes,
+           "Returns the two extra nodes of every ten node tetrahedron (NEL8 < "
+           "0). The nodes of solid i are located at i*2 and i*2+1.",
+           py::return_value_policy::take_ownership)
       .def(
           "read_thick_shell_elements", &dro::D3plot::read_thick_shell_elements,
           "Returns the node connectivity + material number of all 8 node thick "
@@ -347,12 +697,95 @@ void add_d3plot_library_to_module(py::module_ &m) {
           "this function multiple times, it is best to preload the part ids.",
           py::arg("part_id"), py::arg("part_ids") = dro::Array<d3_word>(),
           py::return_value_policy::take_ownership)
+      .def("read_all_parts", &dro::D3plot::read_all_parts,
+           "Returns all parts at once. This is a lot faster than calling "
+           "read_part for every part, since all elements are only read once. "
+           "The index into the returned list is the same as the part_index of "
+           "read_part.",
+           py::return_value_policy::take_ownership)
+      .def("ids_to_indices", &dro::D3plot::ids_to_indices,
+           "Translates ids of the given type into indices. Ids that do not "
+           "exist are translated to SIZE_MAX. The ids are only read and "
+           "indexed on the first call for each type.",
+           py::arg("id_type"), py::arg("ids"),
+           py::return_value_policy::take_ownership)
+      .def("id_to_index", &dro::D3plot::id_to_index,
+           "The same as ids_to_indices for a single id.", py::arg("id_type"),
+           py::arg("id"))
+      .def("find_part", &dro::D3plot::find_part,
+           "Returns the index of the first part whose title equals title or "
+           "SIZE_MAX if there is none. The part ids and titles are only read "
+           "once.",
+           py::arg("title"))
+      .def("search_parts", &dro::D3plot::search_parts,
+           "Returns the indices of all parts whose title matches pattern in "
+           "ascending order.",
+           py::arg("pattern"), py::arg("mode") = dro::PartSearch::Exact,
+           py::arg("ignore_case") = false,
+           py::return_value_policy::take_ownership)
+      .def("reduce_elements", &dro::D3plot::reduce_elements,
+           "Reduces a quantity of all elements of a type (Solid, ThickShell "
+           "or Shell) over num_states states starting at first_state, of "
+           "which only one is held in memory at a time. Returns a tuple of "
+           "(values, states) with the reduced values and the states in which "
+           "they occurred.",
+           py::arg("id_type"), py::arg("quantity"), py::arg("op"),
+           py::arg("first_state") = 0, py::arg("num_states") = SIZE_MAX,
+           py::arg("surface") = dro::ShellSurface::Mid)
+      .def("resample_nodes", &dro::D3plot::resample_nodes,
+           "Linearly interpolates a quantity of all nodes at every time of "
+           "times. Every state is only read once as long as times is sorted. "
+           "Returns one array for every time.",
+           py::arg("quantity"), py::arg("times"),
+           py::return_value_policy::take_ownership)
+      .def("resample_elements", &dro::D3plot::resample_elements,
+           "The same as resample_nodes for a quantity of all elements of "
+           "id_type (Solid, ThickShell or Shell).",
+           py::arg("id_type"), py::arg("quantity"), py::arg("times"),
+           py::arg("surface") = dro::ShellSurface::Mid,
+           py::return_value_policy::take_ownership)
+      .def("get_mesh", &dro::D3plot::get_mesh,
+           "Returns the mesh of all elements. It is built on the first call.",
+           py::keep_alive<0, 1>())
+      .def("read_skin", &dro::D3plot::read_skin,
+           "Returns the skin (all faces which are not shared by two elements) "
+           "of all solid and thick shell elements.")
+      .def("read_part_skin", &dro::D3plot::read_part_skin,
+           "The same as read_skin but only the solids and thick shells of "
+           "part are used.",
+           py::arg("part"))
 
       .def("num_time_steps", &dro::D3plot::num_time_steps,
            "Returns the number of states (time steps).")
 
       ;
 
+  py::class_<dro::D3plotSkin>(m, "D3plotSkin")
+      .def_readonly("node_indices", &dro::D3plotSkin::node_indices)
+      .def_readonly("faces", &dro::D3plotSkin::faces)
+      .def_readonly("face_elements", &dro::D3plotSkin::face_elements)
+      .def_readonly("face_element_types",
+                    &dro::D3plotSkin::face_element_types);
+
+  py::class_<dro::D3plotMesh>(m, "D3plotMesh")
+      .def("num_nodes", &dro::D3plotMesh::num_nodes)
+      .def("num_elements", &dro::D3plotMesh::num_elements)
+      .def("num_parts", &dro::D3plotMesh::num_parts)
+      .def("get_element_nodes", &dro::D3plotMesh::get_element_nodes,
+           "Returns the node indices of an element in the order of its "
+           "connectivity. The elements are numbered in the order solids, "
+           "beams, shells and thick shells.",
+           py::arg("element_index"), py::keep_alive<0, 1>())
+      .def("get_node_elements", &dro::D3plotMesh::get_node_elements,
+           "Returns the indices of all elements which contain a node.",
+           py::arg("node_index"), py::keep_alive<0, 1>())
+      .def("get_part_elements", &dro::D3plotMesh::get_part_elements,
+           "Returns the indices of all elements of a part.",
+           py::arg("part_index"), py::keep_alive<0, 1>())
+      .def("get_part_nodes", &dro::D3plotMesh::get_part_nodes,
+           "Returns the indices of all nodes of a part.", py::arg("part_index"),
+           py::keep_alive<0, 1>());
+
   py::class_<dro::D3plotPart>(m, "D3plotPart")
       .def("get_solid_elements", &dro::D3plotPart::get_solid_elements,
            "Returns all solid element ids of the part.",
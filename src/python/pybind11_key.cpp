@@ -26,6 +26,7 @@
 #include "conversions.hpp"
 #include <include_transform.hpp>
 #include <key.hpp>
+#include <key_mesh.hpp>
 #include <pybind11/pybind11.h>
 #include <sstream>
 
@@ -134,6 +135,10 @@ void add_key_library_to_module(py::module_ &m) {
       .def("__len__", [](dro::Keywords &self) { return self.size(); })
       .def("__getitem__", &dro::Keywords::operator[],
            py::return_value_policy::take_ownership)
+      .def("__contains__", &dro::Keywords::contains)
+      .def("prefix", &dro::Keywords::prefix, py::arg("prefix"),
+           "Returns all keywords whose name starts with prefix (e.g. \"MAT_\")",
+           py::return_value_policy::take_ownership)
 
       ;
 
@@ -281,12 +286,16 @@ void add_key_library_to_module(py::module_ &m) {
       "key_file_parse",
       [](const fs::path &file_name, bool output_warnings, bool parse_includes,
          bool ignore_not_found_includes,
-         std::vector<fs::path> extra_include_paths) {
+         std::vector<fs::path> extra_include_paths,
+         std::vector<std::string> include_keywords,
+         std::vector<std::string> exclude_keywords) {
         std::optional<dro::String> warnings;
         auto keywords = dro::KeyFile::parse(
             file_name,
-            dro::KeyFile::ParseConfig(parse_includes, ignore_not_found_includes,
-                                      std::move(extra_include_paths)),
+            dro::KeyFile::ParseConfig(
+                parse_includes, ignore_not_found_includes,
+                std::move(extra_include_paths), std::move(include_keywords),
+                std::move(exclude_keywords)),
             &warnings);
 
         if (output_warnings && warnings) {
@@ -297,13 +306,58 @@ void add_key_library_to_module(py::module_ &m) {
       },
       "Parses an LS Dyna key file for keywords and their respective cards. "
       "Returns an array of keywords.\nparse_config: Configure how the file is "
-      "parsed",
+      "parsed\ninclude_keywords: Glob patterns of the keywords which should be "
+      "parsed (e.g. \"MAT_*\")\nexclude_keywords: Glob patterns of the "
+      "keywords which should be skipped",
       py::arg("file_name"), py::arg("output_warnings") = true,
       py::arg("parse_includes") = true,
       py::arg("ignore_not_found_includes") = false,
       py::arg("extra_include_paths") = std::vector<fs::path>(),
+      py::arg("include_keywords") = std::vector<std::string>(),
+      py::arg("exclude_keywords") = std::vector<std::string>(),
       py::return_value_policy::take_ownership);
 
+  py::class_<dro::IncrementalKeyFile>(m, "IncrementalKeyFile")
+      .def(py::init<>())
+      .def(
+          "parse",
+          [](dro::IncrementalKeyFile &self, const fs::path &file_name,
+             bool output_warnings, bool parse_includes,
+             bool ignore_not_found_includes,
+             std::vector<fs::path> extra_include_paths,
+             std::vector<std::string> include_keywords,
+             std::vector<std::string> exclude_keywords) {
+            std::optional<dro::String> warnings;
+            auto keywords = self.parse(
+                file_name,
+                dro::KeyFile::ParseConfig(
+                    parse_includes, ignore_not_found_includes,
+                    std::move(extra_include_paths), std::move(include_keywords),
+                    std::move(exclude_keywords)),
+                &warnings);
+
+            if (output_warnings && warnings) {
+              std::cout << *warnings << std::endl;
+            }
+
+            return keywords;
+          },
+          "Same as key_file_parse, but only reads the files which have been "
+          "modified since the last call with the same file_name",
+          py::arg("file_name"), py::arg("output_warnings") = true,
+          py::arg("parse_includes") = true,
+          py::arg("ignore_not_found_includes") = false,
+          py::arg("extra_include_paths") = std::vector<fs::path>(),
+          py::arg("include_keywords") = std::vector<std::string>(),
+          py::arg("exclude_keywords") = std::vector<std::string>(),
+          py::return_value_policy::take_ownership)
+      .def_property_readonly("num_parsed_files",
+                             &dro::IncrementalKeyFile::num_parsed_files)
+      .def_property_readonly("num_reused_files",
+                             &dro::IncrementalKeyFile::num_reused_files)
+
+      ;
+
   dro::add_array_type_to_module<dro::TransformationOption>(m);
   dro::add_array_type_to_module<transformation_option_t>(m);
 
@@ -335,6 +389,36 @@ void add_key_library_to_module(py::module_ &m) {
 
       ;
 
+  py::class_<dro::KeyNodes>(m, "KeyNodes")
+      .def(py::init<dro::KeywordSlice &>(), py::arg("keywords"),
+           "Decodes all cards of the NODE keywords in one pass")
+      .def(py::init<dro::Keyword &>(), py::arg("keyword"))
+      .def("__len__", &dro::KeyNodes::size)
+      .def("get_ids", &dro::KeyNodes::get_ids, py::keep_alive<0, 1>())
+      .def("get_coords", &dro::KeyNodes::get_coords, py::keep_alive<0, 1>())
+
+      ;
+
+  py::class_<dro::KeyElements>(m, "KeyElements")
+      .def_static("parse_solid", &dro::KeyElements::parse_solid,
+                  py::arg("keywords"),
+                  "Decodes all cards of the ELEMENT_SOLID keywords in one pass")
+      .def_static("parse_shell", &dro::KeyElements::parse_shell,
+                  py::arg("keywords"),
+                  "Decodes all cards of the ELEMENT_SHELL keywords in one pass")
+      .def_static("parse_beam", &dro::KeyElements::parse_beam,
+                  py::arg("keywords"),
+                  "Decodes all cards of the ELEMENT_BEAM keywords in one pass")
+      .def("__len__", &dro::KeyElements::size)
+      .def("nodes_per_element", &dro::KeyElements::nodes_per_element)
+      .def("get_ids", &dro::KeyElements::get_ids, py::keep_alive<0, 1>())
+      .def("get_part_ids", &dro::KeyElements::get_part_ids,
+           py::keep_alive<0, 1>())
+      .def("get_connectivity", &dro::KeyElements::get_connectivity,
+           py::keep_alive<0, 1>())
+
+      ;
+
   py::class_<dro::TransformationOption>(m, "TransformOption")
       .def("get_name", &dro::TransformationOption::get_name,
            py::return_value_policy::take_ownership)
@@ -26,6 +26,10 @@
 #include "sync.h"
 #include "errno.h"
 #include "profiling.h"
+#include <stdlib.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #ifdef _WIN32
 sync_t sync_create() {
@@ -97,6 +101,50 @@ void sync_destroy(sync_t *snc) {
   END_PROFILE_FUNC();
 }
 
+DWORD WINAPI _thread_start(LPVOID data) {
+  const _thread_start_data start = *(_thread_start_data *)data;
+  free(data);
+  start.func(start.arg);
+  return 0;
+}
+
+int thread_create(thread_t *thread, thread_func_t func, void *arg) {
+  BEGIN_PROFILE_FUNC();
+
+  _thread_start_data *data = malloc(sizeof(_thread_start_data));
+  data->func = func;
+  data->arg = arg;
+
+  *thread = CreateThread(NULL, 0, _thread_start, data, 0, NULL);
+  if (*thread == NULL) {
+    free(data);
+    END_PROFILE_FUNC();
+    return EINVAL;
+  }
+
+  END_PROFILE_FUNC();
+  return 0;
+}
+
+int thread_join(thread_t *thread) {
+  BEGIN_PROFILE_FUNC();
+
+  const DWORD win_rv = WaitForSingleObject(*thread, INFINITE);
+  CloseHandle(*thread);
+  const int rv = win_rv == WAIT_OBJECT_0 ? 0 : EINVAL;
+
+  END_PROFILE_FUNC();
+  return rv;
+}
+
+size_t thread_num_processors() {
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  return system_info.dwNumberOfProcessors > 0
+             ? (size_t)system_info.dwNumberOfProcessors
+             : 1;
+}
+
 #else
 sync_t sync_create() {
   BEGIN_PROFILE_FUNC();
@@ -143,4 +191,41 @@ void sync_destroy(sync_t *snc) {
   END_PROFILE_FUNC();
 }
 
+void *_thread_start(void *data) {
+  const _thread_start_data start = *(_thread_start_data *)data;
+  free(data);
+  start.func(start.arg);
+  return NULL;
+}
+
+int thread_create(thread_t *thread, thread_func_t func, void *arg) {
+  BEGIN_PROFILE_FUNC();
+
+  _thread_start_data *data = malloc(sizeof(_thread_start_data));
+  data->func = func;
+  data->arg = arg;
+
+  const int rv = pthread_create(thread, NULL, _thread_start, data);
+  if (rv != 0) {
+    free(data);
+  }
+
+  END_PROFILE_FUNC();
+  return rv;
+}
+
+int thread_join(thread_t *thread) {
+  BEGIN_PROFILE_FUNC();
+
+  const int rv = pthread_join(*thread, NULL);
+
+  END_PROFILE_FUNC();
+  return rv;
+}
+
+size_t thread_num_processors() {
+  const long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+  return num_processors > 0 ? (size_t)num_processors : 1;
+}
+
 #endif
\ No newline at end of file
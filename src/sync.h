@@ -26,16 +26,23 @@
 #ifndef SYNC_H
 #define SYNC_H
 
+#include <stddef.h>
+
 #ifdef _WIN32
 #include <windows.h>
 
 typedef HANDLE sync_t;
+typedef HANDLE thread_t;
 #else
 #include <pthread.h>
 
 typedef pthread_mutex_t sync_t;
+typedef pthread_t thread_t;
 #endif
 
+/* The function that is called by a thread created by thread_create*/
+typedef void (*thread_func_t)(void *arg);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,6 +65,32 @@ int sync_unlock(sync_t *snc);
 /* Destroy the mutex*/
 void sync_destroy(sync_t *snc);
 
+/* Starts a new thread which calls func with arg. It needs to be joined by
+ * thread_join. Returns 0 on success*/
+int thread_create(thread_t *thread, thread_func_t func, void *arg);
+
+/* Blocks until the thread has finished. Returns 0 on success*/
+int thread_join(thread_t *thread);
+
+/* Returns the number of processors that are currently available (at least
+ * 1)*/
+size_t thread_num_processors();
+
+/* ----- Private Functions ----- */
+
+/* Holds the function and argument of a starting thread*/
+typedef struct {
+  thread_func_t func;
+  void *arg;
+} _thread_start_data;
+
+/* Calls the function of a _thread_start_data and deallocates it*/
+#ifdef _WIN32
+DWORD WINAPI _thread_start(LPVOID data);
+#else
+void *_thread_start(void *data);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
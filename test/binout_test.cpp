@@ -654,7 +654,7 @@ TEST_CASE("glob") {
   size_t num_files;
   char **globed_files = binout_glob("src/*.c", &num_files);
 
-  CHECK(num_files == 20);
+  CHECK(num_files == 30);
   CHECK(strarr_contains(globed_files, num_files, "src/binary_search.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/binout_directory.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/binout_glob.c"));
@@ -662,12 +662,22 @@ TEST_CASE("glob") {
   CHECK(strarr_contains(globed_files, num_files, "src/binout.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/d3_buffer.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/d3plot_data.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_derived.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_id_index.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_mesh.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/d3plot_part_nodes.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_skin.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_part_titles.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_reduce.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/d3plot_resample.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/d3plot_state.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/d3plot.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/extra_string.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/include_transform.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/key.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/key_incremental.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/key_index.c"));
+  CHECK(strarr_contains(globed_files, num_files, "src/key_mesh.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/line.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/multi_file.c"));
   CHECK(strarr_contains(globed_files, num_files, "src/path_view.c"));
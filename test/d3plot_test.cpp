@@ -328,6 +328,94 @@ TEST_CASE("d3plot") {
     free(node_data);
   }
 
+  {
+    size_t num_coord_nodes;
+    double *coords =
+        d3plot_read_node_coordinates(&plot_file, 101, &num_coord_nodes);
+    REQUIRE(plot_file.error_string == NULL);
+    double *displacement =
+        d3plot_read_node_displacement(&plot_file, 101, &num_nodes);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_nodes == num_coord_nodes);
+
+    const size_t node_indices[] = {5, 6, 7, 100000};
+    size_t num_range_nodes;
+    double *range = d3plot_read_node_displacement_range(
+        &plot_file, 100, 2, node_indices, 4, &num_range_nodes);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_range_nodes == 4);
+
+    size_t i = 0;
+    while (i < 4) {
+      const size_t n = node_indices[i];
+      size_t c = 0;
+      while (c < 3) {
+        const double expected =
+            coords[n * 3 + c] - plot_file.initial_node_coords[n * 3 + c];
+        CHECK_APPROX(displacement[n * 3 + c], expected);
+        CHECK(range[(4 + i) * 3 + c] == displacement[n * 3 + c]);
+        c++;
+      }
+      i++;
+    }
+
+    /* Relative to itself the displacement has to be 0*/
+    size_t num_relative_nodes;
+    double *relative = d3plot_read_node_relative_displacement(
+        &plot_file, 101, &node_indices[3], 1, &node_indices[3], 1,
+        &num_relative_nodes);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_relative_nodes == 1);
+    CHECK(relative[0] == 0.0);
+    CHECK(relative[2] == 0.0);
+
+    free(relative);
+    free(range);
+    free(displacement);
+    free(coords);
+
+    d3plot_read_node_displacement_range(&plot_file, 101, 2, NULL, 0,
+                                        &num_nodes);
+    CHECK(plot_file.error_string != NULL);
+    CHECK(num_nodes == 0);
+  }
+
+  {
+    const double times[] = {-1.0, d3plot_read_time(&plot_file, 10),
+                            (d3plot_read_time(&plot_file, 10) +
+                             d3plot_read_time(&plot_file, 11)) *
+                                0.5,
+                            1000.0};
+    const size_t num_values = d3plot_resample_num_values(
+        &plot_file, D3PLOT_ID_TYPE_NODE, D3PLOT_RESAMPLE_NODE_COORDINATES);
+    REQUIRE(num_values == 114893 * 3);
+    double *values = (double *)malloc(4 * num_values * sizeof(double));
+    REQUIRE(d3plot_resample_nodes(&plot_file,
+                                  D3PLOT_RESAMPLE_NODE_COORDINATES, times, 4,
+                                  values));
+
+    size_t num_coord_nodes;
+    double *coords10 =
+        d3plot_read_node_coordinates(&plot_file, 10, &num_coord_nodes);
+    double *coords11 =
+        d3plot_read_node_coordinates(&plot_file, 11, &num_coord_nodes);
+    CHECK_APPROX(values[0], 0.031293001);
+    CHECK(values[num_values + 5] == coords10[5]);
+    CHECK_APPROX(values[2 * num_values + 5],
+                 (coords10[5] + coords11[5]) * 0.5);
+    free(coords11);
+    free(coords10);
+    free(values);
+
+    const size_t num_shells = d3plot_resample_num_values(
+        &plot_file, D3PLOT_ID_TYPE_SHELL, D3PLOT_DERIVED_VON_MISES);
+    values = (double *)malloc(2 * num_shells * sizeof(double));
+    REQUIRE(d3plot_resample_elements(
+        &plot_file, D3PLOT_ID_TYPE_SHELL, D3PLOT_DERIVED_VON_MISES,
+        D3PLOT_SHELL_SURFACE_MID, &times[1], 2, values));
+    free(values);
+  }
+
   {
     float *node_data =
         d3plot_read_node_coordinates_32(&plot_file, 0, &num_nodes);
@@ -491,6 +579,42 @@ TEST_CASE("d3plot") {
   }
   free(part_titles);
 
+  const d3plot_part_titles *titles = d3plot_get_part_titles(&plot_file);
+  REQUIRE(titles != NULL);
+  REQUIRE(titles->num_parts == 9);
+  CHECK(titles->ids[8] == 73000001);
+  CHECK(d3plot_part_titles_get(titles, 4) == "Pouch");
+  CHECK(d3plot_get_part_titles(&plot_file) == titles);
+
+  CHECK(d3plot_find_part(&plot_file, "Pouch") == 4);
+  CHECK(d3plot_find_part(&plot_file, "Pouch   ") == 4);
+  CHECK(d3plot_find_part(&plot_file, "Pouc") == (size_t)~0);
+  CHECK(d3plot_find_part(&plot_file, "pouch") == (size_t)~0);
+
+  size_t *found_parts = d3plot_search_parts(
+      &plot_file, "Negative_Terminal", D3PLOT_PART_SEARCH_PREFIX, &num_parts);
+  REQUIRE(num_parts == 2);
+  CHECK(found_parts[0] == 0);
+  CHECK(found_parts[1] == 1);
+  free(found_parts);
+
+  found_parts = d3plot_search_parts(
+      &plot_file, "POUCH",
+      D3PLOT_PART_SEARCH_PREFIX | D3PLOT_PART_SEARCH_IGNORE_CASE, &num_parts);
+  REQUIRE(num_parts == 2);
+  CHECK(found_parts[0] == 4);
+  CHECK(found_parts[1] == 5);
+  free(found_parts);
+
+  found_parts = d3plot_search_parts(&plot_file, "*terminal*_?athode*",
+                                    D3PLOT_PART_SEARCH_WILDCARD |
+                                        D3PLOT_PART_SEARCH_IGNORE_CASE,
+                                    &num_parts);
+  REQUIRE(num_parts == 2);
+  CHECK(found_parts[0] == 2);
+  CHECK(found_parts[1] == 3);
+  free(found_parts);
+
   d3plot_part part = d3plot_read_part(&plot_file, 0);
   CHECK(part.num_shells == 120);
   d3plot_free_part(&part);
@@ -574,11 +698,151 @@ TEST_CASE("d3plot") {
   CHECK(part.solid_indices != NULL);
   d3plot_free_part(&part);
 
+  d3plot_parts all_parts = d3plot_read_all_parts(&plot_file);
+  REQUIRE(plot_file.error_string == NULL);
+  CHECK(all_parts.num_parts == plot_file.control_data.nmmat);
+  for (size_t i = 0; i < all_parts.num_parts; i++) {
+    const d3plot_part all_part = d3plot_parts_get_part(&all_parts, i);
+    part = d3plot_read_part(&plot_file, i);
+
+    REQUIRE(all_part.num_solids == part.num_solids);
+    REQUIRE(all_part.num_thick_shells == part.num_thick_shells);
+    REQUIRE(all_part.num_beams == part.num_beams);
+    REQUIRE(all_part.num_shells == part.num_shells);
+    for (size_t j = 0; j < part.num_solids; j++) {
+      CHECK(all_part.solid_ids[j] == part.solid_ids[j]);
+      CHECK(all_part.solid_indices[j] == part.solid_indices[j]);
+    }
+    for (size_t j = 0; j < part.num_shells; j++) {
+      CHECK(all_part.shell_ids[j] == part.shell_ids[j]);
+      CHECK(all_part.shell_indices[j] == part.shell_indices[j]);
+    }
+
+    d3plot_free_part(&part);
+  }
+  d3plot_free_parts(&all_parts);
+
   d3plot_solid *solids =
       d3plot_read_solids_state(&plot_file, 101, &num_elements);
   REQUIRE(num_elements == 45000);
   free(solids);
 
+  CHECK(plot_file.control_data.has_solid_extra_nodes == 0);
+  d3_word *solid_extra_nodes =
+      d3plot_read_solid_extra_nodes(&plot_file, &num_elements);
+  CHECK(plot_file.error_string == NULL);
+  CHECK(solid_extra_nodes == NULL);
+  CHECK(num_elements == 0);
+
+  {
+    d3plot_reduction reduction = d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_DERIVED_VON_MISES,
+        D3PLOT_SHELL_SURFACE_MID, D3PLOT_REDUCE_MAX, 100, 3);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(reduction.num_elements == 45000);
+
+    size_t state = 100;
+    while (state < 103) {
+      solids = d3plot_read_solids_state(&plot_file, state, &num_elements);
+      REQUIRE(num_elements == 45000);
+      i = 0;
+      while (i < num_elements) {
+        const double von_mises =
+            d3plot_tensor_derived(&solids[i].stress, D3PLOT_DERIVED_VON_MISES);
+        CHECK(reduction.values[i] >= von_mises);
+        if (reduction.states[i] == state) {
+          CHECK(reduction.values[i] == von_mises);
+        }
+        i++;
+      }
+      free(solids);
+      state++;
+    }
+
+    d3plot_reduction first = d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_DERIVED_VON_MISES,
+        D3PLOT_SHELL_SURFACE_MID, D3PLOT_REDUCE_MAX, 100, 1);
+    d3plot_reduction second = d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_DERIVED_VON_MISES,
+        D3PLOT_SHELL_SURFACE_MID, D3PLOT_REDUCE_MAX, 101, 2);
+    REQUIRE(d3plot_combine_reductions(&first, &second, D3PLOT_REDUCE_MAX));
+    CHECK(memcmp(first.values, reduction.values, 45000 * sizeof(double)) ==
+          0);
+    CHECK(memcmp(first.states, reduction.states, 45000 * sizeof(size_t)) ==
+          0);
+    d3plot_free_reduction(&first);
+    d3plot_free_reduction(&second);
+    d3plot_free_reduction(&reduction);
+
+    reduction = d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_DERIVED_VON_MISES,
+        D3PLOT_SHELL_SURFACE_MID, D3PLOT_REDUCE_MAX, 100, plot_file.num_states);
+    CHECK(plot_file.error_string != NULL);
+    CHECK(reduction.values == NULL);
+  }
+
+  {
+    size_t num_states;
+    d3plot_global *globals = d3plot_read_all_global(&plot_file, &num_states);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_states == plot_file.num_states);
+    const d3plot_global global = d3plot_read_global(&plot_file, 101);
+    CHECK(global.total_energy == globals[101].total_energy);
+    CHECK(global.kinetic_energy >= 0.0);
+    free(globals);
+
+    size_t num_materials;
+    double *masses = d3plot_read_material_data(
+        &plot_file, 101, D3PLOT_MATERIAL_MASS, &num_materials);
+    REQUIRE(plot_file.error_string == NULL);
+    CHECK(num_materials == _d3plot_num_global_materials(&plot_file));
+
+    size_t num_material_states, num_all_materials;
+    double *all_masses =
+        d3plot_read_all_material_data(&plot_file, D3PLOT_MATERIAL_MASS,
+                                      &num_material_states, &num_all_materials);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_material_states == plot_file.num_states);
+    REQUIRE(num_all_materials == num_materials);
+    i = 0;
+    while (i < num_materials) {
+      CHECK(all_masses[101 * num_materials + i] == masses[i]);
+      CHECK(masses[i] >= 0.0);
+      i++;
+    }
+    free(all_masses);
+    free(masses);
+
+    d3plot_read_material_data(&plot_file, 101, D3PLOT_MATERIAL_COUNT,
+                              &num_materials);
+    CHECK(plot_file.error_string != NULL);
+    CHECK(num_materials == 0);
+
+    size_t num_rigid_walls, num_rw_states, num_all_rigid_walls;
+    d3plot_rigid_wall *rigid_walls =
+        d3plot_read_rigid_walls(&plot_file, 101, &num_rigid_walls);
+    REQUIRE(plot_file.error_string == NULL);
+    d3plot_rigid_wall *all_rigid_walls = d3plot_read_all_rigid_walls(
+        &plot_file, &num_rw_states, &num_all_rigid_walls);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_all_rigid_walls == num_rigid_walls);
+    i = 0;
+    while (i < num_rigid_walls) {
+      CHECK(all_rigid_walls[101 * num_rigid_walls + i].force ==
+            rigid_walls[i].force);
+      i++;
+    }
+    free(all_rigid_walls);
+    free(rigid_walls);
+
+    /* This d3plot has no temperatures*/
+    size_t num_temperature_nodes;
+    CHECK(d3plot_read_node_temperature(&plot_file, 101,
+                                       &num_temperature_nodes) == NULL);
+    CHECK(plot_file.error_string != NULL);
+    CHECK(num_temperature_nodes == 0);
+  }
+
   d3plot_thick_shell *thick_shells =
       d3plot_read_thick_shells_state(&plot_file, 101, &num_elements);
   REQUIRE(num_elements == 0);
@@ -588,6 +852,10 @@ TEST_CASE("d3plot") {
   REQUIRE(num_elements == 0);
   d3plot_free_beams_state(beams);
 
+  d3plot_beams beam_arrays = d3plot_alloc_beams(0, 0, 0, 1);
+  CHECK(d3plot_read_beams_state_arrays(&plot_file, 101, &beam_arrays));
+  d3plot_free_beams(&beam_arrays);
+
   d3plot_shell *shells =
       d3plot_read_shells_state(&plot_file, 101, &num_elements);
   REQUIRE(num_elements == 88456);
@@ -603,6 +871,83 @@ TEST_CASE("d3plot") {
   CHECK(shells[789].inner.effective_plastic_strain - 0.0002128475 < 1e-10);
   CHECK(shells[45678].bending_moment.x == 0.0);
 
+  size_t num_alive_shells, *alive_shell_indices;
+  d3plot_shell *alive_shells = d3plot_read_alive_shells_state(
+      &plot_file, 101, &num_alive_shells, &alive_shell_indices);
+  REQUIRE(plot_file.error_string == NULL);
+  if (plot_file.control_data.mdlopt == 2) {
+    size_t num_flags;
+    uint8_t *deleted = d3plot_read_deleted_elements(
+        &plot_file, 101, D3PLOT_ID_TYPE_SHELL, &num_flags);
+    REQUIRE(plot_file.error_string == NULL);
+    REQUIRE(num_flags == num_elements);
+    size_t num_deleted = 0;
+    for (size_t i = 0; i < num_flags; i++) {
+      num_deleted += (deleted[i / 8] >> (i % 8)) & 1;
+    }
+    CHECK(num_alive_shells == num_elements - num_deleted);
+    free(deleted);
+  } else {
+    CHECK(num_alive_shells == num_elements);
+  }
+  for (size_t i = 0; i < num_alive_shells; i++) {
+    CHECK(alive_shells[i].mid.sigma.x ==
+          shells[alive_shell_indices[i]].mid.sigma.x);
+  }
+  free(alive_shell_indices);
+  d3plot_free_shells_state(alive_shells);
+
+  part = d3plot_read_part(&plot_file, 6);
+  REQUIRE(part.shell_indices != NULL);
+  size_t num_part_shells;
+  d3plot_shell *part_shells =
+      d3plot_read_part_shells_state(&plot_file, 101, &part, &num_part_shells);
+  REQUIRE(plot_file.error_string == NULL);
+  REQUIRE(num_part_shells == part.num_shells);
+  for (size_t i = 0; i < num_part_shells; i++) {
+    const d3plot_shell &shell = shells[part.shell_indices[i]];
+    CHECK(part_shells[i].mid.sigma.x == shell.mid.sigma.x);
+    CHECK(part_shells[i].inner.effective_plastic_strain ==
+          shell.inner.effective_plastic_strain);
+    CHECK(part_shells[i].internal_energy == shell.internal_energy);
+  }
+  d3plot_free_shells_state(part_shells);
+
+  /* Without indices the ids need to be translated*/
+  size_t *part_shell_indices = part.shell_indices;
+  part.shell_indices = NULL;
+  part_shells =
+      d3plot_read_part_shells_state(&plot_file, 101, &part, &num_part_shells);
+  REQUIRE(plot_file.error_string == NULL);
+  REQUIRE(num_part_shells == part.num_shells);
+  CHECK(part_shells[100].mid.sigma.x ==
+        shells[part_shell_indices[100]].mid.sigma.x);
+  d3plot_free_shells_state(part_shells);
+  part.shell_indices = part_shell_indices;
+
+  double *node_coords =
+      d3plot_read_node_coordinates(&plot_file, 101, &num_nodes);
+  part_node_indices =
+      d3plot_part_get_node_indices(&plot_file, &part, &num_part_node_indices);
+  size_t num_part_nodes;
+  double *part_node_coords = d3plot_read_part_node_coordinates2(
+      &plot_file, 101, &part, &num_part_nodes, part_node_indices,
+      num_part_node_indices);
+  REQUIRE(plot_file.error_string == NULL);
+  REQUIRE(num_part_nodes == num_part_node_indices);
+  for (size_t i = 0; i < num_part_nodes; i++) {
+    CHECK(part_node_coords[i * 3 + 0] ==
+          node_coords[part_node_indices[i] * 3 + 0]);
+    CHECK(part_node_coords[i * 3 + 1] ==
+          node_coords[part_node_indices[i] * 3 + 1]);
+    CHECK(part_node_coords[i * 3 + 2] ==
+          node_coords[part_node_indices[i] * 3 + 2]);
+  }
+  free(part_node_coords);
+  free(part_node_indices);
+  free(node_coords);
+  d3plot_free_part(&part);
+
   d3plot_free_shells_state(shells);
 
   d3plot_close(&plot_file);
@@ -623,6 +968,35 @@ TEST_CASE("ansys-example-beam") {
     FAIL(d3plot.error_string);
   }
 
+  size_t num_beams;
+  d3plot_beam *beams = d3plot_read_beams_state(&d3plot, 0, &num_beams);
+  REQUIRE(d3plot.error_string == NULL);
+
+  d3plot_beams beam_arrays =
+      d3plot_alloc_beams(d3plot.control_data.nel2, d3plot.control_data.beamip,
+                         d3plot.control_data.neipb, 1);
+  REQUIRE(d3plot_read_beams_state_arrays(&d3plot, 0, &beam_arrays));
+  size_t i = 0;
+  while (i < num_beams) {
+    CHECK(beam_arrays.resultants[0][i] == beams[i].axial_force);
+    CHECK(beam_arrays.resultants[5][i] == beams[i].torsional_resultant);
+    size_t j = 0;
+    while (j < beams[i].num_integration_points) {
+      CHECK(beam_arrays.ip_values[2][j * num_beams + i] ==
+            beams[i].ips[j].axial_stress);
+      j++;
+    }
+    j = 0;
+    while (j < beams[i].num_history_variables) {
+      CHECK(beam_arrays.history_max[j * num_beams + i] ==
+            beams[i].history_max[j]);
+      j++;
+    }
+    i++;
+  }
+  d3plot_free_beams(&beam_arrays);
+  d3plot_free_beams_state(beams);
+
   d3plot_close(&d3plot);
 }
 
@@ -830,6 +1204,17 @@ TEST_CASE("d3plotC++") {
     CHECK(part_titles[8] == "Jellyroll");
   }
 
+  CHECK(plot_file.find_part("Ground") == 7);
+  CHECK(plot_file.search_parts("Pouch", dro::PartSearch::Prefix).size() == 2);
+  {
+    const auto regex_parts =
+        plot_file.search_parts("^.*_(anode|cathode)$", dro::PartSearch::Regex,
+                               true);
+    REQUIRE(regex_parts.size() == 2);
+    CHECK(regex_parts[0] == 0);
+    CHECK(regex_parts[1] == 2);
+  }
+
   auto part(plot_file.read_part(0));
   CHECK(part.get_shell_elements().size() == 120);
 
@@ -905,6 +1290,14 @@ TEST_CASE("d3plotC++") {
   CHECK(part.get_solid_elements().size() == 45000);
   CHECK(part.get_solid_element_indices().size() == 45000);
 
+  {
+    auto all_parts = plot_file.read_all_parts();
+    REQUIRE(all_parts.size() > 8);
+    CHECK(all_parts[7].get_shell_elements().size() == 5000);
+    CHECK(all_parts[8].get_solid_elements().size() == 45000);
+    CHECK(all_parts[8].get_solid_element_indices().size() == 45000);
+  }
+
   {
     const auto solids = plot_file.read_solids_state(101);
     REQUIRE(solids.size() == 45000);
@@ -1224,3 +1617,1335 @@ TEST_CASE("d3_word_binary_search") {
   idx = d3_word_binary_search(arr, 0, arr_size - 1, 5);
   CHECK(idx == UINT64_MAX);
 }
+
+TEST_CASE("_d3plot_id_index") {
+  {
+    /* Dense ids use a direct table*/
+    const d3_word ids[] = {5, 3, 4, 8, 7, 3};
+    constexpr size_t num_ids = sizeof(ids) / sizeof(*ids);
+    d3plot_id_index index = _d3plot_id_index_new(ids, num_ids);
+    CHECK(index.direct == 1);
+    CHECK(_d3plot_id_index_get(&index, 5) == 0);
+    CHECK(_d3plot_id_index_get(&index, 3) == 1);
+    CHECK(_d3plot_id_index_get(&index, 4) == 2);
+    CHECK(_d3plot_id_index_get(&index, 8) == 3);
+    CHECK(_d3plot_id_index_get(&index, 7) == 4);
+    CHECK(_d3plot_id_index_get(&index, 6) == UINT64_MAX);
+    CHECK(_d3plot_id_index_get(&index, 2) == UINT64_MAX);
+    CHECK(_d3plot_id_index_get(&index, 9) == UINT64_MAX);
+    _d3plot_id_index_free(&index);
+  }
+  {
+    /* Sparse ids use a hash table*/
+    const d3_word ids[] = {1000000, 7, 3000000000, 42, 999999999999};
+    constexpr size_t num_ids = sizeof(ids) / sizeof(*ids);
+    d3plot_id_index index = _d3plot_id_index_new(ids, num_ids);
+    CHECK(index.direct == 0);
+    size_t i = 0;
+    while (i < num_ids) {
+      CHECK(_d3plot_id_index_get(&index, ids[i]) == i);
+      i++;
+    }
+    CHECK(_d3plot_id_index_get(&index, 8) == UINT64_MAX);
+    CHECK(_d3plot_id_index_get(&index, 0) == UINT64_MAX);
+    _d3plot_id_index_free(&index);
+  }
+  {
+    d3plot_id_index index = _d3plot_id_index_new(NULL, 0);
+    CHECK(_d3plot_id_index_get(&index, 1) == UINT64_MAX);
+    _d3plot_id_index_free(&index);
+  }
+}
+
+TEST_CASE("_d3plot_mesh") {
+  d3plot_beam_con beams[1];
+  beams[0].node_indices[0] = 5;
+  beams[0].node_indices[1] = 6;
+  beams[0].material_index = 1;
+  d3plot_shell_con shells[2];
+  shells[0].node_indices[0] = 0;
+  shells[0].node_indices[1] = 1;
+  shells[0].node_indices[2] = 2;
+  shells[0].node_indices[3] = 3;
+  shells[0].material_index = 0;
+  /* Degenerated shell (triangle)*/
+  shells[1].node_indices[0] = 1;
+  shells[1].node_indices[1] = 4;
+  shells[1].node_indices[2] = 2;
+  shells[1].node_indices[3] = 2;
+  shells[1].material_index = 1;
+
+  d3plot_mesh mesh;
+  memset(&mesh, 0, sizeof(mesh));
+  mesh.num_nodes = 7;
+  mesh.num_parts = 2;
+  mesh.element_node_offsets = (size_t *)malloc(4 * sizeof(size_t));
+  mesh.element_node_offsets[0] = 0;
+  mesh.element_nodes = (uint32_t *)malloc(10 * sizeof(uint32_t));
+  mesh.element_parts = (uint32_t *)malloc(3 * sizeof(uint32_t));
+
+  mesh.type_offsets[0] = 0;
+  mesh.type_offsets[1] = 0;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)beams, 1,
+                            sizeof(d3plot_beam_con) / sizeof(d3_word), 2);
+  mesh.type_offsets[2] = mesh.num_elements;
+  _d3plot_mesh_add_elements(&mesh, (const d3_word *)shells, 2,
+                            sizeof(d3plot_shell_con) / sizeof(d3_word), 4);
+  mesh.type_offsets[3] = mesh.num_elements;
+  mesh.type_offsets[4] = mesh.num_elements;
+  _d3plot_mesh_build_adjacency(&mesh);
+
+  REQUIRE(mesh.num_elements == 3);
+  CHECK(d3plot_mesh_get_element_index(&mesh, D3PLOT_ID_TYPE_SHELL, 1) == 2);
+  CHECK(d3plot_mesh_get_element_index(&mesh, D3PLOT_ID_TYPE_SHELL, 2) ==
+        UINT64_MAX);
+  CHECK(d3plot_mesh_get_element_index(&mesh, D3PLOT_ID_TYPE_SOLID, 0) ==
+        UINT64_MAX);
+  size_t index;
+  CHECK(d3plot_mesh_get_element_type(&mesh, 0, &index) == D3PLOT_ID_TYPE_BEAM);
+  CHECK(index == 0);
+  CHECK(d3plot_mesh_get_element_type(&mesh, 2, &index) ==
+        D3PLOT_ID_TYPE_SHELL);
+  CHECK(index == 1);
+  CHECK(d3plot_mesh_get_element_type(&mesh, 3, &index) == -1);
+
+  size_t n;
+  const uint32_t *nodes = d3plot_mesh_get_element_nodes(&mesh, 1, &n);
+  REQUIRE(n == 4);
+  CHECK(nodes[0] == 0);
+  CHECK(nodes[3] == 3);
+
+  const uint32_t *elements = d3plot_mesh_get_node_elements(&mesh, 2, &n);
+  REQUIRE(n == 2);
+  CHECK(elements[0] == 1);
+  CHECK(elements[1] == 2);
+  elements = d3plot_mesh_get_node_elements(&mesh, 6, &n);
+  REQUIRE(n == 1);
+  CHECK(elements[0] == 0);
+
+  elements = d3plot_mesh_get_part_elements(&mesh, 1, &n);
+  REQUIRE(n == 2);
+  CHECK(elements[0] == 0);
+  CHECK(elements[1] == 2);
+
+  nodes = d3plot_mesh_get_part_nodes(&mesh, 1, &n);
+  const uint32_t part_nodes[] = {1, 2, 4, 5, 6};
+  REQUIRE(n == 5);
+  size_t i = 0;
+  while (i < n) {
+    CHECK(nodes[i] == part_nodes[i]);
+    i++;
+  }
+  nodes = d3plot_mesh_get_part_nodes(&mesh, 0, &n);
+  CHECK(n == 4);
+  CHECK(d3plot_mesh_get_part_nodes(&mesh, 2, &n) == NULL);
+  CHECK(n == 0);
+
+  d3plot_free_mesh(&mesh);
+}
+
+TEST_CASE("_merge_sorted") {
+  const d3_word a[] = {1, 4, 9, 10};
+  const d3_word b[] = {2, 3, 11};
+  const d3_word c[] = {5, 6, 7, 8, 12};
+  const d3_word *arrays[] = {a, NULL, b, c};
+  const size_t sizes[] = {4, 0, 3, 5};
+
+  d3_word dst[12];
+  uint8_t array_indices[12];
+  size_t element_indices[12];
+  _merge_sorted(arrays, sizes, 4, dst, array_indices, element_indices);
+
+  size_t i = 0;
+  while (i < 12) {
+    CHECK(dst[i] == i + 1);
+    CHECK(arrays[array_indices[i]][element_indices[i]] == dst[i]);
+    i++;
+  }
+  CHECK(array_indices[0] == 0);
+  CHECK(array_indices[1] == 2);
+  CHECK(element_indices[1] == 0);
+  CHECK(array_indices[11] == 3);
+  CHECK(element_indices[11] == 4);
+}
+
+TEST_CASE("d3plot_extract_skin") {
+  d3plot_solid_con solids[2];
+  d3plot_thick_shell_con thick_shells[1];
+  for (size_t i = 0; i < 8; i++) {
+    solids[0].node_indices[i] = i;
+    thick_shells[0].node_indices[i] = i + 4;
+  }
+  solids[0].material_index = 0;
+  thick_shells[0].material_index = 1;
+  /* Degenerated solid (tetrahedron)*/
+  const d3_word tet_nodes[8] = {20, 21, 22, 22, 23, 23, 23, 23};
+  for (size_t i = 0; i < 8; i++) {
+    solids[1].node_indices[i] = tet_nodes[i];
+  }
+  solids[1].material_index = 0;
+
+  d3plot_skin skin = d3plot_extract_skin(solids, 2, thick_shells, 1);
+  /* The solid and the thick shell share one face*/
+  REQUIRE(skin.num_faces == 5 + 4 + 5);
+  REQUIRE(skin.num_nodes == 16);
+  for (size_t i = 0; i < 12; i++) {
+    CHECK(skin.node_indices[i] == i);
+  }
+  CHECK(skin.node_indices[12] == 20);
+  CHECK(skin.node_indices[15] == 23);
+
+  CHECK(skin.faces[0] == 0);
+  CHECK(skin.faces[1] == 3);
+  CHECK(skin.faces[2] == 2);
+  CHECK(skin.faces[3] == 1);
+  for (size_t i = 0; i < 5; i++) {
+    CHECK(skin.face_elements[i] == 0);
+    CHECK(skin.face_element_types[i] == D3PLOT_ID_TYPE_SOLID);
+  }
+
+  /* The bottom of the tetrahedron is a triangle*/
+  CHECK(skin.faces[5 * 4 + 0] == 12);
+  CHECK(skin.faces[5 * 4 + 1] == 14);
+  CHECK(skin.faces[5 * 4 + 2] == 13);
+  CHECK(skin.faces[5 * 4 + 3] == 13);
+  for (size_t i = 5; i < 9; i++) {
+    CHECK(skin.face_elements[i] == 1);
+    CHECK(skin.face_element_types[i] == D3PLOT_ID_TYPE_SOLID);
+  }
+
+  /* The top of the thick shell*/
+  CHECK(skin.faces[9 * 4 + 0] == 8);
+  CHECK(skin.faces[9 * 4 + 1] == 9);
+  CHECK(skin.faces[9 * 4 + 2] == 10);
+  CHECK(skin.faces[9 * 4 + 3] == 11);
+  for (size_t i = 9; i < 14; i++) {
+    CHECK(skin.face_elements[i] == 0);
+    CHECK(skin.face_element_types[i] == D3PLOT_ID_TYPE_THICK_SHELL);
+  }
+
+  d3plot_free_skin(&skin);
+  CHECK(skin.faces == NULL);
+
+  skin = d3plot_extract_skin(NULL, 0, NULL, 0);
+  CHECK(skin.num_faces == 0);
+  CHECK(skin.num_nodes == 0);
+  d3plot_free_skin(&skin);
+
+  /* A block of 4x4x4 hexahedrons split into multiple ranges has to result in
+   * the same skin as hashing all elements at once*/
+  d3plot_solid_con block[4 * 4 * 4];
+  size_t e = 0;
+  for (d3_word z = 0; z < 4; z++) {
+    for (d3_word y = 0; y < 4; y++) {
+      for (d3_word x = 0; x < 4; x++) {
+        const d3_word n = z * 25 + y * 5 + x;
+        const d3_word nodes[8] = {n,      n + 1,      n + 6,      n + 5,
+                                  n + 25, n + 25 + 1, n + 25 + 6, n + 25 + 5};
+        for (size_t i = 0; i < 8; i++) {
+          block[e].node_indices[i] = nodes[i];
+        }
+        block[e].material_index = 0;
+        e++;
+      }
+    }
+  }
+
+  skin = _d3plot_extract_skin(block, 4 * 4 * 4, NULL, 0, 1);
+  REQUIRE(skin.num_faces == 6 * 4 * 4);
+  CHECK(skin.num_nodes == 5 * 5 * 5 - 3 * 3 * 3);
+  for (size_t num_ranges = 2; num_ranges <= 5; num_ranges++) {
+    d3plot_skin ranged_skin =
+        _d3plot_extract_skin(block, 4 * 4 * 4, NULL, 0, num_ranges);
+    REQUIRE(ranged_skin.num_faces == skin.num_faces);
+    REQUIRE(ranged_skin.num_nodes == skin.num_nodes);
+    for (size_t i = 0; i < skin.num_faces * 4; i++) {
+      CHECK(ranged_skin.faces[i] == skin.faces[i]);
+    }
+    for (size_t i = 0; i < skin.num_faces; i++) {
+      CHECK(ranged_skin.face_elements[i] == skin.face_elements[i]);
+    }
+    d3plot_free_skin(&ranged_skin);
+  }
+  d3plot_free_skin(&skin);
+
+  /* The faces between the solids and the thick shell are in different
+   * ranges*/
+  skin = _d3plot_extract_skin(solids, 2, thick_shells, 1, 3);
+  CHECK(skin.num_faces == 5 + 4 + 5);
+  CHECK(skin.num_nodes == 16);
+  d3plot_free_skin(&skin);
+}
+
+TEST_CASE("_d3plot_part_titles_match") {
+  CHECK(_d3plot_part_titles_match("Pouch", "Pouch", 0));
+  CHECK(!_d3plot_part_titles_match("Pouch", "Pouch_Fold", 0));
+  CHECK(_d3plot_part_titles_match("Pouch*", "Pouch_Fold", 0));
+  CHECK(_d3plot_part_titles_match("Pouch*", "Pouch", 0));
+  CHECK(_d3plot_part_titles_match("*_Fold", "Pouch_Fold", 0));
+  CHECK(_d3plot_part_titles_match("P?uch", "Pouch", 0));
+  CHECK(!_d3plot_part_titles_match("P?uch", "Puch", 0));
+  CHECK(_d3plot_part_titles_match("*l*l*l*l*", "Jellyroll", 0));
+  CHECK(!_d3plot_part_titles_match("*l*l*l*l*l*", "Jellyroll", 0));
+  CHECK(!_d3plot_part_titles_match("pouch", "Pouch", 0));
+  CHECK(_d3plot_part_titles_match("pOUCH", "Pouch", 1));
+  CHECK(_d3plot_part_titles_match("*", "", 0));
+  CHECK(!_d3plot_part_titles_match("?", "", 0));
+}
+
+TEST_CASE("d3plot_compute_derived") {
+  d3plot_solid solids[4];
+  memset(solids, 0, sizeof(solids));
+  /* Uniaxial tension*/
+  solids[0].stress.x = 100.0;
+  /* Pure shear*/
+  solids[1].stress.xy = 50.0;
+  /* Hydrostatic compression*/
+  solids[2].stress.x = -10.0;
+  solids[2].stress.y = -10.0;
+  solids[2].stress.z = -10.0;
+  /* Arbitrary*/
+  solids[3].stress.x = 12.0;
+  solids[3].stress.y = -3.0;
+  solids[3].stress.z = 7.0;
+  solids[3].stress.xy = 4.0;
+  solids[3].stress.yz = -2.0;
+  solids[3].stress.zx = 5.0;
+
+  double values[D3PLOT_DERIVED_COUNT][4];
+  double *outputs[D3PLOT_DERIVED_COUNT];
+  int q = 0;
+  while (q < D3PLOT_DERIVED_COUNT) {
+    outputs[q] = values[q];
+    q++;
+  }
+  d3plot_compute_derived(&solids[0].stress, sizeof(d3plot_solid), 4, outputs);
+
+  CHECK(values[D3PLOT_DERIVED_VON_MISES][0] == doctest::Approx(100.0));
+  CHECK(values[D3PLOT_DERIVED_PRESSURE][0] == doctest::Approx(-100.0 / 3.0));
+  CHECK(values[D3PLOT_DERIVED_MAX_PRINCIPAL][0] == doctest::Approx(100.0));
+  CHECK(values[D3PLOT_DERIVED_MID_PRINCIPAL][0] == doctest::Approx(0.0));
+  CHECK(values[D3PLOT_DERIVED_MIN_PRINCIPAL][0] == doctest::Approx(0.0));
+  CHECK(values[D3PLOT_DERIVED_MAX_SHEAR][0] == doctest::Approx(50.0));
+  CHECK(values[D3PLOT_DERIVED_TRIAXIALITY][0] == doctest::Approx(1.0 / 3.0));
+
+  CHECK(values[D3PLOT_DERIVED_VON_MISES][1] ==
+        doctest::Approx(50.0 * sqrt(3.0)));
+  CHECK(values[D3PLOT_DERIVED_MAX_PRINCIPAL][1] == doctest::Approx(50.0));
+  CHECK(values[D3PLOT_DERIVED_MIN_PRINCIPAL][1] == doctest::Approx(-50.0));
+  CHECK(values[D3PLOT_DERIVED_MAX_SHEAR][1] == doctest::Approx(50.0));
+  CHECK(values[D3PLOT_DERIVED_TRIAXIALITY][1] == doctest::Approx(0.0));
+
+  CHECK(values[D3PLOT_DERIVED_VON_MISES][2] == doctest::Approx(0.0));
+  CHECK(values[D3PLOT_DERIVED_PRESSURE][2] == doctest::Approx(10.0));
+  CHECK(values[D3PLOT_DERIVED_MAX_PRINCIPAL][2] == doctest::Approx(-10.0));
+  CHECK(values[D3PLOT_DERIVED_MIN_PRINCIPAL][2] == doctest::Approx(-10.0));
+  CHECK(values[D3PLOT_DERIVED_TRIAXIALITY][2] == 0.0);
+
+  /* The principal values need to be the roots of the characteristic
+   * polynomial and keep the trace*/
+  const d3plot_tensor &t = solids[3].stress;
+  const double i1 = t.x + t.y + t.z;
+  const double i2 = t.x * t.y + t.y * t.z + t.z * t.x - t.xy * t.xy -
+                    t.yz * t.yz - t.zx * t.zx;
+  const double i3 = t.x * (t.y * t.z - t.yz * t.yz) -
+                    t.xy * (t.xy * t.z - t.yz * t.zx) +
+                    t.zx * (t.xy * t.yz - t.y * t.zx);
+  q = D3PLOT_DERIVED_MAX_PRINCIPAL;
+  while (q <= D3PLOT_DERIVED_MIN_PRINCIPAL) {
+    const double l = values[q][3];
+    CHECK(fabs(l * l * l - i1 * l * l + i2 * l - i3) < 1e-9 * fabs(i3));
+    q++;
+  }
+  CHECK(values[D3PLOT_DERIVED_MAX_PRINCIPAL][3] >=
+        values[D3PLOT_DERIVED_MID_PRINCIPAL][3]);
+  CHECK(values[D3PLOT_DERIVED_MID_PRINCIPAL][3] >=
+        values[D3PLOT_DERIVED_MIN_PRINCIPAL][3]);
+  CHECK(values[D3PLOT_DERIVED_MAX_PRINCIPAL][3] +
+            values[D3PLOT_DERIVED_MID_PRINCIPAL][3] +
+            values[D3PLOT_DERIVED_MIN_PRINCIPAL][3] ==
+        doctest::Approx(i1));
+
+  /* The same tensors as separate component arrays*/
+  double components[6][4];
+  size_t i = 0;
+  while (i < 4) {
+    components[0][i] = solids[i].stress.x;
+    components[1][i] = solids[i].stress.y;
+    components[2][i] = solids[i].stress.z;
+    components[3][i] = solids[i].stress.xy;
+    components[4][i] = solids[i].stress.yz;
+    components[5][i] = solids[i].stress.zx;
+    i++;
+  }
+  const double *component_ptrs[6] = {components[0], components[1],
+                                     components[2], components[3],
+                                     components[4], components[5]};
+  double von_mises[4];
+  double *soa_outputs[D3PLOT_DERIVED_COUNT] = {NULL};
+  soa_outputs[D3PLOT_DERIVED_VON_MISES] = von_mises;
+  d3plot_compute_derived_soa(component_ptrs, 4, soa_outputs);
+  i = 0;
+  while (i < 4) {
+    CHECK(von_mises[i] == values[D3PLOT_DERIVED_VON_MISES][i]);
+    CHECK(d3plot_tensor_derived(&solids[i].stress,
+                                D3PLOT_DERIVED_MIN_PRINCIPAL) ==
+          values[D3PLOT_DERIVED_MIN_PRINCIPAL][i]);
+    i++;
+  }
+
+  /* More tensors than fit into one block, with only the quantities requested
+   * which depend on unrequested intermediate values*/
+  d3plot_tensor many[600];
+  i = 0;
+  while (i < 600) {
+    many[i] = solids[i % 4].stress;
+    many[i].x += (double)i;
+    i++;
+  }
+  double triaxiality[600], max_shear_values[600];
+  double *partial_outputs[D3PLOT_DERIVED_COUNT] = {NULL};
+  partial_outputs[D3PLOT_DERIVED_TRIAXIALITY] = triaxiality;
+  partial_outputs[D3PLOT_DERIVED_MAX_SHEAR] = max_shear_values;
+  d3plot_compute_derived(many, sizeof(d3plot_tensor), 600, partial_outputs);
+  i = 0;
+  while (i < 600) {
+    CHECK(triaxiality[i] ==
+          d3plot_tensor_derived(&many[i], D3PLOT_DERIVED_TRIAXIALITY));
+    CHECK(max_shear_values[i] ==
+          d3plot_tensor_derived(&many[i], D3PLOT_DERIVED_MAX_SHEAR));
+    i++;
+  }
+
+  const dro::Array<d3plot_solid> solid_array(solids, 4, false);
+  const auto max_shear =
+      dro::compute_derived(solid_array, dro::DerivedQuantity::MaxShear);
+  REQUIRE(max_shear.size() == 4);
+  CHECK(max_shear[1] == doctest::Approx(50.0));
+}
+
+TEST_CASE("d3plot_combine_reductions") {
+  double values[4] = {1.0, -5.0, 3.0, 0.0};
+  size_t states[4] = {0, 0, 0, 0};
+  d3plot_reduction reduction;
+  reduction.num_elements = 4;
+  reduction.values = values;
+  reduction.states = states;
+
+  double other_values[4] = {2.0, 4.0, 3.0, -1.0};
+  size_t other_states[4] = {1, 2, 1, 3};
+  d3plot_reduction other;
+  other.num_elements = 4;
+  other.values = other_values;
+  other.states = other_states;
+
+  REQUIRE(d3plot_combine_reductions(&reduction, &other, D3PLOT_REDUCE_ABS_MAX));
+  CHECK(values[0] == 2.0);
+  CHECK(states[0] == 1);
+  CHECK(values[1] == -5.0);
+  CHECK(states[1] == 0);
+  /* The first state wins if the values are equal*/
+  CHECK(values[2] == 3.0);
+  CHECK(states[2] == 0);
+  CHECK(values[3] == -1.0);
+  CHECK(states[3] == 3);
+
+  REQUIRE(d3plot_combine_reductions(&reduction, &other, D3PLOT_REDUCE_MIN));
+  CHECK(values[0] == 2.0);
+  CHECK(values[1] == -5.0);
+  CHECK(values[3] == -1.0);
+
+  REQUIRE(d3plot_combine_reductions(&reduction, &other, D3PLOT_REDUCE_LAST));
+  CHECK(values[1] == 4.0);
+  CHECK(states[1] == 2);
+
+  other.num_elements = 3;
+  CHECK(!d3plot_combine_reductions(&reduction, &other, D3PLOT_REDUCE_MAX));
+}
+
+TEST_CASE("d3plot_get_shells_layer") {
+  d3plot_shell shells[2];
+  memset(shells, 0, sizeof(shells));
+  d3plot_surface add_ips[2][2];
+  memset(add_ips, 0, sizeof(add_ips));
+  double history[2][5][2];
+
+  size_t i = 0;
+  while (i < 2) {
+    shells[i].add_ips = add_ips[i];
+    shells[i].num_additional_integration_points = 2;
+    shells[i].num_history_variables = 2;
+
+    d3plot_surface *ips[5] = {&shells[i].mid, &shells[i].inner,
+                              &shells[i].outer, &add_ips[i][0],
+                              &add_ips[i][1]};
+    size_t ip = 0;
+    while (ip < 5) {
+      /* Mid: 0, inner: 1, outer: -6, add_ips: 3, 4 (times i+1)*/
+      const double value = (ip == 2 ? -6.0 : (double)ip) * (double)(i + 1);
+      ips[ip]->stress.x = value;
+      ips[ip]->stress.zx = -value;
+      ips[ip]->effective_plastic_strain = value * 0.5;
+      history[i][ip][0] = value;
+      history[i][ip][1] = 10.0 * value;
+      ips[ip]->history_variables = history[i][ip];
+      ip++;
+    }
+    i++;
+  }
+
+  d3plot_surfaces surfaces = d3plot_alloc_surfaces(2, 2);
+  REQUIRE(d3plot_get_shells_layer(shells, 2, D3PLOT_SHELL_SURFACE_OUTER,
+                                  &surfaces));
+  CHECK(surfaces.stress[0][0] == -6.0);
+  CHECK(surfaces.stress[0][1] == -12.0);
+  CHECK(surfaces.stress[5][1] == 12.0);
+  CHECK(surfaces.history_variables[2 + 1] == -120.0);
+
+  REQUIRE(d3plot_get_shells_layer(shells, 2, D3PLOT_SHELL_SURFACE_MEAN,
+                                  &surfaces));
+  CHECK(surfaces.stress[0][0] == doctest::Approx(2.0 / 5.0));
+  CHECK(surfaces.stress[0][1] == doctest::Approx(4.0 / 5.0));
+  CHECK(surfaces.stress[1][0] == 0.0);
+  CHECK(surfaces.effective_plastic_strain[1] == doctest::Approx(2.0 / 5.0));
+  CHECK(surfaces.history_variables[2 + 0] == doctest::Approx(20.0 / 5.0));
+
+  /* Has to be the same as the mean of a single shell*/
+  d3plot_surface mean = d3plot_get_shell_mean(&shells[1]);
+  CHECK(surfaces.stress[5][1] == doctest::Approx(mean.stress.zx));
+  CHECK(surfaces.history_variables[2 + 1] ==
+        doctest::Approx(mean.history_variables[1]));
+  d3plot_free_surface(mean);
+
+  REQUIRE(d3plot_get_shells_layer(shells, 2, D3PLOT_SHELL_SURFACE_ABS_MAX,
+                                  &surfaces));
+  CHECK(surfaces.stress[0][0] == -6.0);
+  CHECK(surfaces.stress[5][0] == 6.0);
+  CHECK(surfaces.effective_plastic_strain[1] == -6.0);
+  CHECK(surfaces.history_variables[2 + 1] == -120.0);
+
+  /* The largest component of the inner integration point does not matter,
+   * since the outer one has the larger von Mises stress*/
+  shells[0].inner.stress.y = 9.0;
+  REQUIRE(d3plot_get_shells_layer(shells, 2, D3PLOT_SHELL_SURFACE_ABS_MAX,
+                                  &surfaces));
+  CHECK(surfaces.stress[0][0] == -6.0);
+  CHECK(surfaces.stress[1][0] == 0.0);
+  CHECK(surfaces.stress[5][0] == 6.0);
+  shells[0].inner.stress.y = 13.0;
+  REQUIRE(d3plot_get_shells_layer(shells, 2, D3PLOT_SHELL_SURFACE_ABS_MAX,
+                                  &surfaces));
+  CHECK(surfaces.stress[0][0] == 1.0);
+  CHECK(surfaces.stress[1][0] == 13.0);
+  CHECK(surfaces.stress[5][0] == -1.0);
+  CHECK(surfaces.effective_plastic_strain[0] == 0.5);
+  shells[0].inner.stress.y = 0.0;
+
+  CHECK(!d3plot_get_shells_layer(shells, 2, 5, &surfaces));
+  CHECK(!d3plot_get_shells_layer(shells, 3, D3PLOT_SHELL_SURFACE_MID,
+                                 &surfaces));
+  d3plot_free_surfaces(&surfaces);
+  CHECK(surfaces.num_surfaces == 0);
+
+  const dro::Array<dro::D3plotShell> shell_array(
+      static_cast<dro::D3plotShell *>(&shells[0]), 2, false);
+  const auto layer =
+      dro::get_shells_layer(shell_array, dro::ShellSurface::Inner);
+  REQUIRE(layer.size() == 2);
+  CHECK(layer.get_stress(0)[1] == 2.0);
+  CHECK(layer.get_history_variables(1)[0] == 10.0);
+  const auto von_mises = dro::compute_derived(
+      shell_array, dro::DerivedQuantity::VonMises, dro::ShellSurface::AbsMax);
+  REQUIRE(von_mises.size() == 2);
+  CHECK(von_mises[0] == doctest::Approx(sqrt(36.0 + 3.0 * 36.0)));
+}
+
+TEST_CASE("_d3plot_read_rigid_walls") {
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.control_data.nummat4 = 1;
+  /* KE, IE, TE, X, Y, Z, 7 material values and two rigid walls*/
+  double globals[2][6 + 7 + 8];
+  size_t i = 0;
+  while (i < 2 * (6 + 7 + 8)) {
+    (&globals[0][0])[i] = (double)i;
+    i++;
+  }
+  plot_file.state_globals = &globals[0][0];
+  plot_file.num_states = 2;
+
+  /* Older versions only write the forces*/
+  plot_file.control_data.version = 960.0;
+  plot_file.control_data.nglbv = 6 + 7 + 2;
+  size_t words_per_wall;
+  CHECK(_d3plot_num_rigid_walls(&plot_file, &words_per_wall) == 2);
+  CHECK(words_per_wall == 1);
+  d3plot_rigid_wall rigid_walls[2];
+  _d3plot_read_rigid_walls(&plot_file, 1, rigid_walls);
+  CHECK(rigid_walls[0].force == 15.0 + 13.0);
+  CHECK(rigid_walls[1].force == 15.0 + 14.0);
+  CHECK(rigid_walls[1].position_x == 0.0);
+
+  /* Newer versions also write the positions*/
+  plot_file.control_data.version = 971.0;
+  plot_file.control_data.nglbv = 6 + 7 + 8;
+  CHECK(_d3plot_num_rigid_walls(&plot_file, &words_per_wall) == 2);
+  CHECK(words_per_wall == 4);
+  _d3plot_read_rigid_walls(&plot_file, 1, rigid_walls);
+  CHECK(rigid_walls[0].force == 21.0 + 13.0);
+  CHECK(rigid_walls[1].force == 21.0 + 14.0);
+  CHECK(rigid_walls[0].position_x == 21.0 + 15.0);
+  CHECK(rigid_walls[1].position_x == 21.0 + 18.0);
+  CHECK(rigid_walls[1].position_z == 21.0 + 20.0);
+
+  /* No rigid walls*/
+  plot_file.control_data.nglbv = 6 + 7;
+  CHECK(_d3plot_num_rigid_walls(&plot_file, NULL) == 0);
+}
+
+TEST_CASE("d3plot_find_time_interval") {
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  size_t state;
+  double weight;
+  CHECK(d3plot_find_time_interval(&plot_file, 1.0, &state, &weight) == 0);
+
+  double times[] = {0.0, 1.0, 2.0, 2.0, 4.0};
+  plot_file.state_times = times;
+  plot_file.num_states = 5;
+
+  REQUIRE(d3plot_find_time_interval(&plot_file, -1.0, &state, &weight));
+  CHECK(state == 0);
+  CHECK(weight == 0.0);
+  REQUIRE(d3plot_find_time_interval(&plot_file, 0.25, &state, &weight));
+  CHECK(state == 0);
+  CHECK(weight == 0.25);
+  REQUIRE(d3plot_find_time_interval(&plot_file, 1.0, &state, &weight));
+  CHECK(state == 1);
+  CHECK(weight == 0.0);
+  REQUIRE(d3plot_find_time_interval(&plot_file, 3.0, &state, &weight));
+  CHECK(state == 3);
+  CHECK(weight == 0.5);
+  REQUIRE(d3plot_find_time_interval(&plot_file, 5.0, &state, &weight));
+  CHECK(state == 4);
+  CHECK(weight == 0.0);
+
+  const double a[] = {1.0, -2.0, 3.0};
+  const double b[] = {3.0, 2.0, 3.0};
+  double values[3];
+  _d3plot_lerp(a, b, 0.25, 3, values);
+  CHECK(values[0] == 1.5);
+  CHECK(values[1] == -1.0);
+  CHECK(values[2] == 3.0);
+}
+
+TEST_CASE("d3plot_alloc_beams") {
+  d3plot_beams beams = d3plot_alloc_beams(3, 2, 4, 1);
+  CHECK(beams.num_beams == 3);
+  CHECK(beams.resultants[1] == beams.resultants[0] + 3);
+  CHECK(beams.history_average == beams.resultants[5] + 3);
+  CHECK(beams.history_min == beams.history_average + 3 * 4);
+  CHECK(beams.history_max == beams.history_min + 3 * 4);
+  CHECK(beams.ip_values[0] == beams.history_max + 3 * 4);
+  CHECK(beams.ip_values[4] == beams.ip_values[0] + 4 * 3 * 2);
+  CHECK(beams.ip_history_variables == beams.ip_values[4] + 3 * 2);
+  /* The words of NV1D = 6 + 5*2 + 4*(3+2) = 36 per beam follow*/
+  CHECK(beams.words == beams.ip_history_variables + 3 * 2 * 4);
+  d3plot_free_beams(&beams);
+  CHECK(beams.resultants[0] == NULL);
+
+  /* Only the resultants and the history average, min and max*/
+  beams = d3plot_alloc_beams(3, 2, 4, 0);
+  CHECK(beams.ip_values[0] == NULL);
+  CHECK(beams.ip_history_variables == NULL);
+  CHECK(beams.words == beams.history_max + 3 * 4);
+  d3plot_free_beams(&beams);
+}
+
+TEST_CASE("d3plot_part_get_node_ids2") {
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.control_data.numnp = 8;
+
+  /* The second shell references nodes which are not in node_ids*/
+  d3plot_shell_con shell_cons[2];
+  memset(shell_cons, 0, sizeof(shell_cons));
+  d3_word j = 0;
+  while (j < 4) {
+    shell_cons[0].node_indices[j] = 3 - j;
+    shell_cons[1].node_indices[j] = 2 + 2 * j;
+    j++;
+  }
+
+  size_t shell_indices[] = {0, 1};
+  d3plot_part part;
+  memset(&part, 0, sizeof(part));
+  part.shell_indices = shell_indices;
+  part.num_shells = 2;
+
+  const d3_word node_ids[] = {10, 20, 30, 40, 50};
+  size_t num_part_node_ids;
+  d3_word *part_node_ids = d3plot_part_get_node_ids2(
+      &plot_file, &part, &num_part_node_ids, node_ids, 5, NULL, 0, NULL, 0,
+      NULL, 2, NULL, 0, NULL, NULL, shell_cons, NULL);
+  CHECK(plot_file.error_string == NULL);
+  /* The node index 6 does not have an id and 8 is out of bounds*/
+  REQUIRE(num_part_node_ids == 5);
+  CHECK(part_node_ids[0] == 10);
+  CHECK(part_node_ids[1] == 20);
+  CHECK(part_node_ids[2] == 30);
+  CHECK(part_node_ids[3] == 40);
+  CHECK(part_node_ids[4] == 50);
+  free(part_node_ids);
+}
+
+TEST_CASE("d3plot_read_solid_extra_nodes") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_extra_nodes")) {
+    fs::create_directories("test_data/d3plot_extra_nodes");
+  }
+
+  /* A header from which the word size can be determined, followed by the
+   * EXTRA NODE CONNECTIVITY of two ten node solids. The file is large enough
+   * to also read the header as 64 bit words*/
+  {
+    FILE *file = fopen("test_data/d3plot_extra_nodes/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[2 * 23];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 4;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+    data[19] = 1;  /* IT*/
+    data[23] = 5;
+    data[24] = 6;
+    data[25] = 7;
+    data[26] = 8;
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_extra_nodes/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.nel8 = 2;
+  plot_file.control_data.has_solid_extra_nodes = 1;
+
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  CHECK(_d3plot_read_extra_node_connectivity(&plot_file, &d3_ptr) == 1);
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(plot_file.error_string == NULL);
+  CHECK(plot_file.data_pointers[D3PLT_PTR_EL8_EXTRA_NODES] == 23);
+
+  size_t num_solids;
+  d3_word *extra_nodes =
+      d3plot_read_solid_extra_nodes(&plot_file, &num_solids);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_solids == 2);
+  /* The node indices start at 0*/
+  CHECK(extra_nodes[0] == 4);
+  CHECK(extra_nodes[1] == 5);
+  CHECK(extra_nodes[2] == 6);
+  CHECK(extra_nodes[3] == 7);
+  free(extra_nodes);
+
+  free(plot_file.data_pointers);
+  d3_buffer_close(&plot_file.buffer);
+}
+
+TEST_CASE("d3plot_read_packed_connectivity") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_packed")) {
+    fs::create_directories("test_data/d3plot_packed");
+  }
+
+  /* A header from which the word size can be determined, followed by the
+   * GEOMETRY DATA of one node, one solid, one thick shell, one beam and one
+   * shell with two values packed into every word of the connectivity*/
+  {
+    FILE *file = fopen("test_data/d3plot_packed/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[2 * 23];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 3;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+    const auto pack = [](uint32_t first, uint32_t second) {
+      return first | (second << 16);
+    };
+    /* Solid: nodes 1 to 8, material 2*/
+    data[26] = pack(1, 2);
+    data[27] = pack(3, 4);
+    data[28] = pack(5, 6);
+    data[29] = pack(7, 8);
+    data[30] = pack(2, 0);
+    /* Thick shell: nodes 8 to 1, material 3*/
+    data[31] = pack(8, 7);
+    data[32] = pack(6, 5);
+    data[33] = pack(4, 3);
+    data[34] = pack(2, 1);
+    data[35] = pack(3, 0);
+    /* Beam: nodes 1 and 2, orientation node 3, material 4*/
+    data[36] = pack(1, 2);
+    data[37] = pack(3, 0);
+    data[38] = pack(0, 4);
+    /* Shell: nodes 5 to 8, material 1*/
+    data[39] = pack(5, 6);
+    data[40] = pack(7, 8);
+    data[41] = pack(1, 0);
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_packed/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.ndim = 3;
+  plot_file.control_data.element_connectivity_packed = 1;
+  plot_file.control_data.numnp = 1;
+  plot_file.control_data.nel8 = 1;
+  plot_file.control_data.nelt = 1;
+  plot_file.control_data.nel2 = 1;
+  plot_file.control_data.nel4 = 1;
+
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  CHECK(_d3plot_read_geometry_data(&plot_file, &d3_ptr) == 1);
+  CHECK(plot_file.error_string == NULL);
+  CHECK(d3_ptr.cur_word == 42);
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(plot_file.data_pointers[D3PLT_PTR_EL8_CONNECT] == 26);
+  CHECK(plot_file.data_pointers[D3PLT_PTR_ELT_CONNECT] == 31);
+  CHECK(plot_file.data_pointers[D3PLT_PTR_EL2_CONNECT] == 36);
+  CHECK(plot_file.data_pointers[D3PLT_PTR_EL4_CONNECT] == 39);
+
+  /* The node and material indices start at 0*/
+  size_t num_elements;
+  d3plot_solid_con *solids =
+      d3plot_read_solid_elements(&plot_file, &num_elements);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_elements == 1);
+  for (size_t i = 0; i < 8; i++) {
+    CHECK(solids[0].node_indices[i] == i);
+  }
+  CHECK(solids[0].material_index == 1);
+  free(solids);
+
+  d3plot_thick_shell_con *thick_shells =
+      d3plot_read_thick_shell_elements(&plot_file, &num_elements);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_elements == 1);
+  for (size_t i = 0; i < 8; i++) {
+    CHECK(thick_shells[0].node_indices[i] == 7 - i);
+  }
+  CHECK(thick_shells[0].material_index == 2);
+  free(thick_shells);
+
+  d3plot_beam_con *beams = d3plot_read_beam_elements(&plot_file, &num_elements);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_elements == 1);
+  CHECK(beams[0].node_indices[0] == 0);
+  CHECK(beams[0].node_indices[1] == 1);
+  CHECK(beams[0].orientation_node_index == 2);
+  CHECK(beams[0].material_index == 3);
+  free(beams);
+
+  d3plot_shell_con *shells =
+      d3plot_read_shell_elements(&plot_file, &num_elements);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_elements == 1);
+  CHECK(shells[0].node_indices[0] == 4);
+  CHECK(shells[0].node_indices[1] == 5);
+  CHECK(shells[0].node_indices[2] == 6);
+  CHECK(shells[0].node_indices[3] == 7);
+  CHECK(shells[0].material_index == 0);
+  free(shells);
+
+  free(plot_file.data_pointers);
+  d3_buffer_close(&plot_file.buffer);
+}
+
+TEST_CASE("d3plot_read_node_temperature") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_temperatures")) {
+    fs::create_directories("test_data/d3plot_temperatures");
+  }
+
+  /* A header from which the word size can be determined, followed by two
+   * states of three nodes with temperatures, fluxes (IT=2) and coordinates.
+   * The temperature of node n at state s is 100*s+n and its flux is -n*/
+  const size_t words_per_state = 1 + 3 * (1 + 3 + 3);
+  {
+    FILE *file = fopen("test_data/d3plot_temperatures/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[23 + 2 * words_per_state + 1];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 4;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+    data[19] = 2;  /* IT*/
+
+    float *state = (float *)&data[23];
+    size_t s = 0;
+    while (s < 2) {
+      state[0] = (float)s; /* TIME*/
+      size_t n = 0;
+      while (n < 3) {
+        state[1 + n] = (float)(100 * s + n);
+        state[1 + 3 + 3 * n] = -(float)n;
+        state[1 + 3 + 3 * n + 1] = -(float)n;
+        state[1 + 3 + 3 * n + 2] = -(float)n;
+        state[1 + 3 + 9 + 3 * n] = 1000.0f;
+        n++;
+      }
+      state += words_per_state;
+      s++;
+    }
+    *state = (float)D3_EOF;
+
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_temperatures/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.numnp = 3;
+  plot_file.control_data.ndim = 3;
+  plot_file.control_data.it = 2;
+  plot_file.control_data.num_temperatures = 1;
+  plot_file.control_data.num_fluxes = 3;
+  plot_file.control_data.iu = 1;
+
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  int result = 1;
+  while (result == 1) {
+    result = _d3plot_read_state_data(&plot_file, &d3_ptr);
+  }
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(result == 2);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(plot_file.num_states == 2);
+
+  size_t num_nodes;
+  double *temperatures =
+      d3plot_read_node_temperature(&plot_file, 1, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  CHECK(temperatures[0] == 100.0);
+  CHECK(temperatures[1] == 101.0);
+  CHECK(temperatures[2] == 102.0);
+  free(temperatures);
+
+  const size_t node_indices[] = {2, 0};
+  temperatures = d3plot_read_node_temperature_range(
+      &plot_file, 0, 2, node_indices, 2, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 2);
+  CHECK(temperatures[0] == 2.0);
+  CHECK(temperatures[1] == 0.0);
+  CHECK(temperatures[2] == 102.0);
+  CHECK(temperatures[3] == 100.0);
+  free(temperatures);
+
+  double *fluxes = d3plot_read_node_flux(&plot_file, 0, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  CHECK(fluxes[2 * 3] == -2.0);
+  CHECK(fluxes[2 * 3 + 2] == -2.0);
+  free(fluxes);
+
+  /* The coordinates follow the thermal data*/
+  double *coords = d3plot_read_node_coordinates(&plot_file, 1, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  CHECK(coords[3] == 1000.0);
+  CHECK(coords[4] == 0.0);
+  free(coords);
+
+  CHECK(d3plot_read_node_temperature(&plot_file, 2, &num_nodes) == NULL);
+  CHECK(plot_file.error_string != NULL);
+  CHECK(num_nodes == 0);
+
+  free(plot_file.error_string);
+  free(plot_file.state_times);
+  free(plot_file.data_pointers);
+  d3_buffer_close(&plot_file.buffer);
+}
+
+TEST_CASE("d3plot_read_node_displacement") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_displacements")) {
+    fs::create_directories("test_data/d3plot_displacements");
+  }
+
+  /* A header from which the word size can be determined, followed by the
+   * coordinates of three nodes and two states with their coordinates. The
+   * initial coordinates of node n are (n+0.5, 2n, -n) and its displacement at
+   * state s is (s+1)*(n+1, -n, 0.25)*/
+  const size_t words_per_state = 1 + 3 * 3;
+  {
+    FILE *file = fopen("test_data/d3plot_displacements/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[23 + 3 * 3 + 2 * words_per_state + 1];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 4;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+
+    float *coords = (float *)&data[23];
+    size_t n = 0;
+    while (n < 3) {
+      coords[n * 3 + 0] = (float)n + 0.5f;
+      coords[n * 3 + 1] = 2.0f * (float)n;
+      coords[n * 3 + 2] = -(float)n;
+      n++;
+    }
+
+    float *state = &coords[3 * 3];
+    size_t s = 0;
+    while (s < 2) {
+      const float f = (float)(s + 1);
+      state[0] = (float)s; /* TIME*/
+      n = 0;
+      while (n < 3) {
+        state[1 + n * 3 + 0] = coords[n * 3 + 0] + f * ((float)n + 1.0f);
+        state[1 + n * 3 + 1] = coords[n * 3 + 1] - f * (float)n;
+        state[1 + n * 3 + 2] = coords[n * 3 + 2] + f * 0.25f;
+        n++;
+      }
+      state += words_per_state;
+      s++;
+    }
+    *state = (float)D3_EOF;
+
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_displacements/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  REQUIRE(plot_file.buffer.word_size == 4);
+#ifndef NO_THREAD_SAFETY
+  plot_file.initial_node_coords_mutex = sync_create();
+#endif
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.numnp = 3;
+  plot_file.control_data.ndim = 3;
+  plot_file.control_data.iu = 1;
+
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  CHECK(_d3plot_read_geometry_data(&plot_file, &d3_ptr) == 1);
+  int result = 1;
+  while (result == 1) {
+    result = _d3plot_read_state_data(&plot_file, &d3_ptr);
+  }
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(result == 2);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(plot_file.num_states == 2);
+
+  /* The states hold the coordinates, from which the initial ones are
+   * subtracted*/
+  size_t num_nodes;
+  double *displacements =
+      d3plot_read_node_displacement(&plot_file, 1, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  size_t n = 0;
+  while (n < 3) {
+    CHECK(displacements[n * 3 + 0] == 2.0 * ((double)n + 1.0));
+    CHECK(displacements[n * 3 + 1] == -2.0 * (double)n);
+    CHECK(displacements[n * 3 + 2] == 0.5);
+    n++;
+  }
+  free(displacements);
+
+  const size_t node_indices[] = {2, 0};
+  displacements = d3plot_read_node_displacement_range(
+      &plot_file, 0, 2, node_indices, 2, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 2);
+  CHECK(displacements[0] == 3.0);
+  CHECK(displacements[1] == -2.0);
+  CHECK(displacements[3] == 1.0);
+  CHECK(displacements[4] == 0.0);
+  CHECK(displacements[6] == 6.0);
+  CHECK(displacements[7] == -4.0);
+  CHECK(displacements[11] == 0.5);
+  free(displacements);
+
+  /* The mean displacement of node 0 and 2 at state 0 is (2, -1, 0.25), which
+   * is the displacement of node 1*/
+  displacements = d3plot_read_node_relative_displacement(
+      &plot_file, 0, NULL, 0, node_indices, 2, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  CHECK(displacements[0] == -1.0);
+  CHECK(displacements[1] == 1.0);
+  CHECK(displacements[2] == 0.0);
+  CHECK(displacements[3] == 0.0);
+  CHECK(displacements[4] == 0.0);
+  CHECK(displacements[5] == 0.0);
+  CHECK(displacements[6] == 1.0);
+  CHECK(displacements[7] == -1.0);
+  CHECK(displacements[8] == 0.0);
+  free(displacements);
+
+  /* With IU == 2 the states already hold the displacements and the initial
+   * coordinates are added to get the coordinates*/
+  plot_file.control_data.iu = 2;
+  displacements = d3plot_read_node_displacement(&plot_file, 0, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  double *coords = d3plot_read_node_coordinates(&plot_file, 0, &num_nodes);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(num_nodes == 3);
+  CHECK(displacements[3] == 1.5 + 2.0);
+  CHECK(displacements[4] == 2.0 - 1.0);
+  CHECK(displacements[5] == -1.0 + 0.25);
+  CHECK(coords[3] == displacements[3] + 1.5);
+  CHECK(coords[4] == displacements[4] + 2.0);
+  CHECK(coords[5] == displacements[5] - 1.0);
+  free(coords);
+  free(displacements);
+
+  free(plot_file.initial_node_coords);
+  free(plot_file.initial_node_coords_32);
+  free(plot_file.state_times);
+  free(plot_file.data_pointers);
+#ifndef NO_THREAD_SAFETY
+  sync_destroy(&plot_file.initial_node_coords_mutex);
+#endif
+  d3_buffer_close(&plot_file.buffer);
+}
+
+TEST_CASE("d3plot_reduce_elements") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_reduce")) {
+    fs::create_directories("test_data/d3plot_reduce");
+  }
+
+  /* A header from which the word size can be determined, followed by five
+   * states of two solids with stresses and effective plastic strains*/
+  const float strains[2][5] = {{1.0f, 3.0f, 2.0f, 3.0f, 0.0f},
+                               {-1.0f, -4.0f, 2.0f, -4.0f, 1.0f}};
+  const size_t words_per_state = 1 + 2 * 7;
+  {
+    FILE *file = fopen("test_data/d3plot_reduce/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[23 + 5 * words_per_state + 1];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 4;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+
+    float *state = (float *)&data[23];
+    size_t s = 0;
+    while (s < 5) {
+      state[0] = (float)s; /* TIME*/
+      size_t e = 0;
+      while (e < 2) {
+        state[1 + e * 7] = (float)s; /* Sigma-x*/
+        state[1 + e * 7 + 6] = strains[e][s];
+        e++;
+      }
+      state += words_per_state;
+      s++;
+    }
+    *state = (float)D3_EOF;
+
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_reduce/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.ndim = 3;
+  plot_file.control_data.nel8 = 2;
+  plot_file.control_data.nv3d = 7;
+  plot_file.control_data.iosol[0] = 1;
+  plot_file.control_data.iosol[1] = 1;
+
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  int result = 1;
+  while (result == 1) {
+    result = _d3plot_read_state_data(&plot_file, &d3_ptr);
+  }
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(result == 2);
+  REQUIRE(plot_file.num_states == 5);
+
+  /* The states are split into 1 to 5 chunks, which all need to give the same
+   * results*/
+  size_t num_chunks = 1;
+  while (num_chunks <= 5) {
+    d3plot_reduction reduction = _d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_REDUCE_PLASTIC_STRAIN, 0,
+        D3PLOT_REDUCE_MAX, 0, 5, num_chunks);
+    CHECK(plot_file.error_string == NULL);
+    REQUIRE(reduction.num_elements == 2);
+    CHECK(reduction.values[0] == 3.0);
+    CHECK(reduction.states[0] == 1);
+    CHECK(reduction.values[1] == 2.0);
+    CHECK(reduction.states[1] == 2);
+    d3plot_free_reduction(&reduction);
+
+    reduction = _d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_REDUCE_PLASTIC_STRAIN, 0,
+        D3PLOT_REDUCE_ABS_MAX, 1, 4, num_chunks);
+    CHECK(plot_file.error_string == NULL);
+    REQUIRE(reduction.num_elements == 2);
+    CHECK(reduction.values[0] == 3.0);
+    CHECK(reduction.states[0] == 1);
+    CHECK(reduction.values[1] == -4.0);
+    CHECK(reduction.states[1] == 1);
+    d3plot_free_reduction(&reduction);
+
+    reduction = _d3plot_reduce_elements(
+        &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_DERIVED_VON_MISES, 0,
+        D3PLOT_REDUCE_LAST, 0, 5, num_chunks);
+    CHECK(plot_file.error_string == NULL);
+    REQUIRE(reduction.num_elements == 2);
+    CHECK(reduction.values[0] == doctest::Approx(4.0));
+    CHECK(reduction.states[1] == 4);
+    d3plot_free_reduction(&reduction);
+
+    num_chunks++;
+  }
+
+  d3plot_reduction reduction = d3plot_reduce_elements(
+      &plot_file, D3PLOT_ID_TYPE_SOLID, D3PLOT_REDUCE_PLASTIC_STRAIN, 0,
+      D3PLOT_REDUCE_MIN, 0, 5);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(reduction.num_elements == 2);
+  CHECK(reduction.values[0] == 0.0);
+  CHECK(reduction.states[0] == 4);
+  CHECK(reduction.values[1] == -4.0);
+  CHECK(reduction.states[1] == 1);
+  d3plot_free_reduction(&reduction);
+
+  reduction = d3plot_reduce_elements(&plot_file, D3PLOT_ID_TYPE_SOLID,
+                                     D3PLOT_REDUCE_PLASTIC_STRAIN, 0,
+                                     D3PLOT_REDUCE_MIN, 3, 5);
+  CHECK(plot_file.error_string != NULL);
+  CHECK(reduction.num_elements == 0);
+
+  free(plot_file.error_string);
+  free(plot_file.state_times);
+  free(plot_file.data_pointers);
+  d3_buffer_close(&plot_file.buffer);
+}
+
+TEST_CASE("_d3plot_read_state_data") {
+  // Create test data
+  if (!path_is_directory("test_data/d3plot_globals")) {
+    fs::create_directories("test_data/d3plot_globals");
+  }
+
+  /* A header from which the word size can be determined, followed by a state
+   * with the six global values*/
+  {
+    FILE *file = fopen("test_data/d3plot_globals/d3plot", "wb");
+    if (!file) {
+      FAIL("Couldn't create test file: ", strerror(errno));
+      return;
+    }
+    uint32_t data[2 * 23];
+    memset(data, 0, sizeof(data));
+    data[11] = 10; /* INUM*/
+    data[15] = 4;  /* NDIM*/
+    data[17] = 2;  /* ICODE*/
+    float *state = (float *)&data[23];
+    size_t i = 0;
+    while (i < 6) {
+      state[1 + i] = (float)i;
+      i++;
+    }
+    state[7] = (float)D3_EOF;
+    fwrite(data, sizeof(data), 1, file);
+    fclose(file);
+  }
+
+  d3plot_file plot_file;
+  memset(&plot_file, 0, sizeof(plot_file));
+  plot_file.buffer = d3_buffer_open("test_data/d3plot_globals/d3plot");
+  if (plot_file.buffer.error_string) {
+    FAIL(plot_file.buffer.error_string);
+    d3_buffer_close(&plot_file.buffer);
+    return;
+  }
+  plot_file.data_pointers = (size_t *)calloc(D3PLT_PTR_COUNT, sizeof(size_t));
+  plot_file.control_data.ndim = 3;
+  plot_file.control_data.nglbv = 6;
+
+  /* NGLBV is too small for the material values*/
+  plot_file.control_data.nummat4 = 1;
+  d3_pointer d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  CHECK(_d3plot_read_state_data(&plot_file, &d3_ptr) == 0);
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  REQUIRE(plot_file.error_string != NULL);
+  CHECK(std::string(plot_file.error_string) ==
+        "Size of GLOBAL is 13 instead of 6");
+  CHECK(plot_file.num_states == 0);
+  free(plot_file.error_string);
+  plot_file.error_string = NULL;
+
+  plot_file.control_data.nummat4 = 0;
+  d3_ptr = d3_buffer_seek(&plot_file.buffer, 23);
+  CHECK(_d3plot_read_state_data(&plot_file, &d3_ptr) == 1);
+  d3_pointer_close(&plot_file.buffer, &d3_ptr);
+  CHECK(plot_file.error_string == NULL);
+  REQUIRE(plot_file.num_states == 1);
+  CHECK(plot_file.state_globals[5] == 5.0);
+
+  free(plot_file.state_globals);
+  free(plot_file.state_times);
+  free(plot_file.data_pointers);
+  d3_buffer_close(&plot_file.buffer);
+}
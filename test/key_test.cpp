@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <sstream>
 #define DOCTEST_CONFIG_TREAT_CHAR_STAR_AS_STRING
+#include <cerrno>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <doctest/doctest.h>
@@ -33,6 +35,9 @@
 #include <include_transform.h>
 #include <iostream>
 #include <key.h>
+#include <key_incremental.h>
+#include <key_index.h>
+#include <key_mesh.h>
 #include <line.h>
 
 extern char *stralloc(const char *);
@@ -40,6 +45,7 @@ extern char *stralloc(const char *);
 #ifdef BUILD_CPP
 #include <include_transform.hpp>
 #include <key.hpp>
+#include <key_mesh.hpp>
 #endif
 
 extra_string extra_string_new(const char *str) {
@@ -701,6 +707,281 @@ TEST_CASE("card_parse_get_type") {
   CHECK(card_parse_get_type(&card) == CARD_PARSE_STRING);
 }
 
+/* The implementation of card_parse_float64_width before it got replaced by
+ * _parse_float64_field. Used as a reference in card_parse_float64*/
+double reference_card_parse_float64_width(const card_t *card,
+                                          uint8_t value_width) {
+  errno = 0;
+
+  double result = 0.0;
+  double fraction = 0.0;
+  double exponent = 1.0;
+  double sign = 1.0;
+  int has_integer = 0;
+  int has_fraction = 0;
+  int has_exponent = 0;
+  int exponent_sign = 1;
+  int exponent_value = 0;
+
+  uint8_t i = card->current_index;
+  /* Loop until leading whitespace is trimmed*/
+  while (i < card->current_index + value_width && card->string[i] == ' ') {
+    i++;
+  }
+
+  /* The string is completely empty or just spaces*/
+  if (i == card->current_index + value_width || card->string[i] == '\0') {
+    errno = EINVAL;
+
+    return 0.0;
+  }
+
+  /* Check for sign*/
+  if (card->string[i] == '-') {
+    sign = -1.0;
+    i++;
+  } else if (card->string[i] == '+') {
+    i++;
+  }
+
+  if (i == card->current_index + value_width || card->string[i] == '\0' ||
+      card->string[i] == ' ') {
+    errno = EINVAL;
+
+    return 0.0;
+  }
+
+  /* Parse integer part*/
+  while (i < card->current_index + value_width && card->string[i] != '\0' &&
+         card->string[i] != '.' && card->string[i] != 'e' &&
+         card->string[i] != 'E') {
+    if (card->string[i] >= '0' && card->string[i] <= '9') {
+      has_integer = 1;
+
+      result = result * 10.0 + (card->string[i] - '0');
+    } else if (card->string[i] == ' ') {
+      /* Quit when encountering whitespace*/
+      result *= sign;
+
+      return result;
+    } else {
+      /* Invalid character*/
+      errno = EINVAL;
+
+      return 0.0;
+    }
+    i++;
+  }
+
+  /* If we already reached the end*/
+  if (i == card->current_index + value_width || card->string[i] == '\0') {
+    result *= sign;
+
+    return result;
+  }
+
+  /* Parse fraction part*/
+  if (card->string[i] == '.') {
+    i++;
+    has_fraction = 1;
+    while (i < card->current_index + value_width && card->string[i] != '\0' &&
+           card->string[i] != 'e' && card->string[i] != 'E') {
+      if (card->string[i] >= '0' && card->string[i] <= '9') {
+        fraction = fraction * 10.0 + (card->string[i] - '0');
+        exponent *= 10.0;
+        i++;
+      } else if (card->string[i] == ' ') {
+        /* Quit when encountering whitespace*/
+        fraction /= exponent;
+        result += fraction;
+        result *= sign;
+
+        return result;
+      } else {
+        /* Invalid character*/
+        errno = EINVAL;
+
+        return 0.0;
+      }
+    }
+
+    /* If we already reached the end*/
+    if (i == card->current_index + value_width || card->string[i] == '\0') {
+      fraction /= exponent;
+      result += fraction;
+      result *= sign;
+
+      return result;
+    }
+  }
+
+  /* Parse exponent part*/
+  if (card->string[i] == 'e' || card->string[i] == 'E') {
+    if (!has_integer) {
+      errno = EINVAL;
+
+      return 0.0;
+    }
+
+    i++;
+    if (card->string[i] == '-') {
+      exponent_sign = -1;
+      i++;
+    } else if (card->string[i] == '+') {
+      i++;
+    }
+
+    if (i == card->current_index + value_width || card->string[i] == '\0' ||
+        card->string[i] == ' ') {
+      if (has_fraction) {
+        fraction /= exponent;
+        result += fraction;
+      }
+
+      result *= sign;
+
+      errno = EINVAL;
+
+      return result;
+    }
+
+    while (i < card->current_index + value_width && card->string[i] != '\0') {
+      if (card->string[i] >= '0' && card->string[i] <= '9') {
+        has_exponent = 1;
+
+        exponent_value = exponent_value * 10 + (card->string[i] - '0');
+        i++;
+      } else if (card->string[i] == ' ') {
+        /* Quit when encountering whitespace*/
+        if (has_fraction) {
+          fraction /= exponent;
+          result += fraction;
+        }
+        result *= pow(10, exponent_sign * exponent_value);
+        result *= sign;
+
+        return result;
+      } else {
+        /* Invalid character*/
+        errno = EINVAL;
+
+        return 0.0;
+      }
+    }
+
+    if (!has_exponent) {
+      if (has_fraction) {
+        fraction /= exponent;
+        result += fraction;
+      }
+
+      result *= sign;
+
+      errno = EINVAL;
+
+      return result;
+    }
+  }
+
+  /* Combine integer, fraction, and exponent parts */
+  if (has_fraction) {
+    fraction /= exponent;
+    result += fraction;
+  }
+  if (has_exponent) {
+    result *= pow(10, exponent_sign * exponent_value);
+  }
+
+  result *= sign;
+
+  return result;
+}
+
+TEST_CASE("card_parse_float64") {
+  card_t card;
+  card.current_index = 0;
+  card.value_width = 16;
+
+  card.string = stralloc("             1.0");
+  CHECK(card_parse_float64(&card) == 1.0);
+  CHECK(errno == 0);
+
+  card.string = stralloc("           1.0-3");
+  CHECK(card_parse_float64(&card) == 0.001);
+  CHECK(errno == 0);
+
+  card.string = stralloc("  -2.5+2");
+  CHECK(card_parse_float64(&card) == -250.0);
+  CHECK(errno == 0);
+
+  card.string = stralloc("1.5d3");
+  CHECK(card_parse_float64(&card) == 1500.0);
+  CHECK(card_parse_get_type(&card) == CARD_PARSE_FLOAT);
+
+  card.string = stralloc("7-1");
+  CHECK(card_parse_float64(&card) == 0.7);
+  CHECK(card_parse_get_type(&card) == CARD_PARSE_FLOAT);
+
+  card.string = stralloc("12345678.12345678");
+  CHECK(card_parse_float64_width(&card, 17) == 12345678.12345678);
+
+  card.string = stralloc("0.1234567890123456789012");
+  CHECK(card_parse_float64_width(&card, 24) == 0.1234567890123456789012);
+
+  card.string = stralloc("1.7976931348623157e308");
+  CHECK(card_parse_float64_width(&card, 22) == 1.7976931348623157e308);
+
+  card.string = stralloc("                ");
+  card_parse_float64(&card);
+  CHECK(errno == EINVAL);
+
+  card.string = stralloc("1.0e");
+  card_parse_float64(&card);
+  CHECK(errno == EINVAL);
+
+  card.string = stralloc("1.0-");
+  card_parse_float64(&card);
+  CHECK(errno == EINVAL);
+
+  card.string = stralloc("5.6j");
+  card_parse_float64(&card);
+  CHECK(errno == EINVAL);
+
+  /* Compare against the previous implementation and strtod using random
+   * numbers in all kinds of formats*/
+  const char *formats[] = {"%16.*e", "%16.*f", "%16.*g", "%-16.*E"};
+  char buffer[64];
+  uint64_t seed = 0x2545F4914F6CDD1D;
+  for (int i = 0; i < 100000; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const double mantissa =
+        static_cast<double>(seed >> 11) / static_cast<double>(1ULL << 53);
+    const int exponent = static_cast<int>((seed >> 3) % 21) - 10;
+    const int precision = static_cast<int>((seed >> 7) % 9);
+    const double value =
+        (seed & 1 ? -1.0 : 1.0) * mantissa * std::pow(10.0, exponent);
+
+    snprintf(buffer, sizeof(buffer), formats[(seed >> 1) % 4], precision,
+             value);
+    if (strlen(buffer) > 16) {
+      continue;
+    }
+
+    card.string = buffer;
+    card.current_index = 0;
+    const double expected_value = strtod(buffer, nullptr);
+    const double reference_value =
+        reference_card_parse_float64_width(&card, 16);
+    REQUIRE(errno == 0);
+    const double parsed_value = card_parse_float64_width(&card, 16);
+    REQUIRE(errno == 0);
+
+    INFO(buffer);
+    CHECK(parsed_value == expected_value);
+    CHECK(parsed_value == doctest::Approx(reference_value).epsilon(1e-12));
+  }
+}
+
 TEST_CASE("key_file_parse_no_includes") {
   key_parse_config_t parse_config = {0};
 
@@ -942,6 +1223,369 @@ TEST_CASE("key_file_include_transform") {
   key_file_free(keywords, num_keywords);
 }
 
+TEST_CASE("key_parse_nodes") {
+  card_t cards[4];
+  cards[0].string = stralloc(
+      "       1             0.0             1.0            -2.5       0       0");
+  cards[1].string = stralloc("2,1.5,2e3,-1.0");
+  cards[2].string = stralloc("                   3                 1.0       "
+                             "          2.0                 3.0");
+  cards[3].string = stralloc("       4   1.0E-03");
+
+  keyword_t keyword;
+  keyword.name = stralloc("NODE");
+  keyword.cards = cards;
+  keyword.num_cards = 4;
+
+  char *error_string;
+  key_nodes_t nodes = key_parse_nodes(&keyword, 1, &error_string);
+  REQUIRE(error_string == NULL);
+  REQUIRE(nodes.num_nodes == 4);
+
+  CHECK(nodes.ids[0] == 1);
+  CHECK(nodes.xyz[0] == 0.0);
+  CHECK(nodes.xyz[1] == 1.0);
+  CHECK(nodes.xyz[2] == -2.5);
+  CHECK(nodes.ids[1] == 2);
+  CHECK(nodes.xyz[3] == 1.5);
+  CHECK(nodes.xyz[4] == 2000.0);
+  CHECK(nodes.xyz[5] == -1.0);
+  CHECK(nodes.ids[2] == 3);
+  CHECK(nodes.xyz[6] == 1.0);
+  CHECK(nodes.xyz[7] == 2.0);
+  CHECK(nodes.xyz[8] == 3.0);
+  CHECK(nodes.ids[3] == 4);
+  CHECK(nodes.xyz[9] == doctest::Approx(0.001));
+  CHECK(nodes.xyz[10] == 0.0);
+  CHECK(nodes.xyz[11] == 0.0);
+
+  key_free_nodes(&nodes);
+
+  card_t solid_cards[3];
+  solid_cards[0].string = stralloc("       1       2      10      11      12  "
+                                   "    13      14      15      16      17");
+  solid_cards[1].string = stralloc("       2       2");
+  solid_cards[2].string = stralloc(
+      "      20      21      22      23      24      25      26      27");
+  keyword.name = stralloc("ELEMENT_SOLID");
+  keyword.cards = solid_cards;
+  keyword.num_cards = 3;
+
+  key_elements_t solids = key_parse_element_solid(&keyword, 1, &error_string);
+  REQUIRE(error_string == NULL);
+  REQUIRE(solids.num_elements == 2);
+  CHECK(solids.nodes_per_element == KEY_SOLID_NUM_NODES);
+  CHECK(solids.ids[0] == 1);
+  CHECK(solids.ids[1] == 2);
+  CHECK(solids.part_ids[0] == 2);
+  CHECK(solids.part_ids[1] == 2);
+  CHECK(solids.connectivity[0] == 10);
+  CHECK(solids.connectivity[7] == 17);
+  CHECK(solids.connectivity[8] == 20);
+  CHECK(solids.connectivity[15] == 27);
+  key_free_elements(&solids);
+
+  card_t shell_cards[4];
+  shell_cards[0].string = stralloc("1,3,1,2,3,4");
+  shell_cards[1].string = stralloc("1.0,1.0,1.0,1.0");
+  shell_cards[2].string = stralloc("       2       3       5       6       7");
+  shell_cards[3].string = stralloc("     1.0");
+  keyword.name = stralloc("ELEMENT_SHELL_THICKNESS");
+  keyword.cards = shell_cards;
+  keyword.num_cards = 4;
+
+  key_elements_t shells = key_parse_element_shell(&keyword, 1, &error_string);
+  REQUIRE(error_string == NULL);
+  REQUIRE(shells.num_elements == 2);
+  CHECK(shells.ids[1] == 2);
+  CHECK(shells.part_ids[0] == 3);
+  CHECK(shells.connectivity[3] == 4);
+  CHECK(shells.connectivity[4] == 5);
+  CHECK(shells.connectivity[7] == 0);
+  key_free_elements(&shells);
+
+  keyword.name = stralloc("ELEMENT_SHELL_COMPOSITE");
+  shells = key_parse_element_shell(&keyword, 1, &error_string);
+  CHECK(error_string == "The keyword ELEMENT_SHELL_COMPOSITE is not supported");
+  CHECK(shells.num_elements == 0);
+  free(error_string);
+
+  card_t beam_card;
+  beam_card.string = stralloc("       1       2       3       4       x");
+  keyword.name = stralloc("ELEMENT_BEAM");
+  keyword.cards = &beam_card;
+  keyword.num_cards = 1;
+
+  key_elements_t beams = key_parse_element_beam(&keyword, 1, &error_string);
+  CHECK(error_string != NULL);
+  CHECK(beams.num_elements == 0);
+  free(error_string);
+}
+
+TEST_CASE("key_file_parse_keyword_filter") {
+  CHECK(_key_glob_match("MAT_*", "MAT_ELASTIC"));
+  CHECK(_key_glob_match("mat_*", "MAT_ELASTIC"));
+  CHECK(_key_glob_match("*", ""));
+  CHECK(_key_glob_match("ELEMENT_?HELL", "ELEMENT_SHELL"));
+  CHECK(_key_glob_match("*_SHELL*", "ELEMENT_SHELL_THICKNESS"));
+  CHECK(_key_glob_match("*A*B", "XAYAB"));
+  CHECK(!_key_glob_match("MAT_*", "MAT"));
+  CHECK(!_key_glob_match("NODE", "NODE_SCALAR"));
+  CHECK(!_key_glob_match("*A*B", "XAYABC"));
+  CHECK(!_key_glob_match("", "NODE"));
+
+  const char *file_name = "key_file_parse_keyword_filter.k";
+  FILE *file = fopen(file_name, "w");
+  REQUIRE(file != NULL);
+  fputs("*KEYWORD\n"
+        "*NODE\n"
+        "       1     0.0     0.0     0.0\n"
+        "       2     1.0     0.0     0.0\n"
+        "*ELEMENT_SHELL\n"
+        "       1       1       1       2       2       1\n"
+        "*MAT_ELASTIC\n"
+        "       1   7.8E-9  210000.0       0.3\n"
+        "*MAT_RIGID\n"
+        "       2   7.8E-9  210000.0       0.3\n"
+        "*CONTROL_TERMINATION\n"
+        "*END\n",
+        file);
+  fclose(file);
+
+  key_parse_config_t parse_config = key_default_parse_config();
+  char *include_keywords[] = {const_cast<char *>("MAT_*"),
+                              const_cast<char *>("NODE"),
+                              const_cast<char *>("CONTROL_*")};
+  char *exclude_keywords[] = {const_cast<char *>("*RIGID")};
+  parse_config.include_keywords = include_keywords;
+  parse_config.num_include_keywords = 3;
+  parse_config.exclude_keywords = exclude_keywords;
+  parse_config.num_exclude_keywords = 1;
+
+  char *error_string;
+  size_t num_keywords;
+  keyword_t *keywords = key_file_parse(file_name, &num_keywords, &parse_config,
+                                       &error_string, NULL);
+  remove(file_name);
+  REQUIRE(error_string == NULL);
+  REQUIRE(num_keywords == 3);
+
+  CHECK(key_file_get(keywords, num_keywords, "ELEMENT_SHELL", 0) == NULL);
+  CHECK(key_file_get(keywords, num_keywords, "MAT_RIGID", 0) == NULL);
+  CHECK(key_file_get(keywords, num_keywords, "KEYWORD", 0) == NULL);
+
+  keyword_t *node = key_file_get(keywords, num_keywords, "NODE", 0);
+  REQUIRE(node != NULL);
+  CHECK(node->num_cards == 2);
+  keyword_t *mat = key_file_get(keywords, num_keywords, "MAT_ELASTIC", 0);
+  REQUIRE(mat != NULL);
+  CHECK(mat->num_cards == 1);
+  keyword_t *control =
+      key_file_get(keywords, num_keywords, "CONTROL_TERMINATION", 0);
+  REQUIRE(control != NULL);
+  CHECK(control->num_cards == 0);
+
+  key_file_free(keywords, num_keywords);
+}
+
+TEST_CASE("key_index") {
+  const char *names[] = {"CONTROL_TERMINATION",
+                         "ELEMENT_SHELL",
+                         "ELEMENT_SHELL",
+                         "ELEMENT_SOLID",
+                         "MAT",
+                         "MAT_ELASTIC",
+                         "MAT_ELASTIC",
+                         "MAT_ELASTIC",
+                         "MAT_RIGID",
+                         "NODE",
+                         "NODE_SCALAR"};
+  const size_t num_keywords = sizeof(names) / sizeof(*names);
+  keyword_t keywords[num_keywords];
+  for (size_t i = 0; i < num_keywords; i++) {
+    keywords[i].name = const_cast<char *>(names[i]);
+    keywords[i].cards = NULL;
+    keywords[i].num_cards = 0;
+  }
+
+  key_index_t index = key_index_new(keywords, num_keywords);
+  CHECK(index.num_names == 8);
+
+  size_t slice_size;
+  keyword_t *slice = key_index_get_slice(&index, "MAT_ELASTIC", &slice_size);
+  CHECK(slice == &keywords[5]);
+  CHECK(slice_size == 3);
+  CHECK(key_index_get(&index, "MAT_ELASTIC", 2) == &keywords[7]);
+  CHECK(key_index_get(&index, "MAT_ELASTIC", 3) == NULL);
+  CHECK(key_index_get(&index, "CONTROL_TERMINATION", 0) == &keywords[0]);
+  CHECK(key_index_get(&index, "NODE_SCALAR", 0) == &keywords[10]);
+  CHECK(key_index_get_slice(&index, "MAT_", &slice_size) == NULL);
+  CHECK(slice_size == 0);
+  CHECK(key_index_get(&index, "PART", 0) == NULL);
+
+  for (size_t i = 0; i < num_keywords; i++) {
+    size_t expected_size;
+    keyword_t *expected =
+        key_file_get_slice(keywords, num_keywords, names[i], &expected_size);
+    CHECK(key_index_get_slice(&index, names[i], &slice_size) == expected);
+    CHECK(slice_size == expected_size);
+  }
+
+  slice = key_index_get_prefix(&index, "MAT_", &slice_size);
+  CHECK(slice == &keywords[5]);
+  CHECK(slice_size == 4);
+  slice = key_index_get_prefix(&index, "ELEMENT_SHELL_", &slice_size);
+  CHECK(slice == NULL);
+  CHECK(slice_size == 0);
+  slice = key_index_get_prefix(&index, "ELEMENT_", &slice_size);
+  CHECK(slice == &keywords[1]);
+  CHECK(slice_size == 3);
+  slice = key_index_get_prefix(&index, "MAT", &slice_size);
+  CHECK(slice == &keywords[4]);
+  CHECK(slice_size == 5);
+  slice = key_index_get_prefix(&index, "NODE", &slice_size);
+  CHECK(slice == &keywords[9]);
+  CHECK(slice_size == 2);
+  slice = key_index_get_prefix(&index, "ELEMENT_SO", &slice_size);
+  CHECK(slice == &keywords[3]);
+  CHECK(slice_size == 1);
+  slice = key_index_get_prefix(&index, "Z", &slice_size);
+  CHECK(slice == NULL);
+  CHECK(slice_size == 0);
+  slice = key_index_get_prefix(&index, "", &slice_size);
+  CHECK(slice == keywords);
+  CHECK(slice_size == num_keywords);
+
+  key_index_free(&index);
+
+  index = key_index_new(NULL, 0);
+  CHECK(key_index_get_slice(&index, "NODE", &slice_size) == NULL);
+  CHECK(key_index_get_prefix(&index, "MAT_", &slice_size) == NULL);
+  key_index_free(&index);
+}
+
+TEST_CASE("key_incremental_parse") {
+  const auto write_file = [](const char *file_name, const char *content) {
+    FILE *file = fopen(file_name, "w");
+    REQUIRE(file != NULL);
+    fputs(content, file);
+    fclose(file);
+  };
+
+  write_file("key_incremental_root.k", "*KEYWORD\n"
+                                       "*INCLUDE\n"
+                                       "key_incremental_a.k\n"
+                                       "key_incremental_b.k\n"
+                                       "*PART\n"
+                                       "root\n"
+                                       "*END\n");
+  write_file("key_incremental_a.k", "*NODE\n"
+                                    "       1     0.0     0.0     0.0\n"
+                                    "*END\n");
+  write_file("key_incremental_b.k", "*NODE\n"
+                                    "       2     1.0     0.0     0.0\n"
+                                    "*END\n");
+
+  key_incremental_t incremental = key_incremental_new();
+  char *error_string;
+  size_t num_keywords;
+  keyword_t *keywords = key_incremental_parse(
+      &incremental, "key_incremental_root.k", &num_keywords, NULL,
+      &error_string, NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_files == 3);
+  CHECK(incremental.num_parsed_files == 3);
+  CHECK(incremental.num_reused_files == 0);
+  REQUIRE(num_keywords == 4);
+  CHECK(keywords[1].name == "NODE");
+  CHECK(keywords[1].cards[0].string == "       1     0.0     0.0     0.0");
+  CHECK(keywords[2].cards[0].string == "       2     1.0     0.0     0.0");
+  key_file_free(keywords, num_keywords);
+
+  /* Nothing changed*/
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, NULL, &error_string, NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_parsed_files == 0);
+  CHECK(incremental.num_reused_files == 3);
+  REQUIRE(num_keywords == 4);
+  CHECK(keywords[0].name == "KEYWORD");
+  CHECK(keywords[1].cards[0].string == "       1     0.0     0.0     0.0");
+  CHECK(keywords[2].cards[0].string == "       2     1.0     0.0     0.0");
+  CHECK(keywords[3].name == "PART");
+  CHECK(keywords[3].cards[0].string == "root");
+  key_file_free(keywords, num_keywords);
+
+  /* Only one include changed*/
+  write_file("key_incremental_b.k", "*NODE\n"
+                                    "       2     1.0     0.0     0.0\n"
+                                    "       3     2.0     0.0     0.0\n"
+                                    "*END\n");
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, NULL, &error_string, NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_parsed_files == 1);
+  CHECK(incremental.num_reused_files == 2);
+  REQUIRE(num_keywords == 4);
+  CHECK(keywords[1].num_cards == 1);
+  REQUIRE(keywords[2].num_cards == 2);
+  CHECK(keywords[2].cards[1].string == "       3     2.0     0.0     0.0");
+  key_file_free(keywords, num_keywords);
+
+  /* The root file does not include a anymore*/
+  write_file("key_incremental_root.k", "*KEYWORD\n"
+                                       "*INCLUDE\n"
+                                       "key_incremental_b.k\n"
+                                       "*END\n");
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, NULL, &error_string, NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_files == 2);
+  CHECK(incremental.num_parsed_files == 1);
+  CHECK(incremental.num_reused_files == 1);
+  REQUIRE(num_keywords == 2);
+  CHECK(keywords[1].name == "NODE");
+  CHECK(keywords[1].num_cards == 2);
+  key_file_free(keywords, num_keywords);
+
+  /* A different parse config can not reuse the recorded files*/
+  key_parse_config_t parse_config = key_default_parse_config();
+  char *exclude_keywords[] = {(char *)"NODE"};
+  parse_config.exclude_keywords = exclude_keywords;
+  parse_config.num_exclude_keywords = 1;
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, &parse_config, &error_string,
+                                   NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_parsed_files == 2);
+  CHECK(incremental.num_reused_files == 0);
+  REQUIRE(num_keywords == 1);
+  CHECK(keywords[0].name == "KEYWORD");
+  key_file_free(keywords, num_keywords);
+
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, &parse_config, &error_string,
+                                   NULL);
+  REQUIRE(error_string == NULL);
+  CHECK(incremental.num_parsed_files == 0);
+  CHECK(incremental.num_reused_files == 2);
+  CHECK(num_keywords == 1);
+  key_file_free(keywords, num_keywords);
+
+  remove("key_incremental_root.k");
+  remove("key_incremental_a.k");
+  remove("key_incremental_b.k");
+
+  keywords = key_incremental_parse(&incremental, "key_incremental_root.k",
+                                   &num_keywords, NULL, &error_string, NULL);
+  CHECK(error_string != NULL);
+  CHECK(keywords == NULL);
+  CHECK(num_keywords == 0);
+  free(error_string);
+
+  key_incremental_free(&incremental);
+}
+
 #ifdef BUILD_CPP
 #define FABS(x) ((x) > 0 ? (x) : -(x))
 
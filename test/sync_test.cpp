@@ -45,6 +45,28 @@ TEST_CASE("sync") {
   CHECK(sync_unlock(&snc) == 0);
   sync_destroy(&snc);
 }
+
+TEST_CASE("thread") {
+  const auto square = [](void *arg) {
+    size_t *value = reinterpret_cast<size_t *>(arg);
+    *value *= *value;
+  };
+
+  size_t values[4] = {1, 2, 3, 4};
+  thread_t threads[4];
+  for (size_t i = 0; i < 4; i++) {
+    REQUIRE(thread_create(&threads[i], square, &values[i]) == 0);
+  }
+  for (size_t i = 0; i < 4; i++) {
+    CHECK(thread_join(&threads[i]) == 0);
+  }
+
+  CHECK(values[0] == 1);
+  CHECK(values[1] == 4);
+  CHECK(values[2] == 9);
+  CHECK(values[3] == 16);
+  CHECK(thread_num_processors() >= 1);
+}
 #endif
 
 TEST_CASE("multi_file") {
@@ -55,6 +55,11 @@ target("dynareadout")
     end
     add_options("profiling", "thread_safe")
     add_files("src/*.c")
+    if is_plat("linux", "macosx") then
+        -- sqrt does not need to set errno, so that the loops of
+        -- d3plot_derived.c can be vectorized
+        add_files("src/d3plot_derived.c", {cflags = "-fno-math-errno"})
+    end
     if not get_config("profiling") then
         remove_files("src/profiling.c")
     end
@@ -64,6 +69,9 @@ target("dynareadout")
     elseif not is_plat("windows") then
         add_syslinks("pthread")
     end
+    if not is_plat("windows") then
+        add_syslinks("m")
+    end
     add_headerfiles("src/*.h")
     if is_kind("shared") then
         add_rules("utils.symbols.export_all")